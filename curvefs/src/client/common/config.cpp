@@ -203,6 +203,12 @@ void InitDiskCacheOption(Configuration *conf,
                               &diskCacheOption->avgReadFileBytes);
     conf->GetValueFatalIfFail("diskCache.avgReadFileIops",
                               &diskCacheOption->avgReadFileIops);
+    LOG_IF(WARNING, !conf->GetStringValue(
+                        "diskCache.readCacheAdmission",
+                        &diskCacheOption->readCacheAdmission))
+        << "Not found `diskCache.readCacheAdmission` in conf, "
+           "use default value `"
+        << diskCacheOption->readCacheAdmission << '`';
 }
 
 void InitS3Option(Configuration *conf, S3Option *s3Opt) {
@@ -211,6 +217,21 @@ void InitS3Option(Configuration *conf, S3Option *s3Opt) {
                               &s3Opt->s3ClientAdaptorOpt.pageSize);
     conf->GetValueFatalIfFail("s3.prefetchBlocks",
                               &s3Opt->s3ClientAdaptorOpt.prefetchBlocks);
+    LOG_IF(WARNING, !conf->GetUInt32Value(
+                        "s3.maxReadAheadBlocks",
+                        &s3Opt->s3ClientAdaptorOpt.maxReadAheadBlocks))
+        << "Not found `s3.maxReadAheadBlocks` in conf, use default value `"
+        << s3Opt->s3ClientAdaptorOpt.maxReadAheadBlocks << '`';
+    LOG_IF(WARNING, !conf->GetUInt32Value(
+                        "s3.readAheadThreads",
+                        &s3Opt->s3ClientAdaptorOpt.readAheadThreads))
+        << "Not found `s3.readAheadThreads` in conf, use default value `"
+        << s3Opt->s3ClientAdaptorOpt.readAheadThreads << '`';
+    LOG_IF(WARNING, !conf->GetUInt64Value(
+                        "s3.readAheadInflightBytes",
+                        &s3Opt->s3ClientAdaptorOpt.readAheadInflightBytes))
+        << "Not found `s3.readAheadInflightBytes` in conf, use default value `"
+        << s3Opt->s3ClientAdaptorOpt.readAheadInflightBytes << '`';
     conf->GetValueFatalIfFail("s3.prefetchExecQueueNum",
                               &s3Opt->s3ClientAdaptorOpt.prefetchExecQueueNum);
     conf->GetValueFatalIfFail("s3.threadScheduleInterval",
@@ -219,12 +240,32 @@ void InitS3Option(Configuration *conf, S3Option *s3Opt) {
                               &s3Opt->s3ClientAdaptorOpt.flushIntervalSec);
     conf->GetValueFatalIfFail("s3.chunkFlushThreads",
                               &s3Opt->s3ClientAdaptorOpt.chunkFlushThreads);
+    LOG_IF(WARNING, !conf->GetUInt32Value(
+                        "s3.dataCacheFlushThreads",
+                        &s3Opt->s3ClientAdaptorOpt.dataCacheFlushThreads))
+        << "Not found `s3.dataCacheFlushThreads` in conf, use default value `"
+        << s3Opt->s3ClientAdaptorOpt.dataCacheFlushThreads << '`';
+    LOG_IF(WARNING, !conf->GetUInt64Value(
+                        "s3.flushInflightBytes",
+                        &s3Opt->s3ClientAdaptorOpt.flushInflightBytes))
+        << "Not found `s3.flushInflightBytes` in conf, use default value `"
+        << s3Opt->s3ClientAdaptorOpt.flushInflightBytes << '`';
     conf->GetValueFatalIfFail("s3.writeCacheMaxByte",
                               &s3Opt->s3ClientAdaptorOpt.writeCacheMaxByte);
     conf->GetValueFatalIfFail("s3.readCacheMaxByte",
                               &s3Opt->s3ClientAdaptorOpt.readCacheMaxByte);
     conf->GetValueFatalIfFail("s3.readCacheThreads",
                               &s3Opt->s3ClientAdaptorOpt.readCacheThreads);
+    LOG_IF(WARNING, !conf->GetUInt32Value(
+                        "s3.readCacheShards",
+                        &s3Opt->s3ClientAdaptorOpt.readCacheShards))
+        << "Not found `s3.readCacheShards` in conf, use default value `"
+        << s3Opt->s3ClientAdaptorOpt.readCacheShards << '`';
+    LOG_IF(WARNING, !conf->GetStringValue(
+                        "s3.readCacheAdmission",
+                        &s3Opt->s3ClientAdaptorOpt.readCacheAdmission))
+        << "Not found `s3.readCacheAdmission` in conf, use default value `"
+        << s3Opt->s3ClientAdaptorOpt.readCacheAdmission << '`';
     conf->GetValueFatalIfFail("s3.nearfullRatio",
                               &s3Opt->s3ClientAdaptorOpt.nearfullRatio);
     conf->GetValueFatalIfFail("s3.baseSleepUs",
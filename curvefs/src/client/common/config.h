@@ -117,6 +117,8 @@ struct DiskCacheOption {
     uint64_t avgFlushIops;
     // the read throttle iops of disk cache
     uint64_t avgReadFileIops;
+    // admission policy of the objects read into disk cache, lru or tinylfu
+    std::string readCacheAdmission = "lru";
 };
 
 struct S3ClientAdaptorOption {
@@ -124,13 +126,27 @@ struct S3ClientAdaptorOption {
     uint64_t chunkSize;
     uint64_t pageSize;
     uint32_t prefetchBlocks;
+    // max blocks read ahead of a file read sequentially, 0 means disabled
+    uint32_t maxReadAheadBlocks = 0;
+    // threads reading ahead, apart from the threads reading for the callers
+    uint32_t readAheadThreads = 4;
+    // memory of the buffers being read ahead, 0 means not limited
+    uint64_t readAheadInflightBytes = 67108864;
     uint32_t prefetchExecQueueNum;
     uint32_t intervalSec;
     uint32_t chunkFlushThreads;
+    // threads putting the data caches of the flushing chunks to s3
+    uint32_t dataCacheFlushThreads = 16;
+    // memory of the data caches being put to s3, 0 means not limited
+    uint64_t flushInflightBytes = 268435456;
     uint32_t flushIntervalSec;
     uint64_t writeCacheMaxByte;
     uint64_t readCacheMaxByte;
     uint32_t readCacheThreads;
+    // shards of the read cache lru, a file chunk belongs to one shard
+    uint32_t readCacheShards = 32;
+    // admission policy of the read cache, lru or tinylfu
+    std::string readCacheAdmission = "lru";
     uint32_t nearfullRatio;
     uint32_t baseSleepUs;
     uint32_t maxReadRetryIntervalMs;
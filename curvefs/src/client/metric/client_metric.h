@@ -208,6 +208,29 @@ struct S3MultiManagerMetric {
     }
 };
 
+// lookups of a read cache and the admissions of the data read into it
+struct ReadCacheMetric {
+    bvar::Adder<uint64_t> hit;
+    bvar::Adder<uint64_t> miss;
+    bvar::Adder<uint64_t> admit;
+    bvar::Adder<uint64_t> reject;
+    bvar::PassiveStatus<double> hitRatio;
+
+    ReadCacheMetric(const std::string &prefix, const std::string &name)
+        : hit(prefix, name + "_hit"),
+          miss(prefix, name + "_miss"),
+          admit(prefix, name + "_admit"),
+          reject(prefix, name + "_reject"),
+          hitRatio(prefix, name + "_hit_ratio", GetHitRatio, this) {}
+
+    static double GetHitRatio(void *arg) {
+        auto *metric = static_cast<ReadCacheMetric *>(arg);
+        uint64_t hit = metric->hit.get_value();
+        uint64_t total = hit + metric->miss.get_value();
+        return total == 0 ? 0 : static_cast<double>(hit) / total;
+    }
+};
+
 struct FSMetric {
     static const std::string prefix;
 
@@ -237,8 +260,11 @@ struct S3Metric {
     InterfaceMetric adaptorWriteDiskCache;
     InterfaceMetric adaptorReadS3;
     InterfaceMetric adaptorReadDiskCache;
+    // data caches flushed to s3 and their metadata
+    InterfaceMetric adaptorFlush;
     bvar::Status<uint32_t> readSize;
     bvar::Status<uint32_t> writeSize;
+    ReadCacheMetric memReadCache;
 
     explicit S3Metric(const std::string &name = "")
         : fsName(!name.empty() ? name
@@ -249,8 +275,10 @@ struct S3Metric {
           adaptorWriteDiskCache(prefix, fsName + "_adaptor_write_disk_cache"),
           adaptorReadS3(prefix, fsName + "_adaptor_read_s3"),
           adaptorReadDiskCache(prefix, fsName + "_adaptor_read_disk_cache"),
+          adaptorFlush(prefix, fsName + "_adaptor_flush"),
           readSize(prefix, fsName + "_adaptor_read_size", 0),
-          writeSize(prefix, fsName + "_adaptor_write_size", 0) {}
+          writeSize(prefix, fsName + "_adaptor_write_size", 0),
+          memReadCache(prefix, fsName + "_mem_read_cache") {}
 };
 
 struct DiskCacheMetric {
@@ -259,12 +287,14 @@ struct DiskCacheMetric {
     std::string fsName;
     InterfaceMetric writeS3;
     bvar::Status<uint64_t> diskUsedBytes;
+    ReadCacheMetric readCache;
 
     explicit DiskCacheMetric(const std::string &name = "")
         : fsName(!name.empty() ? name
                                : prefix + curve::common::ToHexString(this)),
           writeS3(prefix, fsName + "_write_s3"),
-          diskUsedBytes(prefix, fsName + "_diskcache_usedbytes", 0) {}
+          diskUsedBytes(prefix, fsName + "_diskcache_usedbytes", 0),
+          readCache(prefix, fsName + "_diskcache_read") {}
 };
 
 struct KVClientMetric {
@@ -0,0 +1,142 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "curvefs/src/client/s3/cache_admission.h"
+
+#include <algorithm>
+
+namespace curvefs {
+namespace client {
+
+constexpr uint32_t FrequencySketch::kMaxFrequency;
+constexpr int FrequencySketch::kDepth;
+
+namespace {
+
+const uint64_t kMinTableSize = 64;
+const uint64_t kMaxTableSize = 1ull << 22;
+const uint64_t kSampleFactor = 10;
+const uint64_t kSeeds[] = {0xc3a5c85c97cb3127ull, 0xb492b66fbe98f273ull,
+                           0x9ae16a3b2f90404full, 0xcbf29ce484222325ull};
+
+uint64_t Mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+uint64_t TableSize(uint64_t capacity) {
+    uint64_t size = kMinTableSize;
+    while (size < capacity && size < kMaxTableSize) {
+        size <<= 1;
+    }
+    return size;
+}
+
+}  // namespace
+
+FrequencySketch::FrequencySketch(uint64_t capacity)
+    : table_(TableSize(capacity)),
+      mask_(table_.size() - 1),
+      sampleSize_(kSampleFactor * std::max<uint64_t>(capacity, 1)),
+      additions_(0) {}
+
+void FrequencySketch::Locate(uint64_t keyHash, int i, uint64_t *index,
+                             uint32_t *shift) const {
+    uint64_t h = Mix(keyHash + kSeeds[i]);
+    *index = (h >> 4) & mask_;
+    *shift = (h & 15) << 2;
+}
+
+void FrequencySketch::Increment(uint64_t keyHash) {
+    bool added = false;
+    for (int i = 0; i < kDepth; i++) {
+        uint64_t index;
+        uint32_t shift;
+        Locate(keyHash, i, &index, &shift);
+        auto &word = table_[index];
+        uint64_t old = word.load(std::memory_order_relaxed);
+        while (((old >> shift) & kMaxFrequency) != kMaxFrequency) {
+            if (word.compare_exchange_weak(old, old + (1ull << shift),
+                                           std::memory_order_relaxed)) {
+                added = true;
+                break;
+            }
+        }
+    }
+
+    if (added &&
+        additions_.fetch_add(1, std::memory_order_relaxed) + 1 >=
+            sampleSize_) {
+        Reset();
+    }
+}
+
+uint32_t FrequencySketch::Frequency(uint64_t keyHash) const {
+    uint32_t frequency = kMaxFrequency;
+    for (int i = 0; i < kDepth; i++) {
+        uint64_t index;
+        uint32_t shift;
+        Locate(keyHash, i, &index, &shift);
+        uint64_t word = table_[index].load(std::memory_order_relaxed);
+        frequency = std::min<uint32_t>(frequency,
+                                       (word >> shift) & kMaxFrequency);
+    }
+    return frequency;
+}
+
+void FrequencySketch::Reset() {
+    std::unique_lock<std::mutex> lk(resetMtx_, std::try_to_lock);
+    // another thread is halving the counters
+    if (!lk.owns_lock() ||
+        additions_.load(std::memory_order_relaxed) < sampleSize_) {
+        return;
+    }
+
+    for (auto &word : table_) {
+        uint64_t old = word.load(std::memory_order_relaxed);
+        while (!word.compare_exchange_weak(
+            old, (old >> 1) & 0x7777777777777777ull,
+            std::memory_order_relaxed)) {
+        }
+    }
+    additions_.store(additions_.load(std::memory_order_relaxed) / 2,
+                     std::memory_order_relaxed);
+}
+
+std::unique_ptr<CacheAdmission> NewCacheAdmission(const std::string &policy,
+                                                  uint64_t capacity) {
+    if (policy == "lru") {
+        return std::unique_ptr<CacheAdmission>(new LruAdmission());
+    }
+    if (policy == "tinylfu") {
+        return std::unique_ptr<CacheAdmission>(
+            new TinyLfuAdmission(capacity));
+    }
+    return nullptr;
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+#ifndef CURVEFS_SRC_CLIENT_S3_CACHE_ADMISSION_H_
+#define CURVEFS_SRC_CLIENT_S3_CACHE_ADMISSION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace curvefs {
+namespace client {
+
+/**
+ * @brief approximate access frequencies of the keys
+ *
+ * A count-min sketch of 4-bit counters, sixteen counters in a word. All the
+ * counters are halved once the accesses reach ten times the capacity, so
+ * the frequencies follow the recent accesses instead of the whole history.
+ */
+class FrequencySketch {
+ public:
+    static constexpr uint32_t kMaxFrequency = 15;
+
+    // capacity is the number of entries the cache holds
+    explicit FrequencySketch(uint64_t capacity);
+
+    void Increment(uint64_t keyHash);
+
+    uint32_t Frequency(uint64_t keyHash) const;
+
+    uint64_t GetSampleSize() const { return sampleSize_; }
+
+ private:
+    static constexpr int kDepth = 4;
+
+    // word index and counter shift of the key in row i
+    void Locate(uint64_t keyHash, int i, uint64_t *index,
+                uint32_t *shift) const;
+
+    void Reset();
+
+ private:
+    std::vector<std::atomic<uint64_t>> table_;
+    uint64_t mask_;
+    uint64_t sampleSize_;
+    std::atomic<uint64_t> additions_;
+    std::mutex resetMtx_;
+};
+
+/**
+ * @brief decides whether a new entry is worth its place in a full cache
+ *
+ * The cache records every lookup of a key, hit or miss, and asks the
+ * policy before evicting the victim for a candidate read into the cache.
+ */
+class CacheAdmission {
+ public:
+    virtual ~CacheAdmission() = default;
+
+    virtual void RecordAccess(uint64_t keyHash) = 0;
+
+    virtual bool Admit(uint64_t candidateHash, uint64_t victimHash) = 0;
+
+    // false if every candidate is admitted, the cache can skip the victim
+    virtual bool Filtering() const = 0;
+};
+
+// admit every candidate, the cache is a plain lru
+class LruAdmission : public CacheAdmission {
+ public:
+    void RecordAccess(uint64_t) override {}
+
+    bool Admit(uint64_t, uint64_t) override { return true; }
+
+    bool Filtering() const override { return false; }
+};
+
+// admit a candidate only if it is accessed more often than the victim, a
+// scan of cold data doesn't flush the hot entries out of the cache
+class TinyLfuAdmission : public CacheAdmission {
+ public:
+    explicit TinyLfuAdmission(uint64_t capacity) : sketch_(capacity) {}
+
+    void RecordAccess(uint64_t keyHash) override {
+        sketch_.Increment(keyHash);
+    }
+
+    bool Admit(uint64_t candidateHash, uint64_t victimHash) override {
+        return sketch_.Frequency(candidateHash) >
+               sketch_.Frequency(victimHash);
+    }
+
+    bool Filtering() const override { return true; }
+
+ private:
+    FrequencySketch sketch_;
+};
+
+/**
+ * @brief create the admission policy of a cache
+ * @param[in] policy "lru" or "tinylfu"
+ * @param[in] capacity the number of entries the cache holds
+ * @return the policy, nullptr if the policy is unknown
+ */
+std::unique_ptr<CacheAdmission> NewCacheAdmission(const std::string &policy,
+                                                  uint64_t capacity);
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_S3_CACHE_ADMISSION_H_
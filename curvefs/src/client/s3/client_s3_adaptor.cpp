@@ -45,6 +45,7 @@ S3ClientAdaptorImpl::Init(
     blockSize_ = option.blockSize;
     chunkSize_ = option.chunkSize;
     pageSize_ = option.pageSize;
+    pageAllocator_ = std::make_shared<PageAllocator>(pageSize_);
     if (chunkSize_ % blockSize_ != 0) {
         LOG(ERROR) << "chunkSize:" << chunkSize_
                    << " is not integral multiple for the blockSize:"
@@ -52,12 +53,15 @@ S3ClientAdaptorImpl::Init(
         return CURVEFS_ERROR::INVALIDPARAM;
     }
     prefetchBlocks_ = option.prefetchBlocks;
+    maxReadAheadBlocks_ = option.maxReadAheadBlocks;
+    readAheadInflightBytesLimit_ = option.readAheadInflightBytes;
     prefetchExecQueueNum_ = option.prefetchExecQueueNum;
     diskCacheType_ = option.diskCacheOpt.diskCacheType;
     memCacheNearfullRatio_ = option.nearfullRatio;
     throttleBaseSleepUs_ = option.baseSleepUs;
     flushIntervalSec_ = option.flushIntervalSec;
     chunkFlushThreads_ = option.chunkFlushThreads;
+    flushInflightBytesThrottle_.Init(option.flushInflightBytes);
     maxReadRetryIntervalMs_ = option.maxReadRetryIntervalMs;
     readRetryIntervalMs_ = option.readRetryIntervalMs;
     objectPrefix_ = option.objectPrefix;
@@ -65,6 +69,16 @@ S3ClientAdaptorImpl::Init(
     inodeManager_ = inodeManager;
     mdsClient_ = mdsClient;
     fsCacheManager_ = fsCacheManager;
+    if (fsCacheManager_ != nullptr) {
+        auto readCacheAdmission = NewCacheAdmission(
+            option.readCacheAdmission, option.readCacheMaxByte / blockSize_);
+        if (readCacheAdmission == nullptr) {
+            LOG(ERROR) << "unknown read cache admission policy: "
+                       << option.readCacheAdmission;
+            return CURVEFS_ERROR::INVALIDPARAM;
+        }
+        fsCacheManager_->SetReadCacheAdmission(std::move(readCacheAdmission));
+    }
     waitInterval_.Init(option.intervalSec * 1000);
     diskCacheManagerImpl_ = diskCacheManagerImpl;
     kvClientManager_ = std::move(kvClientManager);
@@ -93,16 +107,27 @@ S3ClientAdaptorImpl::Init(
     LOG(INFO) << "S3ClientAdaptorImpl Init. block size:" << blockSize_
               << ", chunk size: " << chunkSize_
               << ", prefetchBlocks: " << prefetchBlocks_
+              << ", maxReadAheadBlocks: " << maxReadAheadBlocks_
+              << ", readAheadThreads: " << option.readAheadThreads
+              << ", readAheadInflightBytes: " << option.readAheadInflightBytes
               << ", prefetchExecQueueNum: " << prefetchExecQueueNum_
               << ", intervalSec: " << option.intervalSec
               << ", flushIntervalSec: " << option.flushIntervalSec
               << ", writeCacheMaxByte: " << option.writeCacheMaxByte
               << ", readCacheMaxByte: " << option.readCacheMaxByte
               << ", readCacheThreads: " << option.readCacheThreads
+              << ", readCacheShards: " << option.readCacheShards
+              << ", readCacheAdmission: " << option.readCacheAdmission
+              << ", dataCacheFlushThreads: " << option.dataCacheFlushThreads
+              << ", flushInflightBytes: " << option.flushInflightBytes
               << ", nearfullRatio: " << option.nearfullRatio
               << ", baseSleepUs: " << option.baseSleepUs;
     // start chunk flush threads
     taskPool_.Start(chunkFlushThreads_);
+    dataCacheFlushPool_.Start(option.dataCacheFlushThreads);
+    if (maxReadAheadBlocks_ > 0) {
+        readAheadPool_.Start(option.readAheadThreads);
+    }
     return CURVEFS_ERROR::OK;
 }
 
@@ -320,6 +345,8 @@ int S3ClientAdaptorImpl::Stop() {
         diskCacheManagerImpl_->UmountDiskCache();
     }
     taskPool_.Stop();
+    dataCacheFlushPool_.Stop();
+    readAheadPool_.Stop();
     client_->Deinit();
     return 0;
 }
@@ -343,6 +370,10 @@ int S3ClientAdaptorImpl::ExecAsyncDownloadTask(
 void S3ClientAdaptorImpl::InitMetrics(const std::string &fsName) {
     fsName_ = fsName;
     s3Metric_ = std::make_shared<S3Metric>(fsName);
+    pageAllocator_->ExposeMetric(S3Metric::prefix, s3Metric_->fsName);
+    if (fsCacheManager_ != nullptr) {
+        fsCacheManager_->InitMetrics(s3Metric_);
+    }
     if (HasDiskCache()) {
         diskCacheManagerImpl_->InitMetrics(fsName);
     }
@@ -399,6 +430,70 @@ void S3ClientAdaptorImpl::Enqueue(
     taskPool_.Enqueue(task);
 }
 
+void S3ClientAdaptorImpl::EnqueueDataCacheFlush(uint64_t bytes,
+                                                std::function<void()> task) {
+    auto flushTask = [this, bytes, task]() {
+        flushInflightBytesThrottle_.OnStart(bytes);
+        task();
+        flushInflightBytesThrottle_.OnComplete(bytes);
+    };
+    // not initialized, e.g. in unit tests
+    if (dataCacheFlushPool_.ThreadOfNums() == 0) {
+        flushTask();
+        return;
+    }
+    dataCacheFlushPool_.Enqueue(flushTask);
+}
+
+bool S3ClientAdaptorImpl::AcquireReadAheadBytes(uint64_t bytes) {
+    if (fsCacheManager_ != nullptr &&
+        fsCacheManager_->MemCacheRatio() > memCacheNearfullRatio_) {
+        return false;
+    }
+
+    uint64_t inflightBytes =
+        readAheadInflightBytes_.load(std::memory_order_relaxed);
+    do {
+        if (readAheadInflightBytesLimit_ > 0 &&
+            inflightBytes + bytes > readAheadInflightBytesLimit_) {
+            return false;
+        }
+    } while (!readAheadInflightBytes_.compare_exchange_weak(
+        inflightBytes, inflightBytes + bytes, std::memory_order_relaxed));
+    return true;
+}
+
+void S3ClientAdaptorImpl::ReleaseReadAheadBytes(uint64_t bytes) {
+    readAheadInflightBytes_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void S3ClientAdaptorImpl::EnqueueReadAhead(std::function<void()> task) {
+    // not initialized, e.g. in unit tests
+    if (readAheadPool_.ThreadOfNums() == 0) {
+        task();
+        return;
+    }
+    readAheadPool_.Enqueue(std::move(task));
+}
+
+void S3ClientAdaptorImpl::FlushInflightBytesThrottle::OnStart(uint64_t len) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    // 0 means not limited, a data cache larger than the limit goes alone
+    while (maxInflightBytes_ > 0 && inflightBytes_ > 0 &&
+           inflightBytes_ + len > maxInflightBytes_) {
+        cond_.wait(lock);
+    }
+
+    inflightBytes_ += len;
+}
+
+void S3ClientAdaptorImpl::FlushInflightBytesThrottle::OnComplete(
+    uint64_t len) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    inflightBytes_ -= len;
+    cond_.notify_all();
+}
+
 int S3ClientAdaptorImpl::FlushChunkClosure(
   std::shared_ptr<FlushChunkCacheContext> context) {
     VLOG(9) << "FlushChunkCacheClosure start: " << context->inode;
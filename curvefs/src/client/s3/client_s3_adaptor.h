@@ -24,7 +24,11 @@
 
 #include <bthread/execution_queue.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -39,6 +43,7 @@
 #include "curvefs/src/client/s3/client_s3.h"
 #include "curvefs/src/client/s3/client_s3_cache_manager.h"
 #include "curvefs/src/client/s3/disk_cache_manager_impl.h"
+#include "curvefs/src/client/s3/page_allocator.h"
 #include "src/common/wait_interval.h"
 namespace curvefs {
 namespace client {
@@ -163,6 +168,9 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
     uint32_t GetPrefetchBlocks() {
         return prefetchBlocks_;
     }
+    uint32_t GetMaxReadAheadBlocks() const {
+        return maxReadAheadBlocks_;
+    }
     uint32_t GetDiskCacheType() {
         return diskCacheType_;
     }
@@ -206,6 +214,9 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
     uint32_t GetPageSize() {
         return pageSize_;
     }
+    std::shared_ptr<PageAllocator> GetPageAllocator() {
+        return pageAllocator_;
+    }
     void InitMetrics(const std::string &fsName);
     void CollectMetrics(InterfaceMetric *interface, int count, uint64_t start);
     void SetDiskCache(DiskCacheType type) {
@@ -245,11 +256,56 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
 
     void Enqueue(std::shared_ptr<FlushChunkCacheContext> context);
 
+    /**
+     * @brief flush a data cache in the data cache flush threads
+     * @param[in] bytes the memory the data cache takes, the data caches
+     *            being flushed take at most flushInflightBytes in total
+     * @param[in] task flush the data cache
+     */
+    void EnqueueDataCacheFlush(uint64_t bytes, std::function<void()> task);
+
+    /**
+     * @brief take the memory of a readahead buffer
+     * @return false if the buffers being read ahead take
+     *         readAheadInflightBytes already or the write cache is nearfull,
+     *         the readahead is skipped then
+     */
+    bool AcquireReadAheadBytes(uint64_t bytes);
+    void ReleaseReadAheadBytes(uint64_t bytes);
+
+    // read ahead in the readahead threads, so the reads of the callers
+    // don't queue up behind it
+    void EnqueueReadAhead(std::function<void()> task);
+
+ private:
+    class FlushInflightBytesThrottle {
+     public:
+        FlushInflightBytesThrottle()
+            : maxInflightBytes_(0), inflightBytes_(0) {}
+
+        void Init(uint64_t maxInflightBytes) {
+            maxInflightBytes_ = maxInflightBytes;
+        }
+
+        void OnStart(uint64_t len);
+        void OnComplete(uint64_t len);
+
+     private:
+        uint64_t maxInflightBytes_;
+        uint64_t inflightBytes_;
+
+        std::mutex mtx_;
+        std::condition_variable cond_;
+    };
+
  private:
     std::shared_ptr<S3Client> client_;
     uint64_t blockSize_;
     uint64_t chunkSize_;
     uint32_t prefetchBlocks_;
+    uint32_t maxReadAheadBlocks_ = 0;
+    uint64_t readAheadInflightBytesLimit_ = 0;
+    std::atomic<uint64_t> readAheadInflightBytes_{0};
     uint32_t prefetchExecQueueNum_;
     std::string allocateServerEps_;
     uint32_t flushIntervalSec_;
@@ -275,11 +331,19 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
     std::vector<bthread::ExecutionQueueId<AsyncDownloadTask>>
       downloadTaskQueues_;
     uint32_t pageSize_;
+    std::shared_ptr<PageAllocator> pageAllocator_;
 
     int FlushChunkClosure(std::shared_ptr<FlushChunkCacheContext> context);
 
+    FlushInflightBytesThrottle flushInflightBytesThrottle_;
     TaskThreadPool<bthread::Mutex, bthread::ConditionVariable>
         taskPool_;
+    // the data caches of the chunks flushed in taskPool_ are put to s3 here,
+    // so a chunk doesn't wait for its data caches one by one
+    TaskThreadPool<bthread::Mutex, bthread::ConditionVariable>
+        dataCacheFlushPool_;
+    TaskThreadPool<bthread::Mutex, bthread::ConditionVariable>
+        readAheadPool_;
 
     std::shared_ptr<KVClientManager> kvClientManager_ = nullptr;
 };
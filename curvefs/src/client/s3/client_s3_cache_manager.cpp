@@ -91,6 +91,11 @@ FileCacheManagerPtr FsCacheManager::FindFileCacheManager(uint64_t inodeId) {
 
 FileCacheManagerPtr
 FsCacheManager::FindOrCreateFileCacheManager(uint64_t fsId, uint64_t inodeId) {
+    FileCacheManagerPtr fileCache = FindFileCacheManager(inodeId);
+    if (fileCache != nullptr) {
+        return fileCache;
+    }
+
     WriteLockGuard writeLockGuard(rwLock_);
 
     auto it = fileCacheManagerMap_.find(inodeId);
@@ -123,67 +128,198 @@ void FsCacheManager::ReleaseFileCacheManager(uint64_t inodeId) {
     return;
 }
 
+FsCacheManager::LruShard *
+FsCacheManager::GetLruShard(const DataCachePtr &dataCache) {
+    // there is one chunk cache manager for each chunk of a file
+    uint64_t key =
+        reinterpret_cast<uintptr_t>(dataCache->GetChunkCacheManager());
+    key = (key >> 4) * 0x9E3779B97F4A7C15ULL;
+    return lruShards_[(key >> 32) % lruShards_.size()].get();
+}
+
+void FsCacheManager::TrimReadCache(LruShard *shard) {
+    size_t start = 0;
+    while (lruShards_[start].get() != shard) {
+        start++;
+    }
+
+    uint64_t retiredBytes = 0;
+    std::list<DataCachePtr> retired;
+    for (size_t i = 0; i < lruShards_.size(); i++) {
+        if (lruByte_.load(std::memory_order_relaxed) < readCacheMaxByte_) {
+            break;
+        }
+
+        LruShard *trimShard =
+            lruShards_[(start + i) % lruShards_.size()].get();
+        std::lock_guard<std::mutex> lk(trimShard->mtx);
+        auto &lruList = trimShard->lruList;
+        // each data cache gets at most one more chance in a round
+        size_t chances = lruList.size();
+        while (!lruList.empty() &&
+               lruByte_.load(std::memory_order_relaxed) >= readCacheMaxByte_) {
+            auto iter = std::prev(lruList.end());
+            auto &trim = *iter;
+            if (chances > 0 && trim->TestAndClearReadCacheHit()) {
+                chances--;
+                lruList.splice(lruList.begin(), lruList, iter);
+                continue;
+            }
+
+            trim->SetReadCacheState(false);
+            trimShard->bytes -= trim->GetActualLen();
+            lruByte_.fetch_sub(trim->GetActualLen(),
+                               std::memory_order_relaxed);
+            retiredBytes += trim->GetActualLen();
+            retired.splice(retired.end(), lruList, iter);
+        }
+    }
+
+    VLOG(3) << "lru release " << retiredBytes << " bytes, retired "
+            << retired.size() << " data cache";
+
+    releaseReadCache_.Release(&retired);
+}
+
 bool FsCacheManager::Set(DataCachePtr dataCache,
-                         std::list<DataCachePtr>::iterator *outIter) {
-    std::lock_guard<std::mutex> lk(lruMtx_);
-    VLOG(3) << "lru current byte:" << lruByte_
+                         std::list<DataCachePtr>::iterator *outIter,
+                         bool admission) {
+    VLOG(3) << "lru current byte:" << lruByte_.load(std::memory_order_relaxed)
             << ",lru max byte:" << readCacheMaxByte_
             << ", dataCache len:" << dataCache->GetLen();
     if (readCacheMaxByte_ == 0) {
         return false;
     }
+
+    LruShard *shard = GetLruShard(dataCache);
     // trim cache without consider dataCache's size, because its size is
     // expected to be very smaller than `readCacheMaxByte_`
-    if (lruByte_ >= readCacheMaxByte_) {
-        uint64_t retiredBytes = 0;
-        auto iter = lruReadDataCacheList_.end();
-
-        while (lruByte_ >= readCacheMaxByte_) {
-            --iter;
-            auto &trim = *iter;
-            trim->SetReadCacheState(false);
-            lruByte_ -= trim->GetActualLen();
-            retiredBytes += trim->GetActualLen();
+    if (lruByte_.load(std::memory_order_relaxed) >= readCacheMaxByte_) {
+        if (admission && !AdmitReadCache(shard, dataCache)) {
+            VLOG(6) << "read cache reject data cache, chunkPos: "
+                    << dataCache->GetChunkPos()
+                    << ", len: " << dataCache->GetLen();
+            return false;
         }
+        TrimReadCache(shard);
+    }
 
-        std::list<DataCachePtr> retired;
-        retired.splice(retired.end(), lruReadDataCacheList_, iter,
-                       lruReadDataCacheList_.end());
+    std::lock_guard<std::mutex> lk(shard->mtx);
+    shard->bytes += dataCache->GetActualLen();
+    lruByte_.fetch_add(dataCache->GetActualLen(), std::memory_order_relaxed);
+    dataCache->SetReadCacheState(true);
+    shard->lruList.push_front(std::move(dataCache));
+    *outIter = shard->lruList.begin();
+    return true;
+}
 
-        VLOG(3) << "lru release " << retiredBytes << " bytes, retired "
-                << retired.size() << " data cache";
+bool FsCacheManager::AdmitReadCache(LruShard *shard,
+                                    const DataCachePtr &dataCache) {
+    if (!readCacheAdmission_->Filtering()) {
+        return true;
+    }
 
-        releaseReadCache_.Release(&retired);
+    uint64_t victimKey;
+    if (!FindReadCacheVictim(shard, &victimKey)) {
+        return true;
     }
 
-    lruByte_ += dataCache->GetActualLen();
-    dataCache->SetReadCacheState(true);
-    lruReadDataCacheList_.push_front(std::move(dataCache));
-    *outIter = lruReadDataCacheList_.begin();
-    return true;
+    bool admit =
+        readCacheAdmission_->Admit(ReadCacheKey(dataCache), victimKey);
+    if (metric_ != nullptr) {
+        if (admit) {
+            metric_->memReadCache.admit << 1;
+        } else {
+            metric_->memReadCache.reject << 1;
+        }
+    }
+    return admit;
 }
 
-void FsCacheManager::Get(std::list<DataCachePtr>::iterator iter) {
-    std::lock_guard<std::mutex> lk(lruMtx_);
+bool FsCacheManager::FindReadCacheVictim(LruShard *shard,
+                                         uint64_t *victimKey) {
+    size_t start = 0;
+    while (lruShards_[start].get() != shard) {
+        start++;
+    }
 
-    if (!(*iter)->InReadCache()) {
+    // the same order as `TrimReadCache`, the first shard not empty evicts
+    // the first data cache from the tail not hit, or the tail if all are hit
+    for (size_t i = 0; i < lruShards_.size(); i++) {
+        LruShard *trimShard =
+            lruShards_[(start + i) % lruShards_.size()].get();
+        std::lock_guard<std::mutex> lk(trimShard->mtx);
+        auto &lruList = trimShard->lruList;
+        if (lruList.empty()) {
+            continue;
+        }
+        auto iter = std::find_if(
+            lruList.rbegin(), lruList.rend(),
+            [](const DataCachePtr &dataCache) {
+                return !dataCache->ReadCacheHit();
+            });
+        *victimKey = ReadCacheKey(iter != lruList.rend() ? *iter
+                                                         : lruList.back());
+        return true;
+    }
+    return false;
+}
+
+uint64_t FsCacheManager::ReadCacheKey(uint64_t inodeId, uint64_t index,
+                                      uint64_t blockIndex) const {
+    return (inodeId * 0x9e3779b97f4a7c15ull) ^
+           (index * 0xbf58476d1ce4e5b9ull) ^ blockIndex;
+}
+
+uint64_t FsCacheManager::ReadCacheKey(const DataCachePtr &dataCache) const {
+    ChunkCacheManager *chunkCacheManager = dataCache->GetChunkCacheManager();
+    return ReadCacheKey(chunkCacheManager->GetInodeId(),
+                        chunkCacheManager->GetIndex(),
+                        dataCache->GetChunkPos() /
+                            s3ClientAdaptor_->GetBlockSize());
+}
+
+void FsCacheManager::RecordReadCacheAccess(uint64_t inodeId, uint64_t index,
+                                           uint64_t chunkPos, uint64_t len) {
+    if (!readCacheAdmission_->Filtering() || len == 0) {
+        return;
+    }
+
+    uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
+    for (uint64_t blockIndex = chunkPos / blockSize;
+         blockIndex <= (chunkPos + len - 1) / blockSize; blockIndex++) {
+        readCacheAdmission_->RecordAccess(
+            ReadCacheKey(inodeId, index, blockIndex));
+    }
+}
+
+void FsCacheManager::CollectReadCacheMetric(bool hit) {
+    if (metric_ == nullptr) {
         return;
     }
+    if (hit) {
+        metric_->memReadCache.hit << 1;
+    } else {
+        metric_->memReadCache.miss << 1;
+    }
+}
 
-    lruReadDataCacheList_.splice(lruReadDataCacheList_.begin(),
-                                 lruReadDataCacheList_, iter);
+void FsCacheManager::Get(std::list<DataCachePtr>::iterator iter) {
+    (*iter)->MarkReadCacheHit();
 }
 
 bool FsCacheManager::Delete(std::list<DataCachePtr>::iterator iter) {
-    std::lock_guard<std::mutex> lk(lruMtx_);
+    LruShard *shard = GetLruShard(*iter);
+    std::lock_guard<std::mutex> lk(shard->mtx);
 
     if (!(*iter)->InReadCache()) {
         return false;
     }
 
     (*iter)->SetReadCacheState(false);
-    lruByte_ -= (*iter)->GetActualLen();
-    lruReadDataCacheList_.erase(iter);
+    shard->bytes -= (*iter)->GetActualLen();
+    lruByte_.fetch_sub((*iter)->GetActualLen(), std::memory_order_relaxed);
+    shard->lruList.erase(iter);
     return true;
 }
 
@@ -272,6 +408,7 @@ void FileCacheManager::WriteChunk(uint64_t index, uint64_t chunkPos,
     ChunkCacheManagerPtr chunkCacheManager =
         FindOrCreateChunkCacheManager(index);
     WriteLockGuard writeLockGuard(chunkCacheManager->rwLockChunk_);  // todo
+    chunkCacheManager->IncDataVersion();
     std::vector<DataCachePtr> mergeDataCacheVer;
     DataCachePtr dataCache = chunkCacheManager->FindWriteableDataCache(
         chunkPos, writeLen, &mergeDataCacheVer, inode_);
@@ -296,7 +433,7 @@ FileCacheManager::FindOrCreateChunkCacheManager(uint64_t index) {
 
     ChunkCacheManagerPtr chunkCacheManager =
         std::make_shared<ChunkCacheManager>(index, s3ClientAdaptor_,
-                                            kvClientManager_);
+                                            kvClientManager_, inode_);
     auto ret = chunkCacheMap_.emplace(index, chunkCacheManager);
     g_s3MultiManagerMetric->chunkManagerNum << 1;
     assert(ret.second);
@@ -324,7 +461,7 @@ void FileCacheManager::GetBlockLoc(uint64_t offset, uint64_t *chunkIndex,
 
 void FileCacheManager::ReadFromMemCache(
     uint64_t offset, uint64_t length, char *dataBuf, uint64_t *actualReadLen,
-    std::vector<ReadRequest> *memCacheMissRequest) {
+    std::vector<ReadRequest> *memCacheMissRequest, bool recordAccess) {
 
     uint64_t index = 0, chunkPos = 0, chunkSize = 0;
     GetChunkLoc(offset, &index, &chunkPos, &chunkSize);
@@ -349,6 +486,10 @@ void FileCacheManager::ReadFromMemCache(
         std::vector<ReadRequest> tmpMissRequests;
         chunkCacheManager->ReadChunk(index, chunkPos, currentReadLen, dataBuf,
                                      dataBufferOffset, &tmpMissRequests);
+        if (recordAccess) {
+            s3ClientAdaptor_->GetFsCacheManager()->RecordReadCacheAccess(
+                inode_, index, chunkPos, currentReadLen);
+        }
         memCacheMissRequest->insert(memCacheMissRequest->end(),
                                     tmpMissRequests.begin(),
                                     tmpMissRequests.end());
@@ -364,6 +505,40 @@ void FileCacheManager::ReadFromMemCache(
     VLOG_IF(3, memCacheMissRequest->empty()) << "great! memory cache all hit.";
 }
 
+void MergeS3ReadRequests(uint64_t blockSize,
+                         std::vector<S3ReadRequest> *requests) {
+    if (requests->size() < 2) {
+        return;
+    }
+    std::sort(requests->begin(), requests->end(),
+              [](const S3ReadRequest &a, const S3ReadRequest &b) {
+                  return a.offset < b.offset;
+              });
+
+    std::vector<S3ReadRequest> merged;
+    merged.reserve(requests->size());
+    for (const auto &req : *requests) {
+        if (!merged.empty()) {
+            S3ReadRequest &last = merged.back();
+            // only the first block read by a request starts at objectOffset
+            uint64_t objectOffset = last.offset / blockSize ==
+                                            req.offset / blockSize
+                                        ? last.objectOffset
+                                        : 0;
+            if (last.chunkId == req.chunkId &&
+                last.compaction == req.compaction &&
+                last.offset + last.len == req.offset &&
+                last.readOffset + last.len == req.readOffset &&
+                objectOffset == req.objectOffset) {
+                last.len += req.len;
+                continue;
+            }
+        }
+        merged.emplace_back(req);
+    }
+    requests->swap(merged);
+}
+
 int FileCacheManager::GenerateKVRequest(
     const std::shared_ptr<InodeWrapper> &inodeWrapper,
     const std::vector<ReadRequest> &readRequest, char *dataBuf,
@@ -391,6 +566,7 @@ int FileCacheManager::GenerateKVRequest(
                                   tmpKVRequests.end());
             }
         });
+    MergeS3ReadRequests(s3ClientAdaptor_->GetBlockSize(), kvRequest);
 
     VLOG(9) << "process inode: " << S3ReadRequestVecDebugString(*kvRequest)
             << " ok";
@@ -427,22 +603,30 @@ int FileCacheManager::HandleReadS3NotExist(
 
 int FileCacheManager::Read(uint64_t inodeId, uint64_t offset, uint64_t length,
                            char *dataBuf) {
+    uint64_t readAheadOffset = 0;
+    uint64_t readAheadLen = UpdateReadAhead(offset, length, &readAheadOffset);
+
     // 1. read from memory cache
     uint64_t actualReadLen = 0;
     std::vector<ReadRequest> memCacheMissRequest;
     ReadFromMemCache(offset, length, dataBuf, &actualReadLen,
                      &memCacheMissRequest);
-    if (memCacheMissRequest.empty()) {
+    s3ClientAdaptor_->GetFsCacheManager()->CollectReadCacheMetric(
+        memCacheMissRequest.empty());
+    if (memCacheMissRequest.empty() && readAheadLen == 0) {
         return actualReadLen;
     }
 
-
     // 2. read from localcache and remote cluster
     std::shared_ptr<InodeWrapper> inodeWrapper;
     auto inodeManager = s3ClientAdaptor_->GetInodeCacheManager();
     if (CURVEFS_ERROR::OK != inodeManager->GetInode(inodeId, inodeWrapper)) {
         LOG(ERROR) << "get inode = " << inodeId << " fail";
-        return -1;
+        return memCacheMissRequest.empty() ? actualReadLen : -1;
+    }
+    if (memCacheMissRequest.empty()) {
+        ReadAhead(inodeWrapper, readAheadOffset, readAheadLen);
+        return actualReadLen;
     }
 
     uint32_t retry = 0;
@@ -472,17 +656,211 @@ int FileCacheManager::Read(uint64_t inodeId, uint64_t offset, uint64_t length,
         }
     } while (1);
 
+    // the data read ahead is fetched after the data being read
+    if (readAheadLen > 0) {
+        ReadAhead(inodeWrapper, readAheadOffset, readAheadLen);
+    }
     return actualReadLen;
 }
 
+uint64_t FileCacheManager::UpdateReadAhead(uint64_t offset, uint64_t length,
+                                           uint64_t *readAheadOffset) {
+    const uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
+    const uint64_t maxWindow =
+        s3ClientAdaptor_->GetMaxReadAheadBlocks() * blockSize;
+    if (maxWindow == 0 || length == 0) {
+        return 0;
+    }
+
+    curve::common::LockGuard lg(readAheadMtx_);
+    uint64_t readEnd = offset + length;
+    if (offset != lastReadEnd_) {
+        VLOG(9) << "random read inode: " << inode_ << ", offset: " << offset
+                << ", last read end: " << lastReadEnd_;
+        lastReadEnd_ = readEnd;
+        readAheadWindow_ = 0;
+        readAheadEnd_ = 0;
+        return 0;
+    }
+    lastReadEnd_ = readEnd;
+
+    // still enough data read ahead of the reader
+    if (readAheadEnd_ > readEnd + readAheadWindow_ / 2) {
+        return 0;
+    }
+
+    readAheadWindow_ = readAheadWindow_ == 0
+                           ? blockSize
+                           : std::min(readAheadWindow_ * 2, maxWindow);
+    // read ahead whole blocks
+    uint64_t start = std::max(readAheadEnd_, readEnd);
+    uint64_t end =
+        (readEnd + readAheadWindow_ + blockSize - 1) / blockSize * blockSize;
+    if (end <= start) {
+        return 0;
+    }
+    readAheadEnd_ = end;
+    *readAheadOffset = start;
+    VLOG(9) << "read ahead inode: " << inode_ << ", offset: " << start
+            << ", len: " << end - start << ", window: " << readAheadWindow_;
+    return end - start;
+}
+
+// keep the buffer and the status of a readahead till its requests end, the
+// memory of the buffer is counted in the readahead inflight bytes
+struct ReadAheadContext {
+    ReadAheadContext(S3ClientAdaptorImpl *s3ClientAdaptor, uint64_t len)
+        : s3ClientAdaptor(s3ClientAdaptor), len(len), buf(new char[len]) {}
+
+    ~ReadAheadContext() { s3ClientAdaptor->ReleaseReadAheadBytes(len); }
+
+    S3ClientAdaptorImpl *s3ClientAdaptor;
+    uint64_t len;
+    std::unique_ptr<char[]> buf;
+    std::once_flag cancelFlag;
+    std::atomic<bool> isCanceled{false};
+    std::atomic<int> retCode{0};
+};
+
+void FileCacheManager::ReadAhead(
+    const std::shared_ptr<InodeWrapper> &inodeWrapper, uint64_t offset,
+    uint64_t length) {
+    // the memory read cache is not used with cto
+    bool toMemCache = !curvefs::client::common::FLAGS_enableCto;
+    if (!toMemCache && !s3ClientAdaptor_->HasDiskCache()) {
+        return;
+    }
+    uint64_t fileLen = inodeWrapper->GetLength();
+    if (offset >= fileLen) {
+        return;
+    }
+    length = std::min(length, fileLen - offset);
+    // the file cache is kept alive by the requests read ahead
+    FileCacheManagerPtr fileCache =
+        s3ClientAdaptor_->GetFsCacheManager()->FindFileCacheManager(inode_);
+    if (!fileCache) {
+        return;
+    }
+    if (!s3ClientAdaptor_->AcquireReadAheadBytes(length)) {
+        VLOG(6) << "skip read ahead inode: " << inode_
+                << ", offset: " << offset << ", len: " << length;
+        return;
+    }
+    auto context = std::make_shared<ReadAheadContext>(s3ClientAdaptor_, length);
+
+    // the chunks are taken before reading, so the data read ahead is
+    // dropped if they are written, flushed or truncated meanwhile
+    const uint64_t chunkSize = s3ClientAdaptor_->GetChunkSize();
+    std::map<uint64_t, std::pair<ChunkCacheManagerPtr, uint64_t>> chunks;
+    if (toMemCache) {
+        for (uint64_t index = offset / chunkSize;
+             index <= (offset + length - 1) / chunkSize; index++) {
+            ChunkCacheManagerPtr chunkCacheManager =
+                FindOrCreateChunkCacheManager(index);
+            uint64_t dataVersion = chunkCacheManager->GetDataVersion();
+            chunks.emplace(index, std::make_pair(std::move(chunkCacheManager),
+                                                 dataVersion));
+        }
+    }
+
+    uint64_t actualReadLen = 0;
+    std::vector<ReadRequest> memCacheMissRequest;
+    ReadFromMemCache(offset, length, context->buf.get(), &actualReadLen,
+                     &memCacheMissRequest, false);
+    if (memCacheMissRequest.empty()) {
+        return;
+    }
+    std::vector<S3ReadRequest> kvRequests;
+    GenerateKVRequest(inodeWrapper, memCacheMissRequest, context->buf.get(),
+                      &kvRequests);
+    VLOG(6) << "read ahead inode: " << inode_ << ", offset: " << offset
+            << ", len: " << length << ", requests: " << kvRequests.size();
+
+    if (toMemCache) {
+        for (const auto &req : kvRequests) {
+            const auto &chunk = chunks[req.offset / chunkSize];
+            s3ClientAdaptor_->EnqueueReadAhead([fileCache, context, req,
+                                                fileLen, chunk]() {
+                if (context->isCanceled) {
+                    return;
+                }
+                fileCache->ProcessKVRequest(req, context->buf.get(), fileLen,
+                                            context->cancelFlag,
+                                            context->isCanceled,
+                                            context->retCode, false);
+                if (!context->isCanceled) {
+                    fileCache->AddReadAheadDataCache(
+                        req, context->buf.get(), chunk.first, chunk.second);
+                }
+            });
+        }
+        return;
+    }
+
+    // download the whole blocks into the disk cache
+    const uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
+    const uint32_t objectPrefix = s3ClientAdaptor_->GetObjectPrefix();
+    std::vector<std::pair<std::string, uint64_t>> prefetchObjs;
+    for (const auto &req : kvRequests) {
+        uint64_t blockOffset = req.offset / blockSize * blockSize;
+        uint64_t chunkIndex = 0, chunkPos = 0, blockIndex = 0, blockPos = 0;
+        GetBlockLoc(req.offset, &chunkIndex, &chunkPos, &blockIndex,
+                    &blockPos);
+        for (; blockOffset < req.offset + req.len;
+             blockOffset += blockSize, blockIndex++) {
+            std::string name = curvefs::common::s3util::GenObjName(
+                req.chunkId, blockIndex, req.compaction, req.fsId,
+                req.inodeId, objectPrefix);
+            prefetchObjs.emplace_back(
+                name, std::min(blockSize, fileLen - blockOffset));
+        }
+    }
+    PrefetchS3Objs(prefetchObjs);
+}
+
+void FileCacheManager::AddReadAheadDataCache(
+    const S3ReadRequest &req, char *dataBuf,
+    const ChunkCacheManagerPtr &chunkCacheManager, uint64_t dataVersion) {
+    uint64_t chunkIndex = 0, chunkPos = 0, chunkSize = 0;
+    GetChunkLoc(req.offset, &chunkIndex, &chunkPos, &chunkSize);
+    {
+        ReadLockGuard readLockGuard(rwLock_);
+        auto iter = chunkCacheMap_.find(chunkIndex);
+        if (iter == chunkCacheMap_.end() ||
+            iter->second != chunkCacheManager) {
+            return;
+        }
+    }
+
+    WriteLockGuard writeLockGuard(chunkCacheManager->rwLockChunk_);
+    if (chunkCacheManager->GetDataVersion() != dataVersion) {
+        VLOG(6) << "drop the data read ahead of inode: " << inode_
+                << ", chunk index: " << chunkIndex
+                << ", chunkPos: " << chunkPos << ", len: " << req.len;
+        return;
+    }
+    // the data read ahead is expected to be read soon, so it counts as a
+    // read, or the admission of a full read cache always rejects it
+    s3ClientAdaptor_->GetFsCacheManager()->RecordReadCacheAccess(
+        inode_, chunkIndex, chunkPos, req.len);
+    DataCachePtr dataCache = std::make_shared<DataCache>(
+        s3ClientAdaptor_, chunkCacheManager, chunkPos, req.len,
+        dataBuf + req.readOffset, kvClientManager_);
+    chunkCacheManager->AddReadDataCache(dataCache);
+}
+
 bool FileCacheManager::ReadKVRequestFromLocalCache(const std::string &name,
                                                    char *databuf,
                                                    uint64_t offset,
                                                    uint64_t len) {
     uint64_t start = butil::cpuwide_time_us();
 
-    bool mayCached = s3ClientAdaptor_->HasDiskCache() &&
-                     s3ClientAdaptor_->GetDiskCacheManager()->IsCached(name);
+    if (!s3ClientAdaptor_->HasDiskCache()) {
+        return false;
+    }
+
+    bool mayCached = s3ClientAdaptor_->GetDiskCacheManager()->IsCached(name);
+    s3ClientAdaptor_->GetDiskCacheManager()->RecordReadAccess(name, mayCached);
     if (!mayCached) {
         return false;
     }
@@ -568,7 +946,8 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest &req, char *dataBuf,
                                         uint64_t fileLen,
                                         std::once_flag &cancelFlag,
                                         std::atomic<bool> &isCanceled,
-                                        std::atomic<int> &retCode) {
+                                        std::atomic<int> &retCode,
+                                        bool toMemCache) {
     VLOG(6) << "read from kv request " << req.DebugString();
     uint64_t chunkIndex = 0;
     uint64_t chunkPos = 0;
@@ -648,7 +1027,7 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest &req, char *dataBuf,
     }
 
     // add data to memory read cache
-    if (!curvefs::client::common::FLAGS_enableCto) {
+    if (toMemCache && !curvefs::client::common::FLAGS_enableCto) {
         auto chunkCacheManager = FindOrCreateChunkCacheManager(chunkIndex);
         WriteLockGuard writeLockGuard(chunkCacheManager->rwLockChunk_);
         DataCachePtr dataCache = std::make_shared<DataCache>(
@@ -744,6 +1123,11 @@ void FileCacheManager::PrefetchS3Objs(
                     << ", size: " << downloadingObj_.size();
             continue;
         }
+        // don't download the object only to be rejected by a full cache
+        if (!s3ClientAdaptor_->GetDiskCacheManager()->AdmitReadCache(name)) {
+            VLOG(9) << "disk cache reject: " << name;
+            continue;
+        }
         VLOG(9) << "download start: " << name
                 << ", size: " << downloadingObj_.size();
         downloadingObj_.emplace(name);
@@ -1175,8 +1559,16 @@ void ChunkCacheManager::ReadByWriteCache(uint64_t chunkPos, uint64_t readLen,
 
     VLOG(6) << "ReadByWriteCache chunkPos:" << chunkPos
             << ",readLen:" << readLen << ",dataBufOffset:" << dataBufOffset;
-    if (dataWCacheMap_.empty()) {
-        VLOG(9) << "dataWCacheMap_ is empty";
+    ReadByDataCaches(dataWCacheMap_, chunkPos, readLen, dataBuf,
+                     dataBufOffset, requests);
+}
+
+void ChunkCacheManager::ReadByDataCaches(
+    const std::map<uint64_t, DataCachePtr> &dataCaches, uint64_t chunkPos,
+    uint64_t readLen, char *dataBuf, uint64_t dataBufOffset,
+    std::vector<ReadRequest> *requests) {
+    if (dataCaches.empty()) {
+        VLOG(9) << "dataCaches is empty";
         ReadRequest request;
         request.index = index_;
         request.len = readLen;
@@ -1186,16 +1578,16 @@ void ChunkCacheManager::ReadByWriteCache(uint64_t chunkPos, uint64_t readLen,
         return;
     }
 
-    auto iter = dataWCacheMap_.upper_bound(chunkPos);
-    if (iter != dataWCacheMap_.begin()) {
+    auto iter = dataCaches.upper_bound(chunkPos);
+    if (iter != dataCaches.begin()) {
         --iter;
     }
 
-    for (; iter != dataWCacheMap_.end(); iter++) {
+    for (; iter != dataCaches.end(); iter++) {
         ReadRequest request;
         uint64_t dcChunkPos = iter->second->GetChunkPos();
         uint64_t dcLen = iter->second->GetLen();
-        VLOG(6) << "ReadByWriteCache chunkPos:" << chunkPos
+        VLOG(6) << "ReadByDataCaches chunkPos:" << chunkPos
                 << ",readLen:" << readLen << ",dcChunkPos:" << dcChunkPos
                 << ",dcLen:" << dcLen << ",first:" << iter->first;
         assert(iter->first == iter->second->GetChunkPos());
@@ -1378,80 +1770,11 @@ void ChunkCacheManager::ReadByReadCache(uint64_t chunkPos, uint64_t readLen,
 void ChunkCacheManager::ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
                                         char *dataBuf, uint64_t dataBufOffset,
                                         std::vector<ReadRequest> *requests) {
-    uint64_t dcChunkPos = flushingDataCache_->GetChunkPos();
-    uint64_t dcLen = flushingDataCache_->GetLen();
-    ReadRequest request;
     VLOG(9) << "ReadByFlushData chunkPos: " << chunkPos
-            << ", readLen: " << readLen << ", dcChunkPos: " << dcChunkPos
-            << ", dcLen: " << dcLen;
-    if (chunkPos + readLen <= dcChunkPos) {
-        request.index = index_;
-        request.len = readLen;
-        request.chunkPos = chunkPos;
-        request.bufOffset = dataBufOffset;
-        requests->emplace_back(request);
-        return;
-    } else if ((chunkPos + readLen > dcChunkPos) && (chunkPos < dcChunkPos)) {
-        request.len = dcChunkPos - chunkPos;
-        request.chunkPos = chunkPos;
-        request.index = index_;
-        request.bufOffset = dataBufOffset;
-        VLOG(6) << "request: index:" << index_ << ",chunkPos:" << chunkPos
-                << ",len:" << request.len << ",bufOffset:" << dataBufOffset;
-        requests->emplace_back(request);
-        /*
-             -----               ReadData
-                ------           DataCache
-        */
-        if (chunkPos + readLen <= dcChunkPos + dcLen) {
-            flushingDataCache_->CopyDataCacheToBuf(
-                0, chunkPos + readLen - dcChunkPos,
-                dataBuf + request.len + dataBufOffset);
-            readLen = 0;
-            return;
-            /*
-                 -----------         ReadData
-                    ------           DataCache
-            */
-        } else {
-            flushingDataCache_->CopyDataCacheToBuf(
-                0, dcLen, dataBuf + request.len + dataBufOffset);
-            readLen = chunkPos + readLen - (dcChunkPos + dcLen);
-            dataBufOffset = dcChunkPos + dcLen - chunkPos + dataBufOffset;
-            chunkPos = dcChunkPos + dcLen;
-        }
-    } else if ((chunkPos >= dcChunkPos) && (chunkPos < dcChunkPos + dcLen)) {
-        /*
-                 ----              ReadData
-               ---------           DataCache
-        */
-        if (chunkPos + readLen <= dcChunkPos + dcLen) {
-            flushingDataCache_->CopyDataCacheToBuf(
-                chunkPos - dcChunkPos, readLen, dataBuf + dataBufOffset);
-            readLen = 0;
-            return;
-            /*
-                     ----------              ReadData
-                   ---------                DataCache
-            */
-        } else {
-            flushingDataCache_->CopyDataCacheToBuf(
-                chunkPos - dcChunkPos, dcChunkPos + dcLen - chunkPos,
-                dataBuf + dataBufOffset);
-            readLen = chunkPos + readLen - dcChunkPos - dcLen;
-            dataBufOffset = dcChunkPos + dcLen - chunkPos + dataBufOffset;
-            chunkPos = dcChunkPos + dcLen;
-        }
-    }
-
-    if (readLen > 0) {
-        request.index = index_;
-        request.len = readLen;
-        request.chunkPos = chunkPos;
-        request.bufOffset = dataBufOffset;
-        requests->emplace_back(request);
-    }
-    return;
+            << ", readLen: " << readLen
+            << ", flushing datacaches num: " << flushingDataCacheMap_.size();
+    ReadByDataCaches(flushingDataCacheMap_, chunkPos, readLen, dataBuf,
+                     dataBufOffset, requests);
 }
 
 DataCachePtr ChunkCacheManager::FindWriteableDataCache(
@@ -1529,7 +1852,8 @@ void ChunkCacheManager::WriteNewDataCache(S3ClientAdaptorImpl *s3ClientAdaptor,
     return;
 }
 
-void ChunkCacheManager::AddReadDataCache(DataCachePtr dataCache) {
+void ChunkCacheManager::AddReadDataCache(DataCachePtr dataCache,
+                                         bool admission) {
     uint64_t chunkPos = dataCache->GetChunkPos();
     uint64_t len = dataCache->GetLen();
     WriteLockGuard writeLockGuard(rwLockRead_);
@@ -1560,7 +1884,8 @@ void ChunkCacheManager::AddReadDataCache(DataCachePtr dataCache) {
         }
     }
     std::list<DataCachePtr>::iterator outIter;
-    bool ret = s3ClientAdaptor_->GetFsCacheManager()->Set(dataCache, &outIter);
+    bool ret = s3ClientAdaptor_->GetFsCacheManager()->Set(dataCache, &outIter,
+                                                          admission);
     if (ret) {
         g_s3MultiManagerMetric->readDataCacheNum << 1;
         g_s3MultiManagerMetric->readDataCacheByte << dataCache->GetActualLen();
@@ -1608,6 +1933,7 @@ void ChunkCacheManager::ReleaseCache() {
 
 void ChunkCacheManager::TruncateCache(uint64_t chunkPos) {
     WriteLockGuard writeLockGuard(rwLockChunk_);
+    IncDataVersion();
 
     TruncateWriteCache(chunkPos);
     TruncateReadCache(chunkPos);
@@ -1669,74 +1995,110 @@ void ChunkCacheManager::ReleaseWriteDataCache(const DataCachePtr &dataCache) {
 
 CURVEFS_ERROR ChunkCacheManager::Flush(uint64_t inodeId, bool force,
                                        bool toS3) {
-    std::map<uint64_t, DataCachePtr> tmp;
     curve::common::LockGuard lg(flushMtx_);
-    CURVEFS_ERROR ret = CURVEFS_ERROR::OK;
-    // DataCachePtr dataCache;
     while (1) {
-        bool isFlush = false;
+        std::vector<DataCachePtr> flushingDataCaches;
         {
             WriteLockGuard writeLockGuard(rwLockChunk_);
 
             auto iter = dataWCacheMap_.begin();
             while (iter != dataWCacheMap_.end()) {
                 if (iter->second->CanFlush(force)) {
-                    {
-                        curve::common::LockGuard lg(flushingDataCacheMtx_);
-                        flushingDataCache_ = std::move(iter->second);
-                    }
-                    dataWCacheMap_.erase(iter);
-                    isFlush = true;
-                    break;
+                    flushingDataCaches.emplace_back(std::move(iter->second));
+                    iter = dataWCacheMap_.erase(iter);
                 } else {
                     iter++;
                 }
             }
-        }
-        if (isFlush) {
-            VLOG(9) << "Flush datacache chunkPos:"
-                    << flushingDataCache_->GetChunkPos()
-                    << ",len:" << flushingDataCache_->GetLen()
-                    << ",inodeId:" << inodeId << ",chunkIndex:" << index_;
-            assert(flushingDataCache_->IsDirty());
-            do {
-                ret = flushingDataCache_->Flush(inodeId, toS3);
-                if (ret == CURVEFS_ERROR::NOTEXIST) {
-                    LOG(WARNING) << "dataCache flush failed. ret:" << ret
-                                 << ",index:" << index_ << ",data chunkpos:"
-                                 << flushingDataCache_->GetChunkPos();
-                    ReleaseWriteDataCache(flushingDataCache_);
-                    break;
-                } else if (ret == CURVEFS_ERROR::INTERNAL) {
-                    LOG(WARNING) << "dataCache flush failed. ret:" << ret
-                                 << ",index:" << index_ << ",data chunkpos:"
-                                 << flushingDataCache_->GetChunkPos()
-                                 << ", should retry.";
-                    ::sleep(3);
-                    continue;
-                }
-                VLOG(9) << "ReleaseWriteDataCache chunkPos:"
-                        << flushingDataCache_->GetChunkPos()
-                        << ",len:" << flushingDataCache_->GetLen()
-                        << ",inodeId:" << inodeId << ",chunkIndex:" << index_;
-                if (!curvefs::client::common::FLAGS_enableCto) {
-                    WriteLockGuard lockGuard(rwLockChunk_);
-                    AddReadDataCache(flushingDataCache_);
-                }
-                ReleaseWriteDataCache(flushingDataCache_);
-            } while (ret != CURVEFS_ERROR::OK);
-            {
+            if (!flushingDataCaches.empty()) {
                 curve::common::LockGuard lg(flushingDataCacheMtx_);
-                flushingDataCache_ = nullptr;
+                for (const auto &dataCache : flushingDataCaches) {
+                    flushingDataCacheMap_.emplace(dataCache->GetChunkPos(),
+                                                  dataCache);
+                }
             }
-        } else {
+        }
+        if (flushingDataCaches.empty()) {
             VLOG(9) << "can not find flush datacache";
             break;
         }
+
+        // the data caches taken at once don't overlap, so they are flushed
+        // concurrently, the data caches written meanwhile wait for the next
+        // round to get larger chunk ids
+        VLOG(9) << "Flush datacaches num:" << flushingDataCaches.size()
+                << ",inodeId:" << inodeId << ",chunkIndex:" << index_;
+        while (!flushingDataCaches.empty()) {
+            curve::common::Mutex retryMtx;
+            std::vector<DataCachePtr> retryDataCaches;
+            CountDownEvent flushEvent(flushingDataCaches.size());
+            for (const auto &dataCache : flushingDataCaches) {
+                s3ClientAdaptor_->EnqueueDataCacheFlush(
+                    dataCache->GetActualLen(),
+                    [this, &flushEvent, &retryMtx, &retryDataCaches,
+                     dataCache, inodeId, toS3]() {
+                        if (!FlushDataCache(inodeId, dataCache, toS3)) {
+                            curve::common::LockGuard lg(retryMtx);
+                            retryDataCaches.emplace_back(dataCache);
+                        }
+                        flushEvent.Signal();
+                    });
+            }
+            flushEvent.Wait();
+            // wait here rather than in the flush pool shared by all chunks
+            if (!retryDataCaches.empty()) {
+                ::sleep(3);
+            }
+            flushingDataCaches.swap(retryDataCaches);
+        }
+        {
+            curve::common::LockGuard lg(flushingDataCacheMtx_);
+            flushingDataCacheMap_.clear();
+        }
     }
     return CURVEFS_ERROR::OK;
 }
 
+bool ChunkCacheManager::FlushDataCache(uint64_t inodeId,
+                                       const DataCachePtr &dataCache,
+                                       bool toS3) {
+    VLOG(9) << "Flush datacache chunkPos:" << dataCache->GetChunkPos()
+            << ",len:" << dataCache->GetLen() << ",inodeId:" << inodeId
+            << ",chunkIndex:" << index_;
+    assert(dataCache->IsDirty());
+    uint64_t start = butil::cpuwide_time_us();
+    CURVEFS_ERROR ret = dataCache->Flush(inodeId, toS3);
+    if (ret == CURVEFS_ERROR::NOTEXIST) {
+        LOG(WARNING) << "dataCache flush failed. ret:" << ret
+                     << ",index:" << index_
+                     << ",data chunkpos:" << dataCache->GetChunkPos();
+        ReleaseWriteDataCache(dataCache);
+        return true;
+    } else if (ret == CURVEFS_ERROR::INTERNAL) {
+        LOG(WARNING) << "dataCache flush failed. ret:" << ret
+                     << ",index:" << index_
+                     << ",data chunkpos:" << dataCache->GetChunkPos()
+                     << ", should retry.";
+        return false;
+    }
+    VLOG(9) << "ReleaseWriteDataCache chunkPos:" << dataCache->GetChunkPos()
+            << ",len:" << dataCache->GetLen() << ",inodeId:" << inodeId
+            << ",chunkIndex:" << index_;
+    if (!curvefs::client::common::FLAGS_enableCto) {
+        WriteLockGuard lockGuard(rwLockChunk_);
+        IncDataVersion();
+        AddReadDataCache(dataCache, false);
+    }
+    ReleaseWriteDataCache(dataCache);
+
+    if (s3ClientAdaptor_->s3Metric_.get() != nullptr) {
+        s3ClientAdaptor_->CollectMetrics(
+            &s3ClientAdaptor_->s3Metric_->adaptorFlush, dataCache->GetLen(),
+            start);
+    }
+    return true;
+}
+
 void ChunkCacheManager::UpdateWriteCacheMap(uint64_t oldChunkPos,
                                             DataCache *pDataCache) {
     auto iter = dataWCacheMap_.find(oldChunkPos);
@@ -1767,7 +2129,8 @@ DataCache::DataCache(S3ClientAdaptorImpl *s3ClientAdaptor,
                      std::shared_ptr<KVClientManager> kvClientManager)
     : s3ClientAdaptor_(std::move(s3ClientAdaptor)),
       chunkCacheManager_(chunkCacheManager), status_(DataCacheStatus::Dirty),
-      inReadCache_(false) {
+      inReadCache_(false), readCacheHit_(false),
+      pageAllocator_(s3ClientAdaptor->GetPageAllocator()) {
     uint64_t blockSize = s3ClientAdaptor->GetBlockSize();
     uint32_t pageSize = s3ClientAdaptor->GetPageSize();
     chunkPos_ = chunkPos;
@@ -1788,7 +2151,7 @@ DataCache::DataCache(S3ClientAdaptorImpl *s3ClientAdaptor,
         } else {
             n = len;
         }
-        PageDataMap &pdMap = dataMap_[blockIndex];
+        BlockPages *block = GetOrCreateBlock(blockIndex);
         blockLen = n;
         pageIndex = blockPos / pageSize;
         pagePos = blockPos % pageSize;
@@ -1799,16 +2162,12 @@ DataCache::DataCache(S3ClientAdaptorImpl *s3ClientAdaptor,
                 m = blockLen;
             }
 
-            PageData *pageData = new PageData();
-            pageData->data = new char[pageSize];
-            memset(pageData->data, 0, pageSize);
-            memcpy(pageData->data + pagePos, data + dataOffset, m);
+            char *page = pageAllocator_->Allocate();
+            memcpy(page + pagePos, data + dataOffset, m);
             if (pagePos + m < pageSize) {
                 tailZeroLen = pageSize - pagePos - m;
             }
-            pageData->index = pageIndex;
-            assert(pdMap.count(pageIndex) == 0);
-            pdMap.emplace(pageIndex, pageData);
+            block->Set(pageIndex, page);
             pageIndex++;
             blockLen -= m;
             dataOffset += m;
@@ -1827,6 +2186,19 @@ DataCache::DataCache(S3ClientAdaptorImpl *s3ClientAdaptor,
     kvClientManager_ = std::move(kvClientManager);
 }
 
+BlockPages *DataCache::GetOrCreateBlock(uint64_t blockIndex) {
+    if (blockIndex >= blocks_.size()) {
+        blocks_.resize(blockIndex + 1);
+    }
+    if (blocks_[blockIndex] == nullptr) {
+        uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
+        uint32_t pageSize = s3ClientAdaptor_->GetPageSize();
+        blocks_[blockIndex].reset(
+            new BlockPages((blockSize + pageSize - 1) / pageSize));
+    }
+    return blocks_[blockIndex].get();
+}
+
 void DataCache::CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
                                    const char *data) {
     uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
@@ -1852,8 +2224,7 @@ void DataCache::CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
             n = len;
         }
         blockLen = n;
-        PageDataMap &pdMap = dataMap_[blockIndex];
-        PageData *pageData;
+        BlockPages *block = GetOrCreateBlock(blockIndex);
         pageIndex = blockPos / pageSize;
         pagePos = blockPos % pageSize;
         while (blockLen > 0) {
@@ -1862,17 +2233,13 @@ void DataCache::CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
             } else {
                 m = blockLen;
             }
-            if (pdMap.count(pageIndex)) {
-                pageData = pdMap[pageIndex];
-            } else {
-                pageData = new PageData();
-                pageData->data = new char[pageSize];
-                memset(pageData->data, 0, pageSize);
-                pageData->index = pageIndex;
-                pdMap.emplace(pageIndex, pageData);
+            char *page = block->Get(pageIndex);
+            if (page == nullptr) {
+                page = pageAllocator_->Allocate();
+                block->Set(pageIndex, page);
                 addLen += pageSize;
             }
-            memcpy(pageData->data + pagePos, data + dataOffset, m);
+            memcpy(page + pagePos, data + dataOffset, m);
             pageIndex++;
             blockLen -= m;
             dataOffset += m;
@@ -1910,9 +2277,8 @@ void DataCache::AddDataBefore(uint64_t len, const char *data) {
             n = tmpLen;
         }
 
-        PageDataMap &pdMap = dataMap_[blockIndex];
+        BlockPages *block = GetOrCreateBlock(blockIndex);
         blockLen = n;
-        PageData *pageData = NULL;
         pageIndex = blockPos / pageSize;
         pagePos = blockPos % pageSize;
         while (blockLen > 0) {
@@ -1922,16 +2288,12 @@ void DataCache::AddDataBefore(uint64_t len, const char *data) {
                 m = blockLen;
             }
 
-            if (pdMap.count(pageIndex)) {
-                pageData = pdMap[pageIndex];
-            } else {
-                pageData = new PageData();
-                pageData->data = new char[pageSize];
-                memset(pageData->data, 0, pageSize);
-                pageData->index = pageIndex;
-                pdMap.emplace(pageIndex, pageData);
+            char *page = block->Get(pageIndex);
+            if (page == nullptr) {
+                page = pageAllocator_->Allocate();
+                block->Set(pageIndex, page);
             }
-            memcpy(pageData->data + pagePos, data + dataOffset, m);
+            memcpy(page + pagePos, data + dataOffset, m);
             pageIndex++;
             blockLen -= m;
             dataOffset += m;
@@ -1967,8 +2329,8 @@ void DataCache::MergeDataCacheToDataCache(DataCachePtr mergeDataCache,
     uint64_t pageIndex = blockPos / pageSize;
     uint64_t pagePos = blockPos % pageSize;
     char *data = nullptr;
-    PageData *mergePage = nullptr;
-    PageDataMap *pdMap = &dataMap_[blockIndex];
+    char *mergePage = nullptr;
+    BlockPages *block = GetOrCreateBlock(blockIndex);
     uint64_t n = 0;
 
     VLOG(9) << "MergeDataCacheToDataCache dataOffset:" << dataOffset
@@ -1982,12 +2344,12 @@ void DataCache::MergeDataCacheToDataCache(DataCachePtr mergeDataCache,
         if (pageIndex == maxPageInBlock) {
             blockIndex++;
             pageIndex = 0;
-            pdMap = &dataMap_[blockIndex];
+            block = GetOrCreateBlock(blockIndex);
         }
-        mergePage = mergeDataCache->GetPageData(blockIndex, pageIndex);
+        mergePage = mergeDataCache->GetPage(blockIndex, pageIndex);
         assert(mergePage);
-        if (pdMap->count(pageIndex)) {
-            data = (*pdMap)[pageIndex]->data;
+        data = block->Get(pageIndex);
+        if (data != nullptr) {
             if (pagePos + len > pageSize) {
                 n = pageSize - pagePos;
             } else {
@@ -1995,11 +2357,10 @@ void DataCache::MergeDataCacheToDataCache(DataCachePtr mergeDataCache,
             }
             VLOG(9) << "MergeDataCacheToDataCache n:" << n
                     << ", pagePos:" << pagePos;
-            memcpy(data + pagePos, mergePage->data + pagePos, n);
-            // mergeDataCache->ReleasePageData(blockIndex, pageIndex);
+            memcpy(data + pagePos, mergePage + pagePos, n);
         } else {
-            pdMap->emplace(pageIndex, mergePage);
-            mergeDataCache->ErasePageData(blockIndex, pageIndex);
+            block->Set(pageIndex, mergePage);
+            mergeDataCache->ErasePage(blockIndex, pageIndex);
             n = pageSize;
             actualLen_ += pageSize;
             VLOG(9) << "MergeDataCacheToDataCache n:" << n;
@@ -2158,12 +2519,11 @@ void DataCache::Truncate(uint64_t size) {
         } else {
             n = truncateLen;
         }
-        PageDataMap &pdMap = dataMap_[blockIndex];
+        BlockPages *block = GetBlock(blockIndex);
         blockLen = n;
         pageIndex = blockPos / pageSize;
         uint64_t pagePos = blockPos % pageSize;
-        PageData *pageData = nullptr;
-        while (blockLen > 0) {
+        while (block != nullptr && blockLen > 0) {
             if (pagePos + blockLen > pageSize) {
                 m = pageSize - pagePos;
             } else {
@@ -2171,24 +2531,23 @@ void DataCache::Truncate(uint64_t size) {
             }
 
             if (pagePos == 0) {
-                if (pdMap.count(pageIndex)) {
-                    pageData = pdMap[pageIndex];
-                    delete pageData->data;
-                    pdMap.erase(pageIndex);
+                char *page = block->Erase(pageIndex);
+                if (page != nullptr) {
+                    pageAllocator_->Free(page);
                     actualLen_ -= pageSize;
                 }
             } else {
-                if (pdMap.count(pageIndex)) {
-                    pageData = pdMap[pageIndex];
-                    memset(pageData->data + pagePos, 0, m);
+                char *page = block->Get(pageIndex);
+                if (page != nullptr) {
+                    memset(page + pagePos, 0, m);
                 }
             }
             pageIndex++;
             blockLen -= m;
             pagePos = (pagePos + m) % pageSize;
         }
-        if (pdMap.empty()) {
-            dataMap_.erase(blockIndex);
+        if (block != nullptr && block->Empty()) {
+            blocks_[blockIndex].reset();
         }
         blockIndex++;
         truncateLen -= n;
@@ -2233,8 +2592,8 @@ void DataCache::CopyDataCacheToBuf(uint64_t offset, uint64_t len, char *data) {
             n = len;
         }
         blockLen = n;
-        PageDataMap &pdMap = dataMap_[blockIndex];
-        PageData *pageData = NULL;
+        BlockPages *block = GetBlock(blockIndex);
+        assert(block != nullptr);
         pageIndex = blockPos / pageSize;
         pagePos = blockPos % pageSize;
         while (blockLen > 0) {
@@ -2244,9 +2603,9 @@ void DataCache::CopyDataCacheToBuf(uint64_t offset, uint64_t len, char *data) {
                 m = blockLen;
             }
 
-            assert(pdMap.count(pageIndex));
-            pageData = pdMap[pageIndex];
-            memcpy(data + dataOffset, pageData->data + pagePos, m);
+            char *page = block->Get(pageIndex);
+            assert(page != nullptr);
+            memcpy(data + dataOffset, page + pagePos, m);
             pageIndex++;
             blockLen -= m;
             dataOffset += m;
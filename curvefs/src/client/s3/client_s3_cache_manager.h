@@ -35,7 +35,10 @@
 
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/client/filesystem/error.h"
+#include "curvefs/src/client/metric/client_metric.h"
+#include "curvefs/src/client/s3/cache_admission.h"
 #include "curvefs/src/client/s3/client_s3.h"
+#include "curvefs/src/client/s3/page_allocator.h"
 #include "src/common/concurrent/concurrent.h"
 #include "src/common/concurrent/task_thread_pool.h"
 #include "curvefs/src/client/kvclient/kvclient_manager.h"
@@ -64,6 +67,7 @@ using curve::common::S3Adapter;
 using curvefs::metaserver::Inode;
 using curvefs::metaserver::S3ChunkInfo;
 using curvefs::metaserver::S3ChunkInfoList;
+using curvefs::client::metric::S3Metric;
 
 enum CacheType { Write = 1, Read = 2 };
 
@@ -116,16 +120,61 @@ S3ReadRequestVecDebugString(const std::vector<S3ReadRequest> &reqs) {
     return os.str();
 }
 
+/**
+ * @brief merge the requests reading adjacent ranges of the same objects
+ *
+ * A merged request may go on across the consecutive block objects of the
+ * same s3 chunk, it reads each block object in one ranged get instead of
+ * one get per request.
+ * @param[in] blockSize the size of a block object
+ * @param[in,out] requests the requests of one read, sorted by file offset
+ *                after merged
+ */
+void MergeS3ReadRequests(uint64_t blockSize,
+                         std::vector<S3ReadRequest> *requests);
+
 struct ObjectChunkInfo {
     S3ChunkInfo s3ChunkInfo;
     uint64_t objectOffset;  // s3 object's begin in the block
 };
 
-struct PageData {
-    uint64_t index;
-    char *data;
+// pages of a block in the cache, indexed by the page index in the block
+class BlockPages {
+ public:
+    explicit BlockPages(uint64_t pageNum) : pages_(pageNum, nullptr),
+                                            count_(0) {}
+
+    char *Get(uint64_t pageIndex) const {
+        assert(pageIndex < pages_.size());
+        return pages_[pageIndex];
+    }
+
+    void Set(uint64_t pageIndex, char *page) {
+        assert(pageIndex < pages_.size());
+        assert(pages_[pageIndex] == nullptr);
+        pages_[pageIndex] = page;
+        count_++;
+    }
+
+    // remove the page and return it, the caller owns the page
+    char *Erase(uint64_t pageIndex) {
+        assert(pageIndex < pages_.size());
+        char *page = pages_[pageIndex];
+        if (page != nullptr) {
+            pages_[pageIndex] = nullptr;
+            count_--;
+        }
+        return page;
+    }
+
+    bool Empty() const { return count_ == 0; }
+
+    const std::vector<char *> &Pages() const { return pages_; }
+
+ private:
+    std::vector<char *> pages_;
+    uint64_t count_;
 };
-using PageDataMap = std::map<uint64_t, PageData *>;
 
 enum DataCacheStatus {
     Dirty = 1,
@@ -139,12 +188,12 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
               uint64_t len, const char *data,
               std::shared_ptr<KVClientManager> kvClientManager);
     virtual ~DataCache() {
-        auto iter = dataMap_.begin();
-        for (; iter != dataMap_.end(); iter++) {
-            auto pageIter = iter->second.begin();
-            for (; pageIter != iter->second.end(); pageIter++) {
-                delete[] pageIter->second->data;
-                delete pageIter->second;
+        for (const auto &block : blocks_) {
+            if (block == nullptr) {
+                continue;
+            }
+            for (char *page : block->Pages()) {
+                pageAllocator_->Free(page);
             }
         }
     }
@@ -154,23 +203,22 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
     virtual void Truncate(uint64_t size);
     uint64_t GetChunkPos() { return chunkPos_; }
     uint64_t GetLen() { return len_; }
-    PageData *GetPageData(uint64_t blockIndex, uint64_t pageIndex) {
-        PageDataMap &pdMap = dataMap_[blockIndex];
-        if (pdMap.count(pageIndex)) {
-            return pdMap[pageIndex];
-        }
-        return nullptr;
+    char *GetPage(uint64_t blockIndex, uint64_t pageIndex) {
+        BlockPages *block = GetBlock(blockIndex);
+        return block != nullptr ? block->Get(pageIndex) : nullptr;
     }
 
-    void ErasePageData(uint64_t blockIndex, uint64_t pageIndex) {
+    // remove the page without freeing it, the page is moved to another
+    // data cache
+    void ErasePage(uint64_t blockIndex, uint64_t pageIndex) {
         curve::common::LockGuard lg(mtx_);
-        PageDataMap &pdMap = dataMap_[blockIndex];
-        auto iter = pdMap.find(pageIndex);
-        if (iter != pdMap.end()) {
-            pdMap.erase(iter);
+        BlockPages *block = GetBlock(blockIndex);
+        if (block == nullptr) {
+            return;
         }
-        if (pdMap.empty()) {
-            dataMap_.erase(blockIndex);
+        block->Erase(pageIndex);
+        if (block->Empty()) {
+            blocks_[blockIndex].reset();
         }
     }
 
@@ -191,6 +239,27 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
         inReadCache_.store(inCache, std::memory_order_release);
     }
 
+    // mark a hit of the read cache, the lru moves it to the front lazily
+    // when it reaches the tail, so a hit takes no lock
+    void MarkReadCacheHit() {
+        if (!readCacheHit_.load(std::memory_order_relaxed)) {
+            readCacheHit_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    // return whether the read cache was hit since the last call
+    bool TestAndClearReadCacheHit() {
+        return readCacheHit_.exchange(false, std::memory_order_relaxed);
+    }
+
+    bool ReadCacheHit() const {
+        return readCacheHit_.load(std::memory_order_relaxed);
+    }
+
+    ChunkCacheManager *GetChunkCacheManager() const {
+        return chunkCacheManager_.get();
+    }
+
     void Lock() {
         mtx_.lock();
     }
@@ -222,6 +291,13 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
 
     CachePolicy GetCachePolicy(bool toS3);
 
+    BlockPages *GetBlock(uint64_t blockIndex) {
+        return blockIndex < blocks_.size() ? blocks_[blockIndex].get()
+                                           : nullptr;
+    }
+
+    BlockPages *GetOrCreateBlock(uint64_t blockIndex);
+
  private:
     S3ClientAdaptorImpl *s3ClientAdaptor_;
     ChunkCacheManagerPtr chunkCacheManager_;
@@ -233,7 +309,10 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
     uint64_t createTime_;
     std::atomic<int> status_;
     std::atomic<bool> inReadCache_;
-    std::map<uint64_t, PageDataMap> dataMap_;  // first is block index
+    std::atomic<bool> readCacheHit_;
+    // indexed by the block index in the chunk, nullptr if no data
+    std::vector<std::unique_ptr<BlockPages>> blocks_;
+    std::shared_ptr<PageAllocator> pageAllocator_;
 
     std::shared_ptr<KVClientManager> kvClientManager_;
 };
@@ -256,9 +335,9 @@ class ChunkCacheManager
     : public std::enable_shared_from_this<ChunkCacheManager> {
  public:
     ChunkCacheManager(uint64_t index, S3ClientAdaptorImpl *s3ClientAdaptor,
-                      std::shared_ptr<KVClientManager> kvClientManager)
-        : index_(index), s3ClientAdaptor_(s3ClientAdaptor),
-          flushingDataCache_(nullptr),
+                      std::shared_ptr<KVClientManager> kvClientManager,
+                      uint64_t inodeId = 0)
+        : index_(index), inodeId_(inodeId), s3ClientAdaptor_(s3ClientAdaptor),
           kvClientManager_(std::move(kvClientManager)) {}
     virtual ~ChunkCacheManager() = default;
     void ReadChunk(uint64_t index, uint64_t chunkPos, uint64_t readLen,
@@ -267,7 +346,10 @@ class ChunkCacheManager
     virtual void WriteNewDataCache(S3ClientAdaptorImpl *s3ClientAdaptor,
                                    uint32_t chunkPos, uint32_t len,
                                    const char *data);
-    virtual void AddReadDataCache(DataCachePtr dataCache);
+    // admission only applies to the data read from the backend, the data
+    // just flushed is always the newest and goes into the read cache
+    virtual void AddReadDataCache(DataCachePtr dataCache,
+                                  bool admission = true);
     virtual DataCachePtr
     FindWriteableDataCache(uint64_t pos, uint64_t len,
                            std::vector<DataCachePtr> *mergeDataCacheVer,
@@ -284,6 +366,16 @@ class ChunkCacheManager
     virtual CURVEFS_ERROR Flush(uint64_t inodeId, bool force,
                                 bool toS3 = false);
     uint64_t GetIndex() { return index_; }
+    uint64_t GetInodeId() const { return inodeId_; }
+    // the data version of the chunk, bumped under rwLockChunk_ by every
+    // write, flush and truncate, the data read ahead of an older version
+    // is dropped
+    uint64_t GetDataVersion() const {
+        return dataVersion_.load(std::memory_order_relaxed);
+    }
+    void IncDataVersion() {
+        dataVersion_.fetch_add(1, std::memory_order_relaxed);
+    }
     bool IsEmpty() {
         ReadLockGuard writeCacheLock(rwLockChunk_);
         return (dataWCacheMap_.empty() && dataRCacheMap_.empty());
@@ -308,13 +400,23 @@ class ChunkCacheManager
 
  private:
     void ReleaseWriteDataCache(const DataCachePtr &dataCache);
+    // flush a data cache once, return false if it should be retried, or
+    // true if it is flushed or its inode is gone
+    bool FlushDataCache(uint64_t inodeId, const DataCachePtr &dataCache,
+                        bool toS3);
+    // read by the non-overlapping data caches keyed by pos in chunk
+    void ReadByDataCaches(const std::map<uint64_t, DataCachePtr> &dataCaches,
+                          uint64_t chunkPos, uint64_t readLen, char *dataBuf,
+                          uint64_t dataBufOffset,
+                          std::vector<ReadRequest> *requests);
     void TruncateWriteCache(uint64_t chunkPos);
     void TruncateReadCache(uint64_t chunkPos);
     bool IsFlushDataEmpty() {
-        return flushingDataCache_ == nullptr;
+        return flushingDataCacheMap_.empty();
     }
  private:
     uint64_t index_;
+    uint64_t inodeId_;
     std::map<uint64_t, DataCachePtr> dataWCacheMap_;  // first is pos in chunk
     std::map<uint64_t, std::list<DataCachePtr>::iterator>
         dataRCacheMap_;  // first is pos in chunk
@@ -322,8 +424,10 @@ class ChunkCacheManager
     RWLock rwLockRead_;  //  for read cache
     S3ClientAdaptorImpl *s3ClientAdaptor_;
     curve::common::Mutex flushMtx_;
-    DataCachePtr flushingDataCache_;
+    // data caches being flushed, first is pos in chunk
+    std::map<uint64_t, DataCachePtr> flushingDataCacheMap_;
     curve::common::Mutex flushingDataCacheMtx_;
+    std::atomic<uint64_t> dataVersion_{0};
 
     std::shared_ptr<KVClientManager> kvClientManager_;
 };
@@ -357,6 +461,18 @@ class FileCacheManager {
 
     uint64_t GetInodeId() const { return inode_; }
 
+    /**
+     * @brief record a read of the file and move the readahead window
+     *
+     * The window starts from one block once the file is read sequentially,
+     * and doubles every time the reader gets close to its end, up to
+     * maxReadAheadBlocks. A random read closes the window.
+     * @param[out] readAheadOffset where to read ahead from
+     * @return the length to read ahead, 0 if nothing to read ahead
+     */
+    uint64_t UpdateReadAhead(uint64_t offset, uint64_t length,
+                             uint64_t *readAheadOffset);
+
     void SetChunkCacheManagerForTest(uint64_t index,
                                      ChunkCacheManagerPtr chunkCacheManager) {
         WriteLockGuard writeLockGuard(rwLock_);
@@ -399,7 +515,13 @@ class FileCacheManager {
     // read data from memory read/write cache
     void ReadFromMemCache(uint64_t offset, uint64_t length, char *dataBuf,
                           uint64_t *actualReadLen,
-                          std::vector<ReadRequest> *memCacheMissRequest);
+                          std::vector<ReadRequest> *memCacheMissRequest,
+                          bool recordAccess = true);
+
+    // read the range into the memory read cache, or the disk cache if the
+    // memory read cache is disabled by cto, without waiting for the data
+    void ReadAhead(const std::shared_ptr<InodeWrapper> &inodeWrapper,
+                   uint64_t offset, uint64_t length);
 
     // miss read from memory read/write cache, need read from
     // kv(localdisk/remote cache/s3)
@@ -431,7 +553,14 @@ class FileCacheManager {
                           uint64_t fileLen,
                           std::once_flag &cancelFlag,     // NOLINT
                           std::atomic<bool> &isCanceled,  // NOLINT
-                          std::atomic<int> &retCode);     // NOLINT
+                          std::atomic<int> &retCode,      // NOLINT
+                          bool toMemCache = true);
+
+    // put the data read ahead into the memory read cache, unless the chunk
+    // cache manager is released or the data version has changed since
+    void AddReadAheadDataCache(const S3ReadRequest &req, char *dataBuf,
+                               const ChunkCacheManagerPtr &chunkCacheManager,
+                               uint64_t dataVersion);
 
     // read kv request from local disk cache
     bool ReadKVRequestFromLocalCache(const std::string &name, char *databuf,
@@ -466,6 +595,12 @@ class FileCacheManager {
     curve::common::Mutex downloadMtx_;
     std::set<std::string> downloadingObj_;
 
+    // sequential read detection and readahead window
+    curve::common::Mutex readAheadMtx_;
+    uint64_t lastReadEnd_ = 0;
+    uint64_t readAheadWindow_ = 0;
+    uint64_t readAheadEnd_ = 0;
+
     std::shared_ptr<KVClientManager> kvClientManager_;
     std::shared_ptr<TaskThreadPool<>> readTaskPool_;
 };
@@ -475,12 +610,16 @@ class FsCacheManager {
     FsCacheManager(S3ClientAdaptorImpl *s3ClientAdaptor,
                    uint64_t readCacheMaxByte, uint64_t writeCacheMaxByte,
                    uint32_t readCacheThreads,
-                   std::shared_ptr<KVClientManager> kvClientManager)
+                   std::shared_ptr<KVClientManager> kvClientManager,
+                   uint32_t readCacheShards = 1)
         : lruByte_(0), wDataCacheNum_(0), wDataCacheByte_(0),
           readCacheMaxByte_(readCacheMaxByte),
           writeCacheMaxByte_(writeCacheMaxByte),
           s3ClientAdaptor_(s3ClientAdaptor), isWaiting_(false),
           kvClientManager_(std::move(kvClientManager)) {
+        for (uint32_t i = 0; i < std::max<uint32_t>(readCacheShards, 1); i++) {
+            lruShards_.emplace_back(new LruShard());
+        }
         readTaskPool_->Start(readCacheThreads);
     }
     FsCacheManager() = default;
@@ -491,7 +630,8 @@ class FsCacheManager {
     void ReleaseFileCacheManager(uint64_t inodeId);
 
     bool Set(DataCachePtr dataCache,
-             std::list<DataCachePtr>::iterator *outIter);
+             std::list<DataCachePtr>::iterator *outIter,
+             bool admission = true);
     bool Delete(std::list<DataCachePtr>::iterator iter);
     void Get(std::list<DataCachePtr>::iterator iter);
 
@@ -535,10 +675,33 @@ class FsCacheManager {
     }
 
     uint64_t GetLruByte() {
-        std::lock_guard<std::mutex> lk(lruMtx_);
-        return lruByte_;
+        return lruByte_.load(std::memory_order_relaxed);
     }
 
+    uint64_t GetLruShardByte(uint32_t shard) {
+        std::lock_guard<std::mutex> lk(lruShards_[shard]->mtx);
+        return lruShards_[shard]->bytes;
+    }
+
+    uint32_t GetLruShardNum() const { return lruShards_.size(); }
+
+    // the admission policy of the data read into a full read cache
+    void SetReadCacheAdmission(std::unique_ptr<CacheAdmission> admission) {
+        readCacheAdmission_ = std::move(admission);
+    }
+
+    void InitMetrics(std::shared_ptr<S3Metric> metric) {
+        metric_ = std::move(metric);
+    }
+
+    // record a read of the file chunk for the read cache admission, hit or
+    // miss, the frequencies are counted by block
+    void RecordReadCacheAccess(uint64_t inodeId, uint64_t index,
+                               uint64_t chunkPos, uint64_t len);
+
+    // count a read all served by the memory cache or not
+    void CollectReadCacheMetric(bool hit);
+
     void SetFileCacheManagerForTest(uint64_t inodeId,
                                     FileCacheManagerPtr fileCacheManager) {
         WriteLockGuard writeLockGuard(rwLock_);
@@ -573,14 +736,39 @@ class FsCacheManager {
         std::thread t_;
     };
 
+    // read data caches of the same file chunk are in the same shard
+    struct LruShard {
+        std::mutex mtx;
+        std::list<DataCachePtr> lruList;
+        uint64_t bytes = 0;
+    };
+
+    LruShard *GetLruShard(const DataCachePtr &dataCache);
+
+    // evict the read data caches until the total size is below the limit,
+    // starting from the given shard
+    void TrimReadCache(LruShard *shard);
+
+    // whether the data cache is worth evicting the data cache which
+    // `TrimReadCache` evicts first
+    bool AdmitReadCache(LruShard *shard, const DataCachePtr &dataCache);
+
+    // find the data cache `TrimReadCache` evicts first without moving it,
+    // return false if the read cache is empty
+    bool FindReadCacheVictim(LruShard *shard, uint64_t *victimKey);
+
+    uint64_t ReadCacheKey(uint64_t inodeId, uint64_t index,
+                          uint64_t blockIndex) const;
+    uint64_t ReadCacheKey(const DataCachePtr &dataCache) const;
+
  private:
     std::unordered_map<uint64_t, FileCacheManagerPtr>
         fileCacheManagerMap_;  // first is inodeid
     RWLock rwLock_;
-    std::mutex lruMtx_;
 
-    std::list<DataCachePtr> lruReadDataCacheList_;
-    uint64_t lruByte_;
+    std::vector<std::unique_ptr<LruShard>> lruShards_;
+    std::atomic<uint64_t> lruByte_;
+    std::unique_ptr<CacheAdmission> readCacheAdmission_{new LruAdmission()};
     std::atomic<uint64_t> wDataCacheNum_;
     std::atomic<uint64_t> wDataCacheByte_;
     uint64_t readCacheMaxByte_;
@@ -594,6 +782,8 @@ class FsCacheManager {
 
     std::shared_ptr<KVClientManager> kvClientManager_;
 
+    std::shared_ptr<S3Metric> metric_;
+
     std::shared_ptr<TaskThreadPool<>> readTaskPool_ =
         std::make_shared<TaskThreadPool<>>();
 };
@@ -21,6 +21,8 @@
  */
 #include <sys/vfs.h>
 #include <errno.h>
+#include <algorithm>
+#include <functional>
 #include <string>
 #include <cstdio>
 #include <memory>
@@ -88,6 +90,19 @@ int DiskCacheManager::Init(std::shared_ptr<S3Client> client,
     maxFileNums_ = option.diskCacheOpt.maxFileNums;
     cmdTimeoutSec_ = option.diskCacheOpt.cmdTimeoutSec;
     objectPrefix_ = option.objectPrefix;
+    // the disk cache holds an object of a block in a file
+    uint64_t capacity = maxFileNums_;
+    if (option.blockSize > 0) {
+        capacity =
+            std::min(capacity, maxUsableSpaceBytes_ / option.blockSize);
+    }
+    readCacheAdmission_ = NewCacheAdmission(
+        option.diskCacheOpt.readCacheAdmission, capacity);
+    if (readCacheAdmission_ == nullptr) {
+        LOG(ERROR) << "unknown disk cache admission policy: "
+                   << option.diskCacheOpt.readCacheAdmission;
+        return -1;
+    }
     cacheWrite_->Init(client_, posixWrapper_, cacheDir_, objectPrefix_,
         option.diskCacheOpt.asyncLoadPeriodMs, cachedObjName_);
     cacheRead_->Init(posixWrapper_, cacheDir_, objectPrefix_);
@@ -132,6 +147,8 @@ int DiskCacheManager::Init(std::shared_ptr<S3Client> client,
               << ", cmdTimeoutSec is: " << cmdTimeoutSec_
               << ", safeRatio is: " << safeRatio_
               << ", fullRatio is: " << fullRatio_
+              << ", readCacheAdmission is: "
+              << option.diskCacheOpt.readCacheAdmission
               << ", disk used bytes: " << GetDiskUsedbytes();
     return 0;
 }
@@ -173,6 +190,41 @@ bool DiskCacheManager::IsCached(const std::string &name) {
     return true;
 }
 
+void DiskCacheManager::RecordReadAccess(const std::string &name, bool hit) {
+    if (readCacheAdmission_->Filtering()) {
+        readCacheAdmission_->RecordAccess(std::hash<std::string>()(name));
+    }
+    if (metric_ != nullptr) {
+        if (hit) {
+            metric_->readCache.hit << 1;
+        } else {
+            metric_->readCache.miss << 1;
+        }
+    }
+}
+
+bool DiskCacheManager::AdmitReadCache(const std::string &name) {
+    if (!readCacheAdmission_->Filtering() || IsDiskCacheSafe()) {
+        return true;
+    }
+
+    std::string victim;
+    if (!cachedObjName_->GetBack(&victim)) {
+        return true;
+    }
+
+    bool admit = readCacheAdmission_->Admit(
+        std::hash<std::string>()(name), std::hash<std::string>()(victim));
+    if (metric_ != nullptr) {
+        if (admit) {
+            metric_->readCache.admit << 1;
+        } else {
+            metric_->readCache.reject << 1;
+        }
+    }
+    return admit;
+}
+
 bool DiskCacheManager::IsCacheClean() {
     return cacheWrite_->IsCacheClean();
 }
@@ -37,6 +37,7 @@
 #include "src/common/wait_interval.h"
 #include "curvefs/src/common/wrap_posix.h"
 #include "curvefs/src/common/utils.h"
+#include "curvefs/src/client/s3/cache_admission.h"
 #include "curvefs/src/client/s3/client_s3.h"
 #include "curvefs/src/client/s3/disk_cache_write.h"
 #include "curvefs/src/client/s3/disk_cache_read.h"
@@ -75,6 +76,19 @@ class DiskCacheManager {
      */
     void AddCache(const std::string &name);
 
+    /**
+     * @brief record a read lookup of obj for the read cache admission
+     * @param[in] name obj name
+     * @param[in] hit whether obj is cached
+     */
+    void RecordReadAccess(const std::string &name, bool hit);
+    /**
+     * @brief whether obj is worth evicting the lru tail for, always true
+     *        if the cache has room for it
+     * @param[in] name obj name
+     */
+    bool AdmitReadCache(const std::string &name);
+
     int CreateDir();
     std::string GetCacheReadFullDir();
     std::string GetCacheWriteFullDir();
@@ -184,6 +198,7 @@ class DiskCacheManager {
     std::shared_ptr<DiskCacheRead> cacheRead_;
 
     std::shared_ptr<SglLRUCache<std::string>> cachedObjName_;
+    std::unique_ptr<CacheAdmission> readCacheAdmission_{new LruAdmission()};
 
     std::shared_ptr<S3Client> client_;
     std::shared_ptr<PosixWrapper> posixWrapper_;
@@ -181,6 +181,18 @@ bool DiskCacheManagerImpl::IsCached(const std::string name) {
     return diskCacheManager_->IsCached(name);
 }
 
+void DiskCacheManagerImpl::RecordReadAccess(const std::string &name,
+                                            bool hit) {
+    if (diskCacheManager_ != nullptr) {
+        diskCacheManager_->RecordReadAccess(name, hit);
+    }
+}
+
+bool DiskCacheManagerImpl::AdmitReadCache(const std::string &name) {
+    return diskCacheManager_ == nullptr ||
+           diskCacheManager_->AdmitReadCache(name);
+}
+
 bool DiskCacheManagerImpl::IsDiskCacheFull() {
     return diskCacheManager_->IsDiskCacheFull();
 }
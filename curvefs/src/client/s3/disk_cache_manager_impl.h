@@ -93,6 +93,18 @@ class DiskCacheManagerImpl {
      * @return cached: true, not cached : < 0
      */
     bool IsCached(const std::string name);
+    /**
+     * @brief record a read lookup of obj for the read cache admission
+     * @param[in] name obj name
+     * @param[in] hit whether obj is cached
+     */
+    void RecordReadAccess(const std::string &name, bool hit);
+    /**
+     * @brief whether obj read from s3 is worth its place in the cache
+     * @param[in] name obj name
+     * @return admitted: true, rejected : false
+     */
+    bool AdmitReadCache(const std::string &name);
     /**
      * @brief read obj
      * @param[in] name obj name
@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "curvefs/src/client/s3/page_allocator.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <unordered_map>
+
+namespace curvefs {
+namespace client {
+
+constexpr uint32_t PageAllocator::kDefaultSlabPages;
+constexpr uint32_t PageAllocator::kDefaultThreadCachePages;
+
+namespace {
+
+// ids are never reused, a thread never mistakes the cache of a destroyed
+// allocator for the one of a new allocator at the same address
+std::atomic<uint64_t> g_nextAllocatorId(1);
+
+// live allocators, so that an exiting thread doesn't touch a destroyed one
+std::mutex g_allocatorsMtx;
+std::unordered_map<uint64_t, PageAllocator *> g_allocators;
+
+}  // namespace
+
+class PageAllocator::ThreadLocalCaches {
+ public:
+    ~ThreadLocalCaches() {
+        std::lock_guard<std::mutex> lk(g_allocatorsMtx);
+        for (const auto &item : caches) {
+            auto iter = g_allocators.find(item.first);
+            if (iter != g_allocators.end()) {
+                iter->second->RemoveThreadCache(item.second);
+            }
+        }
+    }
+
+    // first is allocator id
+    std::unordered_map<uint64_t, ThreadCache *> caches;
+};
+
+PageAllocator::PageAllocator(uint64_t pageSize, uint32_t slabPages,
+                             uint32_t threadCachePages)
+    : id_(g_nextAllocatorId.fetch_add(1, std::memory_order_relaxed)),
+      pageSize_(pageSize),
+      slabPages_(std::max<uint32_t>(slabPages, 1)),
+      threadCachePages_(threadCachePages) {
+    std::lock_guard<std::mutex> lk(g_allocatorsMtx);
+    g_allocators.emplace(id_, this);
+}
+
+PageAllocator::~PageAllocator() {
+    {
+        std::lock_guard<std::mutex> lk(g_allocatorsMtx);
+        g_allocators.erase(id_);
+    }
+    allocatedByte_ << -static_cast<int64_t>(slabs_.size() * slabPages_ *
+                                            pageSize_);
+}
+
+char *PageAllocator::Allocate() {
+    ThreadCache *cache = GetThreadCache();
+    if (cache->pages.empty()) {
+        FetchFromCentral(cache);
+    }
+
+    char *page = cache->pages.back();
+    cache->pages.pop_back();
+    memset(page, 0, pageSize_);
+    usedByte_ << static_cast<int64_t>(pageSize_);
+    return page;
+}
+
+void PageAllocator::Free(char *page) {
+    if (page == nullptr) {
+        return;
+    }
+
+    ThreadCache *cache = GetThreadCache();
+    cache->pages.push_back(page);
+    usedByte_ << -static_cast<int64_t>(pageSize_);
+    if (cache->pages.size() > threadCachePages_) {
+        ReleaseToCentral(cache);
+    }
+}
+
+void PageAllocator::ExposeMetric(const std::string &prefix,
+                                 const std::string &name) {
+    allocatedByte_.expose_as(prefix, name + "_page_allocated_byte");
+    usedByte_.expose_as(prefix, name + "_page_used_byte");
+}
+
+PageAllocator::ThreadCache *PageAllocator::GetThreadCache() {
+    static thread_local ThreadLocalCaches threadLocalCaches;
+    auto &caches = threadLocalCaches.caches;
+
+    auto iter = caches.find(id_);
+    if (iter != caches.end()) {
+        return iter->second;
+    }
+
+    std::unique_ptr<ThreadCache> cache(new ThreadCache());
+    cache->pages.reserve(threadCachePages_ + 1);
+    ThreadCache *ptr = cache.get();
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        threadCaches_.emplace_back(std::move(cache));
+    }
+    caches.emplace(id_, ptr);
+    return ptr;
+}
+
+void PageAllocator::RemoveThreadCache(ThreadCache *cache) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    freePages_.insert(freePages_.end(), cache->pages.begin(),
+                      cache->pages.end());
+    auto iter = std::find_if(
+        threadCaches_.begin(), threadCaches_.end(),
+        [cache](const std::unique_ptr<ThreadCache> &c) {
+            return c.get() == cache;
+        });
+    if (iter != threadCaches_.end()) {
+        threadCaches_.erase(iter);
+    }
+}
+
+void PageAllocator::FetchFromCentral(ThreadCache *cache) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (freePages_.empty()) {
+        uint64_t slabSize = slabPages_ * pageSize_;
+        std::unique_ptr<char[]> slab(new char[slabSize]);
+        for (uint32_t i = 0; i < slabPages_; i++) {
+            freePages_.push_back(slab.get() + i * pageSize_);
+        }
+        slabs_.emplace_back(std::move(slab));
+        allocatedByte_ << static_cast<int64_t>(slabSize);
+        VLOG(6) << "page allocator new slab, slab size: " << slabSize
+                << ", slab num: " << slabs_.size();
+    }
+
+    size_t n = std::min<size_t>(std::max<uint32_t>(threadCachePages_ / 2, 1),
+                                freePages_.size());
+    cache->pages.insert(cache->pages.end(), freePages_.end() - n,
+                        freePages_.end());
+    freePages_.resize(freePages_.size() - n);
+}
+
+void PageAllocator::ReleaseToCentral(ThreadCache *cache) {
+    size_t keep = threadCachePages_ / 2;
+    std::lock_guard<std::mutex> lk(mtx_);
+    freePages_.insert(freePages_.end(), cache->pages.begin() + keep,
+                      cache->pages.end());
+    cache->pages.resize(keep);
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+#ifndef CURVEFS_SRC_CLIENT_S3_PAGE_ALLOCATOR_H_
+#define CURVEFS_SRC_CLIENT_S3_PAGE_ALLOCATOR_H_
+
+#include <bvar/bvar.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace curvefs {
+namespace client {
+
+/**
+ * @brief fixed-size page allocator for the memory data cache
+ *
+ * Pages are carved out of slabs of slabPages pages. Freed pages are kept
+ * in a small cache of the freeing thread and go back to the central free
+ * list in batches, so the hot path takes no lock. Slabs are never given
+ * back to the system, the memory of the cache stays at its peak size
+ * instead of drifting up with malloc fragmentation.
+ */
+class PageAllocator {
+ public:
+    static constexpr uint32_t kDefaultSlabPages = 64;
+    static constexpr uint32_t kDefaultThreadCachePages = 64;
+
+    explicit PageAllocator(uint64_t pageSize,
+                           uint32_t slabPages = kDefaultSlabPages,
+                           uint32_t threadCachePages =
+                               kDefaultThreadCachePages);
+    ~PageAllocator();
+
+    PageAllocator(const PageAllocator &) = delete;
+    PageAllocator &operator=(const PageAllocator &) = delete;
+
+    // allocate a zero filled page
+    char *Allocate();
+
+    void Free(char *page);
+
+    uint64_t GetPageSize() const { return pageSize_; }
+
+    // bytes of slabs allocated from the system
+    uint64_t GetAllocatedBytes() const { return allocatedByte_.get_value(); }
+
+    // bytes of pages handed out and not freed yet
+    uint64_t GetUsedBytes() const { return usedByte_.get_value(); }
+
+    void ExposeMetric(const std::string &prefix, const std::string &name);
+
+ private:
+    struct ThreadCache {
+        std::vector<char *> pages;
+    };
+
+    // caches of a thread, handed back to the allocators on thread exit
+    class ThreadLocalCaches;
+
+    ThreadCache *GetThreadCache();
+
+    // give the pages of an exited thread back to the central free list
+    void RemoveThreadCache(ThreadCache *cache);
+
+    // move a batch of pages from the central free list into the cache,
+    // allocate a new slab if the central free list is empty
+    void FetchFromCentral(ThreadCache *cache);
+
+    // move the pages beyond half of the cache capacity to the central
+    void ReleaseToCentral(ThreadCache *cache);
+
+ private:
+    const uint64_t id_;
+    const uint64_t pageSize_;
+    const uint32_t slabPages_;
+    const uint32_t threadCachePages_;
+
+    std::mutex mtx_;
+    std::vector<std::unique_ptr<char[]>> slabs_;
+    std::vector<char *> freePages_;
+    // the threads only keep raw pointers, a cache is released on thread
+    // exit or with the allocator, whichever comes first
+    std::vector<std::unique_ptr<ThreadCache>> threadCaches_;
+
+    bvar::Adder<int64_t> allocatedByte_;
+    bvar::Adder<int64_t> usedByte_;
+};
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_S3_PAGE_ALLOCATOR_H_
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "curvefs/src/client/s3/cache_admission.h"
+
+namespace curvefs {
+namespace client {
+
+TEST(FrequencySketchTest, Increment) {
+    FrequencySketch sketch(1024);
+    ASSERT_EQ(0, sketch.Frequency(1));
+
+    for (uint32_t i = 1; i <= 5; i++) {
+        sketch.Increment(1);
+        ASSERT_EQ(i, sketch.Frequency(1));
+    }
+    ASSERT_EQ(0, sketch.Frequency(2));
+
+    // the counters saturate
+    for (int i = 0; i < 20; i++) {
+        sketch.Increment(1);
+    }
+    ASSERT_EQ(FrequencySketch::kMaxFrequency, sketch.Frequency(1));
+}
+
+TEST(FrequencySketchTest, Reset) {
+    FrequencySketch sketch(64);
+    for (uint32_t i = 0; i < 10; i++) {
+        sketch.Increment(1);
+    }
+    ASSERT_EQ(10, sketch.Frequency(1));
+
+    // the counters are halved once the accesses reach the sample size
+    for (uint64_t key = 100; key < 100 + sketch.GetSampleSize(); key++) {
+        sketch.Increment(key);
+    }
+    ASSERT_LE(sketch.Frequency(1), 5);
+    ASSERT_GE(sketch.Frequency(1), 2);
+}
+
+TEST(FrequencySketchTest, ConcurrentIncrement) {
+    FrequencySketch sketch(1 << 16);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&sketch]() {
+            for (uint64_t key = 0; key < 1000; key++) {
+                sketch.Increment(key);
+                sketch.Increment(key);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    for (uint64_t key = 0; key < 1000; key++) {
+        ASSERT_GE(sketch.Frequency(key), 8);
+    }
+}
+
+TEST(CacheAdmissionTest, Lru) {
+    auto admission = NewCacheAdmission("lru", 16);
+    ASSERT_NE(nullptr, admission);
+    ASSERT_FALSE(admission->Filtering());
+
+    admission->RecordAccess(2);
+    ASSERT_TRUE(admission->Admit(1, 2));
+}
+
+TEST(CacheAdmissionTest, TinyLfu) {
+    auto admission = NewCacheAdmission("tinylfu", 16);
+    ASSERT_NE(nullptr, admission);
+    ASSERT_TRUE(admission->Filtering());
+
+    admission->RecordAccess(1);
+    admission->RecordAccess(2);
+    admission->RecordAccess(2);
+    ASSERT_FALSE(admission->Admit(1, 2));
+    ASSERT_TRUE(admission->Admit(2, 1));
+
+    // no more frequent than the victim
+    admission->RecordAccess(1);
+    ASSERT_FALSE(admission->Admit(1, 2));
+    admission->RecordAccess(1);
+    ASSERT_TRUE(admission->Admit(1, 2));
+}
+
+TEST(CacheAdmissionTest, Unknown) {
+    ASSERT_EQ(nullptr, NewCacheAdmission("arc", 16));
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -338,6 +338,49 @@ TEST_F(ChunkCacheManagerTest, test_flush) {
     delete buf;
 }
 
+TEST_F(ChunkCacheManagerTest, test_flush_concurrently) {
+    uint64_t inodeId = 1;
+    uint64_t len = 1024 * 1024;
+    char *buf = new char[len];
+    memset(buf, 'a', len);
+    auto dataCache = std::make_shared<MockDataCache>(
+        s3ClientAdaptor_, chunkCacheManager_, 0, len, buf, nullptr);
+    memset(buf, 'b', len);
+    auto dataCache1 = std::make_shared<MockDataCache>(
+        s3ClientAdaptor_, chunkCacheManager_, 2 * len, len, buf, nullptr);
+
+    // the data caches being flushed can still be read
+    char *readBuf = new char[3 * len];
+    std::vector<ReadRequest> requests;
+    auto readChunk = [&](uint64_t, bool) {
+        chunkCacheManager_->ReadChunk(0, 0, 3 * len, readBuf, 0, &requests);
+        return CURVEFS_ERROR::OK;
+    };
+    EXPECT_CALL(*dataCache, Flush(_, _)).WillOnce(Invoke(readChunk));
+    EXPECT_CALL(*dataCache1, Flush(_, _))
+        .WillOnce(Return(CURVEFS_ERROR::OK));
+    EXPECT_CALL(*dataCache, CanFlush(_)).WillOnce(Return(true));
+    EXPECT_CALL(*dataCache1, CanFlush(_)).WillOnce(Return(true));
+
+    chunkCacheManager_->AddWriteDataCacheForTest(dataCache);
+    chunkCacheManager_->AddWriteDataCacheForTest(dataCache1);
+    ASSERT_EQ(CURVEFS_ERROR::OK,
+              chunkCacheManager_->Flush(inodeId, true, true));
+
+    ASSERT_EQ(1, requests.size());
+    ASSERT_EQ(len, requests[0].chunkPos);
+    ASSERT_EQ(len, requests[0].len);
+    ASSERT_EQ(len, requests[0].bufOffset);
+    ASSERT_EQ('a', readBuf[0]);
+    ASSERT_EQ('a', readBuf[len - 1]);
+    ASSERT_EQ('b', readBuf[2 * len]);
+    ASSERT_EQ('b', readBuf[3 * len - 1]);
+    chunkCacheManager_->ReleaseCacheForTest();
+
+    delete[] readBuf;
+    delete[] buf;
+}
+
 TEST_F(ChunkCacheManagerTest, test_release_read_dataCache) {
     uint64_t offset = 0;
     uint64_t len = 1024 * 1024;
@@ -153,8 +153,12 @@ TEST_F(DataCacheTest, test_write6) {
 
 TEST_F(DataCacheTest, test_truncate1) {
     uint64_t size = 0;
+    auto pageAllocator = s3ClientAdaptor_->GetPageAllocator();
+    ASSERT_EQ(1024 * 1024, pageAllocator->GetUsedBytes());
     dataCache_->Truncate(size);
     ASSERT_EQ(0, dataCache_->GetLen());
+    // the truncated pages go back to the allocator
+    ASSERT_EQ(0, pageAllocator->GetUsedBytes());
 }
 
 TEST_F(DataCacheTest, test_truncate2) {
@@ -167,6 +171,8 @@ TEST_F(DataCacheTest, test_truncate3) {
     uint64_t size = 2;
     dataCache_->Truncate(size);
     ASSERT_EQ(2, dataCache_->GetLen());
+    ASSERT_EQ(64 * 1024,
+              s3ClientAdaptor_->GetPageAllocator()->GetUsedBytes());
 }
 
 }  // namespace client
@@ -23,6 +23,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
+
 #include "curvefs/src/client/s3/client_s3_adaptor.h"
 #include "curvefs/src/client/s3/client_s3_cache_manager.h"
 #include "curvefs/test/client/mock_client_s3_cache_manager.h"
@@ -243,7 +245,7 @@ TEST_F(FileCacheManagerTest, test_read_s3) {
     EXPECT_CALL(*mockChunkCacheManager_, ReadByReadCache(_, _, _, _, _))
         .WillOnce(DoAll(SetArgPointee<4>(requests), Return()))
         .WillOnce(DoAll(SetArgPointee<4>(requests), Return()));
-    EXPECT_CALL(*mockChunkCacheManager_, AddReadDataCache(_))
+    EXPECT_CALL(*mockChunkCacheManager_, AddReadDataCache(_, _))
         .WillOnce(Return());
     fileCacheManager_->SetChunkCacheManagerForTest(0, mockChunkCacheManager_);
     Inode inode;
@@ -272,6 +274,174 @@ TEST_F(FileCacheManagerTest, test_read_s3) {
     ASSERT_EQ(-1, fileCacheManager_->Read(inodeId, offset, len, buf.data()));
 }
 
+TEST_F(FileCacheManagerTest, test_update_read_ahead) {
+    S3ClientAdaptorOption option;
+    option.blockSize = 1024;
+    option.chunkSize = 4096;
+    option.pageSize = 64;
+    option.maxReadAheadBlocks = 4;
+    option.intervalSec = 5000;
+    option.flushIntervalSec = 5000;
+    option.chunkFlushThreads = 1;
+    option.diskCacheOpt.diskCacheType = (DiskCacheType)0;
+    S3ClientAdaptorImpl s3ClientAdaptor;
+    s3ClientAdaptor.Init(option, nullptr, nullptr, nullptr, nullptr, nullptr,
+                         nullptr);
+    FileCacheManager fileCacheManager(2, 1, &s3ClientAdaptor, nullptr,
+                                      threadPool_);
+
+    // the first sequential read opens a window of one block
+    uint64_t readAheadOffset = 0;
+    ASSERT_EQ(1536, fileCacheManager.UpdateReadAhead(0, 512,
+                                                     &readAheadOffset));
+    ASSERT_EQ(512, readAheadOffset);
+
+    // enough data read ahead
+    ASSERT_EQ(0, fileCacheManager.UpdateReadAhead(512, 256,
+                                                  &readAheadOffset));
+
+    // the window doubles once the reader gets close to its end
+    ASSERT_EQ(2048, fileCacheManager.UpdateReadAhead(768, 768,
+                                                     &readAheadOffset));
+    ASSERT_EQ(2048, readAheadOffset);
+    ASSERT_EQ(3072, fileCacheManager.UpdateReadAhead(1536, 1536,
+                                                     &readAheadOffset));
+    ASSERT_EQ(4096, readAheadOffset);
+
+    // a random read closes the window
+    ASSERT_EQ(0, fileCacheManager.UpdateReadAhead(65536, 512,
+                                                  &readAheadOffset));
+    ASSERT_EQ(1024, fileCacheManager.UpdateReadAhead(66048, 512,
+                                                     &readAheadOffset));
+    ASSERT_EQ(66560, readAheadOffset);
+
+    // disabled
+    ASSERT_EQ(0, fileCacheManager_->UpdateReadAhead(0, 512,
+                                                    &readAheadOffset));
+}
+
+TEST_F(FileCacheManagerTest, test_read_ahead) {
+    const uint64_t inodeId = 3;
+    const uint64_t fileLen = 4096;
+    S3ClientAdaptorOption option;
+    option.blockSize = 1024;
+    option.chunkSize = 4096;
+    option.pageSize = 64;
+    option.maxReadAheadBlocks = 4;
+    // read ahead in the reading thread
+    option.readAheadThreads = 0;
+    option.intervalSec = 5000;
+    option.flushIntervalSec = 5000;
+    option.chunkFlushThreads = 1;
+    option.readCacheMaxByte = 104857600;
+    option.writeCacheMaxByte = 104857600;
+    option.nearfullRatio = 70;
+    option.diskCacheOpt.diskCacheType = (DiskCacheType)0;
+    S3ClientAdaptorImpl s3ClientAdaptor;
+    auto fsCacheManager = std::make_shared<FsCacheManager>(
+        &s3ClientAdaptor, option.readCacheMaxByte, option.writeCacheMaxByte,
+        1, nullptr);
+    s3ClientAdaptor.Init(option, mockS3Client_, mockInodeManager_, nullptr,
+                         fsCacheManager, nullptr, nullptr);
+    auto fileCacheManager =
+        fsCacheManager->FindOrCreateFileCacheManager(2, inodeId);
+
+    Inode inode;
+    inode.set_length(fileLen);
+    S3ChunkInfoList s3ChunkInfoList;
+    auto *s3ChunkInfo = s3ChunkInfoList.add_s3chunks();
+    s3ChunkInfo->set_chunkid(25);
+    s3ChunkInfo->set_compaction(0);
+    s3ChunkInfo->set_offset(0);
+    s3ChunkInfo->set_len(fileLen);
+    s3ChunkInfo->set_size(fileLen);
+    s3ChunkInfo->set_zero(false);
+    inode.mutable_s3chunkinfomap()->insert({0, s3ChunkInfoList});
+    auto inodeWrapper = std::make_shared<InodeWrapper>(inode, nullptr);
+    EXPECT_CALL(*mockInodeManager_, GetInode(_, _))
+        .WillRepeatedly(
+            DoAll(SetArgReferee<1>(inodeWrapper), Return(CURVEFS_ERROR::OK)));
+
+    // the third get reads the second block ahead, a write to the block
+    // meanwhile makes the data read ahead stale
+    int downloads = 0;
+    const std::vector<char> writeBuf(16, 'b');
+    EXPECT_CALL(*mockS3Client_, Download(_, _, _, _))
+        .Times(7)
+        .WillRepeatedly(Invoke([&](const std::string &, char *buf, uint64_t,
+                                   uint64_t len) {
+            if (++downloads == 3) {
+                fileCacheManager->Write(1024, writeBuf.size(),
+                                        writeBuf.data());
+            }
+            memset(buf, 'a', len);
+            return static_cast<int>(len);
+        }));
+
+    // [512, 2048) read ahead and dropped
+    std::vector<char> buf(fileLen);
+    ASSERT_EQ(512, fileCacheManager->Read(inodeId, 0, 512, buf.data()));
+    ASSERT_EQ(3, downloads);
+    ASSERT_EQ(512, fileCacheManager->Read(inodeId, 512, 512, buf.data()));
+    ASSERT_EQ(4, downloads);
+    ASSERT_EQ(std::vector<char>(512, 'a'),
+              std::vector<char>(buf.begin(), buf.begin() + 512));
+
+    // [2048, 4096) read ahead into the memory read cache
+    ASSERT_EQ(1024, fileCacheManager->Read(inodeId, 1024, 1024, buf.data()));
+    ASSERT_EQ(7, downloads);
+    ASSERT_EQ(writeBuf, std::vector<char>(buf.begin(), buf.begin() + 16));
+    ASSERT_EQ(2048, fileCacheManager->Read(inodeId, 2048, 2048, buf.data()));
+    ASSERT_EQ(7, downloads);
+    ASSERT_EQ(std::vector<char>(2048, 'a'),
+              std::vector<char>(buf.begin(), buf.begin() + 2048));
+}
+
+TEST_F(FileCacheManagerTest, test_merge_s3_read_requests) {
+    const uint64_t blockSize = 1024;
+    S3ReadRequest req{.chunkId = 1, .offset = 100, .len = 100,
+                      .objectOffset = 50, .readOffset = 0, .fsId = 2,
+                      .inodeId = 1, .compaction = 0};
+    std::vector<S3ReadRequest> requests;
+    // adjacent ranges of the same object
+    requests.push_back(req);
+    req.offset = 200;
+    req.readOffset = 100;
+    requests.push_back(req);
+    // goes on into the next block
+    req.offset = 300;
+    req.len = 824;
+    req.readOffset = 200;
+    requests.push_back(req);
+    req.offset = 1124;
+    req.len = 100;
+    req.objectOffset = 0;
+    req.readOffset = 1024;
+    requests.push_back(req);
+    // another object
+    req.offset = 1224;
+    req.chunkId = 2;
+    req.readOffset = 1124;
+    requests.push_back(req);
+    // not adjacent
+    req.offset = 1400;
+    req.readOffset = 1300;
+    requests.push_back(req);
+
+    std::reverse(requests.begin(), requests.end());
+    MergeS3ReadRequests(blockSize, &requests);
+    ASSERT_EQ(3, requests.size());
+    ASSERT_EQ(1, requests[0].chunkId);
+    ASSERT_EQ(100, requests[0].offset);
+    ASSERT_EQ(1124, requests[0].len);
+    ASSERT_EQ(50, requests[0].objectOffset);
+    ASSERT_EQ(0, requests[0].readOffset);
+    ASSERT_EQ(2, requests[1].chunkId);
+    ASSERT_EQ(1224, requests[1].offset);
+    ASSERT_EQ(100, requests[1].len);
+    ASSERT_EQ(1400, requests[2].offset);
+}
+
 }  // namespace client
 }  // namespace curvefs
 
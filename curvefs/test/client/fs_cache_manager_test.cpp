@@ -23,6 +23,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <vector>
+
 #include "curvefs/src/client/s3/client_s3_adaptor.h"
 #include "curvefs/src/client/s3/client_s3_cache_manager.h"
 #include "src/common/concurrent/count_down_event.h"
@@ -158,6 +160,184 @@ TEST_F(FsCacheManagerTest, test_lru_set_and_delete) {
     }
 }
 
+TEST_F(FsCacheManagerTest, test_lru_hit_get_another_chance) {
+    uint64_t smallDataCacheByte = 128ull * 1024;  // 128KiB
+    char *buf = new char[smallDataCacheByte];
+    std::list<DataCachePtr>::iterator outIter;
+    std::list<DataCachePtr>::iterator oldestIter;
+    std::list<DataCachePtr>::iterator secondIter;
+
+    for (size_t i = 0; i < maxReadCacheByte_ / smallDataCacheByte; ++i) {
+        fsCacheManager_->Set(std::make_shared<DataCache>(
+                                 s3ClientAdaptor_, mockChunkCacheManager_,
+                                 i * smallDataCacheByte, smallDataCacheByte,
+                                 buf, nullptr),
+                             &outIter);
+        if (i == 0) {
+            oldestIter = outIter;
+        } else if (i == 1) {
+            secondIter = outIter;
+        }
+    }
+
+    // the oldest one is hit, the next one is evicted instead
+    fsCacheManager_->Get(oldestIter);
+    curve::common::CountDownEvent counter(1);
+    EXPECT_CALL(*mockChunkCacheManager_, ReleaseReadDataCache(_))
+        .WillOnce(Invoke([&counter](uint64_t key) {
+            ASSERT_EQ(128ull * 1024, key);
+            counter.Signal();
+        }));
+    DataCachePtr oldest = *oldestIter;
+    DataCachePtr second = *secondIter;
+    fsCacheManager_->Set(std::make_shared<DataCache>(
+                             s3ClientAdaptor_, mockChunkCacheManager_,
+                             maxReadCacheByte_, smallDataCacheByte, buf,
+                             nullptr),
+                         &outIter);
+    counter.Wait();
+    ASSERT_TRUE(oldest->InReadCache());
+    ASSERT_FALSE(second->InReadCache());
+    ASSERT_EQ(maxReadCacheByte_, fsCacheManager_->GetLruByte());
+    delete[] buf;
+}
+
+TEST_F(FsCacheManagerTest, test_lru_shards) {
+    const uint32_t shardNum = 4;
+    auto fsCacheManager = std::make_shared<FsCacheManager>(
+        s3ClientAdaptor_, maxReadCacheByte_, maxReadCacheByte_, 1, nullptr,
+        shardNum);
+    ASSERT_EQ(shardNum, fsCacheManager->GetLruShardNum());
+
+    uint64_t dataCacheByte = 1024ull * 1024;  // 1MiB
+    char *buf = new char[dataCacheByte];
+    std::vector<std::shared_ptr<MockChunkCacheManager>> chunkCacheManagers;
+    std::vector<DataCachePtr> dataCaches;
+    for (int i = 0; i < 8; ++i) {
+        auto chunkCacheManager = std::make_shared<MockChunkCacheManager>();
+        EXPECT_CALL(*chunkCacheManager, ReleaseReadDataCache(_))
+            .Times(::testing::AnyNumber());
+        chunkCacheManagers.push_back(chunkCacheManager);
+    }
+
+    // 32MiB in total, evicted down to the limit across the shards
+    std::list<DataCachePtr>::iterator outIter;
+    for (int i = 0; i < 32; ++i) {
+        auto dataCache = std::make_shared<DataCache>(
+            s3ClientAdaptor_, chunkCacheManagers[i % 8], 0, dataCacheByte, buf,
+            nullptr);
+        dataCaches.push_back(dataCache);
+        ASSERT_TRUE(fsCacheManager->Set(dataCache, &outIter));
+
+        uint64_t total = 0;
+        for (uint32_t shard = 0; shard < shardNum; ++shard) {
+            total += fsCacheManager->GetLruShardByte(shard);
+        }
+        ASSERT_EQ(total, fsCacheManager->GetLruByte());
+        ASSERT_LE(fsCacheManager->GetLruByte(),
+                  maxReadCacheByte_ + dataCacheByte);
+    }
+
+    // the bytes of the shards are the data caches still in the cache
+    uint64_t inCache = 0;
+    for (auto &dataCache : dataCaches) {
+        inCache += dataCache->InReadCache() ? dataCacheByte : 0;
+    }
+    ASSERT_EQ(inCache, fsCacheManager->GetLruByte());
+    delete[] buf;
+}
+
+TEST_F(FsCacheManagerTest, test_lru_tinylfu_admission) {
+    auto fsCacheManager = std::make_shared<FsCacheManager>(
+        s3ClientAdaptor_, maxReadCacheByte_, maxReadCacheByte_, 1, nullptr);
+    fsCacheManager->SetReadCacheAdmission(NewCacheAdmission("tinylfu", 16));
+
+    uint64_t dataCacheByte = 1024ull * 1024;  // 1MiB
+    char *buf = new char[dataCacheByte];
+    auto newDataCache = [&](uint64_t inodeId, int reads) {
+        for (int i = 0; i < reads; ++i) {
+            fsCacheManager->RecordReadCacheAccess(inodeId, 0, 0,
+                                                  dataCacheByte);
+        }
+        auto chunkCacheManager = std::make_shared<ChunkCacheManager>(
+            0, s3ClientAdaptor_, nullptr, inodeId);
+        return std::make_shared<DataCache>(s3ClientAdaptor_, chunkCacheManager,
+                                           0, dataCacheByte, buf, nullptr);
+    };
+
+    // fill the cache with the files read twice
+    std::list<DataCachePtr>::iterator outIter;
+    std::vector<DataCachePtr> hot;
+    for (uint64_t inodeId = 1; inodeId <= 16; ++inodeId) {
+        hot.push_back(newDataCache(inodeId, 2));
+        ASSERT_TRUE(fsCacheManager->Set(hot.back(), &outIter));
+    }
+    ASSERT_EQ(maxReadCacheByte_, fsCacheManager->GetLruByte());
+
+    // a scan reading each file once doesn't evict them
+    for (uint64_t inodeId = 100; inodeId < 132; ++inodeId) {
+        auto dataCache = newDataCache(inodeId, 1);
+        ASSERT_FALSE(fsCacheManager->Set(dataCache, &outIter));
+        ASSERT_FALSE(dataCache->InReadCache());
+    }
+    for (auto &dataCache : hot) {
+        ASSERT_TRUE(dataCache->InReadCache());
+    }
+
+    // a file read more often than the tail gets in
+    auto dataCache = newDataCache(200, 3);
+    ASSERT_TRUE(fsCacheManager->Set(dataCache, &outIter));
+    ASSERT_TRUE(dataCache->InReadCache());
+    ASSERT_FALSE(hot.front()->InReadCache());
+    ASSERT_EQ(maxReadCacheByte_, fsCacheManager->GetLruByte());
+    delete[] buf;
+}
+
+TEST_F(FsCacheManagerTest, test_lru_tinylfu_admission_victim) {
+    auto fsCacheManager = std::make_shared<FsCacheManager>(
+        s3ClientAdaptor_, maxReadCacheByte_, maxReadCacheByte_, 1, nullptr);
+    fsCacheManager->SetReadCacheAdmission(NewCacheAdmission("tinylfu", 16));
+
+    uint64_t dataCacheByte = 1024ull * 1024;  // 1MiB
+    char *buf = new char[dataCacheByte];
+    auto newDataCache = [&](uint64_t inodeId, int reads) {
+        for (int i = 0; i < reads; ++i) {
+            fsCacheManager->RecordReadCacheAccess(inodeId, 0, 0,
+                                                  dataCacheByte);
+        }
+        auto chunkCacheManager = std::make_shared<ChunkCacheManager>(
+            0, s3ClientAdaptor_, nullptr, inodeId);
+        return std::make_shared<DataCache>(s3ClientAdaptor_, chunkCacheManager,
+                                           0, dataCacheByte, buf, nullptr);
+    };
+
+    // the tail is read often and hit since it got in
+    std::list<DataCachePtr>::iterator outIter;
+    std::vector<DataCachePtr> hot;
+    hot.push_back(newDataCache(1, 6));
+    ASSERT_TRUE(fsCacheManager->Set(hot.back(), &outIter));
+    fsCacheManager->Get(outIter);
+    for (uint64_t inodeId = 2; inodeId <= 16; ++inodeId) {
+        hot.push_back(newDataCache(inodeId, 2));
+        ASSERT_TRUE(fsCacheManager->Set(hot.back(), &outIter));
+    }
+
+    // compared with the data cache evicted instead of the tail
+    auto dataCache = newDataCache(100, 4);
+    ASSERT_TRUE(fsCacheManager->Set(dataCache, &outIter));
+    ASSERT_TRUE(dataCache->InReadCache());
+    ASSERT_TRUE(hot[0]->InReadCache());
+    ASSERT_FALSE(hot[1]->InReadCache());
+
+    // the flushed data never read gets in without the admission
+    dataCache = newDataCache(200, 0);
+    ASSERT_FALSE(fsCacheManager->Set(dataCache, &outIter));
+    ASSERT_TRUE(fsCacheManager->Set(dataCache, &outIter, false));
+    ASSERT_TRUE(dataCache->InReadCache());
+    ASSERT_EQ(maxReadCacheByte_, fsCacheManager->GetLruByte());
+    delete[] buf;
+}
+
 TEST_F(FsCacheManagerTest, test_fsSync_ok) {
     uint64_t inodeId = 1;
     auto fileCache = std::make_shared<MockFileCacheManager>();
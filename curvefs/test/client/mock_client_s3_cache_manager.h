@@ -77,7 +77,8 @@ class MockChunkCacheManager : public ChunkCacheManager {
                                        char *dataBuf, uint64_t dataBufOffset,
                                        std::vector<ReadRequest> *requests));
     MOCK_METHOD0(ReleaseCache, void());
-    MOCK_METHOD1(AddReadDataCache, void(DataCachePtr dataCache));
+    MOCK_METHOD2(AddReadDataCache,
+                 void(DataCachePtr dataCache, bool admission));
 };
 
 class MockDataCache : public DataCache {
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "curvefs/src/client/s3/page_allocator.h"
+
+namespace curvefs {
+namespace client {
+
+const uint64_t kPageSize = 4096;
+
+TEST(PageAllocatorTest, AllocateAndFree) {
+    PageAllocator allocator(kPageSize, 4, 2);
+    ASSERT_EQ(0, allocator.GetAllocatedBytes());
+    ASSERT_EQ(0, allocator.GetUsedBytes());
+
+    char *page = allocator.Allocate();
+    ASSERT_NE(nullptr, page);
+    ASSERT_EQ(4 * kPageSize, allocator.GetAllocatedBytes());
+    ASSERT_EQ(kPageSize, allocator.GetUsedBytes());
+    for (uint64_t i = 0; i < kPageSize; i++) {
+        ASSERT_EQ(0, page[i]);
+    }
+
+    // freed pages are zero filled when allocated again
+    memset(page, 'a', kPageSize);
+    allocator.Free(page);
+    ASSERT_EQ(0, allocator.GetUsedBytes());
+    char *again = allocator.Allocate();
+    ASSERT_EQ(page, again);
+    for (uint64_t i = 0; i < kPageSize; i++) {
+        ASSERT_EQ(0, again[i]);
+    }
+    allocator.Free(again);
+    ASSERT_EQ(4 * kPageSize, allocator.GetAllocatedBytes());
+}
+
+TEST(PageAllocatorTest, ReuseSlabs) {
+    PageAllocator allocator(kPageSize, 4, 2);
+    std::vector<char *> pages;
+    for (int i = 0; i < 10; i++) {
+        pages.push_back(allocator.Allocate());
+    }
+    ASSERT_EQ(12 * kPageSize, allocator.GetAllocatedBytes());
+    ASSERT_EQ(10 * kPageSize, allocator.GetUsedBytes());
+
+    for (char *page : pages) {
+        allocator.Free(page);
+    }
+    ASSERT_EQ(0, allocator.GetUsedBytes());
+
+    // no new slab until all the freed pages are used again
+    pages.clear();
+    for (int i = 0; i < 12; i++) {
+        pages.push_back(allocator.Allocate());
+    }
+    ASSERT_EQ(12 * kPageSize, allocator.GetAllocatedBytes());
+    for (char *page : pages) {
+        allocator.Free(page);
+    }
+}
+
+TEST(PageAllocatorTest, FreeByOtherThreads) {
+    PageAllocator allocator(kPageSize, 8, 4);
+    const int kThreadNum = 4;
+    const int kPagePerThread = 16;
+
+    for (int round = 0; round < 10; round++) {
+        std::vector<std::vector<char *>> pages(kThreadNum);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < kThreadNum; i++) {
+            threads.emplace_back([&, i]() {
+                for (int j = 0; j < kPagePerThread; j++) {
+                    char *page = allocator.Allocate();
+                    memset(page, i, kPageSize);
+                    pages[i].push_back(page);
+                }
+            });
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+        threads.clear();
+
+        // pages are freed by a thread other than the one allocating them
+        for (int i = 0; i < kThreadNum; i++) {
+            threads.emplace_back([&, i]() {
+                for (char *page : pages[(i + 1) % kThreadNum]) {
+                    allocator.Free(page);
+                }
+            });
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+    }
+
+    ASSERT_EQ(0, allocator.GetUsedBytes());
+    // the pages cached by the threads are bounded, the memory doesn't grow
+    // with the rounds
+    ASSERT_LE(allocator.GetAllocatedBytes(),
+              (kThreadNum * kPagePerThread + 8 * kThreadNum * 2) * kPageSize);
+}
+
+}  // namespace client
+}  // namespace curvefs
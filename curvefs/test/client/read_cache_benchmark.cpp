@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "curvefs/src/client/s3/client_s3_adaptor.h"
+#include "curvefs/src/client/s3/client_s3_cache_manager.h"
+#include "src/common/timeutility.h"
+
+DEFINE_uint32(shards, 32, "shards of the read cache lru");
+DEFINE_uint64(readsPerThread, 1000000, "reads of each thread");
+DEFINE_uint32(chunksPerThread, 16, "file chunks read by each thread");
+DEFINE_uint32(cachedReadsPerChunk, 64, "cached reads of each file chunk");
+DEFINE_uint32(readSize, 4096, "size of each read");
+DEFINE_uint32(missPercent, 1,
+              "percent of the reads that miss and add a new data cache");
+
+using curve::common::TimeUtility;
+using curvefs::client::ChunkCacheManager;
+using curvefs::client::DataCache;
+using curvefs::client::FsCacheManager;
+using curvefs::client::ReadRequest;
+using curvefs::client::S3ClientAdaptorImpl;
+using curvefs::client::S3ClientAdaptorOption;
+
+namespace {
+
+const uint64_t kChunkSize = 4ull * 1024 * 1024;
+const uint64_t kBlockSize = 1024ull * 1024;
+const uint64_t kPageSize = 4096;
+
+// reads per second of the threads reading the read cache, each thread reads
+// its own file chunks like the fuse workers reading small files
+double Measure(int threadNum, uint32_t shards) {
+    S3ClientAdaptorOption option;
+    option.blockSize = kBlockSize;
+    option.chunkSize = kChunkSize;
+    option.pageSize = kPageSize;
+    option.baseSleepUs = 500;
+    option.objectPrefix = 0;
+    option.intervalSec = 5000;
+    option.flushIntervalSec = 5000;
+    option.writeCacheMaxByte = 8ull * 1024 * 1024;
+    option.readCacheMaxByte = 1024ull * 1024 * 1024;
+    option.readCacheThreads = 1;
+    option.diskCacheOpt.diskCacheType =
+        curvefs::client::DiskCacheType::Disable;
+    option.chunkFlushThreads = 1;
+
+    S3ClientAdaptorImpl *s3ClientAdaptor = new S3ClientAdaptorImpl();
+    auto fsCacheManager = std::make_shared<FsCacheManager>(
+        s3ClientAdaptor, option.readCacheMaxByte, option.writeCacheMaxByte,
+        option.readCacheThreads, nullptr, shards);
+    s3ClientAdaptor->Init(option, nullptr, nullptr, nullptr, fsCacheManager,
+                          nullptr, nullptr);
+
+    const uint64_t readsPerChunk =
+        std::min<uint64_t>(FLAGS_cachedReadsPerChunk,
+                           kChunkSize / FLAGS_readSize);
+    std::vector<char> data(FLAGS_readSize, 'a');
+    std::vector<std::vector<std::shared_ptr<ChunkCacheManager>>> chunks(
+        threadNum);
+    for (int i = 0; i < threadNum; ++i) {
+        for (uint32_t j = 0; j < FLAGS_chunksPerThread; ++j) {
+            auto chunk = std::make_shared<ChunkCacheManager>(
+                j, s3ClientAdaptor, nullptr);
+            for (uint64_t k = 0; k < readsPerChunk; ++k) {
+                chunk->AddReadDataCache(std::make_shared<DataCache>(
+                    s3ClientAdaptor, chunk, k * FLAGS_readSize,
+                    FLAGS_readSize, data.data(), nullptr));
+            }
+            chunks[i].push_back(chunk);
+        }
+    }
+
+    const uint64_t start = TimeUtility::GetTimeofDayUs();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadNum; ++i) {
+        threads.emplace_back([&, i]() {
+            std::mt19937 gen(i);
+            std::vector<char> buf(FLAGS_readSize);
+            std::vector<ReadRequest> misses;
+            for (uint64_t n = 0; n < FLAGS_readsPerThread; ++n) {
+                auto &chunk = chunks[i][gen() % chunks[i].size()];
+                uint64_t pos = gen() % readsPerChunk * FLAGS_readSize;
+                if (gen() % 100 < FLAGS_missPercent) {
+                    // like the data read from s3 going into the read cache
+                    WriteLockGuard writeLockGuard(chunk->rwLockChunk_);
+                    chunk->AddReadDataCache(std::make_shared<DataCache>(
+                        s3ClientAdaptor, chunk, pos, FLAGS_readSize,
+                        buf.data(), nullptr));
+                    continue;
+                }
+
+                misses.clear();
+                chunk->ReadChunk(chunk->GetIndex(), pos, FLAGS_readSize,
+                                 buf.data(), 0, &misses);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    const uint64_t cost = TimeUtility::GetTimeofDayUs() - start;
+
+    // the data caches are freed with the lru lists
+    chunks.clear();
+    fsCacheManager.reset();
+    delete s3ClientAdaptor;
+
+    return static_cast<double>(FLAGS_readsPerThread) * threadNum * 1000000 /
+           cost;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+
+    for (int threadNum : {1, 2, 4, 8, 16, 32, 64}) {
+        double oneShard = Measure(threadNum, 1);
+        double sharded = Measure(threadNum, FLAGS_shards);
+        std::cout << "threads: " << threadNum
+                  << ", 1 shard: " << oneShard << " reads/s"
+                  << ", " << FLAGS_shards << " shards: " << sharded
+                  << " reads/s" << std::endl;
+    }
+    return 0;
+}
@@ -25,9 +25,15 @@
 #include <glog/logging.h>
 #include <brpc/closure_guard.h>
 #include <brpc/controller.h>
+#include <brpc/details/controller_private_accessor.h>
+#include <brpc/stream.h>
+#include <butil/sys_byteorder.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <cerrno>
+#include <string>
 #include <vector>
 
 #include "src/chunkserver/copyset_node.h"
@@ -44,6 +50,169 @@ namespace chunkserver {
 
 using ::curve::common::is_aligned;
 
+namespace {
+
+/**
+ * BatchChunk的上下文，每个子请求有自己的controller和response。客户端创建了
+ * stream的时候，每个子请求完成之后就通过stream单独返回结果；否则所有子请求
+ * 返回之后，把结果和读到的数据按照请求的顺序放到rpc的response中
+ */
+class BatchChunkContext {
+ public:
+    BatchChunkContext(brpc::Controller *cntl,
+                      const BatchChunkRequest *request,
+                      BatchChunkResponse *response,
+                      Closure *done,
+                      brpc::StreamId streamId)
+        : cntl_(cntl),
+          request_(request),
+          response_(response),
+          done_(done),
+          streamId_(streamId),
+          streamReady_(false),
+          subCntls_(new brpc::Controller[request->requests_size()]),
+          subResponses_(new ChunkResponse[request->requests_size()]),
+          // the extra one is released after all sub requests are dispatched
+          pending_(request->requests_size() + 1) {
+        if (streamId_ != brpc::INVALID_STREAM_ID) {
+            // the rpc returns before the sub requests, keep them here
+            requests_.CopyFrom(*request);
+            request_ = &requests_;
+        }
+        for (int i = 0; i < request->requests_size(); ++i) {
+            brpc::ControllerPrivateAccessor(&subCntls_[i])
+                .set_remote_side(cntl->remote_side());
+        }
+    }
+
+    const ChunkRequest &SubRequest(int index) const {
+        return request_->requests(index);
+    }
+
+    brpc::Controller *SubCntl(int index) {
+        return &subCntls_[index];
+    }
+
+    ChunkResponse *SubResponse(int index) {
+        return &subResponses_[index];
+    }
+
+    void OnSubRequestDone(int index) {
+        if (streamId_ != brpc::INVALID_STREAM_ID) {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (streamReady_) {
+                SendSubResponse(index);
+            } else {
+                doneIndexes_.push_back(index);
+            }
+        }
+        Release();
+    }
+
+    /**
+     * 所有子请求都下发之后调用，stream在rpc返回之后才建立，之前完成的子请求
+     * 在这里返回
+     */
+    void OnDispatched() {
+        if (streamId_ != brpc::INVALID_STREAM_ID) {
+            std::lock_guard<std::mutex> lk(mtx_);
+            streamReady_ = true;
+            for (int index : doneIndexes_) {
+                SendSubResponse(index);
+            }
+            doneIndexes_.clear();
+        }
+        Release();
+    }
+
+ private:
+    bool IsReadSuccess(int index) const {
+        return SubRequest(index).optype() == CHUNK_OP_TYPE::CHUNK_OP_READ &&
+               subResponses_[index].status() ==
+                   CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS;
+    }
+
+    void SendSubResponse(int index) {
+        BatchChunkSubResponse subResponse;
+        subResponse.set_index(index);
+        subResponse.mutable_response()->Swap(&subResponses_[index]);
+
+        butil::IOBuf msg;
+        const uint32_t metaSize = butil::HostToNet32(subResponse.ByteSize());
+        msg.append(&metaSize, sizeof(uint32_t));
+        butil::IOBufAsZeroCopyOutputStream wrapper(&msg);
+        if (!subResponse.SerializeToZeroCopyStream(&wrapper)) {
+            LOG(ERROR) << "Fail to serialize batch chunk sub response";
+            return;
+        }
+        if (SubRequest(index).optype() == CHUNK_OP_TYPE::CHUNK_OP_READ &&
+            subResponse.response().status() ==
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            msg.append(subCntls_[index].response_attachment());
+        }
+
+        // the client fails the request when the stream is closed without it
+        int rc = brpc::StreamWrite(streamId_, msg);
+        LOG_IF(WARNING, rc != 0) << "Fail to write batch chunk sub response"
+                                 << ", stream id: " << streamId_
+                                 << ", index: " << index << ", rc: " << rc;
+    }
+
+    void Release() {
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+
+        if (streamId_ != brpc::INVALID_STREAM_ID) {
+            brpc::StreamClose(streamId_);
+        } else {
+            for (int i = 0; i < request_->requests_size(); ++i) {
+                if (IsReadSuccess(i)) {
+                    cntl_->response_attachment().append(
+                        subCntls_[i].response_attachment());
+                }
+                response_->add_responses()->Swap(&subResponses_[i]);
+            }
+            done_->Run();
+        }
+        delete this;
+    }
+
+ private:
+    brpc::Controller *cntl_;
+    const BatchChunkRequest *request_;
+    BatchChunkResponse *response_;
+    Closure *done_;
+    brpc::StreamId streamId_;
+    // the sub requests if the rpc returns before them
+    BatchChunkRequest requests_;
+    // protect streamReady_ and doneIndexes_
+    std::mutex mtx_;
+    bool streamReady_;
+    // the sub requests done before the stream is ready
+    std::vector<int> doneIndexes_;
+    std::unique_ptr<brpc::Controller[]> subCntls_;
+    std::unique_ptr<ChunkResponse[]> subResponses_;
+    std::atomic<int> pending_;
+};
+
+class BatchChunkSubClosure : public Closure {
+ public:
+    BatchChunkSubClosure(BatchChunkContext *ctx, int index)
+        : ctx_(ctx), index_(index) {}
+
+    void Run() override {
+        std::unique_ptr<BatchChunkSubClosure> selfGuard(this);
+        ctx_->OnSubRequestDone(index_);
+    }
+
+ private:
+    BatchChunkContext *ctx_;
+    int index_;
+};
+
+}  // namespace
+
 ChunkServiceImpl::ChunkServiceImpl(
         const ChunkServiceOptions& chunkServiceOptions,
         const std::shared_ptr<EpochMap>& epochMap)
@@ -577,6 +746,82 @@ void ChunkServiceImpl::UpdateEpoch(RpcController *controller,
     }
 }
 
+void ChunkServiceImpl::BatchChunk(RpcController *controller,
+                                  const BatchChunkRequest *request,
+                                  BatchChunkResponse *response,
+                                  Closure *done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller *cntl = dynamic_cast<brpc::Controller *>(controller);
+
+    // 只支持读写，写请求的数据长度之和要和attachment的长度一致
+    bool valid = true;
+    uint64_t writeBytes = 0;
+    for (const ChunkRequest &subRequest : request->requests()) {
+        if (subRequest.optype() == CHUNK_OP_TYPE::CHUNK_OP_WRITE) {
+            writeBytes += subRequest.size();
+        } else if (subRequest.optype() != CHUNK_OP_TYPE::CHUNK_OP_READ) {
+            valid = false;
+        }
+    }
+    if (writeBytes != cntl->request_attachment().size()) {
+        valid = false;
+    }
+
+    if (!valid) {
+        for (int i = 0; i < request->requests_size(); ++i) {
+            response->add_responses()->set_status(
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST);
+        }
+        LOG(ERROR) << "invalid batch chunk request, request count: "
+                   << request->requests_size()
+                   << ", write bytes: " << writeBytes
+                   << ", attachment size: "
+                   << cntl->request_attachment().size();
+        return;
+    }
+    if (request->requests_size() == 0) {
+        return;
+    }
+
+    brpc::StreamId streamId = brpc::INVALID_STREAM_ID;
+    if (cntl->has_remote_stream()) {
+        brpc::StreamOptions streamOptions;
+        streamOptions.max_buf_size = 0;  // unlimited buffer size
+        if (brpc::StreamAccept(&streamId, *cntl, &streamOptions) != 0) {
+            LOG(ERROR) << "Fail to accept batch chunk stream";
+            cntl->SetFailed("Fail to accept stream");
+            return;
+        }
+    }
+
+    bool streaming = streamId != brpc::INVALID_STREAM_ID;
+    BatchChunkContext *ctx = new (std::nothrow) BatchChunkContext(
+        cntl, request, response, streaming ? nullptr : doneGuard.release(),
+        streamId);
+    CHECK(nullptr != ctx) << "new batch chunk context failed";
+
+    for (int i = 0; i < request->requests_size(); ++i) {
+        const ChunkRequest &subRequest = ctx->SubRequest(i);
+        brpc::Controller *subCntl = ctx->SubCntl(i);
+        Closure *subDone = new (std::nothrow) BatchChunkSubClosure(ctx, i);
+        CHECK(nullptr != subDone) << "new batch chunk sub closure failed";
+
+        if (subRequest.optype() == CHUNK_OP_TYPE::CHUNK_OP_WRITE) {
+            cntl->request_attachment().cutn(&subCntl->request_attachment(),
+                                            subRequest.size());
+            WriteChunk(subCntl, &subRequest, ctx->SubResponse(i), subDone);
+        } else {
+            ReadChunk(subCntl, &subRequest, ctx->SubResponse(i), subDone);
+        }
+    }
+
+    if (streaming) {
+        // the stream is established after the rpc returns
+        doneGuard.release()->Run();
+    }
+    ctx->OnDispatched();
+}
+
 bool ChunkServiceImpl::CheckRequestOffsetAndLength(uint32_t offset,
                                                    uint32_t len) const {
     // 检查offset+len是否越界
@@ -98,6 +98,16 @@ class ChunkServiceImpl : public ChunkService {
                     UpdateEpochResponse *response,
                     Closure *done);
 
+    /**
+     * 批量读写，每个子请求按照ReadChunk/WriteChunk的逻辑分发给各自的
+     * copyset。客户端创建了stream的时候，每个子请求完成之后就通过stream
+     * 单独返回，否则所有子请求返回之后rpc才返回
+     */
+    void BatchChunk(RpcController *controller,
+                    const BatchChunkRequest *request,
+                    BatchChunkResponse *response,
+                    Closure *done);
+
  private:
     /**
      * 验证op request的offset和length是否越界和对齐
@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <glog/logging.h>
+#include <string.h>
+
+#include <utility>
+
+#include "src/chunkserver/chunk_write_batch.h"
+
+namespace curve {
+namespace chunkserver {
+
+const uint32_t ChunkWriteBatch::kMaxWriteBytes;
+
+ChunkWriteBatch::ChunkWriteBatch() : pendingNum_(0) {}
+
+ChunkWriteBatch::~ChunkWriteBatch() {
+    if (!writes_.empty()) {
+        Flush();
+    }
+}
+
+ChunkWriteBatch* ChunkWriteBatch::Current() {
+    if (!ApplyBatch::Enabled()) {
+        return nullptr;
+    }
+    static thread_local ChunkWriteBatch batch;
+    return &batch;
+}
+
+bool ChunkWriteBatch::CanMerge(const MergedWrite& write,
+                               const std::shared_ptr<CSDataStore>& datastore,
+                               ChunkID id,
+                               SequenceNum sn,
+                               const std::string& cloneSourceLocation,
+                               off_t offset,
+                               size_t length) {
+    return write.datastore == datastore &&
+           write.chunkId == id &&
+           write.sn == sn &&
+           write.cloneSourceLocation == cloneSourceLocation &&
+           write.offset + static_cast<off_t>(write.data.size()) == offset &&
+           write.data.size() + length <= kMaxWriteBytes;
+}
+
+bool ChunkWriteBatch::CanDefer(const MergedWrite& write) {
+    // WriteChunk sets the clone bitmap, bumps the chunk version and copies
+    // the old data to the snapshot before the deferred data is written,
+    // so only plain writes to the current version of a chunk are deferred
+    if (!write.cloneSourceLocation.empty()) {
+        return false;
+    }
+    CSChunkInfo info;
+    CSErrorCode ret = write.datastore->GetChunkInfo(write.chunkId, &info);
+    if (ret != CSErrorCode::Success) {
+        return false;
+    }
+    return !info.isClone && info.snapSn == 0 && info.curSn == write.sn;
+}
+
+void ChunkWriteBatch::Add(std::shared_ptr<CSDataStore> datastore,
+                          ChunkID id,
+                          SequenceNum sn,
+                          const std::string& cloneSourceLocation,
+                          const butil::IOBuf& data,
+                          off_t offset,
+                          size_t length,
+                          Callback done) {
+    if (writes_.empty()) {
+        ApplyBatch::Register(this);
+    }
+    // only merge with the last write, so the writes are applied in order
+    if (writes_.empty() || !CanMerge(writes_.back(), datastore, id, sn,
+                                     cloneSourceLocation, offset, length)) {
+        writes_.emplace_back();
+        MergedWrite& write = writes_.back();
+        write.datastore = std::move(datastore);
+        write.chunkId = id;
+        write.sn = sn;
+        write.cloneSourceLocation = cloneSourceLocation;
+        write.offset = offset;
+    }
+    MergedWrite& write = writes_.back();
+    // only references the blocks of the data
+    data.append_to(&write.data, length);
+    write.callbacks.emplace_back(std::move(done));
+    ++pendingNum_;
+}
+
+void ChunkWriteBatch::Flush() {
+    if (writes_.empty()) {
+        return;
+    }
+
+    std::vector<MergedWrite> writes;
+    writes.swap(writes_);
+    pendingNum_ = 0;
+
+    // the data of all writes on the same filesystem are submitted together
+    // when the batch of the filesystem is flushed
+    std::vector<CSErrorCode> rets(writes.size());
+    std::shared_ptr<LocalFileSystem> lfs;
+    size_t batchBegin = 0;
+    auto flushBatch = [&](size_t batchEnd) {
+        if (lfs == nullptr) {
+            return;
+        }
+        int rc = lfs->FlushBatch();
+        if (rc == 0) {
+            return;
+        }
+        LOG(ERROR) << "Flush " << batchEnd - batchBegin
+                   << " chunk writes failed: " << strerror(-rc);
+        for (size_t i = batchBegin; i < batchEnd; ++i) {
+            if (rets[i] == CSErrorCode::Success) {
+                rets[i] = CSErrorCode::InternalError;
+            }
+        }
+    };
+
+    for (size_t i = 0; i < writes.size(); ++i) {
+        MergedWrite& write = writes[i];
+        // a write that can't be deferred ends the batch before it
+        std::shared_ptr<LocalFileSystem> writeFs;
+        if (CanDefer(write)) {
+            writeFs = write.datastore->GetLocalFileSystem();
+        }
+        if (writeFs != lfs) {
+            flushBatch(i);
+            lfs = writeFs;
+            batchBegin = i;
+            if (lfs != nullptr) {
+                lfs->BeginBatch();
+            }
+        }
+
+        uint32_t cost;
+        rets[i] = write.datastore->WriteChunk(write.chunkId,
+                                              write.sn,
+                                              write.data,
+                                              write.offset,
+                                              write.data.size(),
+                                              &cost,
+                                              write.cloneSourceLocation);
+        VLOG(9) << "Apply " << write.callbacks.size() << " writes of chunk "
+                << write.chunkId << ", offset: " << write.offset
+                << ", length: " << write.data.size()
+                << ", ret: " << rets[i];
+    }
+    flushBatch(writes.size());
+
+    // the callbacks may add writes to the batch again
+    for (size_t i = 0; i < writes.size(); ++i) {
+        for (auto& done : writes[i].callbacks) {
+            done(rets[i]);
+        }
+    }
+}
+
+}  // namespace chunkserver
+}  // namespace curve
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CHUNKSERVER_CHUNK_WRITE_BATCH_H_
+#define SRC_CHUNKSERVER_CHUNK_WRITE_BATCH_H_
+
+#include <butil/iobuf.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/chunkserver/concurrent_apply/concurrent_apply.h"
+#include "src/chunkserver/datastore/chunkserver_datastore.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::chunkserver::concurrent::ApplyBatch;
+
+/**
+ * Writes applied by a write thread of the concurrent apply module in one
+ * batch. Consecutive writes to contiguous ranges of the same chunk with the
+ * same version are merged into one WriteChunk of the datastore, their data
+ * are chained in one IOBuf without copying, so the merged write is still
+ * done by one vectored write of the chunk file. The merged writes of all
+ * chunks are applied at Flush, the local filesystem may defer their data
+ * and submit them together, the callbacks of the merged writes are run
+ * with the shared result after the data is written. Writes that update
+ * the clone bitmap, the chunk version or the snapshot are applied out of
+ * the filesystem batch, since these updates must follow the data.
+ */
+class ChunkWriteBatch : public ApplyBatch {
+ public:
+    using Callback = std::function<void(CSErrorCode)>;
+
+    // writes are not merged beyond this size
+    static const uint32_t kMaxWriteBytes = 1024 * 1024;
+
+    ChunkWriteBatch();
+    ~ChunkWriteBatch();
+
+    /**
+     * Current: get the batch of the current thread
+     * @return the batch, or nullptr if the current thread doesn't apply
+     *         tasks in batch
+     */
+    static ChunkWriteBatch* Current();
+
+    /**
+     * Add: add a write to the batch, it is merged into the last pending
+     *      write if possible
+     * @param datastore: datastore of the chunk
+     * @param id: chunk id
+     * @param sn: sequence num of the write
+     * @param cloneSourceLocation: clone source of the chunk
+     * @param data: data to write, only the first length bytes are written
+     * @param offset: offset of the write in the chunk
+     * @param length: length of the write
+     * @param done: called with the result after the write is applied
+     */
+    void Add(std::shared_ptr<CSDataStore> datastore,
+             ChunkID id,
+             SequenceNum sn,
+             const std::string& cloneSourceLocation,
+             const butil::IOBuf& data,
+             off_t offset,
+             size_t length,
+             Callback done);
+
+    void Flush() override;
+
+    size_t PendingNum() const {
+        return pendingNum_;
+    }
+
+ private:
+    // writes merged into one WriteChunk
+    struct MergedWrite {
+        std::shared_ptr<CSDataStore> datastore;
+        ChunkID chunkId;
+        SequenceNum sn;
+        std::string cloneSourceLocation;
+        off_t offset;
+        butil::IOBuf data;
+        std::vector<Callback> callbacks;
+    };
+
+    static bool CanMerge(const MergedWrite& write,
+                         const std::shared_ptr<CSDataStore>& datastore,
+                         ChunkID id,
+                         SequenceNum sn,
+                         const std::string& cloneSourceLocation,
+                         off_t offset,
+                         size_t length);
+
+    // whether the data of write may be deferred to the filesystem batch
+    static bool CanDefer(const MergedWrite& write);
+
+ private:
+    std::vector<MergedWrite> writes_;
+    size_t pendingNum_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_CHUNK_WRITE_BATCH_H_
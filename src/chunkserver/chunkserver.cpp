@@ -49,7 +49,9 @@ using ::curve::fs::LocalFileSystem;
 using ::curve::fs::LocalFileSystemOption;
 using ::curve::fs::LocalFsFactory;
 using ::curve::fs::FileSystemType;
+using ::curve::fs::IOEngineType;
 using ::curve::chunkserver::concurrent::ConcurrentApplyModule;
+using ::curve::chunkserver::concurrent::ApplyQueueType;
 using ::curve::common::UriParser;
 
 DEFINE_string(conf, "ChunkServer.conf", "Path of configuration file");
@@ -124,35 +126,46 @@ int ChunkServer::Run(int argc, char** argv) {
         << "Failed to initialize concurrentapply module!";
 
     // 初始化本地文件系统
-    std::shared_ptr<LocalFileSystem> fs(
-        LocalFsFactory::CreateFs(FileSystemType::EXT4, ""));
     LocalFileSystemOption lfsOption;
-    LOG_IF(FATAL, !conf.GetBoolValue(
-        "fs.enable_renameat2", &lfsOption.enableRenameat2));
+    IOEngineType ioEngine;
+    InitLocalFileSystemOptions(&conf, concurrentApplyOptions,
+                               &lfsOption, &ioEngine);
+    std::shared_ptr<LocalFileSystem> fs(
+        LocalFsFactory::CreateFs(FileSystemType::EXT4, "", ioEngine));
     LOG_IF(FATAL, 0 != fs->Init(lfsOption))
         << "Failed to initialize local filesystem module!";
 
     // 初始化chunk文件池
     FilePoolOptions chunkFilePoolOptions;
     InitChunkFilePoolOptions(&conf, &chunkFilePoolOptions);
-    std::shared_ptr<FilePool> chunkfilePool =
-            std::make_shared<FilePool>(fs);
-
-    LOG_IF(FATAL, false == chunkfilePool->Initialize(chunkFilePoolOptions))
-        << "Failed to init chunk file pool";
 
-    // Init Wal file pool
     std::string raftLogUri;
     LOG_IF(FATAL, !conf.GetStringValue("copyset.raft_log_uri", &raftLogUri));
     std::string raftLogProtocol = UriParser::GetProtocolFromUri(raftLogUri);
-    std::shared_ptr<FilePool> walFilePool = nullptr;
     bool useChunkFilePoolAsWalPool = true;
-    uint32_t useChunkFilePoolAsWalPoolReserve = 15;
     if (raftLogProtocol == kProtocalCurve) {
         LOG_IF(FATAL, !conf.GetBoolValue(
             "walfilepool.use_chunk_file_pool",
             &useChunkFilePoolAsWalPool));
+    }
+    // wal的segment需要已经写过的extent，不能用ZERO_RANGE清理出的chunk
+    if (raftLogProtocol == kProtocalCurve && useChunkFilePoolAsWalPool &&
+        chunkFilePoolOptions.cleanByZeroRange) {
+        LOG(WARNING) << "chunkfilepool.clean.by_zero_range is ignored since"
+                     << " the chunk file pool is used as the wal pool";
+        chunkFilePoolOptions.cleanByZeroRange = false;
+    }
+
+    std::shared_ptr<FilePool> chunkfilePool =
+            std::make_shared<FilePool>(fs);
 
+    LOG_IF(FATAL, false == chunkfilePool->Initialize(chunkFilePoolOptions))
+        << "Failed to init chunk file pool";
+
+    // Init Wal file pool
+    std::shared_ptr<FilePool> walFilePool = nullptr;
+    uint32_t useChunkFilePoolAsWalPoolReserve = 15;
+    if (raftLogProtocol == kProtocalCurve) {
         if (!useChunkFilePoolAsWalPool) {
             FilePoolOptions walFilePoolOptions;
             InitWalFilePoolOptions(&conf, &walFilePoolOptions);
@@ -167,6 +180,7 @@ int ChunkServer::Run(int argc, char** argv) {
             &useChunkFilePoolAsWalPoolReserve));
             LOG(INFO) << "initialize to use chunkfilePool as walpool success.";
         }
+        InitWalGroupCommitOptions(&conf);
     }
 
     // 远端拷贝管理模块选项
@@ -518,6 +532,16 @@ void ChunkServer::InitChunkFilePoolOptions(
             &chunkFilePoolOptions->bytesPerWrite));
         LOG_IF(FATAL, !conf->GetUInt32Value("chunkfilepool.clean.throttle_iops",
             &chunkFilePoolOptions->iops4clean));
+        LOG_IF(FATAL, !conf->GetUInt32Value("chunkfilepool.clean.thread_num",
+            &chunkFilePoolOptions->cleanThreadNum));
+        LOG_IF(FATAL, !conf->GetBoolValue("chunkfilepool.clean.by_zero_range",
+            &chunkFilePoolOptions->cleanByZeroRange));
+        LOG_IF(FATAL, !conf->GetUInt64Value(
+            "chunkfilepool.format.low_watermark",
+            &chunkFilePoolOptions->formatLowWatermark));
+        LOG_IF(FATAL, !conf->GetUInt64Value(
+            "chunkfilepool.format.high_watermark",
+            &chunkFilePoolOptions->formatHighWatermark));
 
         if (0 == chunkFilePoolOptions->bytesPerWrite
             || chunkFilePoolOptions->bytesPerWrite > 1 * 1024 * 1024
@@ -539,6 +563,49 @@ void ChunkServer::InitConcurrentApplyOptions(common::Configuration *conf,
         "rconcurrentapply.queuedepth", &concurrentApplyOptions->rqueuedepth));
     LOG_IF(FATAL, !conf->GetIntValue(
         "wconcurrentapply.queuedepth", &concurrentApplyOptions->wqueuedepth));
+
+    std::string queueType;
+    LOG_IF(FATAL, !conf->GetStringValue(
+        "concurrentapply.queue_type", &queueType));
+    if (queueType == "mutex") {
+        concurrentApplyOptions->queuetype = ApplyQueueType::MUTEX;
+    } else if (queueType == "lockfree") {
+        concurrentApplyOptions->queuetype = ApplyQueueType::LOCKFREE;
+    } else {
+        LOG(FATAL) << "Unknown concurrentapply.queue_type: " << queueType;
+    }
+
+    LOG_IF(FATAL, !conf->GetIntValue(
+        "wconcurrentapply.batchsize", &concurrentApplyOptions->wbatchsize));
+    LOG_IF(FATAL, !conf->GetBoolValue("rconcurrentapply.work_stealing",
+        &concurrentApplyOptions->rworkstealing));
+}
+
+void ChunkServer::InitLocalFileSystemOptions(common::Configuration *conf,
+        const ConcurrentApplyOption &concurrentApplyOption,
+        LocalFileSystemOption *lfsOption,
+        IOEngineType *ioEngine) {
+    LOG_IF(FATAL, !conf->GetBoolValue(
+        "fs.enable_renameat2", &lfsOption->enableRenameat2));
+
+    std::string engine;
+    LOG_IF(FATAL, !conf->GetStringValue("fs.io_engine", &engine));
+    if (engine == "psync") {
+        *ioEngine = IOEngineType::PSYNC;
+    } else if (engine == "io_uring") {
+        *ioEngine = IOEngineType::IO_URING;
+    } else {
+        LOG(FATAL) << "Unknown fs.io_engine: " << engine;
+    }
+
+    // as many rings as concurrent apply threads, so they seldom share one,
+    // other threads share the rings with them
+    lfsOption->ioUringRingNum = concurrentApplyOption.wconcurrentsize +
+                                concurrentApplyOption.rconcurrentsize;
+    LOG_IF(FATAL, !conf->GetUInt32Value("fs.io_uring.queue_depth",
+        &lfsOption->ioUringQueueDepth));
+    LOG_IF(FATAL, !conf->GetUInt32Value("fs.io_uring.fixed_file_num",
+        &lfsOption->ioUringFixedFileNum));
 }
 
 void ChunkServer::InitWalFilePoolOptions(
@@ -569,6 +636,27 @@ void ChunkServer::InitWalFilePoolOptions(
     }
 }
 
+void ChunkServer::InitWalGroupCommitOptions(common::Configuration *conf) {
+    // 命令行指定的参数优先
+    google::CommandLineFlagInfo info;
+    if (!GetCommandLineFlagInfo("walGroupCommit", &info) || info.is_default) {
+        LOG_IF(FATAL, !conf->GetBoolValue("wal.group_commit",
+            &FLAGS_walGroupCommit));
+    }
+    if (!GetCommandLineFlagInfo("walGroupCommitMaxDelayUs", &info) ||
+        info.is_default) {
+        LOG_IF(FATAL, !conf->GetUInt32Value("wal.group_commit_max_delay_us",
+            &FLAGS_walGroupCommitMaxDelayUs));
+    }
+    if (!GetCommandLineFlagInfo("walGroupCommitMaxBatch", &info) ||
+        info.is_default) {
+        LOG_IF(FATAL, !conf->GetUInt32Value("wal.group_commit_max_batch",
+            &FLAGS_walGroupCommitMaxBatch));
+    }
+    LOG_IF(WARNING, FLAGS_walGroupCommit && FLAGS_enableWalDirectWrite)
+        << "wal.group_commit doesn't take effect with enableWalDirectWrite";
+}
+
 void ChunkServer::InitCopysetNodeOptions(
     common::Configuration *conf, CopysetNodeOptions *copysetNodeOptions) {
     LOG_IF(FATAL, !conf->GetStringValue("global.ip", &copysetNodeOptions->ip));
@@ -627,6 +715,8 @@ void ChunkServer::InitCopysetNodeOptions(
         LOG_IF(FATAL, !conf->GetUInt32Value("copyset.sync_trigger_seconds",
                 &copysetNodeOptions->syncTriggerSeconds));
     }
+    LOG_IF(FATAL, !conf->GetBoolValue("copyset.enable_lazy_clone_metapage",
+        &copysetNodeOptions->enableLazyCloneMetaPage));
 }
 
 void ChunkServer::InitCopyerOptions(
@@ -64,9 +64,16 @@ class ChunkServer {
     void InitWalFilePoolOptions(common::Configuration *conf,
         FilePoolOptions *walPoolOption);
 
+    void InitWalGroupCommitOptions(common::Configuration *conf);
+
     void InitConcurrentApplyOptions(common::Configuration *conf,
         ConcurrentApplyOption *concurrentApplyOption);
 
+    void InitLocalFileSystemOptions(common::Configuration *conf,
+        const ConcurrentApplyOption &concurrentApplyOption,
+        curve::fs::LocalFileSystemOption *lfsOption,
+        curve::fs::IOEngineType *ioEngine);
+
     void InitCopysetNodeOptions(common::Configuration *conf,
         CopysetNodeOptions *copysetNodeOptions);
 
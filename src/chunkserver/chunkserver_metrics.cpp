@@ -282,6 +282,9 @@ int ChunkServerMetric::Fini() {
     ioMetrics_.Fini();
     leaderCount_ = nullptr;
     chunkLeft_ = nullptr;
+    chunkCleanLeft_ = nullptr;
+    chunkRefillRate_ = nullptr;
+    chunkRefilled_ = nullptr;
     walSegmentLeft_ = nullptr;
     chunkTrashed_ = nullptr;
     chunkCount_ = nullptr;
@@ -379,6 +382,15 @@ void ChunkServerMetric::MonitorChunkFilePool(FilePool *chunkFilePool) {
     std::string chunkLeftPrefix = Prefix() + "_chunkfilepool_left";
     chunkLeft_ = std::make_shared<bvar::PassiveStatus<uint32_t>>(
         chunkLeftPrefix, GetChunkLeftFunc, chunkFilePool);
+    chunkCleanLeft_ = std::make_shared<bvar::PassiveStatus<uint32_t>>(
+        Prefix() + "_chunkfilepool_clean_left", GetChunkCleanLeftFunc,
+        chunkFilePool);
+    chunkRefilled_ = std::make_shared<bvar::PassiveStatus<uint64_t>>(
+        Prefix() + "_chunkfilepool_refilled", GetChunkRefilledFunc,
+        chunkFilePool);
+    chunkRefillRate_ =
+        std::make_shared<bvar::PerSecond<bvar::PassiveStatus<uint64_t>>>(
+            Prefix() + "_chunkfilepool_refill_rate", chunkRefilled_.get());
 }
 
 void ChunkServerMetric::MonitorWalFilePool(FilePool *walFilePool) {
@@ -502,6 +502,18 @@ class ChunkServerMetric : public Uncopyable {
         return chunkLeft_->get_value();
     }
 
+    uint32_t GetChunkCleanLeftCount() const {
+        if (chunkCleanLeft_ == nullptr)
+            return 0;
+        return chunkCleanLeft_->get_value();
+    }
+
+    uint64_t GetChunkRefilledCount() const {
+        if (chunkRefilled_ == nullptr)
+            return 0;
+        return chunkRefilled_->get_value();
+    }
+
     uint32_t GetWalSegmentLeftCount() const {
         if (nullptr == walSegmentLeft_)
             return 0;
@@ -530,6 +542,12 @@ class ChunkServerMetric : public Uncopyable {
     AdderPtr<uint32_t> leaderCount_;
     // chunkfilepool  中剩余的 chunk 的数量
     PassiveStatusPtr<uint32_t> chunkLeft_;
+    // chunkfilepool 中剩余的已清零 chunk 的数量
+    PassiveStatusPtr<uint32_t> chunkCleanLeft_;
+    // chunkfilepool 后台清零和格式化补充的 chunk 总数及速率
+    PassiveStatusPtr<uint64_t> chunkRefilled_;
+    std::shared_ptr<bvar::PerSecond<bvar::PassiveStatus<uint64_t>>>
+        chunkRefillRate_;
     // walfilepool  中剩余的 wal segment 的数量
     PassiveStatusPtr<uint32_t> walSegmentLeft_;
     // trash 中的 chunk 的数量
@@ -23,6 +23,8 @@
 #include <glog/logging.h>
 
 #include <algorithm>
+#include <vector>
+
 #include "src/chunkserver/concurrent_apply/concurrent_apply.h"
 #include "src/common/concurrent/count_down_event.h"
 
@@ -31,6 +33,38 @@ using ::curve::common::CountDownEvent;
 namespace curve {
 namespace chunkserver {
 namespace concurrent {
+
+namespace {
+thread_local bool batchEnabled = false;
+thread_local std::vector<ApplyBatch*> pendingBatches;
+}  // namespace
+
+bool ApplyBatch::Enabled() {
+    return batchEnabled;
+}
+
+void ApplyBatch::SetEnabled(bool enabled) {
+    batchEnabled = enabled;
+}
+
+void ApplyBatch::Register(ApplyBatch* batch) {
+    if (std::find(pendingBatches.begin(), pendingBatches.end(), batch) ==
+        pendingBatches.end()) {
+        pendingBatches.push_back(batch);
+    }
+}
+
+void ApplyBatch::FlushAll() {
+    // a batch may register again while flushing
+    while (!pendingBatches.empty()) {
+        std::vector<ApplyBatch*> batches;
+        batches.swap(pendingBatches);
+        for (auto batch : batches) {
+            batch->Flush();
+        }
+    }
+}
+
 bool ConcurrentApplyModule::Init(const ConcurrentApplyOption &opt) {
     if (start_) {
         LOG(WARNING) << "concurrent module already start!";
@@ -71,6 +105,9 @@ bool ConcurrentApplyModule::checkOptAndInit(
     wqueuedepth_ = opt.wqueuedepth;
     rconcurrentsize_ = opt.rconcurrentsize;
     rqueuedepth_ = opt.rqueuedepth;
+    queuetype_ = opt.queuetype;
+    wbatchsize_ = opt.wbatchsize;
+    rworkstealing_ = opt.rworkstealing;
 
     return true;
 }
@@ -78,8 +115,14 @@ bool ConcurrentApplyModule::checkOptAndInit(
 
 void ConcurrentApplyModule::InitThreadPool(
     ThreadPoolType type, int concurrent, int depth) {
+    if (type == ThreadPoolType::READ && rworkstealing_) {
+        rstealtq_.reset(new GenericWorkStealingTaskQueue<
+            bthread::Mutex, bthread::ConditionVariable>(
+                concurrent, concurrent * depth));
+    }
+
     for (int i = 0; i < concurrent; i++) {
-        auto asyncth = new (std::nothrow) TaskThread(depth);
+        auto asyncth = new (std::nothrow) TaskThread(queuetype_, depth);
         CHECK(asyncth != nullptr) << "allocate failed!";
 
         switch (type) {
@@ -110,10 +153,18 @@ void ConcurrentApplyModule::InitThreadPool(
 
 void ConcurrentApplyModule::Run(ThreadPoolType type, int index) {
     cond_.Signal();
+    if (type == ThreadPoolType::WRITE && wbatchsize_ > 1) {
+        RunWriteBatch(index);
+        return;
+    }
     while (start_) {
         switch (type) {
         case ThreadPoolType::READ:
-            rapplyMap_[index]->tq.Pop()();
+            if (rstealtq_ != nullptr) {
+                rstealtq_->Pop(index)();
+            } else {
+                rapplyMap_[index]->tq.Pop()();
+            }
             break;
 
         case ThreadPoolType::WRITE:
@@ -123,16 +174,37 @@ void ConcurrentApplyModule::Run(ThreadPoolType type, int index) {
     }
 }
 
+void ConcurrentApplyModule::RunWriteBatch(int index) {
+    ApplyBatch::SetEnabled(true);
+    auto& tq = wapplyMap_[index]->tq;
+    ApplyTaskQueue::Task task;
+    while (start_) {
+        tq.Pop()();
+        // apply the tasks already queued before flushing the batches, but
+        // never wait for more
+        for (int i = 1; i < wbatchsize_ && tq.TryPop(&task); i++) {
+            task();
+        }
+        ApplyBatch::FlushAll();
+    }
+    ApplyBatch::SetEnabled(false);
+}
+
 void ConcurrentApplyModule::Stop() {
     LOG(INFO) << "stop ConcurrentApplyModule...";
     start_ = false;
     auto wakeup = []() {};
     for (auto iter : rapplyMap_) {
-        iter.second->tq.Push(wakeup);
+        if (rstealtq_ != nullptr) {
+            rstealtq_->Push(iter.first, false, wakeup);
+        } else {
+            iter.second->tq.Push(wakeup);
+        }
         iter.second->th.join();
         delete iter.second;
     }
     rapplyMap_.clear();
+    rstealtq_.reset();
 
     for (auto iter : wapplyMap_) {
         iter.second->tq.Push(wakeup);
@@ -147,6 +219,7 @@ void ConcurrentApplyModule::Stop() {
 void ConcurrentApplyModule::Flush() {
     CountDownEvent event(wconcurrentsize_);
     auto flushtask = [&event]() {
+        ApplyBatch::FlushAll();
         event.Signal();
     };
 
@@ -157,11 +230,15 @@ void ConcurrentApplyModule::Flush() {
     event.Wait();
 }
 
-ThreadPoolType ConcurrentApplyModule::Schedule(CHUNK_OP_TYPE optype) {
+ThreadPoolType ConcurrentApplyModule::Schedule(CHUNK_OP_TYPE optype) const {
     switch (optype) {
     case CHUNK_OP_READ:
     case CHUNK_OP_RECOVER:
         return ThreadPoolType::READ;
+    case CHUNK_OP_READ_SNAP:
+        // snapshot reads don't depend on the order of the other ops either,
+        // move them off the write threads if reads are balanced
+        return rworkstealing_ ? ThreadPoolType::READ : ThreadPoolType::WRITE;
     default:
         return ThreadPoolType::WRITE;
     }
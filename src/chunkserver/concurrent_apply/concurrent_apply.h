@@ -29,15 +29,20 @@
 
 #include <atomic>
 #include <condition_variable>  // NOLINT
+#include <functional>
+#include <memory>
 #include <mutex>               // NOLINT
 #include <thread>              // NOLINT
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "include/curve_compiler_specific.h"
 #include "proto/chunk.pb.h"
 #include "src/common/concurrent/count_down_event.h"
+#include "src/common/concurrent/mpsc_task_queue.h"
 #include "src/common/concurrent/task_queue.h"
+#include "src/common/concurrent/work_stealing_task_queue.h"
 
 using curve::common::CountDownEvent;
 using curve::chunkserver::CHUNK_OP_TYPE;
@@ -47,12 +52,69 @@ namespace chunkserver {
 namespace concurrent {
 
 using ::curve::common::GenericTaskQueue;
+using ::curve::common::GenericMpscTaskQueue;
+using ::curve::common::GenericWorkStealingTaskQueue;
+
+// MUTEX: mutex and condition variable protected queue
+// LOCKFREE: lock-free ring queue, consumer spins before parking
+enum class ApplyQueueType {MUTEX, LOCKFREE};
 
 struct ConcurrentApplyOption {
     int wconcurrentsize;
     int wqueuedepth;
     int rconcurrentsize;
     int rqueuedepth;
+    ApplyQueueType queuetype;
+    // max number of tasks a write thread applies in one batch,
+    // batching is disabled if it's not greater than 1
+    int wbatchsize;
+    // whether idle read threads steal reads queued to the others
+    bool rworkstealing;
+
+    ConcurrentApplyOption() : ConcurrentApplyOption(0, 0, 0, 0) {}
+    ConcurrentApplyOption(int wsize, int wdepth, int rsize, int rdepth,
+                          ApplyQueueType type = ApplyQueueType::MUTEX,
+                          int batchsize = 1, bool workstealing = false)
+        : wconcurrentsize(wsize), wqueuedepth(wdepth),
+          rconcurrentsize(rsize), rqueuedepth(rdepth), queuetype(type),
+          wbatchsize(batchsize), rworkstealing(workstealing) {}
+};
+
+/**
+ * Work deferred by the tasks of a write thread which applies tasks in batch,
+ * e.g. the writes of a chunk which can be merged into one. A batch registers
+ * itself when it has pending work, and the write thread flushes it after
+ * the tasks popped in one round, or before any task which isn't a write.
+ * All the methods must be called from the write thread.
+ */
+class ApplyBatch {
+ public:
+    virtual ~ApplyBatch() = default;
+
+    /**
+     * Flush: apply the pending work of the batch
+     */
+    virtual void Flush() = 0;
+
+    /**
+     * Enabled: whether the current thread applies tasks in batch
+     */
+    static bool Enabled();
+
+    /**
+     * Register: flush the batch with the others of the current thread
+     */
+    static void Register(ApplyBatch* batch);
+
+    /**
+     * FlushAll: flush all the registered batches of the current thread
+     */
+    static void FlushAll();
+
+ private:
+    friend class ConcurrentApplyModule;
+
+    static void SetEnabled(bool enabled);
 };
 
 enum class ThreadPoolType {READ, WRITE};
@@ -64,6 +126,9 @@ class CURVE_CACHELINE_ALIGNMENT ConcurrentApplyModule {
                              rqueuedepth_(0),
                              wconcurrentsize_(0),
                              wqueuedepth_(0),
+                             queuetype_(ApplyQueueType::MUTEX),
+                             wbatchsize_(1),
+                             rworkstealing_(false),
                              cond_(0) {}
 
     /**
@@ -86,12 +151,31 @@ class CURVE_CACHELINE_ALIGNMENT ConcurrentApplyModule {
     bool Push(uint64_t key, CHUNK_OP_TYPE optype, F&& f, Args&&... args) {
         switch (Schedule(optype)) {
             case ThreadPoolType::READ:
-                rapplyMap_[Hash(key, rconcurrentsize_)]->tq.Push(
-                        std::forward<F>(f), std::forward<Args>(args)...);
+                if (rstealtq_ != nullptr) {
+                    // only recovers of a chunk need to be kept in order
+                    rstealtq_->Push(Hash(key, rconcurrentsize_),
+                                    optype != CHUNK_OP_RECOVER,
+                                    std::forward<F>(f),
+                                    std::forward<Args>(args)...);
+                } else {
+                    rapplyMap_[Hash(key, rconcurrentsize_)]->tq.Push(
+                            std::forward<F>(f), std::forward<Args>(args)...);
+                }
                 break;
             case ThreadPoolType::WRITE:
-                wapplyMap_[Hash(key, wconcurrentsize_)]->tq.Push(
+                if (wbatchsize_ > 1 && optype != CHUNK_OP_WRITE) {
+                    // the pending writes must be applied before the others
+                    auto task = std::bind(std::forward<F>(f),
+                                          std::forward<Args>(args)...);
+                    wapplyMap_[Hash(key, wconcurrentsize_)]->tq.Push(
+                        [task]() mutable {
+                            ApplyBatch::FlushAll();
+                            task();
+                        });
+                } else {
+                    wapplyMap_[Hash(key, wconcurrentsize_)]->tq.Push(
                         std::forward<F>(f), std::forward<Args>(args)...);
+                }
                 break;
         }
 
@@ -105,12 +189,22 @@ class CURVE_CACHELINE_ALIGNMENT ConcurrentApplyModule {
 
     void Stop();
 
+    /**
+     * ReadStealNum: number of reads run by other read threads than the one
+     * hashed to, always 0 if work stealing is disabled
+     */
+    uint64_t ReadStealNum() const {
+        return rstealtq_ != nullptr ? rstealtq_->StealNum() : 0;
+    }
+
  private:
     bool checkOptAndInit(const ConcurrentApplyOption &option);
 
     void Run(ThreadPoolType type, int index);
 
-    static ThreadPoolType Schedule(CHUNK_OP_TYPE optype);
+    void RunWriteBatch(int index);
+
+    ThreadPoolType Schedule(CHUNK_OP_TYPE optype) const;
 
     void InitThreadPool(ThreadPoolType type, int concorrent, int depth);
 
@@ -119,10 +213,48 @@ class CURVE_CACHELINE_ALIGNMENT ConcurrentApplyModule {
     }
 
  private:
+    class ApplyTaskQueue {
+     public:
+        using Task = std::function<void()>;
+
+        ApplyTaskQueue(ApplyQueueType type, size_t capacity) {
+            if (type == ApplyQueueType::LOCKFREE) {
+                mpsc_.reset(new GenericMpscTaskQueue<
+                    bthread::Mutex, bthread::ConditionVariable>(capacity));
+            } else {
+                mutex_.reset(new GenericTaskQueue<
+                    bthread::Mutex, bthread::ConditionVariable>(capacity));
+            }
+        }
+
+        template <class F, class... Args>
+        void Push(F&& f, Args&&... args) {
+            if (mpsc_) {
+                mpsc_->Push(std::forward<F>(f), std::forward<Args>(args)...);
+            } else {
+                mutex_->Push(std::forward<F>(f), std::forward<Args>(args)...);
+            }
+        }
+
+        Task Pop() {
+            return mpsc_ ? mpsc_->Pop() : mutex_->Pop();
+        }
+
+        bool TryPop(Task* task) {
+            return mpsc_ ? mpsc_->TryPop(task) : mutex_->TryPop(task);
+        }
+
+     private:
+        std::unique_ptr<GenericTaskQueue<
+            bthread::Mutex, bthread::ConditionVariable>> mutex_;
+        std::unique_ptr<GenericMpscTaskQueue<
+            bthread::Mutex, bthread::ConditionVariable>> mpsc_;
+    };
+
     struct TaskThread {
         std::thread th;
-        GenericTaskQueue<bthread::Mutex, bthread::ConditionVariable> tq;
-        explicit TaskThread(size_t capacity) : tq(capacity) {}
+        ApplyTaskQueue tq;
+        TaskThread(ApplyQueueType type, size_t capacity) : tq(type, capacity) {}
     };
 
     bool start_;
@@ -130,6 +262,11 @@ class CURVE_CACHELINE_ALIGNMENT ConcurrentApplyModule {
     int rqueuedepth_;
     int wconcurrentsize_;
     int wqueuedepth_;
+    ApplyQueueType queuetype_;
+    int wbatchsize_;
+    bool rworkstealing_;
+    std::unique_ptr<GenericWorkStealingTaskQueue<
+        bthread::Mutex, bthread::ConditionVariable>> rstealtq_;
     CountDownEvent cond_;
     CURVE_CACHELINE_ALIGNMENT std::unordered_map<int, TaskThread*> wapplyMap_;
     CURVE_CACHELINE_ALIGNMENT std::unordered_map<int, TaskThread*> rapplyMap_;
@@ -135,6 +135,8 @@ struct CopysetNodeOptions {
     uint64_t syncThreshold = 64 * 1024;
     // check syncing interval
     uint32_t checkSyncingIntervalMs = 500u;
+    // write back the bitmap of clone chunk lazily at raft snapshot
+    bool enableLazyCloneMetaPage = false;
 
     CopysetNodeOptions();
 };
@@ -131,6 +131,7 @@ int CopysetNode::Init(const CopysetNodeOptions &options) {
     dsOptions.locationLimit = options.locationLimit;
     dsOptions.enableOdsyncWhenOpenChunkFile =
         options.enableOdsyncWhenOpenChunkFile;
+    dsOptions.enableLazyCloneMetaPage = options.enableLazyCloneMetaPage;
     dataStore_ = std::make_shared<CSDataStore>(options.localFileSystem,
                                                options.chunkFilePool,
                                                dsOptions);
@@ -348,6 +349,20 @@ void CopysetNode::save_snapshot_background(::braft::SnapshotWriter *writer,
         ForceSyncAllChunks();
     }
 
+    /**
+     * clone chunk的bitmap可能只更新在内存中，快照后日志会被删除，
+     * 所以要先把metapage写回磁盘
+     */
+    CSErrorCode errorCode = dataStore_->SyncMetaPages();
+    if (errorCode != CSErrorCode::Success) {
+        done->status().set_error(EIO, "sync metapages failed: %d",
+                                 static_cast<int>(errorCode));
+        LOG(ERROR) << "SyncMetaPages failed. "
+                   << "Copyset: " << GroupIdString()
+                   << ", error code: " << errorCode;
+        return;
+    }
+
     /**
      * 2.保存配置版本: conf.epoch，注意conf.epoch是存放在data目录下
      */
@@ -144,6 +144,8 @@ CSChunkFile::CSChunkFile(std::shared_ptr<LocalFileSystem> lfs,
       chunkId_(options.id),
       baseDir_(options.baseDir),
       isCloneChunk_(false),
+      lazyCloneMetaPage_(options.enableLazyCloneMetaPage),
+      metaPageDirty_(false),
       snapshot_(nullptr),
       chunkFilePool_(chunkFilePool),
       lfs_(lfs),
@@ -428,6 +430,10 @@ CSErrorCode CSChunkFile::Write(SequenceNum sn,
 
 CSErrorCode CSChunkFile::Sync() {
     WriteLockGuard writeGuard(rwLock_);
+    CSErrorCode errorCode = writeBackMetaPage();
+    if (errorCode != CSErrorCode::Success) {
+        return errorCode;
+    }
     int rc = SyncData();
     if (rc < 0) {
         LOG(ERROR) << "Sync data failed, "
@@ -437,6 +443,25 @@ CSErrorCode CSChunkFile::Sync() {
     return CSErrorCode::Success;
 }
 
+CSErrorCode CSChunkFile::SyncMetaPage() {
+    WriteLockGuard writeGuard(rwLock_);
+    if (!metaPageDirty_) {
+        return CSErrorCode::Success;
+    }
+    CSErrorCode errorCode = writeBackMetaPage();
+    if (errorCode != CSErrorCode::Success) {
+        return errorCode;
+    }
+    // The changes may not be replayed any more after raft snapshot,
+    // so the metapage must be on disk
+    if (!enableOdsyncWhenOpenChunkFile_ && SyncData() < 0) {
+        LOG(ERROR) << "Sync metapage failed, "
+                   << "ChunkID:" << chunkId_;
+        return CSErrorCode::InternalError;
+    }
+    return CSErrorCode::Success;
+}
+
 CSErrorCode CSChunkFile::Paste(const char * buf, off_t offset, size_t length) {
     WriteLockGuard writeGuard(rwLock_);
     if (!CheckOffsetAndLength(offset, length)) {
@@ -537,6 +562,12 @@ CSErrorCode CSChunkFile::Read(char * buf, off_t offset, size_t length) {
 
 CSErrorCode CSChunkFile::ReadMetaPage(char * buf) {
     ReadLockGuard readGuard(rwLock_);
+    // The metapage on disk is stale, return the one in memory
+    if (metaPageDirty_) {
+        memset(buf, 0, metaPageSize_);
+        metaPage_.encode(buf);
+        return CSErrorCode::Success;
+    }
     int rc = readMetaPage(buf);
     if (rc < 0) {
         LOG(ERROR) << "Read chunk meta page failed."
@@ -894,9 +925,26 @@ CSErrorCode CSChunkFile::updateMetaPage(ChunkFileMetaPage* metaPage) {
                    << ",chunk sn: " << metaPage_.sn;
         return CSErrorCode::InternalError;
     }
+    // The metapage persisted is always based on the one in memory,
+    // so the bitmap changes in memory are written too
+    metaPageDirty_ = false;
     return CSErrorCode::Success;
 }
 
+CSErrorCode CSChunkFile::writeBackMetaPage() {
+    if (!metaPageDirty_) {
+        return CSErrorCode::Success;
+    }
+    ChunkFileMetaPage tempMeta = metaPage_;
+    CSErrorCode errorCode = updateMetaPage(&tempMeta);
+    if (errorCode != CSErrorCode::Success) {
+        LOG(ERROR) << "Write back metapage failed."
+                   << "ChunkID: " << chunkId_
+                   << ",chunk sn: " << metaPage_.sn;
+    }
+    return errorCode;
+}
+
 CSErrorCode CSChunkFile::loadMetaPage() {
     std::unique_ptr<char[]> buf(new char[metaPageSize_]);
     memset(buf.get(), 0, metaPageSize_);
@@ -963,6 +1011,21 @@ CSErrorCode CSChunkFile::copy2Snapshot(off_t offset, size_t length) {
 }
 
 CSErrorCode CSChunkFile::flush() {
+    // The bits are set in memory only, if the chunkserver crashes before
+    // the metapage is written back, the writes will be applied again from
+    // raft log and set them again
+    if (lazyCloneMetaPage_ && isCloneChunk_ && !dirtyPages_.empty()) {
+        for (auto pageIndex : dirtyPages_) {
+            metaPage_.bitmap->Set(pageIndex);
+        }
+        dirtyPages_.clear();
+        metaPageDirty_ = true;
+        // The chunk will be converted to a normal chunk immediately below
+        if (metaPage_.bitmap->NextClearBit(0) != Bitmap::NO_POS) {
+            return CSErrorCode::Success;
+        }
+    }
+
     ChunkFileMetaPage tempMeta = metaPage_;
     bool needUpdateMeta = dirtyPages_.size() > 0;
     bool clearClone = false;
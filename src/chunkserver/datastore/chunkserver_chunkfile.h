@@ -112,6 +112,9 @@ struct ChunkOptions {
     PageSizeType    metaPageSize;
     // enable O_DSYNC When Open ChunkFile
     bool enableOdsyncWhenOpenChunkFile;
+    // Keep the bitmap changes of clone chunk in memory and write back the
+    // metapage lazily, the changes are replayed from raft log after crash
+    bool enableLazyCloneMetaPage;
     // datastore internal statistical metric
     std::shared_ptr<DataStoreMetric> metric;
 
@@ -123,6 +126,7 @@ struct ChunkOptions {
                    , chunkSize(0)
                    , blockSize(0)
                    , metaPageSize(0)
+                   , enableLazyCloneMetaPage(false)
                    , metric(nullptr) {}
 };
 
@@ -173,8 +177,22 @@ class CSChunkFile {
                       size_t length,
                       uint32_t* cost);
 
+    /**
+     * Sync the data of chunk file, the metapage not yet written back is
+     * written before sync
+     * @return: return error code
+     */
     CSErrorCode Sync();
 
+    /**
+     * Write back the metapage if the bitmap of the clone chunk has been
+     * changed only in memory, it's called before raft snapshot, after which
+     * the log of the changes may be truncated.
+     * Add write lock
+     * @return: return error code
+     */
+    CSErrorCode SyncMetaPage();
+
     /**
      * Write the copied data into Chunk
      * Only write areas that have not been written, and will not overwrite
@@ -314,8 +332,14 @@ class CSChunkFile {
      * Update the bitmap of the clone chunk
      * If all pages have been written, the clone chunk will be converted
      * to a normal chunk
+     * If lazy clone metapage is enabled, only the bitmap in memory is
+     * updated unless the chunk is converted
      */
     CSErrorCode flush();
+    /**
+     * Write the metapage in memory back to disk if it's dirty
+     */
+    CSErrorCode writeBackMetaPage();
 
     inline string path() {
         return baseDir_ + "/" +
@@ -422,6 +446,10 @@ class CSChunkFile {
     // has been written but has not yet been updated to the
     // page index in the metapage
     std::set<uint32_t> dirtyPages_;
+    // whether to write back the changed bitmap of clone chunk lazily
+    bool lazyCloneMetaPage_;
+    // the bitmap in memory has changes not written to the metapage on disk
+    bool metaPageDirty_;
     // read-write lock
     RWLock rwLock_;
     // Snapshot file pointer
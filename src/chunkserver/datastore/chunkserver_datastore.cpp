@@ -44,7 +44,8 @@ CSDataStore::CSDataStore(std::shared_ptr<LocalFileSystem> lfs,
       baseDir_(options.baseDir),
       chunkFilePool_(chunkFilePool),
       lfs_(lfs),
-      enableOdsyncWhenOpenChunkFile_(options.enableOdsyncWhenOpenChunkFile) {
+      enableOdsyncWhenOpenChunkFile_(options.enableOdsyncWhenOpenChunkFile),
+      enableLazyCloneMetaPage_(options.enableLazyCloneMetaPage) {
     CHECK(!baseDir_.empty()) << "Create datastore failed";
     CHECK(lfs_ != nullptr) << "Create datastore failed";
     CHECK(chunkFilePool_ != nullptr) << "Create datastore failed";
@@ -254,6 +255,7 @@ CSErrorCode CSDataStore::WriteChunk(ChunkID id,
         options.blockSize = blockSize_;
         options.metaPageSize = metaPageSize_;
         options.metric = metric_;
+        options.enableLazyCloneMetaPage = enableLazyCloneMetaPage_;
         options.enableOdsyncWhenOpenChunkFile = enableOdsyncWhenOpenChunkFile_;
         CSErrorCode errorCode = CreateChunkFile(options, &chunkFile);
         if (errorCode != CSErrorCode::Success) {
@@ -289,6 +291,22 @@ CSErrorCode CSDataStore::SyncChunk(ChunkID id) {
     return CSErrorCode::Success;
 }
 
+CSErrorCode CSDataStore::SyncMetaPages() {
+    if (!enableLazyCloneMetaPage_) {
+        return CSErrorCode::Success;
+    }
+    ChunkMap chunkMap = metaCache_.GetMap();
+    for (auto& item : chunkMap) {
+        CSErrorCode errorCode = item.second->SyncMetaPage();
+        if (errorCode != CSErrorCode::Success) {
+            LOG(WARNING) << "Sync chunk metapage failed."
+                         << "ChunkID = " << item.first;
+            return errorCode;
+        }
+    }
+    return CSErrorCode::Success;
+}
+
 CSErrorCode CSDataStore::CreateCloneChunk(ChunkID id,
                                           SequenceNum sn,
                                           SequenceNum correctedSn,
@@ -319,6 +337,7 @@ CSErrorCode CSDataStore::CreateCloneChunk(ChunkID id,
         options.blockSize = blockSize_;
         options.metaPageSize = metaPageSize_;
         options.metric = metric_;
+        options.enableLazyCloneMetaPage = enableLazyCloneMetaPage_;
         CSErrorCode errorCode = CreateChunkFile(options, &chunkFile);
         if (errorCode != CSErrorCode::Success) {
             return errorCode;
@@ -412,6 +431,7 @@ CSErrorCode CSDataStore::loadChunkFile(ChunkID id) {
         options.blockSize = blockSize_;
         options.metaPageSize = metaPageSize_;
         options.metric = metric_;
+        options.enableLazyCloneMetaPage = enableLazyCloneMetaPage_;
         CSChunkFilePtr chunkFilePtr =
             std::make_shared<CSChunkFile>(lfs_,
                                           chunkFilePool_,
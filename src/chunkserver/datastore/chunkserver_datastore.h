@@ -55,6 +55,7 @@ inline void TrivialDeleter(void* /*ptr*/) {}
  * chunkSize: The size of the chunk file or snapshot file in the DataStore
  * blockSize: the size of the smallest read-write unit
  * metaPageSize: meta page size for chunk
+ * enableLazyCloneMetaPage: write back the bitmap of clone chunk lazily
  */
 struct DataStoreOptions {
     std::string                         baseDir;
@@ -63,6 +64,7 @@ struct DataStoreOptions {
     PageSizeType                        metaPageSize;
     uint32_t                            locationLimit;
     bool                                enableOdsyncWhenOpenChunkFile;
+    bool                                enableLazyCloneMetaPage = false;
 };
 
 /**
@@ -257,6 +259,12 @@ class CSDataStore {
 
     virtual CSErrorCode SyncChunk(ChunkID id);
 
+    /**
+     * Write back the metapages of clone chunks whose bitmap changes are
+     * only in memory, must be called before raft snapshot
+     * @return: return error code
+     */
+    virtual CSErrorCode SyncMetaPages();
 
     // Deprecated, only use for unit & integration test
     virtual CSErrorCode WriteChunk(
@@ -328,6 +336,13 @@ class CSDataStore {
 
     virtual ChunkMap GetChunkMap();
 
+    /**
+     * Get the local filesystem where the chunk files are
+     */
+    virtual std::shared_ptr<LocalFileSystem> GetLocalFileSystem() {
+        return lfs_;
+    }
+
     void SetCacheCondPtr(std::shared_ptr<std::condition_variable> cond) {
         metaCache_.SetCondPtr(cond);
     }
@@ -362,6 +377,8 @@ class CSDataStore {
     DataStoreMetricPtr metric_;
     // enable O_DSYNC When Open ChunkFile
     bool enableOdsyncWhenOpenChunkFile_;
+    // write back the bitmap of clone chunk lazily
+    bool enableLazyCloneMetaPage_;
 };
 
 }  // namespace chunkserver
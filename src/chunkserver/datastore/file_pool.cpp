@@ -57,6 +57,9 @@ const uint32_t FilePoolHelper::kPersistSize = 4096;
 const std::string FilePool::kCleanChunkSuffix_ = ".clean";  // NOLINT
 const std::chrono::milliseconds FilePool::kSuccessSleepMsec_(10);
 const std::chrono::milliseconds FilePool::kFailSleepMsec_(500);
+const std::chrono::milliseconds FilePool::kFormatCheckMsec_(100);
+const std::chrono::milliseconds FilePool::kFormatMaxFailSleepMsec_(30000);
+const uint32_t FilePool::kFormatMaxRetryTimes_ = 10;
 
 using ::curve::common::kDefaultBlockSize;
 
@@ -222,6 +225,8 @@ FilePool::FilePool(std::shared_ptr<LocalFileSystem> fsptr)
 
 bool FilePool::Initialize(const FilePoolOptions &cfopt) {
     poolOpt_ = cfopt;
+    writeBuffer_.reset(new char[poolOpt_.bytesPerWrite]);
+    memset(writeBuffer_.get(), 0, poolOpt_.bytesPerWrite);
     if (poolOpt_.getFileFromPool) {
         if (!CheckValid()) {
             LOG(ERROR) << "check valid failed!";
@@ -295,28 +300,9 @@ bool FilePool::CleanChunk(uint64_t chunkid, bool onlyMarked) {
             LOG(ERROR) << "Fallocate file failed: " << chunkpath;
             return false;
         }
-    } else {
-        int nbytes;
-        uint64_t nwrite = 0;
-        uint64_t ntotal = chunklen;
-        uint32_t bytesPerWrite = poolOpt_.bytesPerWrite;
-        char *buffer = writeBuffer_.get();
-
-        while (nwrite < ntotal) {
-            nbytes = fsptr_->Write(
-                fd, buffer, nwrite,
-                std::min(ntotal - nwrite, (uint64_t)bytesPerWrite));
-            if (nbytes < 0) {
-                LOG(ERROR) << "Write file failed: " << chunkpath;
-                return false;
-            } else if (fsptr_->Fsync(fd) < 0) {
-                LOG(ERROR) << "Fsync file failed: " << chunkpath;
-                return false;
-            }
-
-            cleanThrottle_.Add(false, bytesPerWrite);
-            nwrite += nbytes;
-        }
+    } else if (!WriteZero(fd, true)) {
+        LOG(ERROR) << "Write zero to file failed: " << chunkpath;
+        return false;
     }
 
     std::string targetpath = chunkpath + kCleanChunkSuffix_;
@@ -357,14 +343,19 @@ bool FilePool::CleaningChunk() {
         return false;
     }
 
-    // Fill zero to specify chunk
-    if (!CleanChunk(chunkid, false)) {
+    // Fill zero to specify chunk, fallback to writing zeros if the file
+    // system doesn't support FALLOC_FL_ZERO_RANGE
+    bool cleaned = (poolOpt_.cleanByZeroRange && CleanChunk(chunkid, true)) ||
+                   CleanChunk(chunkid, false);
+    if (!cleaned) {
         pushBack(&dirtyChunks_, chunkid, &currentState_.dirtyChunksLeft);
         return false;
     }
 
     LOG(INFO) << "Clean chunk success, chunkid: " << chunkid;
     pushBack(&cleanChunks_, chunkid, &currentState_.cleanChunksLeft);
+    std::unique_lock<std::mutex> lk(mtx_);
+    currentState_.cleanedChunks++;
     return true;
 }
 
@@ -375,14 +366,128 @@ void FilePool::CleanWorker() {
     }
 }
 
+bool FilePool::WriteZero(int fd, bool syncEveryWrite) {
+    uint64_t nwrite = 0;
+    uint64_t ntotal = poolOpt_.fileSize + poolOpt_.metaPageSize;
+    uint32_t bytesPerWrite = poolOpt_.bytesPerWrite;
+    char *buffer = writeBuffer_.get();
+
+    while (nwrite < ntotal) {
+        int nbytes = fsptr_->Write(
+            fd, buffer, nwrite,
+            std::min(ntotal - nwrite, (uint64_t)bytesPerWrite));
+        if (nbytes < 0) {
+            return false;
+        } else if (syncEveryWrite && fsptr_->Fsync(fd) < 0) {
+            return false;
+        }
+
+        cleanThrottle_.Add(false, bytesPerWrite);
+        nwrite += nbytes;
+    }
+
+    return syncEveryWrite || fsptr_->Fsync(fd) == 0;
+}
+
+bool FilePool::FormatChunk() {
+    uint64_t chunklen = poolOpt_.fileSize + poolOpt_.metaPageSize;
+    // Take the number after the current largest one as RecycleFile() does
+    uint64_t chunkid = currentmaxfilenum_.fetch_add(1) + 1;
+    std::string chunkpath = currentdir_ + "/" + std::to_string(chunkid);
+
+    // The chunk is created with the name of a dirty chunk and has the full
+    // size since fallocate(), so a chunk left by a crash is just dirty
+    int fd = fsptr_->Open(chunkpath, O_RDWR | O_CREAT);
+    if (fd < 0) {
+        LOG(ERROR) << "Open file failed: " << chunkpath;
+        return false;
+    }
+
+    bool success = fsptr_->Fallocate(fd, 0, 0, chunklen) >= 0 &&
+                   WriteZero(fd, false);
+    fsptr_->Close(fd);
+    if (!success ||
+        fsptr_->Rename(chunkpath, chunkpath + kCleanChunkSuffix_) < 0) {
+        LOG(ERROR) << "Format chunk failed: " << chunkpath;
+        fsptr_->Delete(chunkpath);
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lk(mtx_);
+    cleanChunks_.push_back(chunkid);
+    currentState_.cleanChunksLeft++;
+    currentState_.preallocatedChunksLeft++;
+    currentState_.formattedChunks++;
+    return true;
+}
+
+void FilePool::FormatWorker() {
+    bool formatting = false;
+    // Set when formatting keeps failing, formatting will not be started
+    // again until the pool gets back to the low watermark
+    bool suspended = false;
+    uint32_t failTimes = 0;
+    auto sleepInterval = kFormatCheckMsec_;
+    while (cleanSleeper_.wait_for(sleepInterval)) {
+        size_t size = Size();
+        if (size < poolOpt_.formatLowWatermark) {
+            if (!formatting && !suspended) {
+                LOG(INFO) << "Start formatting chunk, pool size = " << size;
+                formatting = true;
+                failTimes = 0;
+            }
+        } else {
+            suspended = false;
+            if (formatting && size >= std::max(poolOpt_.formatHighWatermark,
+                                               poolOpt_.formatLowWatermark)) {
+                LOG(INFO) << "Stop formatting chunk, pool size = " << size;
+                formatting = false;
+            }
+        }
+
+        if (!formatting) {
+            sleepInterval = kFormatCheckMsec_;
+        } else if (FormatChunk()) {
+            failTimes = 0;
+            sleepInterval = std::chrono::milliseconds(0);
+        } else if (++failTimes >= kFormatMaxRetryTimes_) {
+            LOG(ERROR) << "Format chunk failed " << failTimes
+                       << " times, suspend formatting until the pool size"
+                       << " reaches the low watermark, pool size = " << size;
+            formatting = false;
+            suspended = true;
+            sleepInterval = kFormatCheckMsec_;
+        } else {
+            // Back off exponentially from kFailSleepMsec_
+            sleepInterval = std::min(kFailSleepMsec_ * (1 << (failTimes - 1)),
+                                     kFormatMaxFailSleepMsec_);
+        }
+    }
+}
+
 bool FilePool::StartCleaning() {
-    if (poolOpt_.needClean && !cleanAlived_.exchange(true)) {
+    bool needFormat = poolOpt_.getFileFromPool &&
+                      poolOpt_.formatLowWatermark > 0;
+    if ((poolOpt_.needClean || needFormat) && !cleanAlived_.exchange(true)) {
         ReadWriteThrottleParams params;
         params.iopsTotal = ThrottleParams(poolOpt_.iops4clean, 0, 0);
         cleanThrottle_.UpdateThrottleParams(params);
+        cleanSleeper_.init();
 
-        cleanThread_ = Thread(&FilePool::CleanWorker, this);
-        LOG(INFO) << "Start clean thread ok.";
+        if (poolOpt_.needClean) {
+            uint32_t threadNum = std::max(poolOpt_.cleanThreadNum, 1U);
+            for (uint32_t i = 0; i < threadNum; i++) {
+                cleanThreads_.emplace_back(&FilePool::CleanWorker, this);
+            }
+            LOG(INFO) << "Start " << threadNum << " clean threads ok.";
+        }
+
+        if (needFormat) {
+            formatThread_ = Thread(&FilePool::FormatWorker, this);
+            LOG(INFO) << "Start format thread ok, low watermark = "
+                      << poolOpt_.formatLowWatermark << ", high watermark = "
+                      << poolOpt_.formatHighWatermark;
+        }
     }
 
     return true;
@@ -392,8 +497,14 @@ bool FilePool::StopCleaning() {
     if (cleanAlived_.exchange(false)) {
         LOG(INFO) << "Stop cleaning...";
         cleanSleeper_.interrupt();
-        cleanThread_.join();
-        LOG(INFO) << "Stop clean thread ok.";
+        for (auto& thread : cleanThreads_) {
+            thread.join();
+        }
+        cleanThreads_.clear();
+        if (formatThread_.joinable()) {
+            formatThread_.join();
+        }
+        LOG(INFO) << "Stop clean threads ok.";
     }
 
     return true;
@@ -613,8 +724,7 @@ int FilePool::RecycleFile(const std::string &chunkpath) {
         std::string newfilename;
         {
             std::unique_lock<std::mutex> lk(mtx_);
-            currentmaxfilenum_.fetch_add(1);
-            newfilenum = currentmaxfilenum_.load();
+            newfilenum = currentmaxfilenum_.fetch_add(1) + 1;
             newfilename = std::to_string(newfilenum);
         }
         std::string targetpath = currentdir_ + "/" + newfilename;
@@ -64,6 +64,16 @@ struct FilePoolOptions {
     uint32_t    metaFileSize;
     // retry times for get file
     uint16_t    retryTimes;
+    // Number of threads for cleaning chunk
+    uint32_t    cleanThreadNum;
+    // Zero dirty chunks by fallocate(FALLOC_FL_ZERO_RANGE) instead of
+    // writing zeros, which is much faster but leaves unwritten extents,
+    // so it must not be set for the pool which provides wal segments
+    bool        cleanByZeroRange;
+    // Format new chunks in background when the pool has less chunks than
+    // the low watermark, until it has the high watermark, 0 to disable
+    uint64_t    formatLowWatermark;
+    uint64_t    formatHighWatermark;
 
     FilePoolOptions() {
         getFileFromPool = true;
@@ -74,6 +84,10 @@ struct FilePoolOptions {
         fileSize = 0;
         metaPageSize = 0;
         retryTimes = 5;
+        cleanThreadNum = 1;
+        cleanByZeroRange = false;
+        formatLowWatermark = 0;
+        formatHighWatermark = 0;
         blockSize = 0;
         ::memset(metaPath, 0, 256);
         ::memset(filePoolDir, 0, 256);
@@ -87,6 +101,10 @@ struct FilePoolState {
     uint64_t    cleanChunksLeft = 0;
     // How many pre-allocated chunks are not used by the datastore
     uint64_t    preallocatedChunksLeft = 0;
+    // How many dirty chunks have been cleaned in background
+    uint64_t    cleanedChunks = 0;
+    // How many chunks have been formatted in background
+    uint64_t    formattedChunks = 0;
 
     // chunksize
     uint32_t    chunkSize = 0;
@@ -226,13 +244,14 @@ class CURVE_CACHELINE_ALIGNMENT FilePool {
     }
 
     /**
-     * @brief: Start thread for cleaning chunk
+     * @brief: Start threads for cleaning chunk, and the thread for
+     *         formatting chunk if the watermarks are set
      * @return: Return true if success, otherwise return false
      */
     bool StartCleaning();
 
     /**
-     * @brief: Stop thread for cleaning chunk
+     * @brief: Stop threads for cleaning and formatting chunk
      * @return: Return true if success, otherwise return false
      */
     bool StopCleaning();
@@ -287,6 +306,27 @@ class CURVE_CACHELINE_ALIGNMENT FilePool {
      */
     void CleanWorker();
 
+    /**
+     * @brief: Write zeros to the whole chunk file
+     * @param fd: The fd of chunk file
+     * @param syncEveryWrite: Whether sync after every write
+     * @return: Return true if success, else return false
+     */
+    bool WriteZero(int fd, bool syncEveryWrite);
+
+    /**
+     * @brief: Create a new zeroed chunk and add it to the pool
+     * @return: Return true if success, else return false
+     */
+    bool FormatChunk();
+
+    /**
+     * @brief: The function of thread for formatting chunk, which formats
+     *         chunks when the pool is under the low watermark, and backs
+     *         off on failure until it gives up after kFormatMaxRetryTimes_
+     */
+    void FormatWorker();
+
  private:
     // The suffix of clean chunk file (".0")
     static const std::string kCleanChunkSuffix_;
@@ -297,6 +337,15 @@ class CURVE_CACHELINE_ALIGNMENT FilePool {
     // Sets a pause between cleaning when clean chunk fail
     static const std::chrono::milliseconds kFailSleepMsec_;
 
+    // Sets a pause between checking the watermark of pool
+    static const std::chrono::milliseconds kFormatCheckMsec_;
+
+    // The max pause between retrying when format chunk fail
+    static const std::chrono::milliseconds kFormatMaxFailSleepMsec_;
+
+    // Suspend formatting after format chunk fail these times in a row
+    static const uint32_t kFormatMaxRetryTimes_;
+
     // Protect dirtyChunks_, cleanChunks_
     std::mutex mtx_;
 
@@ -325,10 +374,13 @@ class CURVE_CACHELINE_ALIGNMENT FilePool {
     // Whether the clean thread is alive
     Atomic<bool> cleanAlived_;
 
-    // Thread for cleaning chunk
-    Thread cleanThread_;
+    // Threads for cleaning chunk
+    std::vector<Thread> cleanThreads_;
+
+    // Thread for formatting chunk
+    Thread formatThread_;
 
-    // The throttle iops for cleaning chunk (4KB/IO)
+    // The throttle iops for cleaning and formatting chunk (4KB/IO)
     Throttle cleanThrottle_;
 
     // Sleeper for cleaning chunk thread
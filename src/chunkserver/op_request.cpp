@@ -33,6 +33,7 @@
 
 #include "src/chunkserver/copyset_node.h"
 #include "src/chunkserver/chunk_closure.h"
+#include "src/chunkserver/chunk_write_batch.h"
 #include "src/chunkserver/clone_manager.h"
 #include "src/chunkserver/clone_task.h"
 
@@ -235,15 +236,29 @@ ReadChunkRequest::ReadChunkRequest(std::shared_ptr<CopysetNode> nodePtr,
     ChunkOpRequest(nodePtr, cntl, request, response, done),
     cloneMgr_(cloneMgr),
     concurrentApplyModule_(nodePtr->GetConcurrentApplyModule()),
-    applyIndex(0) {
+    applyIndex(0),
+    followerRead_(false) {
+}
+
+bool ReadChunkRequest::CanReadOnFollower() {
+    // the client's applied index covers all the writes it has seen acked,
+    // a follower which has applied it returns the same data as the leader
+    return request_->followerread() &&
+           request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_READ &&
+           request_->has_appliedindex() &&
+           !existCloneInfo(request_) &&
+           node_->GetAppliedIndex() >= request_->appliedindex();
 }
 
 void ReadChunkRequest::Process() {
     brpc::ClosureGuard doneGuard(done_);
 
     if (!node_->IsLeaderTerm()) {
-        RedirectChunkRequest();
-        return;
+        if (!CanReadOnFollower()) {
+            RedirectChunkRequest();
+            return;
+        }
+        followerRead_ = true;
     }
 
     /**
@@ -325,6 +340,11 @@ void ReadChunkRequest::OnApply(uint64_t index,
             break;
         }
         // 如果需要从源端拷贝数据，需要将请求转发给clone manager处理
+        // 拷贝数据需要写chunk，follower不处理，让client去读leader
+        if ((needLazyClone || NeedClone(chunkInfo)) && followerRead_) {
+            RedirectChunkRequest();
+            break;
+        }
         if ( needLazyClone || NeedClone(chunkInfo) ) {
             applyIndex = index;
             std::shared_ptr<CloneTask> cloneTask =
@@ -438,6 +458,26 @@ void WriteChunkRequest::OnApply(uint64_t index,
                             request_->clonefileoffset());
     }
 
+    // 批量apply时与同一chunk上连续的写合并，写入之后再返回
+    ChunkWriteBatch *batch = ChunkWriteBatch::Current();
+    if (nullptr != batch) {
+        auto self = std::static_pointer_cast<WriteChunkRequest>(
+            shared_from_this());
+        batch->Add(datastore_,
+                   request_->chunkid(),
+                   request_->sn(),
+                   cloneSourceLocation,
+                   cntl_->request_attachment(),
+                   request_->offset(),
+                   request_->size(),
+                   [self, index, done](CSErrorCode ret) {
+                       brpc::ClosureGuard doneGuard(done);
+                       self->OnWriteApplied(ret, index);
+                   });
+        doneGuard.release();
+        return;
+    }
+
     auto ret = datastore_->WriteChunk(request_->chunkid(),
                                       request_->sn(),
                                       cntl_->request_attachment(),
@@ -445,7 +485,10 @@ void WriteChunkRequest::OnApply(uint64_t index,
                                       request_->size(),
                                       &cost,
                                       cloneSourceLocation);
+    OnWriteApplied(ret, index);
+}
 
+void WriteChunkRequest::OnWriteApplied(CSErrorCode ret, uint64_t index) {
     if (CSErrorCode::Success == ret) {
         response_->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
         node_->UpdateAppliedIndex(index);
@@ -492,6 +535,21 @@ void WriteChunkRequest::OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
                             request.clonefileoffset());
     }
 
+    ChunkWriteBatch *batch = ChunkWriteBatch::Current();
+    if (nullptr != batch) {
+        batch->Add(datastore,
+                   request.chunkid(),
+                   request.sn(),
+                   cloneSourceLocation,
+                   data,
+                   request.offset(),
+                   request.size(),
+                   [request](CSErrorCode ret) {
+                       OnWriteAppliedFromLog(ret, request);
+                   });
+        return;
+    }
+
     auto ret = datastore->WriteChunk(request.chunkid(),
                                      request.sn(),
                                      data,
@@ -499,9 +557,14 @@ void WriteChunkRequest::OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
                                      request.size(),
                                      &cost,
                                      cloneSourceLocation);
-     if (CSErrorCode::Success == ret) {
-         return;
-     } else if (CSErrorCode::BackwardRequestError == ret) {
+    OnWriteAppliedFromLog(ret, request);
+}
+
+void WriteChunkRequest::OnWriteAppliedFromLog(CSErrorCode ret,
+                                              const ChunkRequest &request) {
+    if (CSErrorCode::Success == ret) {
+        return;
+    } else if (CSErrorCode::BackwardRequestError == ret) {
         LOG(WARNING) << "write failed: "
                      << " data store return: " << ret
                      << ", request: " << request.ShortDebugString();
@@ -234,6 +234,8 @@ class ReadChunkRequest : public ChunkOpRequest {
     bool NeedClone(const CSChunkInfo& chunkInfo);
     // 从chunk文件中读数据
     void ReadChunk();
+    // follower是否可以处理这个读请求
+    bool CanReadOnFollower();
 
  private:
     CloneManager* cloneMgr_;
@@ -241,6 +243,8 @@ class ReadChunkRequest : public ChunkOpRequest {
     ConcurrentApplyModule* concurrentApplyModule_;
     // 保存 apply index
     uint64_t applyIndex;
+    // 是否由follower处理
+    bool followerRead_;
 };
 
 class WriteChunkRequest : public ChunkOpRequest {
@@ -263,6 +267,22 @@ class WriteChunkRequest : public ChunkOpRequest {
     void OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
                         const ChunkRequest &request,
                         const butil::IOBuf &data) override;
+
+ private:
+    /**
+     * 根据datastore写入的结果设置response
+     * @param ret: datastore写入的返回值
+     * @param index: 此op log entry的index
+     */
+    void OnWriteApplied(CSErrorCode ret, uint64_t index);
+
+    /**
+     * 回放日志时处理datastore写入的结果
+     * @param ret: datastore写入的返回值
+     * @param request: 反序列化后得到的request
+     */
+    static void OnWriteAppliedFromLog(CSErrorCode ret,
+                                      const ChunkRequest &request);
 };
 
 class ReadSnapshotRequest : public ChunkOpRequest {
@@ -38,6 +38,26 @@ uint32_t GetChunkLeftFunc(void* arg) {
     return chunkLeft;
 }
 
+uint32_t GetChunkCleanLeftFunc(void* arg) {
+    FilePool* chunkFilePool = reinterpret_cast<FilePool*>(arg);
+    uint32_t cleanLeft = 0;
+    if (chunkFilePool != nullptr) {
+        FilePoolState poolState = chunkFilePool->GetState();
+        cleanLeft = poolState.cleanChunksLeft;
+    }
+    return cleanLeft;
+}
+
+uint64_t GetChunkRefilledFunc(void* arg) {
+    FilePool* chunkFilePool = reinterpret_cast<FilePool*>(arg);
+    uint64_t refilled = 0;
+    if (chunkFilePool != nullptr) {
+        FilePoolState poolState = chunkFilePool->GetState();
+        refilled = poolState.cleanedChunks + poolState.formattedChunks;
+    }
+    return refilled;
+}
+
 uint32_t GetWalSegmentLeftFunc(void* arg) {
     FilePool* walFilePool = reinterpret_cast<FilePool*>(arg);
     uint32_t segmentLeft = 0;
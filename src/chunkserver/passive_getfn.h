@@ -77,6 +77,16 @@ namespace chunkserver {
      * @param arg: chunkfilepool的对象指针
      */
     uint32_t GetChunkLeftFunc(void* arg);
+    /**
+     * 获取chunkfilepool中剩余的已清零chunk的数量
+     * @param arg: chunkfilepool的对象指针
+     */
+    uint32_t GetChunkCleanLeftFunc(void* arg);
+    /**
+     * 获取chunkfilepool后台清零和格式化补充的chunk总数
+     * @param arg: chunkfilepool的对象指针
+     */
+    uint64_t GetChunkRefilledFunc(void* arg);
     /**
      * 获取walfilepool中剩余chunk的数量
      * @param arg: walfilepool的对象指针
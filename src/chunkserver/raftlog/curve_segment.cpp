@@ -45,6 +45,7 @@
 #include <braft/fsync.h>
 #include "src/chunkserver/raftlog/curve_segment.h"
 #include "src/chunkserver/raftlog/define.h"
+#include "src/common/crc32.h"
 
 namespace curve {
 namespace chunkserver {
@@ -71,12 +72,7 @@ int CurveSegment::create() {
         LOG(ERROR) << "Get segment from chunk file pool fail!";
         return -1;
     }
-    _fd = ::open(path.c_str(), O_RDWR|O_NOATIME, 0644);
-    if (_fd >= 0) {
-        butil::make_close_on_exec(_fd);
-    } else {
-        LOG(ERROR) << "Open path: " << path << " fail, error: "
-                   << strerror(errno);
+    if (_open_fds(path, &_fd, &_direct_fd) != 0) {
         return -1;
     }
     res = ::lseek(_fd, _meta_page_size, SEEK_SET);
@@ -86,17 +82,99 @@ int CurveSegment::create() {
     }
     LOG_IF(INFO, _fd >= 0) << "Created new segment `" << path
                            << "' with fd=" << _fd;
-    if (FLAGS_enableWalDirectWrite) {
-        _direct_fd = ::open(path.c_str(), O_RDWR|O_NOATIME|O_DIRECT, 0644);
-        LOG_IF(FATAL, _direct_fd < 0) << "failed to open file with O_DIRECT"
-                                         ", error: " << strerror(errno);
-        butil::make_close_on_exec(_direct_fd);
-    }
     _meta.bytes += _meta_page_size;
     _update_meta_page();
     return _fd >= 0 ? 0 : -1;
 }
 
+int CurveSegment::create(PreparedSegmentFile* file) {
+    if (!_is_open) {
+        CHECK(false) << "Create on a closed segment at first_index="
+                     << _first_index << " in " << _path;
+        return -1;
+    }
+
+    std::string path(_path);
+    butil::string_appendf(&path, "/" CURVE_SEGMENT_OPEN_PATTERN, _first_index);
+    // the fds stay valid across rename, and the meta page stamped by prepare()
+    // is already persisted by the file pool
+    if (::rename(file->path.c_str(), path.c_str()) != 0) {
+        LOG(ERROR) << "Fail to rename `" << file->path << "' to `" << path
+                   << "', " << berror();
+        return -1;
+    }
+    _fd = file->fd;
+    _direct_fd = file->direct_fd;
+    file->fd = -1;
+    file->direct_fd = -1;
+    _meta.bytes = _meta_page_size;
+    LOG(INFO) << "Created new segment `" << path << "' from prepared file `"
+              << file->path << "' with fd=" << _fd;
+    return 0;
+}
+
+int CurveSegment::prepare(const std::string& path,
+                          std::shared_ptr<FilePool> walFilePool,
+                          PreparedSegmentFile* file) {
+    uint32_t metaPageSize = walFilePool->GetFilePoolOpt().metaPageSize;
+    CurveSegmentMeta meta;
+    meta.bytes = metaPageSize;
+    char* metaPage = new char[metaPageSize];
+    memset(metaPage, 0, metaPageSize);
+    memcpy(metaPage, &meta.bytes, sizeof(meta.bytes));
+    int res = walFilePool->GetFile(path, metaPage);
+    delete[] metaPage;
+    if (res != 0) {
+        LOG(ERROR) << "Get prepared segment from chunk file pool fail!";
+        return -1;
+    }
+    file->path = path;
+    if (_open_fds(path, &file->fd, &file->direct_fd) != 0 ||
+        ::lseek(file->fd, metaPageSize, SEEK_SET) !=
+            static_cast<off_t>(metaPageSize)) {
+        LOG(ERROR) << "Fail to open prepared segment " << path
+                   << ", error: " << strerror(errno);
+        release(file, walFilePool);
+        return -1;
+    }
+    return 0;
+}
+
+void CurveSegment::release(PreparedSegmentFile* file,
+                           std::shared_ptr<FilePool> walFilePool) {
+    if (file->fd >= 0) {
+        ::close(file->fd);
+        file->fd = -1;
+    }
+    if (file->direct_fd >= 0) {
+        ::close(file->direct_fd);
+        file->direct_fd = -1;
+    }
+    if (walFilePool->RecycleFile(file->path) != 0) {
+        LOG(ERROR) << "Return prepared segment " << file->path
+                   << " to chunk file pool fail!";
+    }
+}
+
+int CurveSegment::_open_fds(const std::string& path, int* fd,
+                            int* direct_fd) {
+    *fd = ::open(path.c_str(), O_RDWR|O_NOATIME, 0644);
+    if (*fd >= 0) {
+        butil::make_close_on_exec(*fd);
+    } else {
+        LOG(ERROR) << "Open path: " << path << " fail, error: "
+                   << strerror(errno);
+        return -1;
+    }
+    if (FLAGS_enableWalDirectWrite) {
+        *direct_fd = ::open(path.c_str(), O_RDWR|O_NOATIME|O_DIRECT, 0644);
+        LOG_IF(FATAL, *direct_fd < 0) << "failed to open file with O_DIRECT"
+                                         ", error: " << strerror(errno);
+        butil::make_close_on_exec(*direct_fd);
+    }
+    return 0;
+}
+
 struct CurveSegment::EntryHeader {
     int64_t term;
     int type;
@@ -241,13 +319,25 @@ int CurveSegment::_load_meta() {
     return 0;
 }
 
+// CHECKSUM_CRC32 of braft is crc32c as well, curve::common::CRC32 gives the
+// same values with the 3-way interleaved crc32 instructions
+inline uint32_t iobuf_crc32(const butil::IOBuf& data) {
+    uint32_t crc = 0;
+    const size_t block_num = data.backing_block_num();
+    for (size_t i = 0; i < block_num; ++i) {
+        butil::StringPiece block = data.backing_block(i);
+        crc = curve::common::CRC32(crc, block.data(), block.size());
+    }
+    return crc;
+}
+
 inline bool verify_checksum(int checksum_type,
                             const char* data, size_t len, uint32_t value) {
     switch (checksum_type) {
     case CHECKSUM_MURMURHASH32:
         return (value == braft::murmurhash32(data, len));
     case CHECKSUM_CRC32:
-        return (value == braft::crc32(data, len));
+        return (value == curve::common::CRC32(data, len));
     default:
         LOG(ERROR) << "Unknown checksum_type=" << checksum_type;
         return false;
@@ -260,7 +350,7 @@ inline bool verify_checksum(int checksum_type,
     case CHECKSUM_MURMURHASH32:
         return (value == braft::murmurhash32(data));
     case CHECKSUM_CRC32:
-        return (value == braft::crc32(data));
+        return (value == iobuf_crc32(data));
     default:
         LOG(ERROR) << "Unknown checksum_type=" << checksum_type;
         return false;
@@ -272,7 +362,7 @@ inline uint32_t get_checksum(int checksum_type, const char* data, size_t len) {
     case CHECKSUM_MURMURHASH32:
         return braft::murmurhash32(data, len);
     case CHECKSUM_CRC32:
-        return braft::crc32(data, len);
+        return curve::common::CRC32(data, len);
     default:
         CHECK(false) << "Unknown checksum_type=" << checksum_type;
         abort();
@@ -285,7 +375,7 @@ inline uint32_t get_checksum(int checksum_type, const butil::IOBuf& data) {
     case CHECKSUM_MURMURHASH32:
         return braft::murmurhash32(data);
     case CHECKSUM_CRC32:
-        return braft::crc32(data);
+        return iobuf_crc32(data);
     default:
         CHECK(false) << "Unknown checksum_type=" << checksum_type;
         abort();
@@ -416,10 +506,7 @@ int CurveSegment::append(const braft::LogEntry* entry) {
     CHECK_LE(data.length(), 1ul << 56ul);
     char* write_buf = nullptr;
     if (FLAGS_enableWalDirectWrite) {
-        int ret = posix_memalign(reinterpret_cast<void **>(&write_buf),
-                                 FLAGS_walAlignSize, to_write);
-        LOG_IF(FATAL, ret < 0 || write_buf == nullptr)
-        << "posix_memalign WAL write buffer failed " << strerror(ret);
+        write_buf = _get_write_buf(to_write);
     } else {
         write_buf = new char[kEntryHeaderSize];
     }
@@ -435,8 +522,10 @@ int CurveSegment::append(const braft::LogEntry* entry) {
                   _checksum_type, write_buf, kEntryHeaderSize - 4));
     if (FLAGS_enableWalDirectWrite) {
         data.copy_to(write_buf + kEntryHeaderSize, real_length);
+        // the staging buffer is reused, don't leak old entries into padding
+        memset(write_buf + kEntryHeaderSize + real_length, 0,
+               zero_bytes_num);
         int ret = ::pwrite(_direct_fd, write_buf, to_write, _meta.bytes);
-        free(write_buf);
         if (ret != static_cast<int>(to_write)) {
             LOG(ERROR) << "Fail to write directly to fd=" << _direct_fd
                        << ", buf=" << write_buf << ", size=" << to_write
@@ -472,12 +561,34 @@ int CurveSegment::append(const braft::LogEntry* entry) {
     return _update_meta_page();
 }
 
+char* CurveSegment::_get_write_buf(size_t size) {
+    if (size > _write_buf_size) {
+        free(_write_buf);
+        _write_buf = nullptr;
+        // round up to a power of two to avoid growing on every larger entry
+        size_t capacity =
+            std::max<size_t>(_write_buf_size, FLAGS_walAlignSize);
+        while (capacity < size) {
+            capacity <<= 1;
+        }
+        int ret = posix_memalign(reinterpret_cast<void **>(&_write_buf),
+                                 FLAGS_walAlignSize, capacity);
+        LOG_IF(FATAL, ret != 0 || _write_buf == nullptr)
+            << "posix_memalign WAL write buffer failed " << strerror(ret);
+        _write_buf_size = capacity;
+    }
+    return _write_buf;
+}
+
 int CurveSegment::_update_meta_page() {
-    char* metaPage = nullptr;
-    int ret = posix_memalign(reinterpret_cast<void **>(&metaPage),
-                            FLAGS_walAlignSize, _meta_page_size);
-    LOG_IF(FATAL, ret < 0 || metaPage == nullptr)
-        << "posix_memalign WAL meta page failed " << strerror(ret);
+    if (_meta_page_buf == nullptr) {
+        int ret = posix_memalign(reinterpret_cast<void **>(&_meta_page_buf),
+                                FLAGS_walAlignSize, _meta_page_size);
+        LOG_IF(FATAL, ret != 0 || _meta_page_buf == nullptr)
+            << "posix_memalign WAL meta page failed " << strerror(ret);
+    }
+    char* metaPage = _meta_page_buf;
+    int ret = 0;
     memset(metaPage, 0, _meta_page_size);
     memcpy(metaPage, &_meta.bytes, sizeof(_meta.bytes));
     if (FLAGS_enableWalDirectWrite) {
@@ -485,7 +596,6 @@ int CurveSegment::_update_meta_page() {
     } else {
         ret = ::pwrite(_fd, metaPage, _meta_page_size, 0);
     }
-    free(metaPage);
     if (ret != static_cast<int>(_meta_page_size)) {
         LOG(ERROR) << "Fail to write meta page into fd="
                    << (FLAGS_enableWalDirectWrite ? _direct_fd : _fd)
@@ -608,7 +718,7 @@ int CurveSegment::close(bool will_sync) {
     if (_last_index > _first_index) {
         if (FLAGS_raftSyncSegments && will_sync &&
                                 !FLAGS_enableWalDirectWrite) {
-            ret = braft::raft_fsync(_fd);
+            ret = _fsync();
         }
     }
 
@@ -632,7 +742,7 @@ int CurveSegment::sync(bool will_sync) {
         // CHECK(_is_open);
         if (!FLAGS_enableWalDirectWrite && braft::FLAGS_raft_sync
                                             && will_sync) {
-            return braft::raft_fsync(_fd);
+            return _fsync();
         } else {
             return 0;
         }
@@ -641,6 +751,19 @@ int CurveSegment::sync(bool will_sync) {
     }
 }
 
+int CurveSegment::_fsync() {
+    if (!FLAGS_walGroupCommit) {
+        return braft::raft_fsync(_fd);
+    }
+    if (!_group_committer) {
+        _group_committer = WalGroupCommitter::GetInstance(_fd);
+        if (!_group_committer) {
+            return braft::raft_fsync(_fd);
+        }
+    }
+    return _group_committer->Sync(_fd);
+}
+
 int CurveSegment::unlink() {
     std::string path(_path);
     if (_is_open) {
@@ -48,6 +48,7 @@
 #include <braft/log_entry.h>
 #include <braft/storage.h>
 #include <braft/util.h>
+#include <stdlib.h>
 #include <vector>
 #include <memory>
 #include <algorithm>
@@ -55,12 +56,22 @@
 #include <string>
 #include "src/chunkserver/datastore/file_pool.h"
 #include "src/chunkserver/raftlog/segment.h"
+#include "src/chunkserver/raftlog/wal_group_commit.h"
 
 namespace curve {
 namespace chunkserver {
 
 DECLARE_bool(enableWalDirectWrite);
 
+// A segment file taken from the wal file pool and opened in advance, its meta
+// page is already stamped with the size of an empty segment
+struct PreparedSegmentFile {
+    PreparedSegmentFile() : fd(-1), direct_fd(-1) {}
+    std::string path;
+    int fd;
+    int direct_fd;
+};
+
 struct CurveSegmentMeta {
     CurveSegmentMeta() : bytes(0) {}
     int64_t bytes;
@@ -76,7 +87,8 @@ class BAIDU_CACHELINE_ALIGNMENT CurveSegment:
         _first_index(first_index), _last_index(first_index - 1),
         _checksum_type(checksum_type),
         _walFilePool(walFilePool),
-        _meta_page_size(walFilePool->GetFilePoolOpt().metaPageSize) {
+        _meta_page_size(walFilePool->GetFilePoolOpt().metaPageSize),
+        _write_buf(nullptr), _write_buf_size(0), _meta_page_buf(nullptr) {
     }
     CurveSegment(const std::string& path, const int64_t first_index,
                  const int64_t last_index, int checksum_type,
@@ -86,7 +98,8 @@ class BAIDU_CACHELINE_ALIGNMENT CurveSegment:
         _first_index(first_index), _last_index(last_index),
         _checksum_type(checksum_type),
         _walFilePool(walFilePool),
-        _meta_page_size(walFilePool->GetFilePoolOpt().metaPageSize) {
+        _meta_page_size(walFilePool->GetFilePoolOpt().metaPageSize),
+        _write_buf(nullptr), _write_buf_size(0), _meta_page_buf(nullptr) {
     }
     ~CurveSegment() {
         if (_fd >= 0) {
@@ -97,6 +110,8 @@ class BAIDU_CACHELINE_ALIGNMENT CurveSegment:
             ::close(_direct_fd);
             _direct_fd = -1;
         }
+        free(_write_buf);
+        free(_meta_page_buf);
     }
 
     struct EntryHeader;
@@ -104,6 +119,18 @@ class BAIDU_CACHELINE_ALIGNMENT CurveSegment:
     // create open segment
     int create() override;
 
+    // create open segment from a prepared file, only a rename is needed
+    int create(PreparedSegmentFile* file);
+
+    // take a file from the wal file pool, stamp its meta page and open it
+    static int prepare(const std::string& path,
+                       std::shared_ptr<FilePool> walFilePool,
+                       PreparedSegmentFile* file);
+
+    // close the fds of a prepared file and return it to the wal file pool
+    static void release(PreparedSegmentFile* file,
+                        std::shared_ptr<FilePool> walFilePool);
+
     // load open or closed segment
     // open fd, load index, truncate uncompleted entry
     int load(braft::ConfigurationManager* configuration_manager) override;
@@ -162,6 +189,15 @@ class BAIDU_CACHELINE_ALIGNMENT CurveSegment:
 
     int _update_meta_page();
 
+    // open the fds of a segment file
+    static int _open_fds(const std::string& path, int* fd, int* direct_fd);
+
+    // get the aligned staging buffer for direct write, at least size bytes
+    char* _get_write_buf(size_t size);
+
+    // fsync _fd, through the group committer of the disk if enabled
+    int _fsync();
+
     std::string _path;
     CurveSegmentMeta _meta;
     mutable braft::raft_mutex_t _mutex;
@@ -174,6 +210,11 @@ class BAIDU_CACHELINE_ALIGNMENT CurveSegment:
     std::vector<std::pair<int64_t, int64_t> > _offset_and_term;
     std::shared_ptr<FilePool> _walFilePool;
     uint32_t _meta_page_size;
+    std::shared_ptr<WalGroupCommitter> _group_committer;
+    // aligned buffers reused by direct write
+    char* _write_buf;
+    size_t _write_buf_size;
+    char* _meta_page_buf;
 };
 
 }  // namespace chunkserver
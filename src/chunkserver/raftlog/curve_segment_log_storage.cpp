@@ -47,6 +47,10 @@
 namespace curve {
 namespace chunkserver {
 
+DEFINE_uint32(walPreparedSegmentNum, 0,
+              "number of wal segments each copyset opens ahead of time, "
+              "0 means segments are taken from the file pool on rollover");
+
 LogStorageOptions StoreOptForCurveSegmentLogStorage(
     LogStorageOptions options) {
     static LogStorageOptions options_;
@@ -63,6 +67,23 @@ void RegisterCurveSegmentLogStorageOrDie() {
                                     "curve", &logStorage);
 }
 
+CurveSegmentLogStorage::~CurveSegmentLogStorage() {
+    bthread_t tid;
+    {
+        BAIDU_SCOPED_LOCK(_prepare_mutex);
+        _stopped = true;
+        tid = _prepare_tid;
+        _prepare_tid = INVALID_BTHREAD;
+    }
+    if (tid != INVALID_BTHREAD) {
+        bthread_join(tid, NULL);
+    }
+    for (auto& file : _prepared_segments) {
+        CurveSegment::release(&file, _walFilePool);
+    }
+    _prepared_segments.clear();
+}
+
 int CurveSegmentLogStorage::init(
                     braft::ConfigurationManager* configuration_manager) {
     butil::FilePath dir_path(_path);
@@ -110,6 +131,9 @@ int CurveSegmentLogStorage::init(
         _last_log_index.store(0);
         ret = save_meta(1);
     }
+    if (ret == 0) {
+        start_prepare();
+    }
     return ret;
 }
 
@@ -147,6 +171,21 @@ int CurveSegmentLogStorage::list_segments(bool is_empty) {
 
     // restore segment meta
     while (dir_reader.Next()) {
+        // prepared segments hold no logs, give them back to the file pool
+        if (0 == strncmp(dir_reader.name(), CURVE_SEGMENT_PREPARED_PREFIX,
+                         strlen(CURVE_SEGMENT_PREPARED_PREFIX))) {
+            std::string segment_path(_path);
+            segment_path.append("/");
+            segment_path.append(dir_reader.name());
+            if (_walFilePool->RecycleFile(segment_path) != 0) {
+                LOG(ERROR) << "Fail to recycle prepared segment, path: "
+                           << segment_path;
+                return -1;
+            }
+            LOG(INFO) << "recycle prepared segment, path: " << segment_path;
+            continue;
+        }
+
         // unlink unneed segments and unfinished unlinked segments
         if ((is_empty && 0 == strncmp(dir_reader.name(),
                                         "log_", strlen("log_"))) ||
@@ -698,10 +737,8 @@ scoped_refptr<Segment> CurveSegmentLogStorage::open_segment(
     {
         BAIDU_SCOPED_LOCK(_mutex);
         if (!_open_segment) {
-            _open_segment = new CurveSegment(_path, last_log_index() + 1,
-                                             _checksum_type, _walFilePool);
-            if (_open_segment->create() != 0) {
-                _open_segment = NULL;
+            _open_segment = create_open_segment();
+            if (!_open_segment) {
                 return NULL;
             }
         }
@@ -716,9 +753,8 @@ scoped_refptr<Segment> CurveSegmentLogStorage::open_segment(
         if (prev_open_segment) {
             if (prev_open_segment->close(_enable_sync) == 0) {
                 BAIDU_SCOPED_LOCK(_mutex);
-                _open_segment = new CurveSegment(_path, last_log_index() + 1,
-                                                 _checksum_type, _walFilePool);
-                if (_open_segment->create() == 0) {
+                _open_segment = create_open_segment();
+                if (_open_segment) {
                     // success
                     break;
                 }
@@ -735,6 +771,94 @@ scoped_refptr<Segment> CurveSegmentLogStorage::open_segment(
     return _open_segment;
 }
 
+scoped_refptr<Segment> CurveSegmentLogStorage::create_open_segment() {
+    CurveSegment* segment = new CurveSegment(_path, last_log_index() + 1,
+                                             _checksum_type, _walFilePool);
+    scoped_refptr<Segment> ptr(segment);
+    PreparedSegmentFile file;
+    bool prepared = false;
+    {
+        BAIDU_SCOPED_LOCK(_prepare_mutex);
+        if (!_prepared_segments.empty()) {
+            file = _prepared_segments.front();
+            _prepared_segments.pop_front();
+            prepared = true;
+        }
+    }
+    int ret = 0;
+    if (prepared) {
+        ret = segment->create(&file);
+        if (ret != 0) {
+            CurveSegment::release(&file, _walFilePool);
+        }
+    } else {
+        ret = segment->create();
+    }
+    start_prepare();
+    return ret == 0 ? ptr : NULL;
+}
+
+void CurveSegmentLogStorage::start_prepare() {
+    BAIDU_SCOPED_LOCK(_prepare_mutex);
+    if (_preparing || _stopped ||
+        _prepared_segments.size() >= FLAGS_walPreparedSegmentNum) {
+        return;
+    }
+    // the former one has finished its work, make sure it has exited. Clearing
+    // _preparing is the last thing it does under the lock, so joining it
+    // here never waits for the lock
+    if (_prepare_tid != INVALID_BTHREAD) {
+        bthread_join(_prepare_tid, NULL);
+        _prepare_tid = INVALID_BTHREAD;
+    }
+    // the tid is published under the lock, the new bthread can't do
+    // anything before we release it
+    if (bthread_start_background(&_prepare_tid, NULL, run_prepare,
+                                 this) != 0) {
+        LOG(ERROR) << "Fail to start prepare segment bthread, path: " << _path;
+        _prepare_tid = INVALID_BTHREAD;
+        return;
+    }
+    _preparing = true;
+}
+
+void* CurveSegmentLogStorage::run_prepare(void* arg) {
+    CurveSegmentLogStorage* storage =
+        reinterpret_cast<CurveSegmentLogStorage*>(arg);
+    storage->prepare_segments();
+    return NULL;
+}
+
+void CurveSegmentLogStorage::prepare_segments() {
+    while (true) {
+        std::string path(_path);
+        {
+            BAIDU_SCOPED_LOCK(_prepare_mutex);
+            if (_stopped ||
+                _prepared_segments.size() >= FLAGS_walPreparedSegmentNum) {
+                _preparing = false;
+                return;
+            }
+            butil::string_appendf(&path, "/" CURVE_SEGMENT_PREPARED_PATTERN,
+                                  _prepare_seq++);
+        }
+        PreparedSegmentFile file;
+        if (CurveSegment::prepare(path, _walFilePool, &file) != 0) {
+            LOG(ERROR) << "Fail to prepare segment, path: " << path;
+            BAIDU_SCOPED_LOCK(_prepare_mutex);
+            _preparing = false;
+            return;
+        }
+        BAIDU_SCOPED_LOCK(_prepare_mutex);
+        _prepared_segments.push_back(file);
+    }
+}
+
+size_t CurveSegmentLogStorage::prepared_segment_num() {
+    BAIDU_SCOPED_LOCK(_prepare_mutex);
+    return _prepared_segments.size();
+}
+
 LogStorageStatus CurveSegmentLogStorage::GetStatus() {
     uint32_t count = (uint32_t)(_segments.size())
                    + (nullptr != _open_segment ? 1 : 0);
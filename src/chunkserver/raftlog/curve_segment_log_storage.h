@@ -47,6 +47,9 @@
 #include <braft/log_entry.h>
 #include <braft/storage.h>
 #include <braft/util.h>
+#include <bthread/bthread.h>
+#include <gflags/gflags.h>
+#include <deque>
 #include <map>
 #include <vector>
 #include <string>
@@ -60,6 +63,8 @@
 namespace curve {
 namespace chunkserver {
 
+DECLARE_uint32(walPreparedSegmentNum);
+
 class CurveSegmentLogStorage;
 
 struct LogStorageOptions {
@@ -101,13 +106,15 @@ class CurveSegmentLogStorage : public braft::LogStorage {
         std::shared_ptr<FilePool> walFilePool = nullptr)
         : _path(path), _first_log_index(1), _last_log_index(0),
           _walFilePool(walFilePool), _checksum_type(0),
-          _enable_sync(enable_sync) {}
+          _enable_sync(enable_sync), _preparing(false), _stopped(false),
+          _prepare_seq(0), _prepare_tid(INVALID_BTHREAD) {}
 
     CurveSegmentLogStorage()
         : _first_log_index(1), _last_log_index(0), _walFilePool(nullptr),
-          _checksum_type(0), _enable_sync(true) {}
+          _checksum_type(0), _enable_sync(true), _preparing(false),
+          _stopped(false), _prepare_seq(0), _prepare_tid(INVALID_BTHREAD) {}
 
-    virtual ~CurveSegmentLogStorage() {}
+    virtual ~CurveSegmentLogStorage();
 
     // init logstorage, check consistency and integrity
     virtual int init(braft::ConfigurationManager *configuration_manager);
@@ -152,8 +159,17 @@ class CurveSegmentLogStorage : public braft::LogStorage {
 
     LogStorageStatus GetStatus();
 
+    // number of segment files opened ahead of time
+    size_t prepared_segment_num();
+
  private:
     scoped_refptr<Segment> open_segment(size_t to_write);
+    // create the open segment, from a prepared file if there is one
+    scoped_refptr<Segment> create_open_segment();
+    // refill prepared segment files in background
+    void start_prepare();
+    void prepare_segments();
+    static void* run_prepare(void* arg);
     int save_meta(const int64_t log_index);
     int load_meta();
     int list_segments(bool is_empty);
@@ -175,6 +191,15 @@ class CurveSegmentLogStorage : public braft::LogStorage {
     std::shared_ptr<FilePool> _walFilePool;
     int _checksum_type;
     bool _enable_sync;
+
+    // segment files taken from the wal file pool and opened in advance, so
+    // that rolling over a segment only needs a rename
+    braft::raft_mutex_t _prepare_mutex;
+    std::deque<PreparedSegmentFile> _prepared_segments;
+    bool _preparing;
+    bool _stopped;
+    uint64_t _prepare_seq;
+    bthread_t _prepare_tid;
 };
 
 }  // namespace chunkserver
@@ -45,6 +45,10 @@ namespace chunkserver {
 
 #define CURVE_SEGMENT_OPEN_PATTERN "curve_log_inprogress_%020" PRId64
 #define CURVE_SEGMENT_CLOSED_PATTERN "curve_log_%020" PRId64 "_%020" PRId64
+// segment files taken from the wal file pool ahead of time, not holding logs
+#define CURVE_SEGMENT_PREPARED_PREFIX "curve_log_prepared_"
+#define CURVE_SEGMENT_PREPARED_PATTERN \
+    CURVE_SEGMENT_PREPARED_PREFIX "%020" PRIu64
 #define BRAFT_SEGMENT_OPEN_PATTERN "log_inprogress_%020" PRId64
 #define BRAFT_SEGMENT_CLOSED_PATTERN "log_%020" PRId64 "_%020" PRId64
 #define BRAFT_SEGMENT_META_FILE  "log_meta"
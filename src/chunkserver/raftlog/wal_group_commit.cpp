@@ -0,0 +1,280 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <bthread/countdown_event.h>
+#include <glog/logging.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "src/chunkserver/raftlog/wal_group_commit.h"
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace chunkserver {
+
+DEFINE_bool(walGroupCommit, false,
+            "coalesce the wal segment syncs of all copysets on one disk, "
+            "only takes effect when enableWalDirectWrite is false");
+DEFINE_uint32(walGroupCommitMaxDelayUs, 200,
+              "max time a wal sync waits for other syncs to join its batch");
+DEFINE_uint32(walGroupCommitMaxBatch, 256,
+              "max number of wal syncs committed in one batch");
+
+using ::curve::common::TimeUtility;
+
+namespace {
+const uint32_t kSyncRingEntries = 64;
+}  // namespace
+
+std::mutex WalGroupCommitter::instancesMtx_;
+std::map<dev_t, std::shared_ptr<WalGroupCommitter>>
+    WalGroupCommitter::instances_;
+
+struct WalGroupCommitter::SyncRequest {
+    int fd;
+    int result;
+    uint64_t startUs;
+    bthread::CountdownEvent done;
+    explicit SyncRequest(int fd)
+        : fd(fd), result(0), startUs(TimeUtility::GetTimeofDayUs()),
+          done(1) {}
+};
+
+WalGroupCommitter::WalGroupCommitter(const std::string& name)
+    : name_(name), running_(false) {}
+
+WalGroupCommitter::~WalGroupCommitter() {
+    Stop();
+}
+
+std::shared_ptr<WalGroupCommitter> WalGroupCommitter::GetInstance(int fd) {
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        LOG(ERROR) << "fstat failed, fd: " << fd
+                   << ", error: " << strerror(errno);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(instancesMtx_);
+    auto iter = instances_.find(st.st_dev);
+    if (iter != instances_.end()) {
+        return iter->second;
+    }
+
+    std::string name = "wal_group_commit_" +
+                       std::to_string(major(st.st_dev)) + "_" +
+                       std::to_string(minor(st.st_dev));
+    auto committer = std::make_shared<WalGroupCommitter>(name);
+    if (committer->Start() != 0) {
+        return nullptr;
+    }
+    instances_.emplace(st.st_dev, committer);
+    return committer;
+}
+
+int WalGroupCommitter::Start() {
+    std::lock_guard<bthread::Mutex> lock(mtx_);
+    if (running_) {
+        return 0;
+    }
+    if (batchSize_.expose(name_, "batch_size") != 0 ||
+        commitLatency_.expose(name_, "latency") != 0 ||
+        syscallNum_.expose_as(name_, "syscall_num") != 0) {
+        LOG(ERROR) << "Expose metric failed, name: " << name_;
+        return -1;
+    }
+    int ret = uring_.Init(kSyncRingEntries);
+    LOG_IF(WARNING, ret != 0)
+        << "io_uring setup failed, " << name_
+        << " syncs the fds of a batch one by one: " << strerror(-ret);
+    running_ = true;
+    flusher_ = std::thread(&WalGroupCommitter::FlushLoop, this);
+    LOG(INFO) << "Start wal group committer " << name_
+              << ", max delay us: " << FLAGS_walGroupCommitMaxDelayUs
+              << ", max batch: " << FLAGS_walGroupCommitMaxBatch;
+    return 0;
+}
+
+void WalGroupCommitter::Stop() {
+    {
+        std::lock_guard<bthread::Mutex> lock(mtx_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+        cond_.notify_all();
+    }
+    flusher_.join();
+    uring_.Exit();
+    LOG(INFO) << "Stop wal group committer " << name_;
+}
+
+int WalGroupCommitter::Sync(int fd) {
+    SyncRequest request(fd);
+    {
+        std::lock_guard<bthread::Mutex> lock(mtx_);
+        if (!running_) {
+            return SyncFd(fd);
+        }
+        pending_.push_back(&request);
+        // wake up the flusher for a new window or a full batch
+        if (pending_.size() == 1 ||
+            pending_.size() >= FLAGS_walGroupCommitMaxBatch) {
+            cond_.notify_one();
+        }
+    }
+    request.done.wait();
+    return request.result;
+}
+
+void WalGroupCommitter::FlushLoop() {
+    while (true) {
+        std::vector<SyncRequest*> batch;
+        {
+            std::unique_lock<bthread::Mutex> lock(mtx_);
+            while (running_ && pending_.empty()) {
+                cond_.wait(lock);
+            }
+            if (pending_.empty()) {
+                break;
+            }
+            // wait for other copysets to join the batch
+            uint64_t deadline =
+                pending_.front()->startUs + FLAGS_walGroupCommitMaxDelayUs;
+            while (running_ &&
+                   pending_.size() < FLAGS_walGroupCommitMaxBatch) {
+                uint64_t now = TimeUtility::GetTimeofDayUs();
+                if (now >= deadline) {
+                    break;
+                }
+                cond_.wait_for(lock, deadline - now);
+            }
+            batch.swap(pending_);
+        }
+        CommitBatch(&batch);
+    }
+}
+
+void WalGroupCommitter::CommitBatch(std::vector<SyncRequest*>* batch) {
+    // requests of the same segment only need to be synced once
+    std::vector<std::pair<int, int>> fdResults;
+    for (auto request : *batch) {
+        bool found = false;
+        for (auto& fdResult : fdResults) {
+            if (fdResult.first == request->fd) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            fdResults.emplace_back(request->fd, 0);
+        }
+    }
+
+    // the cache flush of fdatasync is only guaranteed for the file it is
+    // called on, so every fd of the batch is synced by itself
+    SyncFds(&fdResults);
+
+    uint64_t now = TimeUtility::GetTimeofDayUs();
+    batchSize_ << batch->size();
+    for (auto request : *batch) {
+        for (auto& fdResult : fdResults) {
+            if (fdResult.first == request->fd) {
+                request->result = fdResult.second;
+                break;
+            }
+        }
+        commitLatency_ << (now - request->startUs);
+        request->done.signal();
+    }
+}
+
+void WalGroupCommitter::SyncFds(std::vector<std::pair<int, int>>* fdResults) {
+    if (!uring_.Inited()) {
+        for (auto& fdResult : *fdResults) {
+            fdResult.second = SyncFd(fdResult.first);
+        }
+        return;
+    }
+
+    // all fdatasyncs go to the kernel in one syscall, so the batch waits
+    // for the slowest of them instead of their sum
+    size_t done = 0;
+    while (done < fdResults->size()) {
+        size_t num = std::min<size_t>(fdResults->size() - done,
+                                      uring_.SqEntries());
+        for (size_t i = done; i < done + num; ++i) {
+            struct io_uring_sqe* sqe = uring_.GetSqe();
+            CHECK(sqe != nullptr) << "io_uring submission queue is full";
+            sqe->opcode = IORING_OP_FSYNC;
+            sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+            sqe->fd = (*fdResults)[i].first;
+            sqe->user_data = i;
+        }
+        uint32_t submitted = 0;
+        int ret = uring_.Submit(num, &submitted);
+        syscallNum_ << 1;
+        for (uint32_t k = 0; k < submitted; ++k) {
+            struct io_uring_cqe* cqe = nullptr;
+            int err = uring_.WaitCqe(&cqe);
+            CHECK(err == 0) << "io_uring wait completion failed: "
+                            << strerror(-err);
+            auto& fdResult = (*fdResults)[cqe->user_data];
+            fdResult.second = cqe->res;
+            uring_.CqeSeen();
+            if (fdResult.second == -EINTR || fdResult.second == -EAGAIN) {
+                fdResult.second = SyncFd(fdResult.first);
+            } else if (fdResult.second < 0) {
+                LOG(ERROR) << "fdatasync failed, fd: " << fdResult.first
+                           << ", error: " << strerror(-fdResult.second);
+            }
+        }
+        if (ret < 0) {
+            LOG(WARNING) << "io_uring submit failed, sync the rest of the"
+                         << " batch one by one: " << strerror(-ret);
+            for (size_t i = done + submitted; i < done + num; ++i) {
+                auto& fdResult = (*fdResults)[i];
+                fdResult.second = SyncFd(fdResult.first);
+            }
+        }
+        done += num;
+    }
+}
+
+int WalGroupCommitter::SyncFd(int fd) {
+    syscallNum_ << 1;
+    if (::fdatasync(fd) != 0) {
+        int err = errno;
+        LOG(ERROR) << "fdatasync failed, fd: " << fd
+                   << ", error: " << strerror(err);
+        return -err;
+    }
+    return 0;
+}
+
+}  // namespace chunkserver
+}  // namespace curve
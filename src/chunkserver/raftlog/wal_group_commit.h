@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CHUNKSERVER_RAFTLOG_WAL_GROUP_COMMIT_H_
+#define SRC_CHUNKSERVER_RAFTLOG_WAL_GROUP_COMMIT_H_
+
+#include <bthread/condition_variable.h>
+#include <bthread/mutex.h>
+#include <bvar/bvar.h>
+#include <gflags/gflags.h>
+#include <sys/types.h>
+
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "src/fs/io_uring.h"
+
+namespace curve {
+namespace chunkserver {
+
+DECLARE_bool(walGroupCommit);
+DECLARE_uint32(walGroupCommitMaxDelayUs);
+DECLARE_uint32(walGroupCommitMaxBatch);
+
+/**
+ * WalGroupCommitter coalesces the segment syncs of all copysets on one disk.
+ *
+ * Callers hand in the fd to sync and block until it is durable. A single
+ * flusher thread collects requests for at most walGroupCommitMaxDelayUs
+ * (or walGroupCommitMaxBatch requests) and fdatasync()s every distinct fd
+ * of the batch once. The fdatasyncs of a batch are submitted together
+ * through io_uring and run concurrently, if io_uring is unavailable they
+ * are issued one by one. The batching saves the wakeups and the repeated
+ * syncs of one segment, not the device cache flushes.
+ *
+ * Segments are only synced when enableWalDirectWrite is false, it is true
+ * by default, then the WAL is written with O_DIRECT and never synced, and
+ * the committer is not used.
+ */
+class WalGroupCommitter {
+ public:
+    explicit WalGroupCommitter(const std::string& name);
+    ~WalGroupCommitter();
+
+    /**
+     * Get the committer of the disk that fd resides on, create it if needed
+     * @return nullptr if fstat fails
+     */
+    static std::shared_ptr<WalGroupCommitter> GetInstance(int fd);
+
+    int Start();
+    void Stop();
+
+    /**
+     * Make the data written to fd durable, block until the batch that the
+     * request belongs to is committed. Can be called from bthreads.
+     * @return success return 0, otherwise return -errno
+     */
+    int Sync(int fd);
+
+ private:
+    struct SyncRequest;
+
+    void FlushLoop();
+    void CommitBatch(std::vector<SyncRequest*>* batch);
+    // fdatasync every fd, the results are filled into the second of pairs
+    void SyncFds(std::vector<std::pair<int, int>>* fdResults);
+    int SyncFd(int fd);
+
+ private:
+    std::string name_;
+    bthread::Mutex mtx_;
+    bthread::ConditionVariable cond_;
+    std::vector<SyncRequest*> pending_;
+    bool running_;
+    std::thread flusher_;
+    // only used by the flusher
+    curve::fs::IoUring uring_;
+
+    // number of sync requests committed in one batch
+    bvar::LatencyRecorder batchSize_;
+    // latency from submitting a sync request to its commit
+    bvar::LatencyRecorder commitLatency_;
+    // number of syscalls issued by the flusher
+    bvar::Adder<uint64_t> syscallNum_;
+
+    static std::mutex instancesMtx_;
+    static std::map<dev_t, std::shared_ptr<WalGroupCommitter>> instances_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_RAFTLOG_WAL_GROUP_COMMIT_H_
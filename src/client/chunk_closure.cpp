@@ -169,6 +169,7 @@ void ClientClosure::Run() {
     chunkIdInfo_ = reqCtx_->idinfo_;
     status_ = -1;
     cntlstatus_ = cntl_->ErrorCode();
+    reqCtx_->trace_.rpcUs += RpcLatencyUs();
 
     bool needRetry = false;
 
@@ -323,7 +324,7 @@ void ClientClosure::ProcessUnstableState() {
 void ClientClosure::OnSuccess() {
     reqDone_->SetFailed(0);
 
-    auto duration = cntl_->latency_us();
+    auto duration = RpcLatencyUs();
     MetricHelper::LatencyRecord(fileMetric_, duration, reqCtx_->optype_);
     MetricHelper::IncremRPCQPSCount(
         fileMetric_, reqCtx_->rawlength_, reqCtx_->optype_);
@@ -341,7 +342,7 @@ void ClientClosure::OnChunkNotExist() {
         << ", remote side = "
         << butil::endpoint2str(cntl_->remote_side()).c_str();
 
-    auto duration = cntl_->latency_us();
+    auto duration = RpcLatencyUs();
     MetricHelper::LatencyRecord(fileMetric_, duration, reqCtx_->optype_);
     MetricHelper::IncremRPCQPSCount(
         fileMetric_, reqCtx_->rawlength_, reqCtx_->optype_);
@@ -431,7 +432,10 @@ void ClientClosure::OnRetry() {
                     << ", request id = " << reqCtx_->id_;
     }
 
+    uint64_t startUs = TimeUtility::GetTimeofDayUs();
     PreProcessBeforeRetry(status_, cntlstatus_);
+    reqCtx_->trace_.retryBackoffUs += TimeUtility::GetTimeofDayUs() - startUs;
+
     SendRetryRequest();
 }
 
@@ -513,6 +517,24 @@ void ReadChunkClosure::SendRetryRequest() {
                        done_);
 }
 
+void ReadChunkClosure::Run() {
+    if (hedgedRead_ != nullptr) {
+        std::shared_ptr<HedgedRead> hedgedRead = std::move(hedgedRead_);
+        if (!hedgedRead->OnLeaderDone(cntl_->Failed() ? -1 : RpcLatencyUs())) {
+            // the follower has completed the read, done_ is released
+            if (cntl_->ErrorCode() == brpc::ERPCTIMEDOUT) {
+                client_->GetMetaCache()->GetUnstableHelper().IncreTimeout(
+                    chunkserverID_);
+            }
+            delete cntl_;
+            delete this;
+            return;
+        }
+    }
+
+    ClientClosure::Run();
+}
+
 void ReadChunkClosure::OnSuccess() {
     ClientClosure::OnSuccess();
 
@@ -33,6 +33,7 @@
 #include "src/client/client_config.h"
 #include "src/client/client_common.h"
 #include "src/client/client_metric.h"
+#include "src/client/hedged_read.h"
 #include "src/client/request_closure.h"
 #include "src/common/math_util.h"
 
@@ -83,6 +84,14 @@ class ClientClosure : public Closure {
         return chunkserverEndPoint_;
     }
 
+    /**
+     * 请求合并在一个rpc中发送的时候，cntl_没有真正发送过rpc，
+     * 使用合并的rpc的延时
+     */
+    void SetBatchLatencyUs(int64_t latencyUs) {
+        batchLatencyUs_ = latencyUs;
+    }
+
     // 统一Run函数入口
     void Run() override;
 
@@ -207,6 +216,10 @@ class ClientClosure : public Closure {
 
     void RefreshLeader();
 
+    int64_t RpcLatencyUs() const {
+        return batchLatencyUs_ >= 0 ? batchLatencyUs_ : cntl_->latency_us();
+    }
+
     static FailureRequestOption         failReqOpt_;
 
     brpc::Controller*                   cntl_;
@@ -233,6 +246,9 @@ class ClientClosure : public Closure {
 
     // rpc 状态码
     int                                 cntlstatus_;
+
+    // 合并发送的rpc的延时，-1表示没有合并发送
+    int64_t                             batchLatencyUs_ = -1;
 };
 
 class WriteChunkClosure : public ClientClosure {
@@ -249,9 +265,18 @@ class ReadChunkClosure : public ClientClosure {
     ReadChunkClosure(CopysetClient* client, Closure* done)
         : ClientClosure(client, done) {}
 
+    void Run() override;
     void OnSuccess() override;
     void OnChunkNotExist() override;
     void SendRetryRequest() override;
+
+    // 开启hedged read的读请求，leader返回的时候决定由谁完成读请求
+    void SetHedgedRead(std::shared_ptr<HedgedRead> hedgedRead) {
+        hedgedRead_ = std::move(hedgedRead);
+    }
+
+ private:
+    std::shared_ptr<HedgedRead> hedgedRead_;
 };
 
 class ReadChunkSnapClosure : public ClientClosure {
@@ -95,6 +95,44 @@ int ClientConfig::Init(const std::string& configpath) {
         &fileServiceOption_.ioOpt.ioSenderOpt.failRequestOpt.chunkserverMaxRPCTimeoutMS);   // NOLINT
     LOG_IF(ERROR, ret == false) << "config no chunkserver.maxRPCTimeoutMS info";
 
+    BatchRPCOption& batchOpt = fileServiceOption_.ioOpt.ioSenderOpt.batchOpt;
+    ret = conf_.GetBoolValue("chunkserver.batchRPC.enable", &batchOpt.enable);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.batchRPC.enable info, using default value "
+        << batchOpt.enable;
+
+    ret = conf_.GetUInt32Value("chunkserver.batchRPC.maxBatchSize",
+                               &batchOpt.maxBatchSize);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.batchRPC.maxBatchSize info, "
+        << "using default value " << batchOpt.maxBatchSize;
+
+    ret = conf_.GetUInt32Value("chunkserver.batchRPC.tickUs",
+                               &batchOpt.tickUs);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.batchRPC.tickUs info, using default value "
+        << batchOpt.tickUs;
+
+    HedgedReadOption& hedgedReadOpt =
+        fileServiceOption_.ioOpt.ioSenderOpt.hedgedReadOpt;
+    ret = conf_.GetBoolValue("chunkserver.hedgedRead.enable",
+                             &hedgedReadOpt.enable);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.hedgedRead.enable info, using default value "
+        << hedgedReadOpt.enable;
+
+    ret = conf_.GetUInt32Value("chunkserver.hedgedRead.minDelayUs",
+                               &hedgedReadOpt.minDelayUs);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.hedgedRead.minDelayUs info, "
+        << "using default value " << hedgedReadOpt.minDelayUs;
+
+    ret = conf_.GetUInt32Value("chunkserver.hedgedRead.maxDelayUs",
+                               &hedgedReadOpt.maxDelayUs);
+    LOG_IF(WARNING, ret == false)
+        << "config no chunkserver.hedgedRead.maxDelayUs info, "
+        << "using default value " << hedgedReadOpt.maxDelayUs;
+
     ret = conf_.GetUInt32Value(
         "chunkserver.maxStableTimeoutTimes",
         &fileServiceOption_.ioOpt.metaCacheOpt.chunkserverUnstableOption.maxStableChunkServerTimeoutTimes);  // NOLINT
@@ -156,6 +194,46 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no schedule.threadpoolSize info";
     RETURN_IF_FALSE(ret);
 
+    WriteMergeOption& writeMergeOpt =
+        fileServiceOption_.ioOpt.reqSchdulerOpt.writeMergeOpt;
+    ret = conf_.GetBoolValue("schedule.writeMerge.enable",
+                             &writeMergeOpt.enable);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.writeMerge.enable info, using default value "
+        << writeMergeOpt.enable;
+
+    ret = conf_.GetUInt32Value("schedule.writeMerge.maxSizeKB",
+                               &writeMergeOpt.maxSizeKB);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.writeMerge.maxSizeKB info, using default value "
+        << writeMergeOpt.maxSizeKB;
+
+    ret = conf_.GetUInt32Value("schedule.writeMerge.waitUs",
+                               &writeMergeOpt.waitUs);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.writeMerge.waitUs info, using default value "
+        << writeMergeOpt.waitUs;
+
+    MultiQueueOption& multiQueueOpt =
+        fileServiceOption_.ioOpt.reqSchdulerOpt.multiQueueOpt;
+    ret = conf_.GetBoolValue("schedule.multiQueue.enable",
+                             &multiQueueOpt.enable);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.multiQueue.enable info, using default value "
+        << multiQueueOpt.enable;
+
+    ret = conf_.GetUInt32Value("schedule.multiQueue.queueCapacity",
+                               &multiQueueOpt.queueCapacity);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.multiQueue.queueCapacity info, "
+        << "using default value " << multiQueueOpt.queueCapacity;
+
+    ret = conf_.GetStringValue("schedule.multiQueue.cpuList",
+                               &multiQueueOpt.cpuList);
+    LOG_IF(WARNING, ret == false)
+        << "config no schedule.multiQueue.cpuList info, using default value "
+        << multiQueueOpt.cpuList;
+
     ret = conf_.GetUInt32Value("mds.refreshTimesPerLease",
         &fileServiceOption_.leaseOpt.mdsRefreshTimesPerLease);
     LOG_IF(ERROR, ret == false) << "config no mds.refreshTimesPerLease info";
@@ -276,6 +354,58 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no discard.taskDelayMs info";
     RETURN_IF_FALSE(ret);
 
+    ReadCacheOption& readCacheOpt = fileServiceOption_.ioOpt.readCacheOpt;
+    ret = conf_.GetBoolValue("readCache.enable", &readCacheOpt.enable);
+    LOG_IF(WARNING, ret == false)
+        << "config no readCache.enable info, using default value "
+        << readCacheOpt.enable;
+
+    ret = conf_.GetUInt64Value("readCache.capacityMB",
+                               &readCacheOpt.capacityMB);
+    LOG_IF(WARNING, ret == false)
+        << "config no readCache.capacityMB info, using default value "
+        << readCacheOpt.capacityMB;
+
+    ret = conf_.GetUInt32Value("readCache.blockSizeKB",
+                               &readCacheOpt.blockSizeKB);
+    LOG_IF(WARNING, ret == false)
+        << "config no readCache.blockSizeKB info, using default value "
+        << readCacheOpt.blockSizeKB;
+
+    ret = conf_.GetStringValue("readCache.fileDir", &readCacheOpt.fileDir);
+    LOG_IF(WARNING, ret == false)
+        << "config no readCache.fileDir info, using memory only";
+
+    ret = conf_.GetUInt64Value("readCache.fileCapacityMB",
+                               &readCacheOpt.fileCapacityMB);
+    LOG_IF(WARNING, ret == false)
+        << "config no readCache.fileCapacityMB info, using default value "
+        << readCacheOpt.fileCapacityMB;
+
+    ReadaheadOption& readaheadOpt = fileServiceOption_.ioOpt.readaheadOpt;
+    ret = conf_.GetBoolValue("readahead.enable", &readaheadOpt.enable);
+    LOG_IF(WARNING, ret == false)
+        << "config no readahead.enable info, using default value "
+        << readaheadOpt.enable;
+
+    ret = conf_.GetUInt64Value("readahead.initWindowKB",
+                               &readaheadOpt.initWindowKB);
+    LOG_IF(WARNING, ret == false)
+        << "config no readahead.initWindowKB info, using default value "
+        << readaheadOpt.initWindowKB;
+
+    ret = conf_.GetUInt64Value("readahead.maxWindowKB",
+                               &readaheadOpt.maxWindowKB);
+    LOG_IF(WARNING, ret == false)
+        << "config no readahead.maxWindowKB info, using default value "
+        << readaheadOpt.maxWindowKB;
+
+    ret = conf_.GetUInt32Value("ioTrace.sampleRate",
+                               &fileServiceOption_.ioOpt.ioTraceOpt.sampleRate);
+    LOG_IF(WARNING, ret == false)
+        << "config no ioTrace.sampleRate info, using default value "
+        << fileServiceOption_.ioOpt.ioTraceOpt.sampleRate;
+
     // only client side need these follow 5 options
     ret = conf_.GetUInt32Value("csClientOpt.rpcTimeoutMs",
         &fileServiceOption_.csClientOpt.rpcTimeoutMs);
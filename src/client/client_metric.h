@@ -102,6 +102,77 @@ struct DiscardMetric {
     bvar::Adder<int64_t> pending;
 };
 
+struct ReadCacheMetric {
+    explicit ReadCacheMetric(const std::string& prefix)
+        : hit(prefix, "read_cache_hit"),
+          miss(prefix, "read_cache_miss"),
+          hitBytes(prefix, "read_cache_hit_bytes"),
+          fileHit(prefix, "read_cache_file_hit"),
+          memoryBytes(prefix, "read_cache_memory_bytes"),
+          fileBytes(prefix, "read_cache_file_bytes"),
+          readahead(prefix, "readahead_count"),
+          readaheadBytes(prefix, "readahead_bytes") {}
+
+    bvar::Adder<uint64_t> hit;
+    bvar::Adder<uint64_t> miss;
+    bvar::Adder<uint64_t> hitBytes;
+    // blocks read from the local cache file
+    bvar::Adder<uint64_t> fileHit;
+    bvar::Adder<int64_t> memoryBytes;
+    bvar::Adder<int64_t> fileBytes;
+    // readahead reads issued to fill the cache
+    bvar::Adder<uint64_t> readahead;
+    bvar::Adder<uint64_t> readaheadBytes;
+};
+
+struct WriteMergeMetric {
+    explicit WriteMergeMetric(const std::string& prefix)
+        : mergedRPC(prefix, "write_merge_rpc"),
+          mergedRequest(prefix, "write_merge_request"),
+          mergedBytes(prefix, "write_merge_bytes") {}
+
+    // write rpcs sent for merged requests
+    bvar::Adder<uint64_t> mergedRPC;
+    // requests merged into these rpcs
+    bvar::Adder<uint64_t> mergedRequest;
+    bvar::Adder<uint64_t> mergedBytes;
+};
+
+struct HedgedReadMetric {
+    explicit HedgedReadMetric(const std::string& prefix)
+        : candidateRPC(prefix, "hedged_read_candidate_rpc"),
+          hedgedRPC(prefix, "hedged_read_rpc"),
+          winRPC(prefix, "hedged_read_win_rpc") {}
+
+    // read rpcs which may be hedged
+    bvar::Adder<uint64_t> candidateRPC;
+    // read rpcs sent to the followers
+    bvar::Adder<uint64_t> hedgedRPC;
+    // follower reads returned before the leader
+    bvar::Adder<uint64_t> winRPC;
+};
+
+// latency of each stage on the client io path
+struct StageLatencyMetric {
+    explicit StageLatencyMetric(const std::string& prefix)
+        : taskQueue(prefix, "stage_task_queue_lat"),
+          scheduleQueue(prefix, "stage_schedule_queue_lat"),
+          getLeader(prefix, "stage_get_leader_lat"),
+          rpc(prefix, "stage_rpc_lat"),
+          retryBackoff(prefix, "stage_retry_backoff_lat") {}
+
+    // user IOs waiting in the task queue of IOManager4File
+    bvar::LatencyRecorder taskQueue;
+    // requests waiting in the RequestScheduler queue
+    bvar::LatencyRecorder scheduleQueue;
+    // looking up the copyset leader and its sender
+    bvar::LatencyRecorder getLeader;
+    // rpcs to chunkservers, retries included
+    bvar::LatencyRecorder rpc;
+    // waiting before retries, only requests that are retried
+    bvar::LatencyRecorder retryBackoff;
+};
+
 // 文件级别metric信息统计
 struct FileMetric {
     const std::string prefix = "curve_client";
@@ -136,6 +207,14 @@ struct FileMetric {
 
     DiscardMetric discardMetric;
 
+    ReadCacheMetric readCacheMetric;
+
+    WriteMergeMetric writeMergeMetric;
+
+    HedgedReadMetric hedgedReadMetric;
+
+    StageLatencyMetric stageLatencyMetric;
+
     explicit FileMetric(const std::string& name)
         : filename(name),
           inflightRPCNum(prefix, filename + "_inflight_rpc_num"),
@@ -149,7 +228,11 @@ struct FileMetric {
           userDiscard(prefix, filename + "_discard"),
           getLeaderRetryQPS(prefix, filename + "_get_leader_retry_rpc"),
           suspendRPCMetric(prefix, filename + "_suspend_io_num"),
-          discardMetric(prefix + filename) {}
+          discardMetric(prefix + filename),
+          readCacheMetric(prefix + filename),
+          writeMergeMetric(prefix + filename),
+          hedgedReadMetric(prefix + filename),
+          stageLatencyMetric(prefix + filename) {}
 };
 
 // 用于全局mds接口统计信息调用信息统计
@@ -500,6 +583,54 @@ class MetricHelper {
                 : fm->suspendRPCMetric.count << 0;
         }
     }
+
+    static void IncremWriteMerge(FileMetric* fm, uint64_t requests,
+                                 uint64_t bytes) {
+        if (fm != nullptr) {
+            fm->writeMergeMetric.mergedRPC << 1;
+            fm->writeMergeMetric.mergedRequest << requests;
+            fm->writeMergeMetric.mergedBytes << bytes;
+        }
+    }
+
+    static void IncremHedgedReadCandidate(FileMetric* fm) {
+        if (fm != nullptr) {
+            fm->hedgedReadMetric.candidateRPC << 1;
+        }
+    }
+
+    static void IncremHedgedRead(FileMetric* fm) {
+        if (fm != nullptr) {
+            fm->hedgedReadMetric.hedgedRPC << 1;
+        }
+    }
+
+    static void IncremHedgedReadWin(FileMetric* fm) {
+        if (fm != nullptr) {
+            fm->hedgedReadMetric.winRPC << 1;
+        }
+    }
+
+    static void TaskQueueLatencyRecord(FileMetric* fm, uint64_t duration) {
+        if (fm != nullptr) {
+            fm->stageLatencyMetric.taskQueue << duration;
+        }
+    }
+
+    static void StageLatencyRecord(FileMetric* fm,
+                                   uint64_t scheduleQueue,
+                                   uint64_t getLeader,
+                                   uint64_t rpc,
+                                   uint64_t retryBackoff) {
+        if (fm != nullptr) {
+            fm->stageLatencyMetric.scheduleQueue << scheduleQueue;
+            fm->stageLatencyMetric.getLeader << getLeader;
+            fm->stageLatencyMetric.rpc << rpc;
+            if (retryBackoff > 0) {
+                fm->stageLatencyMetric.retryBackoff << retryBackoff;
+            }
+        }
+    }
 };
 }   // namespace client
 }   // namespace curve
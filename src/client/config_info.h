@@ -154,16 +154,72 @@ struct FailureRequestOption {
     uint64_t chunkserverMaxRetryTimesBeforeConsiderSuspend = 20;
 };
 
+/**
+ * 发给同一个chunkserver的读写请求合并成一个rpc发送的配置
+ * @enable: 是否开启
+ * @maxBatchSize: 一个rpc中最多的请求个数，达到之后立即发送
+ * @tickUs: 第一个请求等待合并的最长时间，超时之后把已有的请求发送出去
+ */
+struct BatchRPCOption {
+    bool enable = false;
+    uint32_t maxBatchSize = 32;
+    uint32_t tickUs = 50;
+};
+
+/**
+ * hedged read的配置，读leader的请求在一定时间内没有返回的时候，再向一个
+ * follower发送携带applied index的读请求，使用先返回的结果
+ * 需要同时开启chunkserver.enableAppliedIndexRead
+ * @enable: 是否开启
+ * @minDelayUs: 发送follower请求前等待的最短时间
+ * @maxDelayUs: 发送follower请求前等待的最长时间，等待时间在两者之间取
+ *              leader的读请求延时的p95
+ */
+struct HedgedReadOption {
+    bool enable = false;
+    uint32_t minDelayUs = 1000;
+    uint32_t maxDelayUs = 50000;
+};
+
 /**
  * 发送rpc给chunkserver的配置
  * @chunkserverEnableAppliedIndexRead: 是否开启使用appliedindex read
  * @inflightOpt: 一个文件向chunkserver发送请求时的inflight 请求控制配置
  * @failRequestOpt: rpc发送失败之后，需要进行rpc重试的相关配置
+ * @batchOpt: 合并发送读写请求的配置
+ * @hedgedReadOpt: hedged read的配置
  */
 struct IOSenderOption {
     bool chunkserverEnableAppliedIndexRead;
     InFlightIOCntlInfo inflightOpt;
     FailureRequestOption failRequestOpt;
+    BatchRPCOption batchOpt;
+    HedgedReadOption hedgedReadOpt;
+};
+
+/**
+ * schedule模块合并写请求的配置
+ * @enable: 是否把队列中同一个chunk上连续的写请求合并成一个rpc
+ * @maxSizeKB: 合并之后一个写请求的最大长度
+ * @waitUs: 队列为空的时候，等待后续连续写请求的最长时间，0表示不等待
+ */
+struct WriteMergeOption {
+    bool enable = false;
+    uint32_t maxSizeKB = 128;
+    uint32_t waitUs = 0;
+};
+
+/**
+ * schedule模块多队列的配置
+ * @enable: 是否每个调度线程使用一个单独的无锁队列，请求按照chunk分配到
+ *          队列中，同一个chunk上的请求保持顺序，多队列模式下不合并写请求
+ * @queueCapacity: 每个队列的深度，队列的空间是预先分配的
+ * @cpuList: 调度线程绑定的cpu，以逗号分隔，依次绑定到每个线程，为空时不绑定
+ */
+struct MultiQueueOption {
+    bool enable = false;
+    uint32_t queueCapacity = 8192;
+    std::string cpuList;
 };
 
 /**
@@ -171,11 +227,15 @@ struct IOSenderOption {
  * 线程池，线程池中的线程各自配置一个队列
  * @scheduleQueueCapacity: schedule模块配置的队列深度
  * @scheduleThreadpoolSize: schedule模块线程池大小
+ * @writeMergeOpt: 合并写请求的配置
+ * @multiQueueOpt: 多队列的配置
  */
 struct RequestScheduleOption {
     uint32_t scheduleQueueCapacity = 1024;
     uint32_t scheduleThreadpoolSize = 2;
     IOSenderOption ioSenderOpt;
+    WriteMergeOption writeMergeOpt;
+    MultiQueueOption multiQueueOpt;
 };
 
 /**
@@ -252,6 +312,46 @@ struct ThrottleOption {
     bool enable = false;
 };
 
+/**
+ * client read cache config
+ * @enable: whether to cache data read by user
+ * @capacityMB: memory capacity of each opened file
+ * @blockSizeKB: data is cached in blocks of this size
+ * @fileDir: directory of the local cache file, which holds blocks evicted
+ *           from memory, empty means memory only
+ * @fileCapacityMB: capacity of the local cache file of each opened file
+ */
+struct ReadCacheOption {
+    bool enable = false;
+    uint64_t capacityMB = 256;
+    uint32_t blockSizeKB = 64;
+    std::string fileDir;
+    uint64_t fileCapacityMB = 0;
+};
+
+/**
+ * client sequential readahead config, prefetched data is kept in the read
+ * cache, so the read cache is used even if it's not enabled
+ * @enable: whether to prefetch for sequential reads
+ * @initWindowKB: size of the first readahead window of a sequential stream
+ * @maxWindowKB: readahead window doubles on hits up to this size
+ */
+struct ReadaheadOption {
+    bool enable = false;
+    uint64_t initWindowKB = 1024;
+    uint64_t maxWindowKB = 16384;
+};
+
+/**
+ * client io latency tracing config
+ * @sampleRate: dump the per-stage latencies of one in every sampleRate user
+ *              IOs to the log, 0 means no dump. Per-stage latency metrics
+ *              are always exported.
+ */
+struct IOTraceOption {
+    uint32_t sampleRate = 0;
+};
+
 /**
  * IOOption存储了当前io 操作所需要的所有配置信息
  */
@@ -264,6 +364,9 @@ struct IOOption {
     CloseFdThreadOption closeFdThreadOption;
     ThrottleOption throttleOption;
     DiscardOption discardOption;
+    ReadCacheOption readCacheOpt;
+    ReadaheadOption readaheadOpt;
+    IOTraceOption ioTraceOpt;
 };
 
 /**
@@ -27,11 +27,13 @@
 #include <memory>
 #include <utility>
 
+#include "src/client/hedged_read.h"
 #include "src/client/request_sender.h"
 #include "src/client/metacache.h"
 #include "src/client/client_config.h"
 #include "src/client/request_scheduler.h"
 #include "src/client/request_closure.h"
+#include "src/common/timeutility.h"
 
 namespace curve {
 namespace client {
@@ -124,6 +126,16 @@ int CopysetClient::ReadChunk(const ChunkIDInfo& idinfo, uint64_t sn,
 
     auto task = [&](Closure* done, std::shared_ptr<RequestSender> senderPtr) {
         ReadChunkClosure *readDone = new ReadChunkClosure(this, done);
+        // a follower only serves reads of the data applied at appliedindex,
+        // and has no clone source to fill the data with
+        if (iosenderopt_.hedgedReadOpt.enable &&
+            iosenderopt_.chunkserverEnableAppliedIndexRead &&
+            appliedindex > 0 && !sourceInfo.IsValid()) {
+            readDone->SetHedgedRead(HedgedRead::Start(
+                this, senderPtr, idinfo, offset, length, appliedindex,
+                static_cast<RequestClosure*>(done),
+                iosenderopt_.hedgedReadOpt));
+        }
         senderPtr->ReadChunk(idinfo, sn, offset, length,
                              appliedindex, sourceInfo, readDone);
     };
@@ -252,6 +264,9 @@ int CopysetClient::DoRPCTask(const ChunkIDInfo& idinfo,
     butil::EndPoint leaderAddr;
     brpc::ClosureGuard doneGuard(done);
 
+    RequestContext* reqCtx = reqclosure->GetReqCtx();
+    uint64_t startUs = TimeUtility::GetTimeofDayUs();
+
     while (reqclosure->GetRetriedTimes() <
         iosenderopt_.failRequestOpt.chunkserverOPMaxRetry) {
         reqclosure->IncremRetriedTimes();
@@ -265,6 +280,10 @@ int CopysetClient::DoRPCTask(const ChunkIDInfo& idinfo,
         auto senderPtr = senderManager_->GetOrCreateSender(leaderId,
                                         leaderAddr, iosenderopt_);
         if (nullptr != senderPtr) {
+            if (reqCtx != nullptr) {
+                reqCtx->trace_.getLeaderUs +=
+                    TimeUtility::GetTimeofDayUs() - startUs;
+            }
             task(doneGuard.release(), senderPtr);
             break;
         } else {
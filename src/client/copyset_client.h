@@ -190,6 +190,17 @@ class CopysetClient {
         senderManager_->ResetSenderIfNotHealth(csId);
     }
 
+    /**
+     * @brief 获取chunkserver的RequestSender，hedged read向follower发送请求
+     * @param csId chunkserver id
+     * @param addr chunkserver的地址
+     * @return nullptr:get或者create失败，否则成功
+     */
+    std::shared_ptr<RequestSender> GetSender(const ChunkServerID& csId,
+                                             const butil::EndPoint& addr) {
+        return senderManager_->GetOrCreateSender(csId, addr, iosenderopt_);
+    }
+
     /**
      * session过期，需要将重试RPC停住
      */
@@ -0,0 +1,251 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/client/hedged_read.h"
+
+#include <bthread/bthread.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#include "src/client/client_metric.h"
+#include "src/client/copyset_client.h"
+#include "src/client/metacache.h"
+#include "src/client/request_closure.h"
+#include "src/client/request_context.h"
+#include "src/client/request_sender.h"
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace client {
+
+using curve::chunkserver::CHUNK_OP_STATUS;
+using curve::common::TimeUtility;
+
+namespace {
+
+class FollowerReadClosure : public google::protobuf::Closure {
+ public:
+    FollowerReadClosure(std::shared_ptr<HedgedRead> hedgedRead,
+                        std::shared_ptr<RequestSender> follower)
+        : hedgedRead_(std::move(hedgedRead)),
+          follower_(std::move(follower)) {}
+
+    void Run() override {
+        std::unique_ptr<FollowerReadClosure> selfGuard(this);
+        hedgedRead_->OnFollowerDone(follower_, &cntl, response);
+    }
+
+    brpc::Controller cntl;
+    curve::chunkserver::ChunkResponse response;
+
+ private:
+    std::shared_ptr<HedgedRead> hedgedRead_;
+    std::shared_ptr<RequestSender> follower_;
+};
+
+}  // namespace
+
+LatencyQuantile::LatencyQuantile(double quantile, double step)
+    : upRatio_(1 + step * quantile),
+      downRatio_(1 - step * (1 - quantile)),
+      estimate_(0) {}
+
+void LatencyQuantile::Add(int64_t latencyUs) {
+    double sample = std::max<int64_t>(latencyUs, 1);
+    double est = estimate_.load(std::memory_order_relaxed);
+    if (est == 0) {
+        est = sample;
+    } else if (sample > est) {
+        est *= upRatio_;
+    } else {
+        est *= downRatio_;
+    }
+    estimate_.store(est, std::memory_order_relaxed);
+}
+
+int64_t LatencyQuantile::Get() const {
+    return static_cast<int64_t>(estimate_.load(std::memory_order_relaxed));
+}
+
+std::shared_ptr<HedgedRead> HedgedRead::Start(
+    CopysetClient* client, const std::shared_ptr<RequestSender>& leader,
+    const ChunkIDInfo& idinfo, off_t offset, size_t length,
+    uint64_t appliedindex, RequestClosure* done, const HedgedReadOption& opt) {
+    MetricHelper::IncremHedgedReadCandidate(done->GetMetric());
+
+    // wait for the slowest one in twenty of the leader's reads
+    int64_t delayUs = leader->ReadLatency()->Get();
+    if (delayUs <= 0) {
+        delayUs = opt.maxDelayUs;
+    }
+    delayUs = std::max<int64_t>(delayUs, opt.minDelayUs);
+    delayUs = std::min<int64_t>(delayUs, opt.maxDelayUs);
+
+    auto hedgedRead = std::make_shared<HedgedRead>(
+        client, leader, idinfo, offset, length, appliedindex, done);
+    auto* arg = new std::shared_ptr<HedgedRead>(hedgedRead);
+    hedgedRead->timerArg_ = arg;
+    int ret = bthread_timer_add(&hedgedRead->timer_,
+                                butil::microseconds_from_now(delayUs),
+                                &HedgedRead::OnTimer, arg);
+    if (ret != 0) {
+        LOG_EVERY_SECOND(WARNING) << "bthread_timer_add failed, ret = " << ret
+                                  << ", read from leader only";
+        delete arg;
+        return nullptr;
+    }
+
+    return hedgedRead;
+}
+
+HedgedRead::HedgedRead(CopysetClient* client,
+                       const std::shared_ptr<RequestSender>& leader,
+                       const ChunkIDInfo& idinfo, off_t offset, size_t length,
+                       uint64_t appliedindex, RequestClosure* done)
+    : finished_(false),
+      timer_(0),
+      timerArg_(nullptr),
+      client_(client),
+      leader_(leader),
+      idinfo_(idinfo),
+      offset_(offset),
+      length_(length),
+      appliedindex_(appliedindex),
+      done_(done),
+      fileMetric_(done->GetMetric()),
+      startUs_(TimeUtility::GetTimeofDayUs()) {}
+
+bool HedgedRead::OnLeaderDone(int64_t latencyUs) {
+    if (latencyUs >= 0) {
+        leader_->ReadLatency()->Add(latencyUs);
+    }
+
+    // the timer is removed before it runs, drop its reference
+    if (bthread_timer_del(timer_) == 0) {
+        delete timerArg_;
+        timerArg_ = nullptr;
+    }
+
+    return !finished_.exchange(true, std::memory_order_acq_rel);
+}
+
+void HedgedRead::OnTimer(void* arg) {
+    auto* hedgedRead = static_cast<std::shared_ptr<HedgedRead>*>(arg);
+    if ((*hedgedRead)->finished_.load(std::memory_order_acquire)) {
+        delete hedgedRead;
+        return;
+    }
+
+    bthread_t tid;
+    if (bthread_start_background(&tid, nullptr,
+                                 &HedgedRead::SendToFollower,
+                                 hedgedRead) != 0) {
+        LOG_EVERY_SECOND(WARNING) << "start bthread for hedged read failed";
+        delete hedgedRead;
+    }
+}
+
+void* HedgedRead::SendToFollower(void* arg) {
+    std::unique_ptr<std::shared_ptr<HedgedRead>> hedgedRead(
+        static_cast<std::shared_ptr<HedgedRead>*>(arg));
+    (*hedgedRead)->SendToFollower();
+    return nullptr;
+}
+
+void HedgedRead::SendToFollower() {
+    if (finished_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    CopysetInfo<ChunkServerID> copyset =
+        client_->GetMetaCache()->GetServerList(idinfo_.lpid_, idinfo_.cpid_);
+
+    // pick the follower with the lowest read latency, a chunkserver
+    // without samples is tried first
+    std::shared_ptr<RequestSender> follower;
+    int64_t followerLatency = 0;
+    for (const auto& peer : copyset.csinfos_) {
+        if (peer.peerID == leader_->GetChunkServerID()) {
+            continue;
+        }
+
+        auto sender = client_->GetSender(peer.peerID, peer.externalAddr.addr_);
+        if (sender == nullptr || !sender->IsSocketHealth()) {
+            continue;
+        }
+
+        int64_t latency = sender->ReadLatency()->Get();
+        if (follower == nullptr || latency < followerLatency) {
+            follower = sender;
+            followerLatency = latency;
+        }
+    }
+
+    if (follower == nullptr) {
+        return;
+    }
+
+    MetricHelper::IncremHedgedRead(fileMetric_);
+    auto* closure = new FollowerReadClosure(shared_from_this(), follower);
+    follower->FollowerReadChunk(idinfo_, offset_, length_, appliedindex_,
+                                &closure->cntl, &closure->response, closure);
+}
+
+void HedgedRead::OnFollowerDone(
+    const std::shared_ptr<RequestSender>& follower, brpc::Controller* cntl,
+    const curve::chunkserver::ChunkResponse& response) {
+    if (cntl->Failed() ||
+        response.status() != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+        // the follower is lagging behind or isn't able to serve the read,
+        // wait for the leader
+        VLOG(3) << "hedged read failed, error code: " << cntl->ErrorCode()
+                << ", status: " << response.status()
+                << ", chunkserver id: " << follower->GetChunkServerID()
+                << ", logical pool id: " << idinfo_.lpid_
+                << ", copyset id: " << idinfo_.cpid_
+                << ", chunk id: " << idinfo_.cid_;
+        return;
+    }
+
+    follower->ReadLatency()->Add(cntl->latency_us());
+
+    if (finished_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    // the read took from sending to the leader until the follower returned
+    uint64_t latencyUs = TimeUtility::GetTimeofDayUs() - startUs_;
+    RequestContext* reqCtx = done_->GetReqCtx();
+    reqCtx->readData_ = cntl->response_attachment();
+    reqCtx->trace_.rpcUs += latencyUs;
+    done_->SetFailed(0);
+
+    MetricHelper::IncremHedgedReadWin(fileMetric_);
+    MetricHelper::LatencyRecord(fileMetric_, latencyUs, OpType::READ);
+    MetricHelper::IncremRPCQPSCount(fileMetric_, length_, OpType::READ);
+
+    done_->Run();
+}
+
+}  // namespace client
+}  // namespace curve
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CLIENT_HEDGED_READ_H_
+#define SRC_CLIENT_HEDGED_READ_H_
+
+#include <brpc/controller.h>
+#include <bthread/unstable.h>
+
+#include <atomic>
+#include <memory>
+
+#include "proto/chunk.pb.h"
+#include "src/client/client_common.h"
+#include "src/client/config_info.h"
+
+namespace curve {
+namespace client {
+
+class CopysetClient;
+class RequestClosure;
+class RequestSender;
+struct FileMetric;
+
+/**
+ * 流式估计延时的分位值，不保存样本
+ *
+ * 样本大于估计值时估计值按quantile的比例增大，小于时按1-quantile的比例减小，
+ * 稳定之后大于估计值的样本占1-quantile。并发更新时可能丢失个别样本，不影响估计
+ */
+class LatencyQuantile {
+ public:
+    explicit LatencyQuantile(double quantile = 0.95, double step = 0.01);
+
+    void Add(int64_t latencyUs);
+
+    // 当前的估计值，还没有样本的时候返回0
+    int64_t Get() const;
+
+ private:
+    const double upRatio_;
+    const double downRatio_;
+    std::atomic<double> estimate_;
+};
+
+/**
+ * 一个读请求的hedged read状态
+ *
+ * 读请求发给leader的同时启动定时器，等待时间为leader所在chunkserver读延时的
+ * p95，定时器到期时leader还没有返回，就向一个follower发送携带applied index
+ * 的读请求。leader的返回和follower的成功返回中先到的完成读请求，另一个丢弃
+ */
+class HedgedRead : public std::enable_shared_from_this<HedgedRead> {
+ public:
+    /**
+     * 启动hedged read的定时器
+     * @param client: 读请求所在的copyset client
+     * @param leader: 发送leader读请求的sender
+     * @param idinfo: chunk的id信息
+     * @param offset: 读的偏移
+     * @param length: 读的长度
+     * @param appliedindex: follower需要读到>=appliedindex的数据
+     * @param done: 读请求的closure
+     * @param opt: hedged read配置
+     * @return 失败返回nullptr，这时只读leader
+     */
+    static std::shared_ptr<HedgedRead> Start(
+        CopysetClient* client,
+        const std::shared_ptr<RequestSender>& leader,
+        const ChunkIDInfo& idinfo,
+        off_t offset,
+        size_t length,
+        uint64_t appliedindex,
+        RequestClosure* done,
+        const HedgedReadOption& opt);
+
+    HedgedRead(CopysetClient* client,
+               const std::shared_ptr<RequestSender>& leader,
+               const ChunkIDInfo& idinfo,
+               off_t offset,
+               size_t length,
+               uint64_t appliedindex,
+               RequestClosure* done);
+
+    /**
+     * leader的读请求返回
+     * @param latencyUs: leader读请求的延时，rpc失败时为-1
+     * @return leader先返回时为true，由leader的closure完成读请求；
+     *         follower已经完成读请求时为false
+     */
+    bool OnLeaderDone(int64_t latencyUs);
+
+    /**
+     * follower的读请求返回，follower先成功返回时完成读请求
+     * @param follower: 发送follower读请求的sender
+     */
+    void OnFollowerDone(const std::shared_ptr<RequestSender>& follower,
+                        brpc::Controller* cntl,
+                        const curve::chunkserver::ChunkResponse& response);
+
+ private:
+    // 定时器到期，在bthread中发送follower读请求，定时器回调中不能阻塞
+    static void OnTimer(void* arg);
+
+    static void* SendToFollower(void* arg);
+
+    void SendToFollower();
+
+ private:
+    // leader或者follower已经完成了读请求
+    std::atomic<bool> finished_;
+
+    bthread_timer_t timer_;
+    // 定时器回调持有的引用，定时器删除成功时释放
+    std::shared_ptr<HedgedRead>* timerArg_;
+
+    CopysetClient* client_;
+    std::shared_ptr<RequestSender> leader_;
+    ChunkIDInfo idinfo_;
+    off_t offset_;
+    size_t length_;
+    uint64_t appliedindex_;
+
+    // 只在follower完成读请求的时候访问，leader完成之后done_已经释放
+    RequestClosure* done_;
+    FileMetric* fileMetric_;
+    uint64_t startUs_;
+};
+
+}  // namespace client
+}  // namespace curve
+
+#endif  // SRC_CLIENT_HEDGED_READ_H_
@@ -23,17 +23,40 @@
 #ifndef SRC_CLIENT_INFLIGHT_CONTROLLER_H_
 #define SRC_CLIENT_INFLIGHT_CONTROLLER_H_
 
-#include "src/common/concurrent/concurrent.h"
+#include <bthread/butex.h>
+#include <butil/atomicops.h>
+#include <glog/logging.h>
+
+#include <atomic>
 
 namespace curve {
 namespace client {
 
-using curve::common::Mutex;
-using curve::common::ConditionVariable;
-
+/**
+ * inflight计数和令牌控制
+ *
+ * 计数使用原子变量，获取和释放令牌的快速路径不加锁。只有在有等待者的时候，
+ * 释放令牌才会通过butex唤醒等待者，butex既可以在pthread中也可以在bthread
+ * 中等待，bthread等待的时候不会阻塞所在的worker线程。
+ */
 class InflightControl {
  public:
-    InflightControl() = default;
+    InflightControl()
+        : comeBackButex_(
+              bthread::butex_create_checked<butil::atomic<int>>()),
+          allComeBackButex_(
+              bthread::butex_create_checked<butil::atomic<int>>()) {
+        comeBackButex_->store(0, butil::memory_order_relaxed);
+        allComeBackButex_->store(0, butil::memory_order_relaxed);
+    }
+
+    ~InflightControl() {
+        bthread::butex_destroy(comeBackButex_);
+        bthread::butex_destroy(allComeBackButex_);
+    }
+
+    InflightControl(const InflightControl&) = delete;
+    InflightControl& operator=(const InflightControl&) = delete;
 
     void SetMaxInflightNum(uint64_t maxInflightNum) {
         maxInflightNum_ = maxInflightNum;
@@ -45,9 +68,8 @@ class InflightControl {
      */
     void WaitInflightAllComeBack() {
         LOG(INFO) << "wait inflight to complete, count = " << curInflightIONum_;
-        std::unique_lock<std::mutex> lk(inflightAllComeBackmtx_);
-        inflightAllComeBackcv_.wait(lk, [this]() {
-            return curInflightIONum_.load(std::memory_order_acquire) == 0;
+        Wait(allComeBackButex_, &allComeBackWaiters_, [this]() {
+            return curInflightIONum_.load(std::memory_order_seq_cst) == 0;
         });
         LOG(INFO) << "inflight ALL come back.";
     }
@@ -56,14 +78,15 @@ class InflightControl {
      * @brief 调用该接口等待inflight回来，这段期间是hang的
      */
     void WaitInflightComeBack() {
-        if (curInflightIONum_.load(std::memory_order_acquire) >=
+        if (curInflightIONum_.load(std::memory_order_acquire) <
             maxInflightNum_) {
-            std::unique_lock<Mutex> lk(inflightComeBackmtx_);
-            inflightComeBackcv_.wait(lk, [this]() {
-                return curInflightIONum_.load(std::memory_order_acquire) <
-                       maxInflightNum_;
-            });
+            return;
         }
+
+        Wait(comeBackButex_, &comeBackWaiters_, [this]() {
+            return curInflightIONum_.load(std::memory_order_seq_cst) <
+                   maxInflightNum_;
+        });
     }
 
     /**
@@ -74,35 +97,41 @@ class InflightControl {
     }
 
     /**
-     * @brief 递减inflight num
+     * @brief 递减inflight num，只有在有等待者的时候才唤醒
      */
     void DecremInflightNum() {
-        std::lock_guard<Mutex> lk(inflightComeBackmtx_);
-        {
-            std::lock_guard<Mutex> lk(inflightAllComeBackmtx_);
-            const auto cnt =
-                curInflightIONum_.fetch_sub(1, std::memory_order_acq_rel);
-            if (cnt == 1) {
-                inflightAllComeBackcv_.notify_all();
-            }
+        // seq_cst pairs with the waiters, either they see the new count or
+        // we see them waiting
+        const auto cnt =
+            curInflightIONum_.fetch_sub(1, std::memory_order_seq_cst);
+        if (comeBackWaiters_.load(std::memory_order_seq_cst) != 0) {
+            Wake(comeBackButex_, false);
+        }
+        if (cnt == 1 &&
+            allComeBackWaiters_.load(std::memory_order_seq_cst) != 0) {
+            Wake(allComeBackButex_, true);
         }
-        inflightComeBackcv_.notify_one();
     }
 
     /**
-     * WaitInflightComeBack会检查当前未返回的io数量是否超过我们限制的最大未返回inflight数量
-     * 但是真正的inflight数量与上层并发调用的线程数有关。
-     * 假设我们设置的maxinflight=100，上层有三个线程在同时调用GetInflightToken，
-     * 如果这个时候inflight数量为99，那么并发状况下这3个线程在WaitInflightComeBack
-     * 都会通过然后向下并发执行IncremInflightNum，这个时候真正的inflight为102，
-     * 下一个下发的时候需要等到inflight数量小于100才能继续，也就是等至少3个IO回来才能继续
-     * 下发。这个误差是可以接受的，他与scheduler一侧并发度有关，误差有上限。
-     * 如果想要精确控制inflight数量，就需要在接口处加锁，让原本可以并发的逻辑变成了
-     * 串行，这样得不偿失。因此我们这里选择容忍一定误差范围。
+     * 获取令牌，inflight数量没有达到上限的时候通过CAS直接获取，否则等待
+     * 有令牌释放之后再重新获取，因此inflight数量不会超过上限
      */
     void GetInflightToken() {
-        WaitInflightComeBack();
-        IncremInflightNum();
+        uint64_t cur = curInflightIONum_.load(std::memory_order_relaxed);
+        while (true) {
+            if (cur < maxInflightNum_) {
+                if (curInflightIONum_.compare_exchange_weak(
+                        cur, cur + 1, std::memory_order_seq_cst,
+                        std::memory_order_relaxed)) {
+                    return;
+                }
+                continue;
+            }
+
+            WaitInflightComeBack();
+            cur = curInflightIONum_.load(std::memory_order_relaxed);
+        }
     }
 
     void ReleaseInflightToken() {
@@ -116,14 +145,43 @@ class InflightControl {
         return curInflightIONum_.load(std::memory_order_acquire);
     }
 
+ private:
+    template <typename Pred>
+    static void Wait(butil::atomic<int>* butex,
+                     std::atomic<uint32_t>* waiters,
+                     Pred pred) {
+        waiters->fetch_add(1, std::memory_order_seq_cst);
+        while (true) {
+            // a wake between reading the butex and waiting on it changes
+            // the value, so butex_wait returns at once
+            const int expected = butex->load(butil::memory_order_acquire);
+            if (pred()) {
+                break;
+            }
+            bthread::butex_wait(butex, expected, nullptr);
+        }
+        waiters->fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    static void Wake(butil::atomic<int>* butex, bool all) {
+        butex->fetch_add(1, butil::memory_order_release);
+        if (all) {
+            bthread::butex_wake_all(butex);
+        } else {
+            bthread::butex_wake(butex);
+        }
+    }
+
  private:
     uint64_t              maxInflightNum_ = 0;
     std::atomic<uint64_t> curInflightIONum_{0};
 
-    Mutex                 inflightComeBackmtx_;
-    ConditionVariable     inflightComeBackcv_;
-    Mutex                 inflightAllComeBackmtx_;
-    ConditionVariable     inflightAllComeBackcv_;
+    // waiters of WaitInflightComeBack and WaitInflightAllComeBack, wake up
+    // only when somebody is waiting
+    std::atomic<uint32_t> comeBackWaiters_{0};
+    std::atomic<uint32_t> allComeBackWaiters_{0};
+    butil::atomic<int>*   comeBackButex_;
+    butil::atomic<int>*   allComeBackButex_;
 };
 
 }   //  namespace client
@@ -35,6 +35,7 @@
 #include "src/client/source_reader.h"
 #include "src/client/metacache_struct.h"
 #include "src/client/discard_task.h"
+#include "src/client/read_cache.h"
 
 namespace curve {
 namespace client {
@@ -43,6 +44,7 @@ using curve::chunkserver::CHUNK_OP_STATUS;
 
 std::atomic<uint64_t> IOTracker::tracekerID_(1);
 DiscardOption IOTracker::discardOption_;
+IOTraceOption IOTracker::ioTraceOption_;
 
 IOTracker::IOTracker(IOManager* iomanager,
                      MetaCache* mc,
@@ -53,7 +55,11 @@ IOTracker::IOTracker(IOManager* iomanager,
       scheduler_(scheduler),
       iomanager_(iomanager),
       fileMetric_(clientMetric),
-      disableStripe_(disableStripe) {
+      disableStripe_(disableStripe),
+      readCache_(nullptr),
+      readCacheSeq_(0),
+      readCacheHit_(false),
+      readahead_(false) {
     id_         = tracekerID_.fetch_add(1, std::memory_order_relaxed);
     scc_        = nullptr;
     aioctx_     = nullptr;
@@ -65,6 +71,7 @@ IOTracker::IOTracker(IOManager* iomanager,
     reqlist_.clear();
     reqcount_.store(0, std::memory_order_release);
     opStartTimePoint_ = curve::common::TimeUtility::GetTimeofDayUs();
+    taskQueueUs_ = 0;
 }
 
 void IOTracker::ReleaseAllSegmentLocks() {
@@ -88,6 +95,8 @@ void IOTracker::StartRead(void* buf, off_t offset, size_t length,
 
 void IOTracker::StartAioRead(CurveAioContext* ctx, MDSClient* mdsclient,
                              const FInfo_t* fileInfo, Throttle* throttle) {
+    RecordTaskQueueLatency();
+
     aioctx_ = ctx;
     data_ = ctx->buf;
     offset_ = ctx->offset;
@@ -102,6 +111,19 @@ void IOTracker::StartAioRead(CurveAioContext* ctx, MDSClient* mdsclient,
 
 void IOTracker::DoRead(MDSClient* mdsclient, const FInfo_t* fileInfo,
                        Throttle* throttle) {
+    // cache hits don't go to chunkservers, so they aren't throttled
+    if (readCache_ != nullptr) {
+        butil::IOBuf data;
+        if (!readahead_ && readCache_->Get(offset_, length_, &data)) {
+            readCacheHit_ = true;
+            PrepareReadIOBuffers(1);
+            SetReadData(0, data);
+            Done();
+            return;
+        }
+        readCacheSeq_ = readCache_->Sequence(offset_, length_);
+    }
+
     if (throttle) {
         throttle->Add(true, length_);
     }
@@ -109,7 +131,7 @@ void IOTracker::DoRead(MDSClient* mdsclient, const FInfo_t* fileInfo,
     int ret = Splitor::IO2ChunkRequests(this, mc_, &reqlist_, nullptr, offset_,
                                         length_, mdsclient, fileInfo, nullptr);
     if (ret == 0) {
-        PrepareReadIOBuffers(reqlist_.size());
+        PrepareRead();
         uint32_t subIoIndex = 0;
         std::vector<RequestContext*> originReadVec;
 
@@ -177,6 +199,8 @@ void IOTracker::StartWrite(const void* buf, off_t offset, size_t length,
 void IOTracker::StartAioWrite(CurveAioContext* ctx, MDSClient* mdsclient,
                               const FInfo_t* fileInfo, const FileEpoch* fEpoch,
                               Throttle* throttle) {
+    RecordTaskQueueLatency();
+
     aioctx_ = ctx;
     data_ = ctx->buf;
     offset_ = ctx->offset;
@@ -207,6 +231,10 @@ void IOTracker::DoWrite(MDSClient* mdsclient, const FInfo_t* fileInfo,
             break;
     }
 
+    if (readCache_ != nullptr) {
+        readCache_->Invalidate(offset_, length_);
+    }
+
     if (throttle) {
         throttle->Add(false, length_);
     }
@@ -248,6 +276,8 @@ void IOTracker::StartDiscard(off_t offset, size_t length, MDSClient* mdsclient,
 void IOTracker::StartAioDiscard(CurveAioContext* ctx, MDSClient* mdsclient,
                                 const FInfo_t* fileInfo,
                                 DiscardTaskManager* taskManager) {
+    RecordTaskQueueLatency();
+
     aioctx_ = ctx;
     offset_ = ctx->offset;
     length_ = ctx->length;
@@ -258,6 +288,10 @@ void IOTracker::StartAioDiscard(CurveAioContext* ctx, MDSClient* mdsclient,
 
 void IOTracker::DoDiscard(MDSClient* mdsClient, const FInfo* fileInfo,
                           DiscardTaskManager* taskManager) {
+    if (readCache_ != nullptr) {
+        readCache_->Invalidate(offset_, length_);
+    }
+
     int ret = Splitor::IO2ChunkRequests(this, mc_, &reqlist_, nullptr, offset_,
                                         length_, mdsClient, fileInfo, nullptr);
 
@@ -298,7 +332,7 @@ void IOTracker::ReadSnapChunk(const ChunkIDInfo &cinfo,
         ret = Splitor::SingleChunkIO2ChunkRequests(
             this, mc_, &reqlist_, cinfo, nullptr, offset_, length_, seq);
         if (ret == 0) {
-            PrepareReadIOBuffers(reqlist_.size());
+            PrepareRead();
             uint32_t subIoIndex = 0;
             reqcount_.store(reqlist_.size(), std::memory_order_release);
 
@@ -432,6 +466,46 @@ void IOTracker::RecoverChunk(const ChunkIDInfo& cinfo, uint64_t offset,
     }
 }
 
+void IOTracker::PrepareRead() {
+    // the read cache needs the whole IOBuf of the IO
+    if (userDataType_ == UserDataType::RawBuffer && readCache_ == nullptr) {
+        PrepareReadUserBuffer(reqlist_);
+    } else {
+        PrepareReadIOBuffers(reqlist_.size());
+    }
+}
+
+void IOTracker::PrepareReadUserBuffer(
+    const std::vector<RequestContext*>& reqlist) {
+    readDataOffsets_.resize(reqlist.size());
+    uint64_t offset = 0;
+    for (size_t i = 0; i < reqlist.size(); ++i) {
+        readDataOffsets_[i] = offset;
+        offset += reqlist[i]->rawlength_;
+    }
+}
+
+void IOTracker::CopyToUserBuffer(RequestContext* reqctx) {
+    if (reqctx->done_->GetErrorCode() != 0) {
+        return;
+    }
+
+    // the response is copied in the rpc thread, and its blocks are released
+    // without waiting for the other sub-requests
+    char* dst = static_cast<char*>(data_) +
+                readDataOffsets_[reqctx->subIoIndex_];
+    size_t nc = reqctx->readData_.copy_to(dst, reqctx->rawlength_);
+    if (nc != reqctx->rawlength_) {
+        errcode_ = LIBCURVE_ERROR::FAILED;
+        LOG(ERROR) << "IO Error, copy data to read buffer failed, "
+                   << ", filename: " << fileMetric_->filename
+                   << ", offset: " << offset_
+                   << ", length: " << length_
+                   << ", " << *reqctx;
+    }
+    reqctx->readData_.clear();
+}
+
 void IOTracker::FillCommonFields(ChunkIDInfo idinfo, RequestContext* req) {
     req->optype_      = type_;
     req->idinfo_      = idinfo;
@@ -445,9 +519,21 @@ void IOTracker::HandleResponse(RequestContext* reqctx) {
                                    &errcode_);
     }
 
+    // fake requests of unallocated chunks don't go through the stages
+    const RequestTrace& trace = reqctx->trace_;
+    if (trace.rpcUs > 0) {
+        MetricHelper::StageLatencyRecord(fileMetric_, trace.scheduleQueueUs,
+                                         trace.getLeaderUs, trace.rpcUs,
+                                         trace.retryBackoffUs);
+    }
+
     // copy read data
     if (OpType::READ == type_ || OpType::READ_SNAP == type_) {
-        SetReadData(reqctx->subIoIndex_, reqctx->readData_);
+        if (!readDataOffsets_.empty()) {
+            CopyToUserBuffer(reqctx);
+        } else {
+            SetReadData(reqctx->subIoIndex_, reqctx->readData_);
+        }
     }
 
     if (1 == reqcount_.fetch_sub(1, std::memory_order_acq_rel)) {
@@ -459,6 +545,36 @@ void IOTracker::InitDiscardOption(const DiscardOption& opt) {
     discardOption_ = opt;
 }
 
+void IOTracker::InitIOTraceOption(const IOTraceOption& opt) {
+    ioTraceOption_ = opt;
+}
+
+void IOTracker::RecordTaskQueueLatency() {
+    taskQueueUs_ = TimeUtility::GetTimeofDayUs() - opStartTimePoint_;
+    if (!readahead_) {
+        MetricHelper::TaskQueueLatencyRecord(fileMetric_, taskQueueUs_);
+    }
+}
+
+void IOTracker::DumpTrace() const {
+    std::ostringstream os;
+    os << "IO trace, IO id = " << id_
+       << ", OpType = " << OpTypeToString(type_)
+       << ", offset = " << offset_
+       << ", length = " << length_
+       << ", total = " << TimeUtility::GetTimeofDayUs() - opStartTimePoint_
+       << " us, task queue = " << taskQueueUs_ << " us";
+    for (const auto* req : reqlist_) {
+        os << "; request id = " << req->id_
+           << ", chunk id = " << req->idinfo_.cid_
+           << ", offset = " << req->offset_
+           << ", length = " << req->rawlength_
+           << ", retried times = " << req->done_->GetRetriedTimes()
+           << ", " << req->trace_;
+    }
+    LOG(INFO) << os.str();
+}
+
 int IOTracker::Wait() {
     return iocv_.Wait();
 }
@@ -468,13 +584,25 @@ void IOTracker::Done() {
         ReleaseAllSegmentLocks();
     }
 
+    // invalidate again after the data is changed, in case reads sent
+    // after the first invalidation got the old data
+    if (readCache_ != nullptr &&
+        (type_ == OpType::WRITE || type_ == OpType::DISCARD)) {
+        readCache_->Invalidate(offset_, length_);
+    }
+
     if (errcode_ == LIBCURVE_ERROR::OK) {
-        uint64_t duration = TimeUtility::GetTimeofDayUs() - opStartTimePoint_;
-        MetricHelper::UserLatencyRecord(fileMetric_, duration, type_);
-        MetricHelper::IncremUserQPSCount(fileMetric_, length_, type_);
+        if (!readahead_) {
+            uint64_t duration =
+                TimeUtility::GetTimeofDayUs() - opStartTimePoint_;
+            MetricHelper::UserLatencyRecord(fileMetric_, duration, type_);
+            MetricHelper::IncremUserQPSCount(fileMetric_, length_, type_);
+        }
 
-        // copy read data to user buffer
-        if (OpType::READ == type_ || OpType::READ_SNAP == type_) {
+        // copy read data to user buffer, unless it's copied as the
+        // sub-requests returned
+        if ((OpType::READ == type_ || OpType::READ_SNAP == type_) &&
+            readDataOffsets_.empty()) {
             butil::IOBuf readData;
             for (const auto& buf : readDatas_) {
                 readData.append(buf);
@@ -499,6 +627,11 @@ void IOTracker::Done() {
                 }
             }
 
+            if (errcode_ == LIBCURVE_ERROR::OK && readCache_ != nullptr &&
+                !readCacheHit_ && OpType::READ == type_) {
+                readCache_->Put(offset_, readData, readCacheSeq_);
+            }
+
             if (errcode_ != LIBCURVE_ERROR::OK) {
                 LOG(ERROR) << "IO Error, copy data to read buffer failed, "
                            << ", filename: " << fileMetric_->filename
@@ -507,7 +640,9 @@ void IOTracker::Done() {
             }
         }
     } else {
-        MetricHelper::IncremUserEPSCount(fileMetric_, type_);
+        if (!readahead_) {
+            MetricHelper::IncremUserEPSCount(fileMetric_, type_);
+        }
         if (type_ == OpType::READ || type_ == OpType::WRITE) {
             if (LIBCURVE_ERROR::EPOCH_TOO_OLD == errcode_) {
                 LOG(WARNING) << "file [" << fileMetric_->filename << "]"
@@ -531,6 +666,11 @@ void IOTracker::Done() {
         }
     }
 
+    if (ioTraceOption_.sampleRate > 0 && !readahead_ &&
+        id_ % ioTraceOption_.sampleRate == 0) {
+        DumpTrace();
+    }
+
     DestoryRequestList();
 
     // scc_和aioctx都为空的时候肯定是个同步调用
@@ -48,6 +48,7 @@ using curve::common::Throttle;
 class IOManager;
 class FileSegment;
 class DiscardTaskManager;
+class ReadCache;
 
 // IOTracker用于跟踪一个用户IO，因为一个用户IO可能会跨chunkserver，
 // 因此在真正下发的时候会被拆分成多个小IO并发的向下发送，因此我们需要
@@ -210,6 +211,21 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
         userDataType_ = dataType;
     }
 
+    /**
+     * @brief 设置文件的读缓存，读请求先查询缓存，写和discard会失效缓存
+     * @param readCache 读缓存，为空表示不使用读缓存
+     */
+    void SetReadCache(ReadCache* readCache) {
+        readCache_ = readCache;
+    }
+
+    /**
+     * @brief 标记为预读请求，预读请求不统计到用户读的metric中
+     */
+    void SetReadahead(bool readahead) {
+        readahead_ = readahead;
+    }
+
     /**
      * @brief prepare space to store read data
      * @param subIoCount #space to store read data
@@ -222,12 +238,21 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
         readDatas_[subIoIndex] = data;
     }
 
+    /**
+     * @brief 用户buffer为raw buffer并且不使用读缓存时，每个子IO返回的时候
+     *        直接拷贝到用户buffer，这里记录每个子IO在用户buffer中的偏移
+     * @param reqlist 按照用户buffer顺序拆分的子IO
+     */
+    void PrepareReadUserBuffer(const std::vector<RequestContext*>& reqlist);
+
     bool IsStripeDisabled() const {
         return disableStripe_;
     }
 
     static void InitDiscardOption(const DiscardOption& opt);
 
+    static void InitIOTraceOption(const IOTraceOption& opt);
+
  private:
     void ReleaseAllSegmentLocks();
 
@@ -267,6 +292,28 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
      */
     RequestContext* GetInitedRequestContext() const;
 
+    /**
+     * 为读请求准备保存数据的空间，可以直接拷贝到用户buffer的时候记录子IO的偏移，
+     * 否则保存子IO返回的IOBuf，在所有子IO返回之后拼接
+     */
+    void PrepareRead();
+
+    /**
+     * 将子IO读到的数据直接拷贝到用户buffer中
+     * @param: reqctx为返回的子IO
+     */
+    void CopyToUserBuffer(RequestContext* reqctx);
+
+    /**
+     * 记录用户IO在IOManager4File任务队列中等待的时间
+     */
+    void RecordTaskQueueLatency();
+
+    /**
+     * 被采样的IO结束时，将各个子IO在各个阶段的耗时打印到日志
+     */
+    void DumpTrace() const;
+
     // perform read operation
     void DoRead(MDSClient* mdsclient, const FInfo_t* fileInfo,
                 Throttle* throttle);
@@ -315,6 +362,9 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
     // save read data
     std::vector<butil::IOBuf> readDatas_;
 
+    // 子IO在用户buffer中的偏移，不为空的时候子IO返回时直接拷贝到用户buffer
+    std::vector<uint64_t> readDataOffsets_;
+
     // 当用户下发的是同步IO的时候，其需要在上层进行等待，因为client的
     // IO发送流程全部是异步的，因此这里需要用条件变量等待，待异步IO返回
     // 之后才将这个等待的条件变量唤醒，然后向上返回。
@@ -350,6 +400,9 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
     // 发起时间
     uint64_t opStartTimePoint_;
 
+    // 在IOManager4File任务队列中等待的时间
+    uint64_t taskQueueUs_;
+
     // client端的metric统计信息
     FileMetric* fileMetric_;
 
@@ -361,6 +414,18 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
 
     bool disableStripe_;
 
+    // 文件的读缓存，为空表示不使用
+    ReadCache* readCache_;
+
+    // 读请求下发前缓存范围的序列号，读缓存未命中的时候才有效
+    uint64_t readCacheSeq_;
+
+    // 读请求是否由读缓存返回
+    bool readCacheHit_;
+
+    // 是否是client自己发起的预读请求
+    bool readahead_;
+
     // read/write operations will hold segment's read lock,
     // so store corresponding segment lock and release after operations finished
     std::vector<FileSegment*> segmentLocks_;
@@ -369,6 +434,8 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
     static std::atomic<uint64_t> tracekerID_;
 
     static DiscardOption discardOption_;
+
+    static IOTraceOption ioTraceOption_;
 };
 }   // namespace client
 }   // namespace curve
@@ -22,6 +22,7 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <chrono>   // NOLINT
 
 #include "src/client/metacache.h"
@@ -32,6 +33,19 @@
 
 namespace curve {
 namespace client {
+
+namespace {
+
+// 预读请求的异步上下文，预读的数据只用于填充读缓存
+struct ReadaheadContext : public CurveAioContext {
+    butil::IOBuf data;
+    IOManager4File* iomanager;
+    // Readahead::AddInflight返回的预读id
+    uint64_t id;
+};
+
+}  // namespace
+
 Atomic<uint64_t> IOManager::idRecorder_(1);
 IOManager4File::IOManager4File() : scheduler_(nullptr), exit_(false) {}
 
@@ -44,6 +58,7 @@ bool IOManager4File::Initialize(const std::string& filename,
     mc_.Init(ioopt_.metaCacheOpt, mdsclient);
 
     IOTracker::InitDiscardOption(ioopt_.discardOption);
+    IOTracker::InitIOTraceOption(ioopt_.ioTraceOpt);
     Splitor::Init(ioopt_.ioSplitOpt);
 
     inflightRpcCntl_.SetMaxInflightNum(
@@ -87,6 +102,21 @@ bool IOManager4File::Initialize(const std::string& filename,
     discardTaskManager_.reset(
         new DiscardTaskManager(&(fileMetric_->discardMetric)));
 
+    // prefetched data is kept in the read cache
+    if (ioopt_.readCacheOpt.enable || ioopt_.readaheadOpt.enable) {
+        readCache_.reset(new ReadCache());
+        if (!readCache_->Init(ioopt_.readCacheOpt, filename,
+                              &(fileMetric_->readCacheMetric))) {
+            LOG(ERROR) << "read cache init failed!";
+            return false;
+        }
+    }
+
+    if (ioopt_.readaheadOpt.enable) {
+        readahead_.reset(
+            new Readahead(ioopt_.readaheadOpt, readCache_->BlockSize()));
+    }
+
     LOG(INFO) << "iomanager init success, conf info: "
               << "isolationTaskThreadPoolSize = "
               << ioopt_.taskThreadOpt.isolationTaskThreadPoolSize
@@ -145,21 +175,25 @@ int IOManager4File::Read(char* buf, off_t offset,
     MetricHelper::IncremUserRPSCount(fileMetric_, OpType::READ);
     FlightIOGuard guard(this);
 
-    butil::IOBuf data;
-
     IOTracker temp(this, &mc_, scheduler_, fileMetric_, disableStripe_);
-    temp.SetUserDataType(UserDataType::IOBuffer);
-    temp.StartRead(&data, offset, length, mdsclient, this->GetFileInfo(),
-                   throttle_.get());
+    temp.SetUserDataType(UserDataType::RawBuffer);
+    temp.SetReadCache(readCache_.get());
+
+    // reads overlapping the readahead in flight wait for it and then hit
+    // the read cache, instead of reading the same data once more
+    if (readahead_) {
+        curve::common::CountDownEvent done(1);
+        if (readahead_->WaitInflight(offset, length,
+                                     [&done]() { done.Signal(); })) {
+            done.Wait();
+        }
+    }
 
-    int rc = temp.Wait();
+    temp.StartRead(buf, offset, length, mdsclient, this->GetFileInfo(),
+                   throttle_.get());
+    TryReadahead(offset, length, mdsclient);
 
-    if (rc < 0) {
-        return rc;
-    } else {
-        size_t nc = data.copy_to(buf, length);
-        return nc == length ? rc : -LIBCURVE_ERROR::FAILED;
-    }
+    return temp.Wait();
 }
 
 int IOManager4File::Write(const char* buf,
@@ -174,6 +208,7 @@ int IOManager4File::Write(const char* buf,
 
     IOTracker temp(this, &mc_, scheduler_, fileMetric_, disableStripe_);
     temp.SetUserDataType(UserDataType::IOBuffer);
+    temp.SetReadCache(readCache_.get());
     temp.StartWrite(&data, offset, length, mdsclient, this->GetFileInfo(),
                     this->GetFileEpoch(),
                     throttle_.get());
@@ -196,13 +231,20 @@ int IOManager4File::AioRead(CurveAioContext* ctx, MDSClient* mdsclient,
     }
 
     temp->SetUserDataType(dataType);
+    temp->SetReadCache(readCache_.get());
     inflightCntl_.IncremInflightNum();
     auto task = [this, ctx, mdsclient, temp]() {
         temp->StartAioRead(ctx, mdsclient, this->GetFileInfo(),
                            throttle_.get());
     };
 
-    taskPool_.Enqueue(task);
+    // read ctx before enqueue, it may be freed once the read is done
+    off_t offset = ctx->offset;
+    size_t length = ctx->length;
+    if (!readahead_ || !readahead_->WaitInflight(offset, length, task)) {
+        taskPool_.Enqueue(task);
+    }
+    TryReadahead(offset, length, mdsclient);
     return LIBCURVE_ERROR::OK;
 }
 
@@ -220,6 +262,7 @@ int IOManager4File::AioWrite(CurveAioContext* ctx, MDSClient* mdsclient,
     }
 
     temp->SetUserDataType(dataType);
+    temp->SetReadCache(readCache_.get());
     inflightCntl_.IncremInflightNum();
     auto task = [this, ctx, mdsclient, temp]() {
         temp->StartAioWrite(ctx, mdsclient, this->GetFileInfo(),
@@ -241,6 +284,7 @@ int IOManager4File::Discard(off_t offset, size_t length, MDSClient* mdsclient) {
     FlightIOGuard guard(this);
 
     IOTracker tracker(this, &mc_, scheduler_, fileMetric_);
+    tracker.SetReadCache(readCache_.get());
     tracker.StartDiscard(offset, length, mdsclient, GetFileInfo(),
                          discardTaskManager_.get());
     return tracker.Wait();
@@ -265,6 +309,7 @@ int IOManager4File::AioDiscard(CurveAioContext* aioctx, MDSClient* mdsclient) {
         return LIBCURVE_ERROR::OK;
     }
 
+    ioTracker->SetReadCache(readCache_.get());
     inflightCntl_.IncremInflightNum();
     auto task = [this, aioctx, mdsclient, ioTracker]() {
         ioTracker->StartAioDiscard(aioctx, mdsclient, this->GetFileInfo(),
@@ -277,6 +322,17 @@ int IOManager4File::AioDiscard(CurveAioContext* aioctx, MDSClient* mdsclient) {
 
 void IOManager4File::UpdateFileInfo(const FInfo_t& fi) {
     mc_.UpdateFileInfo(fi);
+    if (readCache_) {
+        readCache_->Clear();
+    }
+}
+
+void IOManager4File::UpdateFileEpoch(const FileEpoch& fEpoch) {
+    mc_.UpdateFileEpoch(fEpoch);
+    // other clients may have written the file before the epoch changed
+    if (readCache_) {
+        readCache_->Clear();
+    }
 }
 
 void IOManager4File::UpdateFileThrottleParams(
@@ -295,6 +351,71 @@ void IOManager4File::HandleAsyncIOResponse(IOTracker* iotracker) {
     delete iotracker;
 }
 
+void IOManager4File::ReadaheadCallback(CurveAioContext* ctx) {
+    ReadaheadContext* raCtx = static_cast<ReadaheadContext*>(ctx);
+    IOManager4File* iomanager = raCtx->iomanager;
+
+    // the reads waiting for the readahead go on, whether it succeeded or not
+    std::vector<Readahead::Task> tasks;
+    iomanager->readahead_->RemoveInflight(raCtx->id, &tasks);
+    for (auto& task : tasks) {
+        iomanager->taskPool_.Enqueue(task);
+    }
+
+    delete raCtx;
+}
+
+void IOManager4File::TryReadahead(off_t offset, size_t length,
+                                  MDSClient* mdsclient) {
+    if (!readahead_) {
+        return;
+    }
+
+    uint64_t raOffset = 0;
+    uint64_t raLength = 0;
+    if (!readahead_->OnRead(offset, length, &raOffset, &raLength)) {
+        return;
+    }
+
+    uint64_t fileLength = GetFileInfo()->length;
+    if (raOffset >= fileLength) {
+        return;
+    }
+    raLength = std::min(raLength, fileLength - raOffset);
+
+    IOTracker* tracker = new (std::nothrow)
+        IOTracker(this, &mc_, scheduler_, fileMetric_, disableStripe_);
+    if (tracker == nullptr) {
+        LOG(ERROR) << "allocate readahead tracker failed!";
+        return;
+    }
+
+    ReadaheadContext* ctx = new ReadaheadContext();
+    ctx->offset = raOffset;
+    ctx->length = raLength;
+    ctx->ret = 0;
+    ctx->op = LIBCURVE_OP_READ;
+    ctx->cb = ReadaheadCallback;
+    ctx->buf = &ctx->data;
+    ctx->iomanager = this;
+    ctx->id = readahead_->AddInflight(raOffset, raLength);
+
+    tracker->SetUserDataType(UserDataType::IOBuffer);
+    tracker->SetReadCache(readCache_.get());
+    tracker->SetReadahead(true);
+
+    fileMetric_->readCacheMetric.readahead << 1;
+    fileMetric_->readCacheMetric.readaheadBytes << raLength;
+
+    inflightCntl_.IncremInflightNum();
+    auto task = [this, ctx, mdsclient, tracker]() {
+        tracker->StartAioRead(ctx, mdsclient, this->GetFileInfo(),
+                              throttle_.get());
+    };
+
+    taskPool_.Enqueue(task);
+}
+
 bool IOManager4File::IsNeedDiscard(size_t len) const {
     if (ioopt_.discardOption.enable &&
         len >= ioopt_.metaCacheOpt.discardGranularity) {
@@ -307,6 +428,10 @@ bool IOManager4File::IsNeedDiscard(size_t len) const {
 void IOManager4File::LeaseTimeoutBlockIO() {
     std::unique_lock<std::mutex> lk(exitMtx_);
     if (exit_ == false) {
+        // the file may be opened and written by others without the lease
+        if (readCache_) {
+            readCache_->Clear();
+        }
         scheduler_->LeaseTimeoutBlockIO();
     } else {
         LOG(WARNING) << "io manager already exit, no need block io!";
@@ -31,6 +31,7 @@
 #include <mutex>               // NOLINT
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "include/curve_compiler_specific.h"
 #include "src/client/client_common.h"
@@ -38,6 +39,8 @@
 #include "src/client/iomanager.h"
 #include "src/client/mds_client.h"
 #include "src/client/metacache.h"
+#include "src/client/read_cache.h"
+#include "src/client/readahead.h"
 #include "src/client/request_scheduler.h"
 #include "src/common/concurrent/concurrent.h"
 #include "src/common/concurrent/task_thread_pool.h"
@@ -181,9 +184,7 @@ class IOManager4File : public IOManager {
         return mc_.GetFileInfo();
     }
 
-    void UpdateFileEpoch(const FileEpoch& fEpoch) {
-        mc_.UpdateFileEpoch(fEpoch);
-    }
+    void UpdateFileEpoch(const FileEpoch& fEpoch);
 
     const FileEpoch* GetFileEpoch() const {
         return mc_.GetFileEpoch();
@@ -260,6 +261,20 @@ class IOManager4File : public IOManager {
 
     bool IsNeedDiscard(size_t len) const;
 
+    /**
+     * 用户读请求下发之后调用，检测到顺序读的时候异步预读之后的数据到读缓存
+     * @param offset 用户读请求的偏移
+     * @param length 用户读请求的长度
+     * @param mdsclient 透传给底层，在必要的时候与mds通信
+     */
+    void TryReadahead(off_t offset, size_t length, MDSClient* mdsclient);
+
+    /**
+     * 预读完成的回调，下发等待这个预读的读请求
+     * @param ctx 预读请求的异步上下文
+     */
+    static void ReadaheadCallback(CurveAioContext* ctx);
+
  private:
     // 每个IOManager都有其IO配置，保存在iooption里
     IOOption ioopt_;
@@ -306,6 +321,12 @@ class IOManager4File : public IOManager {
     bool disableStripe_;
 
     std::unique_ptr<DiscardTaskManager> discardTaskManager_;
+
+    // 文件的读缓存，读缓存和预读都没有开启的时候为空
+    std::unique_ptr<ReadCache> readCache_;
+
+    // 顺序读检测，没有开启预读的时候为空
+    std::unique_ptr<Readahead> readahead_;
 };
 
 }  // namespace client
@@ -41,6 +41,8 @@ using curve::common::WriteLockGuard;
 using curve::common::ReadLockGuard;
 using curve::client::ClientConfig;
 
+constexpr uint32_t MetaCache::kMapShardNum;
+
 void MetaCache::Init(const MetaCacheOption& metaCacheOpt,
                      MDSClient* mdsclient) {
     mdsclient_ = mdsclient;
@@ -57,9 +59,10 @@ void MetaCache::Init(const MetaCacheOption& metaCacheOpt,
 
 MetaCacheErrorType MetaCache::GetChunkInfoByIndex(ChunkIndex chunkidx,
                                                   ChunkIDInfo* chunxinfo) {
-    ReadLockGuard rdlk(rwlock4ChunkInfo_);
-    auto iter = chunkindex2idMap_.find(chunkidx);
-    if (iter != chunkindex2idMap_.end()) {
+    auto& shard = GetChunkIndexShard(chunkidx);
+    ReadLockGuard rdlk(shard.rwlock);
+    auto iter = shard.map.find(chunkidx);
+    if (iter != shard.map.end()) {
         *chunxinfo = iter->second;
         return MetaCacheErrorType::OK;
     }
@@ -68,23 +71,22 @@ MetaCacheErrorType MetaCache::GetChunkInfoByIndex(ChunkIndex chunkidx,
 
 void MetaCache::UpdateChunkInfoByIndex(ChunkIndex cindex,
                                        const ChunkIDInfo& cinfo) {
-    WriteLockGuard wrlk(rwlock4ChunkInfo_);
-    chunkindex2idMap_[cindex] = cinfo;
+    auto& shard = GetChunkIndexShard(cindex);
+    WriteLockGuard wrlk(shard.rwlock);
+    shard.map[cindex] = cinfo;
 }
 
 bool MetaCache::IsLeaderMayChange(LogicPoolID logicPoolId,
                                   CopysetID copysetId) {
-    rwlock4ChunkInfo_.RDLock();
-    auto iter = lpcsid2CopsetInfoMap_.find(
-        CalcLogicPoolCopysetID(logicPoolId, copysetId));
-    if (iter == lpcsid2CopsetInfoMap_.end()) {
-        rwlock4ChunkInfo_.Unlock();
+    const auto key = CalcLogicPoolCopysetID(logicPoolId, copysetId);
+    auto& shard = GetCopysetShard(key);
+    ReadLockGuard rdlk(shard.rwlock);
+    auto iter = shard.map.find(key);
+    if (iter == shard.map.end()) {
         return false;
     }
 
-    bool flag = iter->second.LeaderMayChange();
-    rwlock4ChunkInfo_.Unlock();
-    return flag;
+    return iter->second.LeaderMayChange();
 }
 
 int MetaCache::GetLeader(LogicPoolID logicPoolId,
@@ -96,16 +98,28 @@ int MetaCache::GetLeader(LogicPoolID logicPoolId,
     const auto key = CalcLogicPoolCopysetID(logicPoolId, copysetId);
 
     CopysetInfo<ChunkServerID> targetInfo;
-    rwlock4CopysetInfo_.RDLock();
-    auto iter = lpcsid2CopsetInfoMap_.find(key);
-    if (iter == lpcsid2CopsetInfoMap_.end()) {
-        rwlock4CopysetInfo_.Unlock();
-        LOG(ERROR) << "server list not exist, LogicPoolID = " << logicPoolId
-                   << ", CopysetID = " << copysetId;
-        return -1;
+    {
+        auto& shard = GetCopysetShard(key);
+        ReadLockGuard rdlk(shard.rwlock);
+        auto iter = shard.map.find(key);
+        if (iter == shard.map.end()) {
+            LOG(ERROR) << "server list not exist, LogicPoolID = "
+                       << logicPoolId << ", CopysetID = " << copysetId;
+            return -1;
+        }
+
+        // fast path, the leader is known and stable, read it in place
+        // instead of copying the whole copyset info
+        const auto& cached = iter->second;
+        const int16_t leaderIndex = cached.GetCurrentLeaderIndex();
+        if (!refresh && !cached.LeaderMayChange() && leaderIndex >= 0 &&
+            leaderIndex < static_cast<int>(cached.csinfos_.size())) {
+            *serverId = cached.csinfos_[leaderIndex].peerID;
+            *serverAddr = cached.csinfos_[leaderIndex].externalAddr.addr_;
+            return 0;
+        }
+        targetInfo = cached;
     }
-    targetInfo = iter->second;
-    rwlock4CopysetInfo_.Unlock();
 
     int ret = 0;
     if (refresh || targetInfo.LeaderMayChange()) {
@@ -236,9 +250,10 @@ CopysetInfo<ChunkServerID> MetaCache::GetServerList(LogicPoolID logicPoolId,
     const auto key = CalcLogicPoolCopysetID(logicPoolId, copysetId);
     CopysetInfo<ChunkServerID> ret;
 
-    ReadLockGuard rdlk(rwlock4CopysetInfo_);
-    auto iter = lpcsid2CopsetInfoMap_.find(key);
-    if (iter == lpcsid2CopsetInfoMap_.end()) {
+    auto& shard = GetCopysetShard(key);
+    ReadLockGuard rdlk(shard.rwlock);
+    auto iter = shard.map.find(key);
+    if (iter == shard.map.end()) {
         // it's impossible to get here
         return ret;
     }
@@ -255,9 +270,10 @@ int MetaCache::UpdateLeader(LogicPoolID logicPoolId,
                             const EndPoint& leaderAddr) {
     const auto key = CalcLogicPoolCopysetID(logicPoolId, copysetId);
 
-    ReadLockGuard rdlk(rwlock4CopysetInfo_);
-    auto iter = lpcsid2CopsetInfoMap_.find(key);
-    if (iter == lpcsid2CopsetInfoMap_.end()) {
+    auto& shard = GetCopysetShard(key);
+    ReadLockGuard rdlk(shard.rwlock);
+    auto iter = shard.map.find(key);
+    if (iter == shard.map.end()) {
         // it's impossible to get here
         return -1;
     }
@@ -269,8 +285,9 @@ int MetaCache::UpdateLeader(LogicPoolID logicPoolId,
 void MetaCache::UpdateCopysetInfo(LogicPoolID logicPoolid, CopysetID copysetid,
                                   const CopysetInfo<ChunkServerID>& csinfo) {
     const auto key = CalcLogicPoolCopysetID(logicPoolid, copysetid);
-    WriteLockGuard wrlk(rwlock4CopysetInfo_);
-    lpcsid2CopsetInfoMap_[key] = csinfo;
+    auto& shard = GetCopysetShard(key);
+    WriteLockGuard wrlk(shard.rwlock);
+    shard.map[key] = csinfo;
 }
 
 void MetaCache::UpdateAppliedIndex(LogicPoolID logicPoolId,
@@ -278,9 +295,10 @@ void MetaCache::UpdateAppliedIndex(LogicPoolID logicPoolId,
                                    uint64_t appliedindex) {
     const auto key = CalcLogicPoolCopysetID(logicPoolId, copysetId);
 
-    ReadLockGuard wrlk(rwlock4CopysetInfo_);
-    auto iter = lpcsid2CopsetInfoMap_.find(key);
-    if (iter == lpcsid2CopsetInfoMap_.end()) {
+    auto& shard = GetCopysetShard(key);
+    ReadLockGuard rdlk(shard.rwlock);
+    auto iter = shard.map.find(key);
+    if (iter == shard.map.end()) {
         return;
     }
 
@@ -291,9 +309,10 @@ uint64_t MetaCache::GetAppliedIndex(LogicPoolID logicPoolId,
                                     CopysetID copysetId) {
     const auto key = CalcLogicPoolCopysetID(logicPoolId, copysetId);
 
-    ReadLockGuard rdlk(rwlock4CopysetInfo_);
-    auto iter = lpcsid2CopsetInfoMap_.find(key);
-    if (iter == lpcsid2CopsetInfoMap_.end()) {
+    auto& shard = GetCopysetShard(key);
+    ReadLockGuard rdlk(shard.rwlock);
+    auto iter = shard.map.find(key);
+    if (iter == shard.map.end()) {
         return 0;
     }
 
@@ -334,11 +353,12 @@ void MetaCache::SetChunkserverUnstable(ChunkServerID csid) {
         }
     }
 
-    ReadLockGuard rdlk(rwlock4CopysetInfo_);
     for (auto it : copysetIDSet) {
         const auto key = CalcLogicPoolCopysetID(it.lpid, it.cpid);
-        auto cpinfo = lpcsid2CopsetInfoMap_.find(key);
-        if (cpinfo != lpcsid2CopsetInfoMap_.end()) {
+        auto& shard = GetCopysetShard(key);
+        ReadLockGuard rdlk(shard.rwlock);
+        auto cpinfo = shard.map.find(key);
+        if (cpinfo != shard.map.end()) {
             ChunkServerID leaderid;
             if (cpinfo->second.GetCurrentLeaderID(&leaderid)) {
                 if (leaderid == csid) {
@@ -361,11 +381,12 @@ void MetaCache::AddCopysetIDInfo(ChunkServerID csid,
 
 void MetaCache::UpdateChunkserverCopysetInfo(LogicPoolID lpid,
                                  const CopysetInfo<ChunkServerID>& cpinfo) {
-    ReadLockGuard rdlk(rwlock4CopysetInfo_);
     const auto key = CalcLogicPoolCopysetID(lpid, cpinfo.cpid_);
+    auto& shard = GetCopysetShard(key);
+    ReadLockGuard rdlk(shard.rwlock);
     // 先获取原来的chunkserver到copyset映射
-    auto previouscpinfo = lpcsid2CopsetInfoMap_.find(key);
-    if (previouscpinfo != lpcsid2CopsetInfoMap_.end()) {
+    auto previouscpinfo = shard.map.find(key);
+    if (previouscpinfo != shard.map.end()) {
         std::vector<ChunkServerID> newID;
         std::vector<ChunkServerID> changedID;
 
@@ -405,10 +426,11 @@ void MetaCache::UpdateChunkserverCopysetInfo(LogicPoolID lpid,
 
 CopysetInfo<ChunkServerID> MetaCache::GetCopysetinfo(
     LogicPoolID lpid, CopysetID csid) {
-    ReadLockGuard rdlk(rwlock4CopysetInfo_);
     const auto key = CalcLogicPoolCopysetID(lpid, csid);
-    auto cpinfo = lpcsid2CopsetInfoMap_.find(key);
-    if (cpinfo != lpcsid2CopsetInfoMap_.end()) {
+    auto& shard = GetCopysetShard(key);
+    ReadLockGuard rdlk(shard.rwlock);
+    auto cpinfo = shard.map.find(key);
+    if (cpinfo != shard.map.end()) {
         return cpinfo->second;
     }
     return CopysetInfo<ChunkServerID>();
@@ -435,7 +457,6 @@ FileSegment* MetaCache::GetFileSegment(SegmentIndex segmentIndex) {
 }
 
 void MetaCache::CleanChunksInSegment(SegmentIndex segmentIndex) {
-    WriteLockGuard lk(rwlock4chunkInfoMap_);
     ChunkIndex beginChunkIndex = static_cast<uint64_t>(segmentIndex) *
                                  fileInfo_.segmentsize / fileInfo_.chunksize;
     ChunkIndex endChunkIndex = static_cast<uint64_t>(segmentIndex + 1) *
@@ -443,7 +464,9 @@ void MetaCache::CleanChunksInSegment(SegmentIndex segmentIndex) {
 
     auto currentIndex = beginChunkIndex;
     while (currentIndex < endChunkIndex) {
-        chunkindex2idMap_.erase(currentIndex);
+        auto& shard = GetChunkIndexShard(currentIndex);
+        WriteLockGuard lk(shard.rwlock);
+        shard.map.erase(currentIndex);
         ++currentIndex;
     }
 }
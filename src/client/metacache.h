@@ -22,6 +22,7 @@
 #ifndef SRC_CLIENT_METACACHE_H_
 #define SRC_CLIENT_METACACHE_H_
 
+#include <array>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -283,23 +284,40 @@ class MetaCache {
     MDSClient *mdsclient_;
     MetaCacheOption metacacheopt_;
 
+    // 映射表按key分片，每个分片有自己的读写锁并且独占cache line，IO路径
+    // 上对不同chunk和copyset的查询不会竞争同一把锁
+    static constexpr uint32_t kMapShardNum = 64;
+
+    template <typename MapT>
+    struct CURVE_CACHELINE_ALIGNMENT MapShard {
+        RWLock rwlock;
+        MapT map;
+    };
+
+    using ChunkIndexShard = MapShard<ChunkIndexInfoMap>;
+    using CopysetShard = MapShard<CopysetInfoMap>;
+
+    ChunkIndexShard& GetChunkIndexShard(ChunkIndex chunkidx) {
+        return chunkIndexShards_[chunkidx % kMapShardNum];
+    }
+
+    CopysetShard& GetCopysetShard(LogicPoolCopysetID key) {
+        return copysetShards_[(key ^ (key >> 32)) % kMapShardNum];
+    }
+
     // chunkindex到chunkidinfo的映射表
-    CURVE_CACHELINE_ALIGNMENT ChunkIndexInfoMap chunkindex2idMap_;
+    std::array<ChunkIndexShard, kMapShardNum> chunkIndexShards_;
 
     CURVE_CACHELINE_ALIGNMENT RWLock rwlock4Segments_;
     CURVE_CACHELINE_ALIGNMENT std::unordered_map<SegmentIndex, FileSegment>
         segments_;  // NOLINT
 
     // logicalpoolid和copysetid到copysetinfo的映射表
-    CURVE_CACHELINE_ALIGNMENT CopysetInfoMap lpcsid2CopsetInfoMap_;
+    std::array<CopysetShard, kMapShardNum> copysetShards_;
 
     // chunkid到chunkidinfo的映射表
     CURVE_CACHELINE_ALIGNMENT ChunkInfoMap chunkid2chunkInfoMap_;
-
-    // 三个读写锁分别保护上述三个映射表
     CURVE_CACHELINE_ALIGNMENT RWLock rwlock4chunkInfoMap_;
-    CURVE_CACHELINE_ALIGNMENT RWLock rwlock4ChunkInfo_;
-    CURVE_CACHELINE_ALIGNMENT RWLock rwlock4CopysetInfo_;
 
     // chunkserverCopysetIDMap_存放当前chunkserver到copyset的映射
     // 当rpc closure设置SetChunkserverUnstable时，会设置该chunkserver
@@ -0,0 +1,451 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/client/read_cache.h"
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace curve {
+namespace client {
+
+const uint32_t ReadCache::kStripeNum;
+
+ReadCache::ReadCache()
+    : blockSize_(0),
+      memCapacity_(0),
+      memBytes_(0),
+      generation_(0),
+      fd_(-1),
+      metric_(nullptr) {
+    for (uint32_t i = 0; i < kStripeNum; ++i) {
+        stripes_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+ReadCache::~ReadCache() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool ReadCache::Init(const ReadCacheOption& opt, const std::string& filename,
+                     ReadCacheMetric* metric) {
+    if (opt.blockSizeKB == 0 || opt.capacityMB == 0) {
+        LOG(ERROR) << "Invalid read cache option, block size = "
+                   << opt.blockSizeKB << "KB, capacity = " << opt.capacityMB
+                   << "MB";
+        return false;
+    }
+
+    blockSize_ = static_cast<uint64_t>(opt.blockSizeKB) * 1024;
+    memCapacity_ = opt.capacityMB * 1024 * 1024;
+    metric_ = metric;
+
+    if (!opt.fileDir.empty() && opt.fileCapacityMB > 0) {
+        uint64_t slotNum = opt.fileCapacityMB * 1024 * 1024 / blockSize_;
+        freeSlots_.reserve(slotNum);
+        for (uint64_t slot = slotNum; slot > 0; --slot) {
+            freeSlots_.push_back(slot - 1);
+        }
+        if (!OpenCacheFile(opt.fileDir, filename)) {
+            return false;
+        }
+    }
+
+    LOG(INFO) << "Read cache of " << filename << " inited, block size = "
+              << blockSize_ << ", memory capacity = " << memCapacity_
+              << ", cache file slots = " << freeSlots_.size();
+    return true;
+}
+
+bool ReadCache::OpenCacheFile(const std::string& dir,
+                              const std::string& filename) {
+    std::string name = filename;
+    std::replace(name.begin(), name.end(), '/', '_');
+    std::string path = dir + "/" + std::to_string(getpid()) + "_" + name;
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        LOG(ERROR) << "Open read cache file " << path
+                   << " failed, errno = " << errno;
+        return false;
+    }
+
+    // only this process uses the file, and it's removed when closed
+    if (::unlink(path.c_str()) != 0) {
+        LOG(WARNING) << "Unlink read cache file " << path
+                     << " failed, errno = " << errno;
+    }
+    return true;
+}
+
+uint64_t ReadCache::BlockSequence(uint64_t index) const {
+    return generation_.load() + stripes_[index % kStripeNum].load();
+}
+
+uint64_t ReadCache::Sequence(uint64_t offset, uint64_t length) const {
+    uint64_t sequence = generation_.load();
+    if (length == 0) {
+        return sequence;
+    }
+
+    // the counters only increase, so the sum changes if any of them changes
+    uint64_t first = offset / blockSize_;
+    uint64_t last = (offset + length - 1) / blockSize_;
+    if (last - first + 1 >= kStripeNum) {
+        for (uint32_t i = 0; i < kStripeNum; ++i) {
+            sequence += stripes_[i].load();
+        }
+    } else {
+        for (uint64_t index = first; index <= last; ++index) {
+            sequence += stripes_[index % kStripeNum].load();
+        }
+    }
+    return sequence;
+}
+
+bool ReadCache::Get(uint64_t offset, uint64_t length, butil::IOBuf* data) {
+    if (length == 0) {
+        return false;
+    }
+
+    uint64_t first = offset / blockSize_;
+    uint64_t last = (offset + length - 1) / blockSize_;
+    std::vector<butil::IOBuf> blocks(last - first + 1);
+    std::vector<uint64_t> missing;
+    {
+        std::lock_guard<std::mutex> lk(memMtx_);
+        for (uint64_t index = first; index <= last; ++index) {
+            auto iter = memory_.map.find(index);
+            if (iter == memory_.map.end()) {
+                missing.push_back(index);
+                continue;
+            }
+            memory_.lru.splice(memory_.lru.begin(), memory_.lru, iter->second);
+            blocks[index - first] = iter->second->data;
+        }
+    }
+
+    if (!missing.empty() && fd_ < 0) {
+        if (metric_ != nullptr) {
+            metric_->miss << 1;
+        }
+        return false;
+    }
+
+    // promote the blocks after all of them are read, so that they don't
+    // evict each other from the file
+    std::vector<uint64_t> sequences(missing.size());
+    for (size_t i = 0; i < missing.size(); ++i) {
+        uint64_t index = missing[i];
+        if (!LoadFromFile(index, &blocks[index - first], &sequences[i])) {
+            if (metric_ != nullptr) {
+                metric_->miss << 1;
+            }
+            return false;
+        }
+    }
+
+    if (!missing.empty()) {
+        std::vector<Entry> evicted;
+        {
+            std::lock_guard<std::mutex> lk(memMtx_);
+            for (size_t i = 0; i < missing.size(); ++i) {
+                uint64_t index = missing[i];
+                if (BlockSequence(index) == sequences[i]) {
+                    InsertToMemory(index, blocks[index - first],
+                                   sequences[i], &evicted);
+                }
+            }
+        }
+        for (const auto& entry : evicted) {
+            SpillToFile(entry);
+        }
+    }
+
+    uint64_t pos = offset - first * blockSize_;
+    uint64_t left = length;
+    for (const auto& block : blocks) {
+        uint64_t n = std::min(blockSize_ - pos, left);
+        block.append_to(data, n, pos);
+        left -= n;
+        pos = 0;
+    }
+
+    if (metric_ != nullptr) {
+        metric_->hit << 1;
+        metric_->hitBytes << length;
+    }
+    return true;
+}
+
+void ReadCache::Put(uint64_t offset, const butil::IOBuf& data,
+                    uint64_t sequence) {
+    uint64_t length = data.size();
+    uint64_t first = (offset + blockSize_ - 1) / blockSize_;
+    uint64_t end = (offset + length) / blockSize_;
+    if (first >= end) {
+        return;
+    }
+
+    std::vector<Entry> evicted;
+    {
+        std::lock_guard<std::mutex> lk(memMtx_);
+        // written or invalidated after the data was read
+        if (Sequence(offset, length) != sequence) {
+            return;
+        }
+
+        for (uint64_t index = first; index < end; ++index) {
+            butil::IOBuf block;
+            data.append_to(&block, blockSize_, index * blockSize_ - offset);
+            InsertToMemory(index, block, BlockSequence(index), &evicted);
+        }
+    }
+
+    for (const auto& entry : evicted) {
+        SpillToFile(entry);
+    }
+}
+
+void ReadCache::Invalidate(uint64_t offset, uint64_t length) {
+    if (length == 0) {
+        return;
+    }
+
+    uint64_t first = offset / blockSize_;
+    uint64_t last = (offset + length - 1) / blockSize_;
+
+    // bump the sequences before erasing, so reads sent before can't fill
+    // the blocks again
+    if (last - first + 1 >= kStripeNum) {
+        generation_.fetch_add(1);
+    } else {
+        for (uint64_t index = first; index <= last; ++index) {
+            stripes_[index % kStripeNum].fetch_add(1);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(memMtx_);
+        EraseRange(memory_, first, last,
+                   [this](uint64_t index) { EraseFromMemory(index); });
+    }
+
+    if (fd_ >= 0) {
+        std::lock_guard<std::mutex> lk(fileMtx_);
+        EraseRange(file_, first, last,
+                   [this](uint64_t index) { EraseFromFile(index); });
+    }
+}
+
+void ReadCache::Clear() {
+    generation_.fetch_add(1);
+
+    {
+        std::lock_guard<std::mutex> lk(memMtx_);
+        if (metric_ != nullptr) {
+            metric_->memoryBytes << -static_cast<int64_t>(memBytes_);
+        }
+        memory_.map.clear();
+        memory_.lru.clear();
+        memBytes_ = 0;
+    }
+
+    if (fd_ >= 0) {
+        std::lock_guard<std::mutex> lk(fileMtx_);
+        if (metric_ != nullptr) {
+            metric_->fileBytes <<
+                -static_cast<int64_t>(file_.lru.size() * blockSize_);
+        }
+        for (const auto& entry : file_.lru) {
+            freeSlots_.push_back(entry.slot);
+        }
+        file_.map.clear();
+        file_.lru.clear();
+    }
+}
+
+template <typename EraseFunc>
+void ReadCache::EraseRange(const Tier& tier, uint64_t first, uint64_t last,
+                           EraseFunc erase) {
+    std::vector<uint64_t> indexes;
+    if (last - first >= tier.map.size()) {
+        for (const auto& item : tier.map) {
+            if (item.first >= first && item.first <= last) {
+                indexes.push_back(item.first);
+            }
+        }
+    } else {
+        for (uint64_t index = first; index <= last; ++index) {
+            if (tier.map.count(index) != 0) {
+                indexes.push_back(index);
+            }
+        }
+    }
+
+    for (auto index : indexes) {
+        erase(index);
+    }
+}
+
+void ReadCache::EraseFromMemory(uint64_t index) {
+    auto iter = memory_.map.find(index);
+    if (iter == memory_.map.end()) {
+        return;
+    }
+
+    uint64_t size = iter->second->data.size();
+    memBytes_ -= size;
+    if (metric_ != nullptr) {
+        metric_->memoryBytes << -static_cast<int64_t>(size);
+    }
+    memory_.lru.erase(iter->second);
+    memory_.map.erase(iter);
+}
+
+void ReadCache::EraseFromFile(uint64_t index) {
+    auto iter = file_.map.find(index);
+    if (iter == file_.map.end()) {
+        return;
+    }
+
+    if (metric_ != nullptr) {
+        metric_->fileBytes << -static_cast<int64_t>(blockSize_);
+    }
+    freeSlots_.push_back(iter->second->slot);
+    file_.lru.erase(iter->second);
+    file_.map.erase(iter);
+}
+
+void ReadCache::InsertToMemory(uint64_t index, const butil::IOBuf& data,
+                               uint64_t sequence,
+                               std::vector<Entry>* evicted) {
+    EraseFromMemory(index);
+
+    memory_.lru.push_front(Entry{index, sequence, data, 0});
+    memory_.map[index] = memory_.lru.begin();
+    memBytes_ += data.size();
+    if (metric_ != nullptr) {
+        metric_->memoryBytes << static_cast<int64_t>(data.size());
+    }
+
+    while (memBytes_ > memCapacity_) {
+        Entry& victim = memory_.lru.back();
+        memBytes_ -= victim.data.size();
+        if (metric_ != nullptr) {
+            metric_->memoryBytes << -static_cast<int64_t>(victim.data.size());
+        }
+        memory_.map.erase(victim.index);
+        if (fd_ >= 0) {
+            evicted->push_back(std::move(victim));
+        }
+        memory_.lru.pop_back();
+    }
+}
+
+void ReadCache::SpillToFile(const Entry& entry) {
+    std::unique_ptr<char[]> buf(new char[blockSize_]);
+    entry.data.copy_to(buf.get(), blockSize_);
+
+    std::lock_guard<std::mutex> lk(fileMtx_);
+    // invalidated after it was evicted from memory
+    if (BlockSequence(entry.index) != entry.sequence) {
+        return;
+    }
+
+    auto iter = file_.map.find(entry.index);
+    if (iter != file_.map.end()) {
+        if (iter->second->sequence == entry.sequence) {
+            file_.lru.splice(file_.lru.begin(), file_.lru, iter->second);
+            return;
+        }
+        EraseFromFile(entry.index);
+    }
+
+    if (freeSlots_.empty()) {
+        if (file_.lru.empty()) {
+            return;
+        }
+        EraseFromFile(file_.lru.back().index);
+    }
+
+    uint64_t slot = freeSlots_.back();
+    ssize_t nwrite = ::pwrite(fd_, buf.get(), blockSize_, slot * blockSize_);
+    if (nwrite != static_cast<ssize_t>(blockSize_)) {
+        LOG(WARNING) << "Write read cache file failed, slot = " << slot
+                     << ", ret = " << nwrite << ", errno = " << errno;
+        return;
+    }
+
+    freeSlots_.pop_back();
+    file_.lru.push_front(Entry{entry.index, entry.sequence, butil::IOBuf(),
+                               slot});
+    file_.map[entry.index] = file_.lru.begin();
+    if (metric_ != nullptr) {
+        metric_->fileBytes << static_cast<int64_t>(blockSize_);
+    }
+}
+
+bool ReadCache::LoadFromFile(uint64_t index, butil::IOBuf* data,
+                             uint64_t* sequence) {
+    std::unique_ptr<char[]> buf(new char[blockSize_]);
+    {
+        std::lock_guard<std::mutex> lk(fileMtx_);
+        auto iter = file_.map.find(index);
+        if (iter == file_.map.end()) {
+            return false;
+        }
+
+        *sequence = iter->second->sequence;
+        if (BlockSequence(index) != *sequence) {
+            EraseFromFile(index);
+            return false;
+        }
+
+        uint64_t slot = iter->second->slot;
+        ssize_t nread = ::pread(fd_, buf.get(), blockSize_, slot * blockSize_);
+        if (nread != static_cast<ssize_t>(blockSize_)) {
+            LOG(WARNING) << "Read read cache file failed, slot = " << slot
+                         << ", ret = " << nread << ", errno = " << errno;
+            EraseFromFile(index);
+            return false;
+        }
+        file_.lru.splice(file_.lru.begin(), file_.lru, iter->second);
+    }
+
+    data->append(buf.get(), blockSize_);
+    if (metric_ != nullptr) {
+        metric_->fileHit << 1;
+    }
+    return true;
+}
+
+}  // namespace client
+}  // namespace curve
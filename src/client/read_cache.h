@@ -0,0 +1,172 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CLIENT_READ_CACHE_H_
+#define SRC_CLIENT_READ_CACHE_H_
+
+#include <butil/iobuf.h>
+
+#include <atomic>
+#include <list>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/client/client_metric.h"
+#include "src/client/config_info.h"
+
+namespace curve {
+namespace client {
+
+/**
+ * 文件级别的读缓存，按照文件内固定大小的block缓存用户读到的数据
+ *
+ * 缓存只保存完整的对齐block，一个读请求只有在其覆盖的所有block都在缓存中
+ * 的时候才命中，未命中的读照常下发到chunkserver，返回后再填充缓存。
+ * 内存中的block按LRU淘汰，配置了缓存文件的时候，被淘汰的block写入本地
+ * 缓存文件作为第二级缓存，文件打开后即unlink，进程退出后自动回收。
+ *
+ * 每个block有一个序列号，由文件级别的generation和block所在分片的计数器
+ * 组成，写和discard在下发前和返回后都会增加对应分片的计数器并删除缓存，
+ * 读在下发前记录序列号，只有返回时序列号没有变化才会填充缓存，这样与写
+ * 并发的读不会把旧数据留在缓存里。
+ */
+class ReadCache {
+ public:
+    ReadCache();
+    ~ReadCache();
+
+    /**
+     * @brief 初始化读缓存
+     * @param opt 读缓存配置
+     * @param filename 缓存的文件名，用于生成缓存文件的路径
+     * @param metric 命中率等统计信息，可以为空
+     * @return 成功返回true，缓存文件打开失败返回false
+     */
+    bool Init(const ReadCacheOption& opt, const std::string& filename,
+              ReadCacheMetric* metric);
+
+    /**
+     * @brief 从缓存读取数据，只有整个范围都在缓存中才会成功
+     * @param offset 文件内偏移
+     * @param length 读取长度
+     * @param[out] data 读到的数据
+     * @return 命中返回true，否则返回false
+     */
+    bool Get(uint64_t offset, uint64_t length, butil::IOBuf* data);
+
+    /**
+     * @brief 读请求下发前获取范围的序列号，数据返回后传给Put
+     */
+    uint64_t Sequence(uint64_t offset, uint64_t length) const;
+
+    /**
+     * @brief 用从chunkserver读到的数据填充缓存，只缓存完整的对齐block，
+     *        如果期间范围内有写或者失效，数据会被丢弃
+     * @param offset 读请求的文件内偏移
+     * @param data 读请求读到的数据
+     * @param sequence 读请求下发前通过Sequence获取的序列号
+     */
+    void Put(uint64_t offset, const butil::IOBuf& data, uint64_t sequence);
+
+    /**
+     * @brief 失效范围内的缓存，写和discard在下发前和返回后调用
+     */
+    void Invalidate(uint64_t offset, uint64_t length);
+
+    /**
+     * @brief 失效所有缓存，在文件版本、epoch变化或者lease失效的时候调用
+     */
+    void Clear();
+
+    uint64_t BlockSize() const {
+        return blockSize_;
+    }
+
+ private:
+    struct Entry {
+        uint64_t index;
+        uint64_t sequence;
+        // 内存中的数据
+        butil::IOBuf data;
+        // 缓存文件中的位置
+        uint64_t slot;
+    };
+
+    using LRUList = std::list<Entry>;
+
+    struct Tier {
+        LRUList lru;
+        std::unordered_map<uint64_t, LRUList::iterator> map;
+    };
+
+    uint64_t BlockSequence(uint64_t index) const;
+
+    // 必须持有memMtx_
+    void EraseFromMemory(uint64_t index);
+
+    // 必须持有fileMtx_
+    void EraseFromFile(uint64_t index);
+
+    // 将从内存中淘汰的block写入缓存文件
+    void SpillToFile(const Entry& entry);
+
+    // 从缓存文件中读取block，sequence返回block写入文件时的序列号
+    bool LoadFromFile(uint64_t index, butil::IOBuf* data, uint64_t* sequence);
+
+    // 将block放入内存，evicted返回需要写入缓存文件的block
+    void InsertToMemory(uint64_t index, const butil::IOBuf& data,
+                        uint64_t sequence, std::vector<Entry>* evicted);
+
+    bool OpenCacheFile(const std::string& dir, const std::string& filename);
+
+    template <typename EraseFunc>
+    void EraseRange(const Tier& tier, uint64_t first, uint64_t last,
+                    EraseFunc erase);
+
+ private:
+    static const uint32_t kStripeNum = 1024;
+
+    uint64_t blockSize_;
+    uint64_t memCapacity_;
+    uint64_t memBytes_;
+
+    std::atomic<uint64_t> generation_;
+    std::atomic<uint64_t> stripes_[kStripeNum];
+
+    std::mutex memMtx_;
+    Tier memory_;
+
+    // 缓存文件相关，fd_小于0表示没有第二级缓存
+    int fd_;
+    std::mutex fileMtx_;
+    Tier file_;
+    std::vector<uint64_t> freeSlots_;
+
+    ReadCacheMetric* metric_;
+};
+
+}  // namespace client
+}  // namespace curve
+
+#endif  // SRC_CLIENT_READ_CACHE_H_
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/client/readahead.h"
+
+#include <algorithm>
+
+namespace curve {
+namespace client {
+
+const uint32_t Readahead::kTriggerCount;
+
+Readahead::Readahead(const ReadaheadOption& opt, uint64_t alignment)
+    : initWindow_(std::min(opt.initWindowKB, opt.maxWindowKB) * 1024),
+      maxWindow_(opt.maxWindowKB * 1024),
+      alignment_(alignment),
+      nextOffset_(0),
+      seqCount_(0),
+      window_(0),
+      raEnd_(0),
+      nextId_(0) {}
+
+bool Readahead::OnRead(uint64_t offset, uint64_t length,
+                       uint64_t* raOffset, uint64_t* raLength) {
+    if (length == 0 || maxWindow_ == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lk(mtx_);
+    // async reads of a stream may arrive out of order, reads in the
+    // prefetched range not far behind the stream are also sequential
+    bool sequential = offset == nextOffset_ ||
+                      (window_ > 0 && offset < raEnd_ &&
+                       offset + window_ > nextOffset_);
+    if (!sequential) {
+        nextOffset_ = offset + length;
+        seqCount_ = 1;
+        window_ = 0;
+        raEnd_ = 0;
+        return false;
+    }
+
+    nextOffset_ = std::max(nextOffset_, offset + length);
+    if (seqCount_ < kTriggerCount) {
+        ++seqCount_;
+    }
+    if (seqCount_ < kTriggerCount) {
+        return false;
+    }
+
+    if (window_ == 0) {
+        window_ = std::min(std::max(initWindow_, length), maxWindow_);
+        raEnd_ = nextOffset_;
+    } else if (raEnd_ > nextOffset_ && raEnd_ - nextOffset_ >= window_ / 2) {
+        // enough data is prefetched ahead of the reads
+        return false;
+    } else {
+        // the last window is hit, grow the window
+        window_ = std::min(window_ * 2, maxWindow_);
+        raEnd_ = std::max(raEnd_, nextOffset_);
+    }
+
+    uint64_t start = raEnd_ / alignment_ * alignment_;
+    uint64_t end =
+        (raEnd_ + window_ + alignment_ - 1) / alignment_ * alignment_;
+    raEnd_ = end;
+    *raOffset = start;
+    *raLength = end - start;
+    return true;
+}
+
+uint64_t Readahead::AddInflight(uint64_t offset, uint64_t length) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    uint64_t id = nextId_++;
+    InflightWindow& window = inflight_[id];
+    window.offset = offset;
+    window.length = length;
+    return id;
+}
+
+bool Readahead::WaitInflight(uint64_t offset, uint64_t length,
+                             const Task& task) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    InflightWindow* window = FindInflight(offset, length);
+    if (window == nullptr) {
+        return false;
+    }
+
+    window->waiters.push_back(Waiter{offset, length, task});
+    return true;
+}
+
+void Readahead::RemoveInflight(uint64_t id, std::vector<Task>* tasks) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto iter = inflight_.find(id);
+    if (iter == inflight_.end()) {
+        return;
+    }
+
+    std::vector<Waiter> waiters;
+    waiters.swap(iter->second.waiters);
+    inflight_.erase(iter);
+
+    // a read may span several windows, it waits for all of them
+    for (auto& waiter : waiters) {
+        InflightWindow* window = FindInflight(waiter.offset, waiter.length);
+        if (window != nullptr) {
+            window->waiters.push_back(std::move(waiter));
+        } else {
+            tasks->push_back(std::move(waiter.task));
+        }
+    }
+}
+
+Readahead::InflightWindow* Readahead::FindInflight(uint64_t offset,
+                                                   uint64_t length) {
+    for (auto& item : inflight_) {
+        InflightWindow& window = item.second;
+        if (offset < window.offset + window.length &&
+            window.offset < offset + length) {
+            return &window;
+        }
+    }
+    return nullptr;
+}
+
+uint64_t Readahead::Window() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return window_;
+}
+
+}  // namespace client
+}  // namespace curve
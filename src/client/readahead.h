@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CLIENT_READAHEAD_H_
+#define SRC_CLIENT_READAHEAD_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "src/client/config_info.h"
+
+namespace curve {
+namespace client {
+
+/**
+ * 文件级别的顺序读检测，决定什么时候预读以及预读的范围
+ *
+ * 连续的读请求达到一定次数之后开始预读，预读窗口从初始大小开始，每当
+ * 用户读到上一个窗口的后半部分，就在上一个窗口之后预读下一个窗口，并
+ * 将窗口大小翻倍，直到最大值。出现随机读的时候窗口清零，重新检测。
+ * 预读的数据放在读缓存中，之后的读请求直接从缓存返回。
+ * 和正在进行的预读重叠的读请求等预读完成之后再下发，避免重复读同样的数据。
+ */
+class Readahead {
+ public:
+    using Task = std::function<void()>;
+
+    /**
+     * @param opt 预读配置
+     * @param alignment 预读范围的对齐大小，即读缓存的block大小
+     */
+    Readahead(const ReadaheadOption& opt, uint64_t alignment);
+
+    /**
+     * @brief 记录一个用户读请求，需要预读的时候返回预读的范围
+     * @param offset 用户读请求的偏移
+     * @param length 用户读请求的长度
+     * @param[out] raOffset 预读的偏移
+     * @param[out] raLength 预读的长度
+     * @return 需要预读返回true，否则返回false
+     */
+    bool OnRead(uint64_t offset, uint64_t length,
+                uint64_t* raOffset, uint64_t* raLength);
+
+    /**
+     * @brief 记录一个已经下发的预读
+     * @param offset 预读的偏移
+     * @param length 预读的长度
+     * @return 预读的id，预读完成的时候传给RemoveInflight
+     */
+    uint64_t AddInflight(uint64_t offset, uint64_t length);
+
+    /**
+     * @brief 读请求和正在进行的预读重叠的时候，把读请求挂在预读上
+     * @param offset 读请求的偏移
+     * @param length 读请求的长度
+     * @param task 预读完成之后执行的读请求
+     * @return 挂在预读上返回true，否则返回false，调用者直接执行task
+     */
+    bool WaitInflight(uint64_t offset, uint64_t length, const Task& task);
+
+    /**
+     * @brief 预读完成，不论成功还是失败
+     * @param id AddInflight返回的预读id
+     * @param[out] tasks 挂在预读上，并且不再和其他预读重叠的读请求
+     */
+    void RemoveInflight(uint64_t id, std::vector<Task>* tasks);
+
+    // 当前预读窗口大小，测试使用
+    uint64_t Window();
+
+ private:
+    struct Waiter {
+        uint64_t offset;
+        uint64_t length;
+        Task task;
+    };
+
+    struct InflightWindow {
+        uint64_t offset;
+        uint64_t length;
+        std::vector<Waiter> waiters;
+    };
+
+    // 返回和范围重叠的正在进行的预读，没有的时候返回nullptr，需要持有mtx_
+    InflightWindow* FindInflight(uint64_t offset, uint64_t length);
+
+    // 开始预读需要的连续读请求数量
+    static const uint32_t kTriggerCount = 2;
+
+    const uint64_t initWindow_;
+    const uint64_t maxWindow_;
+    const uint64_t alignment_;
+
+    std::mutex mtx_;
+    // 顺序读的情况下，下一个读请求的偏移
+    uint64_t nextOffset_;
+    // 连续读请求的数量
+    uint32_t seqCount_;
+    // 当前预读窗口大小，0表示没有在预读
+    uint64_t window_;
+    // 已经下发的预读的结束位置
+    uint64_t raEnd_;
+    // 下一个预读的id
+    uint64_t nextId_;
+    // 正在进行的预读，key是预读的id
+    std::map<uint64_t, InflightWindow> inflight_;
+};
+
+}  // namespace client
+}  // namespace curve
+
+#endif  // SRC_CLIENT_READAHEAD_H_
@@ -52,5 +52,33 @@ void RequestClosure::ReleaseInflightRPCToken() {
     }
 }
 
+MergedRequestClosure::MergedRequestClosure(
+    RequestContext* reqctx, std::vector<RequestContext*> requests)
+    : RequestClosure(reqctx), requests_(std::move(requests)) {
+    RequestClosure* first = requests_.front()->done_;
+    SetIOTracker(first->GetIOTracker());
+    SetFileMetric(first->GetMetric());
+    SetIOManager(first->GetIOManager());
+}
+
+void MergedRequestClosure::Run() {
+    ReleaseInflightRPCToken();
+    if (IsSuspendRPC()) {
+        MetricHelper::DecremIOSuspendNum(GetMetric());
+    }
+
+    int errcode = GetErrorCode();
+    for (RequestContext* ctx : requests_) {
+        ctx->trace_.Add(GetReqCtx()->trace_);
+        ctx->done_->SetFailed(errcode);
+        ctx->done_->Run();
+    }
+
+    // deletes this closure as well
+    RequestContext* reqCtx = GetReqCtx();
+    reqCtx->UnInit();
+    delete reqCtx;
+}
+
 }  // namespace client
 }  // namespace curve
@@ -26,6 +26,8 @@
 // for Closure
 #include <google/protobuf/stubs/callback.h>
 
+#include <vector>
+
 #include "include/curve_compiler_specific.h"
 #include "src/client/client_common.h"
 #include "src/client/client_metric.h"
@@ -59,6 +61,14 @@ class CURVE_CACHELINE_ALIGNMENT RequestClosure
      */
     void ReleaseInflightRPCToken();
 
+    /**
+     * @brief Whether the request has got an inflight token, e.g. it has
+     *        been sent and rescheduled
+     */
+    bool HasInflightRPCToken() const {
+        return ownInflight_;
+    }
+
     /**
      * @brief Get error code
      */
@@ -101,6 +111,10 @@ class CURVE_CACHELINE_ALIGNMENT RequestClosure
         ioManager_ = ioManager;
     }
 
+    IOManager* GetIOManager() const {
+        return ioManager_;
+    }
+
     /**
      * @brief 设置当前closure重试次数
      */
@@ -180,6 +194,25 @@ class CURVE_CACHELINE_ALIGNMENT RequestClosure
     uint64_t nextTimeoutMS_ = 0;
 };
 
+/**
+ * 多个写请求合并之后的closure，合并的写请求返回的时候，把结果交给每个
+ * 被合并的写请求，然后释放合并的RequestContext
+ */
+class MergedRequestClosure : public RequestClosure {
+ public:
+    /**
+     * @param reqctx: 合并之后的request
+     * @param requests: 被合并的request，tracker等信息使用第一个request的
+     */
+    MergedRequestClosure(RequestContext* reqctx,
+                         std::vector<RequestContext*> requests);
+
+    void Run() override;
+
+ private:
+    std::vector<RequestContext*> requests_;
+};
+
 }  // namespace client
 }  // namespace curve
 
@@ -58,6 +58,39 @@ inline std::ostream& operator<<(std::ostream& os,
     return os;
 }
 
+/**
+ * 请求在client内部各个阶段的耗时，单位us，重试时累加
+ */
+struct RequestTrace {
+    // 放入RequestScheduler队列的时间，取出之后清零
+    uint64_t enqueueUs = 0;
+    // 在RequestScheduler队列中等待的时间
+    uint64_t scheduleQueueUs = 0;
+    // 获取leader和sender的时间，包括失败之后的等待
+    uint64_t getLeaderUs = 0;
+    // rpc的时间
+    uint64_t rpcUs = 0;
+    // rpc失败之后重试前的等待时间
+    uint64_t retryBackoffUs = 0;
+
+    // 合并发送的请求累加合并之后的请求的耗时
+    void Add(const RequestTrace& other) {
+        scheduleQueueUs += other.scheduleQueueUs;
+        getLeaderUs += other.getLeaderUs;
+        rpcUs += other.rpcUs;
+        retryBackoffUs += other.retryBackoffUs;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const RequestTrace& trace) {
+    os << "schedule queue = " << trace.scheduleQueueUs
+       << " us, get leader = " << trace.getLeaderUs
+       << " us, rpc = " << trace.rpcUs
+       << " us, retry backoff = " << trace.retryBackoffUs << " us";
+
+    return os;
+}
+
 struct CURVE_CACHELINE_ALIGNMENT RequestContext {
     RequestContext() : id_(GetNextRequestContextId()) {}
 
@@ -117,6 +150,9 @@ struct CURVE_CACHELINE_ALIGNMENT RequestContext {
     // 当前request context id
     uint64_t            id_ = 0;
 
+    // 各个阶段的耗时
+    RequestTrace        trace_;
+
     static RequestContext* NewInitedRequestContext() {
         RequestContext* ctx = new (std::nothrow) RequestContext();
         if (ctx && ctx->Init()) {
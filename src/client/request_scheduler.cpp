@@ -24,21 +24,35 @@
 
 #include <brpc/closure_guard.h>
 #include <glog/logging.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <chrono>  // NOLINT
+#include <string>
+#include <vector>
 
 #include "src/client/request_context.h"
 #include "src/client/request_closure.h"
 #include "src/client/chunk_closure.h"
+#include "src/common/string_util.h"
+#include "src/common/timeutility.h"
 
 namespace curve {
 namespace client {
 
-RequestScheduler::~RequestScheduler() {}
+RequestScheduler::~RequestScheduler() {
+    // the schedule threads must be joined before the queues go away
+    if (!scheduleQueues_.empty()) {
+        RequestScheduler::Fini();
+    }
+}
 
 int RequestScheduler::Init(const RequestScheduleOption& reqSchdulerOpt,
                            MetaCache* metaCache,
                            FileMetric* fm) {
     blockIO_.store(false);
     reqschopt_ = reqSchdulerOpt;
+    fileMetric_ = fm;
 
     int rc = 0;
     rc = queue_.Init(reqschopt_.scheduleQueueCapacity);
@@ -46,8 +60,12 @@ int RequestScheduler::Init(const RequestScheduleOption& reqSchdulerOpt,
         return -1;
     }
 
-    rc = threadPool_.Init(reqschopt_.scheduleThreadpoolSize,
-                          std::bind(&RequestScheduler::Process, this));
+    if (reqschopt_.multiQueueOpt.enable) {
+        rc = InitScheduleQueues();
+    } else {
+        rc = threadPool_.Init(reqschopt_.scheduleThreadpoolSize,
+                              std::bind(&RequestScheduler::Process, this));
+    }
     if (0 != rc) {
         return -1;
     }
@@ -61,20 +79,87 @@ int RequestScheduler::Init(const RequestScheduleOption& reqSchdulerOpt,
               << "scheduleQueueCapacity = "
               << reqschopt_.scheduleQueueCapacity
               << ", scheduleThreadpoolSize = "
-              << reqschopt_.scheduleThreadpoolSize;
+              << reqschopt_.scheduleThreadpoolSize
+              << ", writeMerge.enable = "
+              << reqschopt_.writeMergeOpt.enable
+              << ", writeMerge.maxSizeKB = "
+              << reqschopt_.writeMergeOpt.maxSizeKB
+              << ", writeMerge.waitUs = "
+              << reqschopt_.writeMergeOpt.waitUs
+              << ", multiQueue.enable = "
+              << reqschopt_.multiQueueOpt.enable
+              << ", multiQueue.queueCapacity = "
+              << reqschopt_.multiQueueOpt.queueCapacity
+              << ", multiQueue.cpuList = "
+              << reqschopt_.multiQueueOpt.cpuList;
+    return 0;
+}
+
+int RequestScheduler::InitScheduleQueues() {
+    const MultiQueueOption& opt = reqschopt_.multiQueueOpt;
+    if (reqschopt_.scheduleThreadpoolSize == 0) {
+        LOG(ERROR) << "schedule thread pool size must be positive";
+        return -1;
+    }
+
+    std::vector<std::string> items;
+    curve::common::SplitString(opt.cpuList, ",", &items);
+    std::vector<int> cpus;
+    for (const auto& item : items) {
+        int32_t cpu = 0;
+        if (!curve::common::StringToInt(item, &cpu) || cpu < 0 ||
+            cpu >= CPU_SETSIZE) {
+            LOG(ERROR) << "invalid schedule cpu list: " << opt.cpuList;
+            return -1;
+        }
+        cpus.push_back(cpu);
+    }
+
+    LOG_IF(WARNING, reqschopt_.writeMergeOpt.enable)
+        << "writes are not merged when multi queue is enabled";
+
+    scheduleQueues_.clear();
+    for (uint32_t i = 0; i < reqschopt_.scheduleThreadpoolSize; ++i) {
+        std::unique_ptr<ScheduleQueue> q(
+            new ScheduleQueue(opt.queueCapacity));
+        if (!cpus.empty()) {
+            q->cpu = cpus[i % cpus.size()];
+        }
+        scheduleQueues_.emplace_back(std::move(q));
+    }
     return 0;
 }
 
 int RequestScheduler::Run() {
     if (!running_.exchange(true, std::memory_order_acq_rel)) {
         stop_.store(false, std::memory_order_release);
-        threadPool_.Start();
+        if (scheduleQueues_.empty()) {
+            threadPool_.Start();
+        } else {
+            for (auto& q : scheduleQueues_) {
+                q->stop = false;
+                q->thread = std::thread(&RequestScheduler::ProcessQueue,
+                                        this, q.get());
+            }
+        }
     }
     return 0;
 }
 
 int RequestScheduler::Fini() {
     if (running_.exchange(false, std::memory_order_acq_rel)) {
+        if (!scheduleQueues_.empty()) {
+            // the stop task runs after all the requests in the queue
+            for (auto& q : scheduleQueues_) {
+                ScheduleQueue* queue = q.get();
+                queue->queue.Push([queue]() { queue->stop = true; });
+            }
+            for (auto& q : scheduleQueues_) {
+                q->thread.join();
+            }
+            return 0;
+        }
+
         for (int i = 0; i < threadPool_.NumOfThreads(); ++i) {
             // notify the wait thread
             BBQItem<RequestContext *> stopReq(nullptr, true);
@@ -99,8 +184,7 @@ int RequestScheduler::ScheduleRequest(
                 continue;
             }
 
-            BBQItem<RequestContext *> req(it);
-            queue_.PutBack(req);
+            EnqueueRequest(it, false);
         }
         return 0;
     }
@@ -109,8 +193,7 @@ int RequestScheduler::ScheduleRequest(
 
 int RequestScheduler::ScheduleRequest(RequestContext *request) {
     if (running_.load(std::memory_order_acquire)) {
-        BBQItem<RequestContext *> req(request);
-        queue_.PutBack(req);
+        EnqueueRequest(request, false);
         return 0;
     }
     return -1;
@@ -118,13 +201,31 @@ int RequestScheduler::ScheduleRequest(RequestContext *request) {
 
 int RequestScheduler::ReSchedule(RequestContext *request) {
     if (running_.load(std::memory_order_acquire)) {
-        BBQItem<RequestContext *> req(request);
-        queue_.PutFront(req);
+        EnqueueRequest(request, true);
         return 0;
     }
     return -1;
 }
 
+void RequestScheduler::EnqueueRequest(RequestContext* ctx, bool front) {
+    ctx->trace_.enqueueUs = TimeUtility::GetTimeofDayUs();
+
+    if (scheduleQueues_.empty()) {
+        BBQItem<RequestContext *> req(ctx);
+        if (front) {
+            queue_.PutFront(req);
+        } else {
+            queue_.PutBack(req);
+        }
+        return;
+    }
+
+    // requests of a chunk are always in the same queue and keep their order,
+    // rescheduled requests go to the back as the queue has no front
+    auto& q = scheduleQueues_[ctx->idinfo_.cid_ % scheduleQueues_.size()];
+    q->queue.Push(&RequestScheduler::ProcessQueuedRequest, this, ctx);
+}
+
 void RequestScheduler::WakeupBlockQueueAtExit() {
     // 在scheduler退出的时候要把队列的内容清空, 通知copyset client
     // 当前操作是退出状态，copyset client会针对inflight RPC做响应处理
@@ -148,6 +249,10 @@ void RequestScheduler::Process() {
         BBQItem<RequestContext*> item = queue_.TakeFront();
         if (!item.IsStop()) {
             RequestContext* req = item.Item();
+            if (reqschopt_.writeMergeOpt.enable &&
+                req->optype_ == OpType::WRITE) {
+                req = MergeWrite(req);
+            }
             ProcessOne(req);
         } else {
             /**
@@ -159,9 +264,122 @@ void RequestScheduler::Process() {
     }
 }
 
+void RequestScheduler::ProcessQueue(ScheduleQueue* q) {
+    if (q->cpu >= 0) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(q->cpu, &cpuset);
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset),
+                                        &cpuset);
+        LOG_IF(WARNING, rc != 0) << "bind schedule thread to cpu " << q->cpu
+                                 << " failed, error = " << rc;
+    }
+
+    while (!q->stop) {
+        q->queue.Pop()();
+    }
+}
+
+void RequestScheduler::ProcessQueuedRequest(RequestContext* ctx) {
+    WaitValidSession();
+    ProcessOne(ctx);
+}
+
+bool RequestScheduler::IsContiguousWrite(const RequestContext* last,
+                                         const RequestContext* next) {
+    // requests of clone chunks carry the source location of their own range,
+    // and rescheduled requests release their inflight token on their own
+    return next->optype_ == OpType::WRITE &&
+           !next->done_->HasInflightRPCToken() &&
+           next->idinfo_.cid_ == last->idinfo_.cid_ &&
+           next->idinfo_.cpid_ == last->idinfo_.cpid_ &&
+           next->idinfo_.lpid_ == last->idinfo_.lpid_ &&
+           next->idinfo_.chunkExist == last->idinfo_.chunkExist &&
+           next->fileId_ == last->fileId_ &&
+           next->epoch_ == last->epoch_ &&
+           next->seq_ == last->seq_ &&
+           !next->sourceInfo_.IsValid() && !last->sourceInfo_.IsValid() &&
+           next->offset_ == last->offset_ +
+                            static_cast<off_t>(last->rawlength_);
+}
+
+RequestContext* RequestScheduler::MergeWrite(RequestContext* ctx) {
+    const uint64_t maxSize =
+        static_cast<uint64_t>(reqschopt_.writeMergeOpt.maxSizeKB) * 1024;
+    if (ctx->sourceInfo_.IsValid() || ctx->done_->HasInflightRPCToken() ||
+        ctx->rawlength_ >= maxSize) {
+        return ctx;
+    }
+
+    // only the front of the queue is merged, so the order of the writes
+    // doesn't change, and overlapping writes are never reordered
+    std::vector<RequestContext*> requests{ctx};
+    uint64_t length = ctx->rawlength_;
+    auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(reqschopt_.writeMergeOpt.waitUs);
+    auto mergeable = [&](BBQItem<RequestContext*>& item) {
+        if (item.IsStop()) {
+            return false;
+        }
+        RequestContext* next = item.Item();
+        return IsContiguousWrite(requests.back(), next) &&
+               length + next->rawlength_ <= maxSize;
+    };
+
+    BBQItem<RequestContext*> item(nullptr);
+    while (length < maxSize &&
+           queue_.TakeFrontIf(mergeable, deadline, &item)) {
+        requests.push_back(item.Item());
+        length += item.Item()->rawlength_;
+    }
+
+    if (requests.size() == 1) {
+        return ctx;
+    }
+
+    RequestContext* merged = new (std::nothrow) RequestContext();
+    MergedRequestClosure* done = nullptr;
+    if (merged != nullptr) {
+        done = new (std::nothrow) MergedRequestClosure(merged, requests);
+    }
+    if (done == nullptr) {
+        LOG(ERROR) << "allocate merged write request failed, "
+                   << "send the requests separately";
+        delete merged;
+        for (size_t i = 0; i + 1 < requests.size(); ++i) {
+            ProcessOne(requests[i]);
+        }
+        return requests.back();
+    }
+
+    merged->done_ = done;
+    merged->idinfo_ = ctx->idinfo_;
+    merged->optype_ = OpType::WRITE;
+    merged->offset_ = ctx->offset_;
+    merged->rawlength_ = length;
+    merged->fileId_ = ctx->fileId_;
+    merged->epoch_ = ctx->epoch_;
+    merged->seq_ = ctx->seq_;
+    for (RequestContext* req : requests) {
+        // IOBuf append only refers to the data blocks
+        merged->writeData_.append(req->writeData_);
+    }
+
+    MetricHelper::IncremWriteMerge(fileMetric_, requests.size(), length);
+    VLOG(9) << "merged " << requests.size() << " write requests, "
+            << *merged;
+    return merged;
+}
+
 void RequestScheduler::ProcessOne(RequestContext* ctx) {
     brpc::ClosureGuard guard(ctx->done_);
 
+    if (ctx->trace_.enqueueUs != 0) {
+        ctx->trace_.scheduleQueueUs +=
+            TimeUtility::GetTimeofDayUs() - ctx->trace_.enqueueUs;
+        ctx->trace_.enqueueUs = 0;
+    }
+
     switch (ctx->optype_) {
         case OpType::READ:
             ctx->done_->GetInflightRPCToken();
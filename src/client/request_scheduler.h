@@ -23,11 +23,14 @@
 #ifndef SRC_CLIENT_REQUEST_SCHEDULER_H_
 #define SRC_CLIENT_REQUEST_SCHEDULER_H_
 
+#include <memory>
+#include <thread>  // NOLINT
 #include <vector>
 
 #include "src/common/uncopyable.h"
 #include "src/client/config_info.h"
 #include "src/common/concurrent/bounded_blocking_queue.h"
+#include "src/common/concurrent/mpsc_task_queue.h"
 #include "src/common/concurrent/thread_pool.h"
 #include "src/client/client_common.h"
 #include "src/client/copyset_client.h"
@@ -39,12 +42,16 @@ namespace client {
 using curve::common::ThreadPool;
 using curve::common::BoundedBlockingDeque;
 using curve::common::BBQItem;
+using curve::common::MpscTaskQueue;
 using curve::common::Uncopyable;
 
 struct RequestContext;
 /**
  * 请求调度器，上层拆分的I/O会交给Scheduler的线程池
  * 分发到具体的ChunkServer，后期QoS也会放在这里处理
+ *
+ * 默认所有调度线程共用一个阻塞队列，多队列模式下每个调度线程有自己的
+ * 无锁队列，请求按照chunk id分配到队列中
  */
 class RequestScheduler : public Uncopyable {
  public:
@@ -52,6 +59,7 @@ class RequestScheduler : public Uncopyable {
         : running_(false),
           stop_(true),
           client_(),
+          fileMetric_(nullptr),
           blockingQueue_(true) {}
     virtual ~RequestScheduler();
 
@@ -133,13 +141,60 @@ class RequestScheduler : public Uncopyable {
     }
 
  private:
+    // 多队列模式下每个调度线程的队列
+    struct ScheduleQueue {
+        explicit ScheduleQueue(size_t capacity) : queue(capacity) {}
+
+        MpscTaskQueue queue;
+        // 只在调度线程中访问，收到stop任务之后退出
+        bool stop = false;
+        // 绑定的cpu，-1表示不绑定
+        int cpu = -1;
+        std::thread thread;
+    };
+
     /**
      * Thread pool的运行函数，会从queue中取request进行处理
      */
     void Process();
 
+    /**
+     * 多队列模式下调度线程的运行函数
+     */
+    void ProcessQueue(ScheduleQueue* q);
+
+    /**
+     * 多队列模式下处理一个从队列中取出的request
+     */
+    void ProcessQueuedRequest(RequestContext* ctx);
+
+    /**
+     * 把request放入队列，多队列模式下同一个chunk的请求放入同一个队列
+     * @param front: 单队列模式下是否放到队列头部
+     */
+    void EnqueueRequest(RequestContext* ctx, bool front);
+
+    /**
+     * 初始化多队列模式的队列
+     * @return 0成功，-1失败
+     */
+    int InitScheduleQueues();
+
     void ProcessOne(RequestContext* ctx);
 
+    /**
+     * 把队首同一个chunk上连续的写请求合并到ctx之后
+     * @param ctx: 刚从队列中取出的写请求
+     * @return 合并之后的request，没有可以合并的请求时返回ctx
+     */
+    RequestContext* MergeWrite(RequestContext* ctx);
+
+    /**
+     * next是否可以合并到last之后
+     */
+    static bool IsContiguousWrite(const RequestContext* last,
+                                  const RequestContext* next);
+
     void WaitValidSession() {
         // lease续约失败的时候需要阻塞IO直到续约成功
         if (blockIO_.load(std::memory_order_acquire) && blockingQueue_) {
@@ -157,6 +212,8 @@ class RequestScheduler : public Uncopyable {
     BoundedBlockingDeque<BBQItem<RequestContext *>> queue_;
     // 处理 request 的线程池
     ThreadPool threadPool_;
+    // 多队列模式下每个调度线程的队列，单队列模式下为空
+    std::vector<std::unique_ptr<ScheduleQueue>> scheduleQueues_;
     // Scheduler 运行标记，只有运行了，才接收 request
     std::atomic<bool> running_;
     // stop thread pool 标记，当调用 Scheduler Fini
@@ -165,6 +222,8 @@ class RequestScheduler : public Uncopyable {
     std::atomic<bool> stop_;
     // 访问复制组Chunk的客户端
     CopysetClient client_;
+    // 文件的metric信息
+    FileMetric* fileMetric_;
     // 续约失败，卡住IO
     std::atomic<bool> blockIO_;
     // 此锁与LeaseRefreshcv_条件变量配合使用
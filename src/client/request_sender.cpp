@@ -21,9 +21,15 @@
  */
 
 #include "src/client/request_sender.h"
+#include <bthread/bthread.h>
+#include <brpc/errno.pb.h>
+#include <brpc/stream.h>
+#include <butil/sys_byteorder.h>
 #include <glog/logging.h>
 
 #include <algorithm>
+#include <atomic>
+#include <utility>
 
 #include "proto/chunk.pb.h"
 #include "src/common/timeutility.h"
@@ -33,6 +39,9 @@
 namespace curve {
 namespace client {
 
+using curve::chunkserver::BatchChunkRequest;
+using curve::chunkserver::BatchChunkResponse;
+using curve::chunkserver::BatchChunkSubResponse;
 using curve::chunkserver::ChunkRequest;
 using curve::chunkserver::ChunkResponse;
 using curve::chunkserver::ChunkService_Stub;
@@ -41,6 +50,236 @@ using curve::chunkserver::GetChunkInfoResponse;
 using curve::common::TimeUtility;
 using ::google::protobuf::Closure;
 
+namespace {
+
+/**
+ * BatchChunk rpc的closure。创建了stream的时候，每个请求的结果在stream上
+ * 单独返回，收到之后就把response和读到的数据交给各自的cntl，然后调用各自
+ * 的closure；否则rpc返回之后一起处理。rpc失败或者stream关闭的时候，还没有
+ * 返回的请求都失败，chunkserver不支持BatchChunk rpc的时候，这些请求交给
+ * sender单独重新发送
+ */
+class BatchChunkClosure : public Closure, public brpc::StreamInputHandler {
+ public:
+    BatchChunkClosure(std::shared_ptr<RequestSender> sender,
+                      std::vector<BatchChunkOp>* ops)
+        : sender_(std::move(sender)),
+          finished_(ops->size(), false),
+          rpcReturned_(false),
+          streamClosed_(false),
+          streamId_(brpc::INVALID_STREAM_ID),
+          timedOut_(false),
+          refs_(1),
+          startUs_(TimeUtility::GetTimeofDayUs()) {
+        ops_.swap(*ops);
+        for (BatchChunkOp& op : ops_) {
+            request_.add_requests()->Swap(&op.request);
+        }
+    }
+
+    const BatchChunkRequest* Request() const {
+        return &request_;
+    }
+
+    brpc::Controller* Cntl() {
+        return &cntl_;
+    }
+
+    BatchChunkResponse* Response() {
+        return &response_;
+    }
+
+    /**
+     * 创建接收每个请求结果的stream，创建失败的时候所有请求在rpc返回之后
+     * 一起处理
+     */
+    void CreateStream(int64_t timeoutMs) {
+        brpc::StreamOptions options;
+        options.handler = this;
+        options.idle_timeout_ms = timeoutMs;
+        options.max_buf_size = 0;  // unlimited buffer size
+        if (brpc::StreamCreate(&streamId_, cntl_, &options) != 0) {
+            LOG(WARNING) << "Fail to create batch chunk stream";
+            streamId_ = brpc::INVALID_STREAM_ID;
+            return;
+        }
+        // released in on_closed()
+        refs_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Run() override {
+        if (cntl_.Failed() && (cntl_.ErrorCode() == brpc::ENOMETHOD ||
+                               cntl_.ErrorCode() == brpc::EREQUEST)) {
+            LOG(WARNING) << "Batch chunk rpc is not supported by chunkserver "
+                         << sender_->GetChunkServerID() << ", "
+                         << cntl_.ErrorText()
+                         << ", send the requests one by one";
+            Resend();
+        } else if (cntl_.Failed()) {
+            FailAll(cntl_.ErrorCode(), cntl_.ErrorText());
+        } else if (streamId_ == brpc::INVALID_STREAM_ID ||
+                   response_.responses_size() > 0) {
+            // all the responses are returned in the rpc
+            butil::IOBuf& readData = cntl_.response_attachment();
+            for (int i = 0; i < response_.responses_size() &&
+                            i < static_cast<int>(ops_.size()); ++i) {
+                Finish(i, response_.mutable_responses(i), &readData);
+            }
+            FailAll(brpc::ERESPONSE, "missing response in batch rpc");
+        }
+
+        if (streamId_ != brpc::INVALID_STREAM_ID &&
+            (cntl_.Failed() || response_.responses_size() > 0)) {
+            brpc::StreamClose(streamId_);
+        }
+
+        bool streamClosed = false;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            rpcReturned_ = true;
+            streamClosed = streamClosed_;
+        }
+        if (streamClosed) {
+            FailOnStreamClosed();
+        }
+        Release();
+    }
+
+    int on_received_messages(brpc::StreamId id,
+                             butil::IOBuf* const messages[],
+                             size_t size) override {
+        for (size_t i = 0; i < size; ++i) {
+            butil::IOBuf* msg = messages[i];
+            uint32_t metaSize = 0;
+            msg->cutn(&metaSize, sizeof(uint32_t));
+            metaSize = butil::NetToHost32(metaSize);
+
+            butil::IOBuf meta;
+            msg->cutn(&meta, metaSize);
+            butil::IOBufAsZeroCopyInputStream wrapper(meta);
+            BatchChunkSubResponse subResponse;
+            if (!subResponse.ParseFromZeroCopyStream(&wrapper) ||
+                subResponse.index() >= ops_.size()) {
+                LOG(ERROR) << "Invalid batch chunk sub response, stream id: "
+                           << id;
+                continue;
+            }
+            Finish(subResponse.index(), subResponse.mutable_response(), msg);
+        }
+        return 0;
+    }
+
+    void on_idle_timeout(brpc::StreamId id) override {
+        LOG(WARNING) << "Batch chunk stream idle timeout, stream id: " << id;
+        timedOut_.store(true, std::memory_order_relaxed);
+        brpc::StreamClose(id);
+    }
+
+    void on_closed(brpc::StreamId id) override {
+        (void)id;
+        bool rpcReturned = false;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            streamClosed_ = true;
+            rpcReturned = rpcReturned_;
+        }
+        // the stream may be closed before the rpc returns if the rpc fails,
+        // then the requests fail with the error of the rpc in Run()
+        if (rpcReturned) {
+            FailOnStreamClosed();
+        }
+        Release();
+    }
+
+ private:
+    void FailOnStreamClosed() {
+        if (timedOut_.load(std::memory_order_relaxed)) {
+            FailAll(brpc::ERPCTIMEDOUT, "batch chunk stream timed out");
+        } else {
+            FailAll(brpc::EEOF, "batch chunk stream closed");
+        }
+    }
+
+    // 请求是否第一次完成，重复的和rpc失败之后才收到的结果被丢弃
+    bool MarkFinished(size_t index) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (finished_[index]) {
+            return false;
+        }
+        finished_[index] = true;
+        return true;
+    }
+
+    void Finish(size_t index, ChunkResponse* response, butil::IOBuf* data) {
+        if (!MarkFinished(index)) {
+            return;
+        }
+
+        BatchChunkOp& op = ops_[index];
+        const ChunkRequest& request = request_.requests(index);
+        op.response->Swap(response);
+        if (request.optype() ==
+                curve::chunkserver::CHUNK_OP_TYPE::CHUNK_OP_READ &&
+            op.response->status() ==
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            data->cutn(&op.cntl->response_attachment(), request.size());
+        }
+        op.done->SetBatchLatencyUs(TimeUtility::GetTimeofDayUs() - startUs_);
+        op.done->Run();
+    }
+
+    // 把还没有结果的请求交给sender单独重新发送
+    void Resend() {
+        std::vector<BatchChunkOp> ops;
+        for (size_t i = 0; i < ops_.size(); ++i) {
+            if (!MarkFinished(i)) {
+                continue;
+            }
+            ops.push_back(ops_[i]);
+            ops.back().request.Swap(request_.mutable_requests(i));
+        }
+        sender_->FallbackFromBatch(&ops);
+    }
+
+    void FailAll(int errorCode, const std::string& errorText) {
+        for (size_t i = 0; i < ops_.size(); ++i) {
+            if (!MarkFinished(i)) {
+                continue;
+            }
+            BatchChunkOp& op = ops_[i];
+            op.cntl->SetFailed(errorCode, "%s", errorText.c_str());
+            op.done->SetBatchLatencyUs(
+                TimeUtility::GetTimeofDayUs() - startUs_);
+            op.done->Run();
+        }
+    }
+
+    // rpc和stream都结束之后释放
+    void Release() {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+ private:
+    std::shared_ptr<RequestSender> sender_;
+    std::vector<BatchChunkOp> ops_;
+    BatchChunkRequest request_;
+    brpc::Controller cntl_;
+    BatchChunkResponse response_;
+    // 保护finished_、rpcReturned_和streamClosed_
+    std::mutex mtx_;
+    std::vector<bool> finished_;
+    bool rpcReturned_;
+    bool streamClosed_;
+    brpc::StreamId streamId_;
+    std::atomic<bool> timedOut_;
+    std::atomic<int> refs_;
+    uint64_t startUs_;
+};
+
+}  // namespace
+
 inline void RequestSender::UpdateRpcRPS(ClientClosure* done,
                                         OpType type) const {
     RequestClosure* request = static_cast<RequestClosure*>(done->GetClosure());
@@ -105,12 +344,40 @@ int RequestSender::ReadChunk(const ChunkIDInfo& idinfo,
         request.set_appliedindex(appliedindex);
     }
 
+    if (BatchEnabled()) {
+        AddToBatch(&request, cntl, response, doneGuard.release());
+        return 0;
+    }
+
     ChunkService_Stub stub(&channel_);
     stub.ReadChunk(cntl, &request, response, doneGuard.release());
 
     return 0;
 }
 
+void RequestSender::FollowerReadChunk(const ChunkIDInfo& idinfo,
+                                      off_t offset,
+                                      size_t length,
+                                      uint64_t appliedindex,
+                                      brpc::Controller* cntl,
+                                      ChunkResponse* response,
+                                      google::protobuf::Closure* done) {
+    cntl->set_timeout_ms(iosenderopt_.failRequestOpt.chunkserverRPCTimeoutMS);
+
+    ChunkRequest request;
+    request.set_optype(curve::chunkserver::CHUNK_OP_TYPE::CHUNK_OP_READ);
+    request.set_logicpoolid(idinfo.lpid_);
+    request.set_copysetid(idinfo.cpid_);
+    request.set_chunkid(idinfo.cid_);
+    request.set_offset(offset);
+    request.set_size(length);
+    request.set_appliedindex(appliedindex);
+    request.set_followerread(true);
+
+    ChunkService_Stub stub(&channel_);
+    stub.ReadChunk(cntl, &request, response, done);
+}
+
 int RequestSender::WriteChunk(const ChunkIDInfo& idinfo,
                               uint64_t fileId,
                               uint64_t epoch,
@@ -149,12 +416,117 @@ int RequestSender::WriteChunk(const ChunkIDInfo& idinfo,
     }
 
     cntl->request_attachment().append(data);
+    if (BatchEnabled()) {
+        AddToBatch(&request, cntl, response, doneGuard.release());
+        return 0;
+    }
+
     ChunkService_Stub stub(&channel_);
     stub.WriteChunk(cntl, &request, response, doneGuard.release());
 
     return 0;
 }
 
+void RequestSender::AddToBatch(ChunkRequest* request,
+                               brpc::Controller* cntl,
+                               ChunkResponse* response,
+                               ClientClosure* done) {
+    std::vector<BatchChunkOp> ops;
+    bool startTick = false;
+    {
+        std::lock_guard<std::mutex> lk(batchMtx_);
+        batchOps_.push_back(BatchChunkOp{ChunkRequest(), cntl, response, done});
+        batchOps_.back().request.Swap(request);
+        if (batchOps_.size() >= iosenderopt_.batchOpt.maxBatchSize) {
+            ops.swap(batchOps_);
+        } else {
+            startTick = batchOps_.size() == 1;
+        }
+    }
+
+    if (!ops.empty()) {
+        SendBatch(&ops);
+        return;
+    }
+
+    if (startTick) {
+        // the tick keeps the sender alive until the ops are sent
+        auto sender = new std::shared_ptr<RequestSender>(shared_from_this());
+        bthread_t tid;
+        if (bthread_start_background(&tid, nullptr, &RequestSender::BatchTick,
+                                     sender) != 0) {
+            LOG(ERROR) << "start batch tick failed, send the requests now";
+            delete sender;
+            FlushBatch();
+        }
+    }
+}
+
+void* RequestSender::BatchTick(void* arg) {
+    std::unique_ptr<std::shared_ptr<RequestSender>> sender(
+        static_cast<std::shared_ptr<RequestSender>*>(arg));
+    bthread_usleep((*sender)->iosenderopt_.batchOpt.tickUs);
+    (*sender)->FlushBatch();
+    return nullptr;
+}
+
+void RequestSender::FlushBatch() {
+    std::vector<BatchChunkOp> ops;
+    {
+        std::lock_guard<std::mutex> lk(batchMtx_);
+        ops.swap(batchOps_);
+    }
+
+    if (!ops.empty()) {
+        SendBatch(&ops);
+    }
+}
+
+void RequestSender::SendChunkOp(BatchChunkOp* op) {
+    ChunkService_Stub stub(&channel_);
+    if (op->request.optype() ==
+            curve::chunkserver::CHUNK_OP_TYPE::CHUNK_OP_WRITE) {
+        stub.WriteChunk(op->cntl, &op->request, op->response, op->done);
+    } else {
+        stub.ReadChunk(op->cntl, &op->request, op->response, op->done);
+    }
+}
+
+void RequestSender::FallbackFromBatch(std::vector<BatchChunkOp>* ops) {
+    batchUnsupported_.store(true, std::memory_order_relaxed);
+    for (BatchChunkOp& op : *ops) {
+        SendChunkOp(&op);
+    }
+}
+
+void RequestSender::SendBatch(std::vector<BatchChunkOp>* ops) {
+    // a single request doesn't need the batch rpc, and the requests queued
+    // before the chunkserver is found not to support it are sent one by one
+    if (ops->size() == 1 ||
+        batchUnsupported_.load(std::memory_order_relaxed)) {
+        for (BatchChunkOp& op : *ops) {
+            SendChunkOp(&op);
+        }
+        return;
+    }
+
+    butil::IOBuf data;
+    int64_t timeoutMs = 0;
+    for (BatchChunkOp& op : *ops) {
+        timeoutMs = std::max(timeoutMs, op.cntl->timeout_ms());
+        data.append(op.cntl->request_attachment());
+    }
+
+    BatchChunkClosure* done = new BatchChunkClosure(shared_from_this(), ops);
+    brpc::Controller* cntl = done->Cntl();
+    cntl->request_attachment().swap(data);
+    cntl->set_timeout_ms(timeoutMs);
+    done->CreateStream(timeoutMs);
+
+    ChunkService_Stub stub(&channel_);
+    stub.BatchChunk(cntl, done->Request(), done->Response(), done);
+}
+
 int RequestSender::ReadChunkSnapshot(const ChunkIDInfo& idinfo,
                                      uint64_t sn,
                                      off_t offset,
@@ -282,6 +654,8 @@ int RequestSender::ResetSender(ChunkServerID chunkServerId,
                                butil::EndPoint serverEndPoint) {
     chunkServerId_ = chunkServerId;
     serverEndPoint_ = serverEndPoint;
+    // the new chunkserver may support the batch rpc
+    batchUnsupported_.store(false, std::memory_order_relaxed);
     return Init(iosenderopt_);
 }
 
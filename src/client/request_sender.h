@@ -27,28 +27,49 @@
 #include <butil/endpoint.h>
 #include <butil/iobuf.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <vector>
 
 #include "src/client/client_config.h"
 #include "src/client/client_common.h"
 #include "src/client/chunk_closure.h"
+#include "src/client/hedged_read.h"
 #include "include/curve_compiler_specific.h"
 #include "src/client/request_context.h"
 
 namespace curve {
 namespace client {
 
+/**
+ * 等待合并发送的读写请求，cntl、response和done与单独发送的时候一样
+ */
+struct BatchChunkOp {
+    curve::chunkserver::ChunkRequest request;
+    brpc::Controller* cntl;
+    ChunkResponse* response;
+    ClientClosure* done;
+};
+
 /**
  * 一个RequestSender负责管理一个ChunkServer的所有
  * connection，目前一个ChunkServer仅有一个connection
+ *
+ * 开启batchRPC之后，读写请求先放到等待队列中，队列中的请求个数达到
+ * maxBatchSize或者第一个请求等待了tickUs之后，合并成一个BatchChunk
+ * rpc发送，每个请求的结果通过rpc的stream单独返回，交给各自的closure处理。
+ * chunkserver不支持BatchChunk rpc的时候，这个sender不再合并发送
  */
-class RequestSender {
+class RequestSender : public std::enable_shared_from_this<RequestSender> {
  public:
     RequestSender(ChunkServerID chunkServerId,
                   butil::EndPoint serverEndPoint)
         : chunkServerId_(chunkServerId),
           serverEndPoint_(serverEndPoint),
-          channel_() {}
+          channel_(),
+          batchUnsupported_(false) {}
     virtual ~RequestSender() {}
 
     int Init(const IOSenderOption& ioSenderOpt);
@@ -71,6 +92,23 @@ class RequestSender {
                   const RequestSourceInfo& sourceInfo,
                   ClientClosure *done);
 
+    /**
+     * hedged read向follower读Chunk，不经过合并发送
+     * @param idinfo为chunk相关的id信息
+     * @param offset:读的偏移
+     * @param length:读的长度
+     * @param appliedindex:需要读到>=appliedIndex的数据
+     * @param cntl,response:rpc的controller和response，由done释放
+     * @param done:rpc返回的回调
+     */
+    void FollowerReadChunk(const ChunkIDInfo& idinfo,
+                           off_t offset,
+                           size_t length,
+                           uint64_t appliedindex,
+                           brpc::Controller* cntl,
+                           ChunkResponse* response,
+                           google::protobuf::Closure* done);
+
     /**
    * 写Chunk
    * @param idinfo为chunk相关的id信息
@@ -176,12 +214,54 @@ class RequestSender {
        return channel_.CheckHealth() == 0;
     }
 
+    ChunkServerID GetChunkServerID() const {
+        return chunkServerId_;
+    }
+
+    // 这个chunkserver读请求延时的p95，用于决定hedged read的等待时间
+    LatencyQuantile* ReadLatency() {
+        return &readLatency_;
+    }
+
+    /**
+     * chunkserver不支持BatchChunk rpc，之后的读写请求不再合并发送，
+     * 已经合并的请求作为单独的ReadChunk/WriteChunk重新发送
+     * @param ops: 要重新发送的请求
+     */
+    void FallbackFromBatch(std::vector<BatchChunkOp>* ops);
+
  private:
     void UpdateRpcRPS(ClientClosure* done, OpType type) const;
 
     void SetRpcStuff(ClientClosure* done, brpc::Controller* cntl,
                      google::protobuf::Message* rpcResponse) const;
 
+    /**
+     * 读写请求放到等待合并的队列中，request的内容被移走
+     */
+    void AddToBatch(curve::chunkserver::ChunkRequest* request,
+                    brpc::Controller* cntl,
+                    ChunkResponse* response,
+                    ClientClosure* done);
+
+    /**
+     * 发送队列中所有等待合并的请求
+     */
+    void FlushBatch();
+
+    void SendBatch(std::vector<BatchChunkOp>* ops);
+
+    // 单独发送一个等待合并的请求
+    void SendChunkOp(BatchChunkOp* op);
+
+    bool BatchEnabled() const {
+        return iosenderopt_.batchOpt.enable &&
+               !batchUnsupported_.load(std::memory_order_relaxed);
+    }
+
+    // 等待tickUs之后发送队列中的请求
+    static void* BatchTick(void* arg);
+
  private:
     // Rpc stub配置
     IOSenderOption iosenderopt_;
@@ -190,6 +270,15 @@ class RequestSender {
     // ChunkServer 的地址
     butil::EndPoint serverEndPoint_;
     brpc::Channel channel_; /* TODO(wudemiao): 后期会维护多个 channel */
+
+    // 保护batchOps_
+    std::mutex batchMtx_;
+    // 等待合并发送的读写请求
+    std::vector<BatchChunkOp> batchOps_;
+    // chunkserver不支持BatchChunk rpc
+    std::atomic<bool> batchUnsupported_;
+
+    LatencyQuantile readLatency_;
 };
 
 }   // namespace client
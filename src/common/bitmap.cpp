@@ -22,6 +22,12 @@
 
 #include <glog/logging.h>
 #include <memory.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
 #include <utility>
 #include <string>
 #include "src/common/bitmap.h"
@@ -29,6 +35,86 @@
 namespace curve {
 namespace common {
 
+namespace {
+
+const uint32_t kWordBits = 64;
+const size_t kWordBytes = 8;
+
+// 结束位置在其所在64位字中及之前的位的掩码
+inline uint64_t TailMask(uint32_t endIndex) {
+    uint32_t tail = endIndex % kWordBits;
+    return tail == kWordBits - 1 ? ~0ULL : (2ULL << tail) - 1;
+}
+
+/**
+ * 返回从p开始连续等于filler的字节数，每次比较一个64位字
+ */
+size_t SkipByWord(const char* p, size_t len, uint8_t filler) {
+    const uint64_t pattern = filler == 0 ? 0 : ~0ULL;
+    size_t i = 0;
+    for (; i + kWordBytes <= len; i += kWordBytes) {
+        uint64_t word;
+        memcpy(&word, p + i, kWordBytes);
+        if (word != pattern) {
+            break;
+        }
+    }
+    while (i < len && static_cast<uint8_t>(p[i]) == filler) {
+        ++i;
+    }
+    return i;
+}
+
+#if defined(__x86_64__)
+
+/**
+ * 同SkipByWord，每次比较32个字节
+ */
+__attribute__((target("avx2")))
+size_t SkipAvx2(const char* p, size_t len, uint8_t filler) {
+    const __m256i pattern = _mm256_set1_epi8(static_cast<char>(filler));
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        uint32_t equal = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, pattern)));
+        if (equal != 0xFFFFFFFF) {
+            return i + __builtin_ctz(~equal);
+        }
+    }
+    return i + SkipByWord(p + i, len - i, filler);
+}
+
+#endif  // __x86_64__
+
+typedef size_t (*SkipFunc)(const char* p, size_t len, uint8_t filler);
+
+struct ScanDispatcher {
+    SkipFunc skip;
+    bool accelerated;
+    ScanDispatcher() : skip(SkipByWord), accelerated(false) {
+#if defined(__x86_64__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            skip = SkipAvx2;
+            accelerated = true;
+        }
+#endif
+    }
+};
+
+const ScanDispatcher& GetDispatcher() {
+    static const ScanDispatcher dispatcher;
+    return dispatcher;
+}
+
+}  // namespace
+
+bool IsBitmapScanAccelerated() {
+    return GetDispatcher().accelerated;
+}
+
 std::string BitRangeVecToString(const std::vector<BitRange> &ranges) {
     std::stringstream ss;
     for (uint32_t i = 0; i < ranges.size(); ++i) {
@@ -138,10 +224,7 @@ void Bitmap::Set(uint32_t index) {
 }
 
 void Bitmap::Set(uint32_t startIndex, uint32_t endIndex) {
-    // TODO(wuhanqing): implement fast algorithm if one byte is all set
-    for (uint32_t index = startIndex; index <= endIndex; ++index) {
-        Set(index);
-    }
+    fill(startIndex, endIndex, true);
 }
 
 void Bitmap::Clear() {
@@ -154,10 +237,7 @@ void Bitmap::Clear(uint32_t index) {
 }
 
 void Bitmap::Clear(uint32_t startIndex, uint32_t endIndex) {
-    // TODO(wuhanqing): implement fast algorithm if one byte is all clear
-    for (uint32_t index = startIndex; index <= endIndex; ++index) {
-        Clear(index);
-    }
+    fill(startIndex, endIndex, false);
 }
 
 bool Bitmap::Test(uint32_t index) const {
@@ -168,54 +248,19 @@ bool Bitmap::Test(uint32_t index) const {
 }
 
 uint32_t Bitmap::NextSetBit(uint32_t index) const {
-    for (; index < bits_; ++index) {
-        if (Test(index))
-            break;
-    }
-    if (index >= bits_)
-        index = NO_POS;
-    return index;
+    return findNext(index, bits_ - 1, true);
 }
 
 uint32_t Bitmap::NextSetBit(uint32_t startIndex, uint32_t endIndex) const {
-    uint32_t index = startIndex;
-    // bitmap中最后一个bit的index值
-    uint32_t lastIndex = bits_ - 1;
-    // endIndex值不能超过lastIndex
-    if (endIndex > lastIndex)
-        endIndex = lastIndex;
-    for (; index <= endIndex; ++index) {
-        if (Test(index))
-            break;
-    }
-    if (index > endIndex)
-        index = NO_POS;
-    return index;
+    return findNext(startIndex, endIndex, true);
 }
 
 uint32_t Bitmap::NextClearBit(uint32_t index) const {
-    for (; index < bits_; ++index) {
-        if (!Test(index))
-            break;
-    }
-    if (index >= bits_)
-        index = NO_POS;
-    return index;
+    return findNext(index, bits_ - 1, false);
 }
 
 uint32_t Bitmap::NextClearBit(uint32_t startIndex, uint32_t endIndex) const {
-    uint32_t index = startIndex;
-    uint32_t lastIndex = bits_ - 1;
-    // endIndex值不能超过lastIndex
-    if (endIndex > lastIndex)
-        endIndex = lastIndex;
-    for (; index <= endIndex; ++index) {
-        if (!Test(index))
-            break;
-    }
-    if (index > endIndex)
-        index = NO_POS;
-    return index;
+    return findNext(startIndex, endIndex, false);
 }
 
 void Bitmap::Divide(uint32_t startIndex,
@@ -226,47 +271,17 @@ void Bitmap::Divide(uint32_t startIndex,
     if (endIndex < startIndex)
         return;
 
-    // endIndex值不能超过lastIndex
-    uint32_t lastIndex = bits_ - 1;
-    if (endIndex > lastIndex)
-        endIndex = lastIndex;
-
-    BitRange clearRange;
-    BitRange setRange;
     vector<BitRange> tmpClearRanges;
     vector<BitRange> tmpSetRanges;
-    // 下一个位为0的index
-    uint32_t nextClearIndex;
-    // 下一个位为1的index
-    uint32_t nextSetIndex;
-
     // 划分所有range
-    while (startIndex != NO_POS) {
-        nextClearIndex = NextClearBit(startIndex, endIndex);
-        // 1.存放当前clear index之前的 set range
-        //   nextClearIndex如果等于startIndex说明前面没有 set range
-        if (nextClearIndex != startIndex) {
-            setRange.beginIndex = startIndex;
-            // nextClearIndex等于NO_POS说明已经找到末尾
-            // 最后一块连续区域是 set range
-            setRange.endIndex = nextClearIndex == NO_POS
-                              ? endIndex
-                              : nextClearIndex - 1;
-            tmpSetRanges.push_back(setRange);
-        }
-        if (nextClearIndex == NO_POS)
-            break;
-
-        nextSetIndex = NextSetBit(nextClearIndex, endIndex);
-        // 2.存放当前set index之前的 clear range
-        //   能到这一步说明前面肯定存在clear range，所以不用像第1步一样做判断
-        clearRange.beginIndex = nextClearIndex;
-        clearRange.endIndex = nextSetIndex == NO_POS
-                            ? endIndex
-                            : nextSetIndex - 1;
-        tmpClearRanges.push_back(clearRange);
-        startIndex = nextSetIndex;
-    }
+    ForEachRun(startIndex, endIndex,
+               [&](const BitRange& range, bool isSet) {
+                   if (isSet) {
+                       tmpSetRanges.push_back(range);
+                   } else {
+                       tmpClearRanges.push_back(range);
+                   }
+               });
 
     // 根据参数中的clearRanges和setRanges指针是否为空返回结果
     if (clearRanges != nullptr) {
@@ -277,6 +292,123 @@ void Bitmap::Divide(uint32_t startIndex,
     }
 }
 
+bool Bitmap::NextRun(uint32_t startIndex,
+                     uint32_t endIndex,
+                     BitRange* range) const {
+    if (bits_ == 0 || startIndex > endIndex || startIndex >= bits_) {
+        return false;
+    }
+    if (endIndex >= bits_) {
+        endIndex = bits_ - 1;
+    }
+    bool isSet = Test(startIndex);
+    // 连续区域在下一个状态不同的位之前结束
+    uint32_t nextIndex = findNext(startIndex, endIndex, !isSet);
+    range->beginIndex = startIndex;
+    range->endIndex = nextIndex == NO_POS ? endIndex : nextIndex - 1;
+    return isSet;
+}
+
+uint32_t Bitmap::Count(uint32_t startIndex, uint32_t endIndex) const {
+    if (bits_ == 0 || startIndex > endIndex || startIndex >= bits_) {
+        return 0;
+    }
+    if (endIndex >= bits_) {
+        endIndex = bits_ - 1;
+    }
+    uint32_t wordIndex = startIndex / kWordBits;
+    const uint32_t lastWord = endIndex / kWordBits;
+    uint64_t word = loadWord(wordIndex) & (~0ULL << (startIndex % kWordBits));
+    uint32_t count = 0;
+    while (wordIndex != lastWord) {
+        count += __builtin_popcountll(word);
+        word = loadWord(++wordIndex);
+    }
+    return count + __builtin_popcountll(word & TailMask(endIndex));
+}
+
+uint32_t Bitmap::Count() const {
+    return Count(0, bits_ - 1);
+}
+
+uint64_t Bitmap::loadWord(uint32_t wordIndex) const {
+    size_t offset = static_cast<size_t>(wordIndex) * kWordBytes;
+    size_t count = unitCount();
+    uint64_t word = 0;
+    memcpy(&word, bitmap_ + offset, std::min(kWordBytes, count - offset));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    // bit i is in byte i / 8, which must be the lowest byte of the word
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+uint32_t Bitmap::findNext(uint32_t startIndex,
+                          uint32_t endIndex,
+                          bool set) const {
+    if (bits_ == 0 || startIndex > endIndex || startIndex >= bits_) {
+        return NO_POS;
+    }
+    // endIndex值不能超过lastIndex
+    if (endIndex >= bits_) {
+        endIndex = bits_ - 1;
+    }
+
+    // 查找0时取反，统一为查找首个为1的位
+    const uint64_t flip = set ? 0 : ~0ULL;
+    uint32_t wordIndex = startIndex / kWordBits;
+    const uint32_t lastWord = endIndex / kWordBits;
+    uint64_t word = (loadWord(wordIndex) ^ flip) &
+                    (~0ULL << (startIndex % kWordBits));
+    while (word == 0 && wordIndex != lastWord) {
+        ++wordIndex;
+        // 跳过最后一个字之前全为0（或全为1）的字节
+        size_t skipped = GetDispatcher().skip(
+            bitmap_ + static_cast<size_t>(wordIndex) * kWordBytes,
+            static_cast<size_t>(lastWord - wordIndex) * kWordBytes,
+            set ? 0 : 0xff);
+        wordIndex += skipped / kWordBytes;
+        word = loadWord(wordIndex) ^ flip;
+    }
+    if (wordIndex == lastWord) {
+        word &= TailMask(endIndex);
+    }
+    if (word == 0) {
+        return NO_POS;
+    }
+    return wordIndex * kWordBits + __builtin_ctzll(word);
+}
+
+void Bitmap::fill(uint32_t startIndex, uint32_t endIndex, bool set) {
+    if (bits_ == 0 || startIndex > endIndex || startIndex >= bits_) {
+        return;
+    }
+    if (endIndex >= bits_) {
+        endIndex = bits_ - 1;
+    }
+    uint32_t index = startIndex;
+    // 处理首个字节中的位，然后整字节设置，最后处理末尾字节中的位
+    for (; index <= endIndex && index % BITMAP_UNIT_SIZE != 0; ++index) {
+        if (set) {
+            Set(index);
+        } else {
+            Clear(index);
+        }
+    }
+    if (index <= endIndex) {
+        uint32_t units = (endIndex - index + 1) >> ALIGN_FACTOR;
+        memset(bitmap_ + indexOfUnit(index), set ? 0xff : 0, units);
+        index += units << ALIGN_FACTOR;
+    }
+    for (; index <= endIndex; ++index) {
+        if (set) {
+            Set(index);
+        } else {
+            Clear(index);
+        }
+    }
+}
+
 uint32_t Bitmap::Size() const {
     return bits_;
 }
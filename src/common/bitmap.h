@@ -48,6 +48,11 @@ struct BitRange {
 
 std::string BitRangeVecToString(const std::vector<BitRange> &ranges);
 
+/**
+ * 当前CPU是否支持使用AVX2扫描bitmap，否则每次比较一个64位字
+ */
+bool IsBitmapScanAccelerated();
+
 class Bitmap {
  public:
     /**
@@ -170,6 +175,54 @@ class Bitmap {
                 uint32_t endIndex,
                 vector<BitRange>* clearRanges,
                 vector<BitRange>* setRanges) const;
+    /**
+     * 获取从指定位置开始的连续区域，区域内的位状态与起始位一致
+     * @param startIndex: 连续区域的起始位置
+     * @param endIndex: 连续区域的最大结束位置，包含此位置
+     * @param range: 存放找到的连续区域
+     * @return: 连续区域的位状态，true表示为1，false表示为0；
+     *          startIndex超出范围时返回false，range不变
+     */
+    bool NextRun(uint32_t startIndex,
+                 uint32_t endIndex,
+                 BitRange* range) const;
+    /**
+     * 按顺序遍历指定区域内的所有连续区域，不需要像Divide一样分配vector
+     * @param startIndex: 指定区域的起始索引
+     * @param endIndex: 指定区域的结束索引
+     * @param visitor: 对每个连续区域调用visitor(const BitRange&, bool isSet)
+     */
+    template <typename Visitor>
+    void ForEachRun(uint32_t startIndex,
+                    uint32_t endIndex,
+                    Visitor&& visitor) const {
+        if (bits_ == 0 || startIndex > endIndex || startIndex >= bits_) {
+            return;
+        }
+        if (endIndex >= bits_) {
+            endIndex = bits_ - 1;
+        }
+        BitRange range;
+        while (true) {
+            bool isSet = NextRun(startIndex, endIndex, &range);
+            visitor(range, isSet);
+            if (range.endIndex == endIndex) {
+                break;
+            }
+            startIndex = range.endIndex + 1;
+        }
+    }
+    /**
+     * 统计指定区域内位为1的个数
+     * @param startIndex: 起始位置，包含此位置
+     * @param endIndex: 结束位置，包含此位置
+     * @return: 位为1的个数
+     */
+    uint32_t Count(uint32_t startIndex, uint32_t endIndex) const;
+    /**
+     * 统计bitmap中位为1的个数
+     */
+    uint32_t Count() const;
     /**
      * bitmap的有效位数
      * @return: 返回位数
@@ -198,6 +251,14 @@ class Bitmap {
         char mask = 0x01 << indexInUnit;
         return mask;
     }
+    // 读取第wordIndex个64位字，超出bitmap的字节补0
+    uint64_t loadWord(uint32_t wordIndex) const;
+    // 查找指定区域内首个状态为set的位
+    uint32_t findNext(uint32_t startIndex,
+                      uint32_t endIndex,
+                      bool set) const;
+    // 将指定区域的位都置为set
+    void fill(uint32_t startIndex, uint32_t endIndex, bool set);
 
  public:
     // 表示不存在的位置，值为0xffffffff
@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <cstdio>
+#include <chrono>               //NOLINT
 #include <condition_variable>   //NOLINT
 #include <deque>
 #include <mutex>                //NOLINT
@@ -131,6 +132,39 @@ class BoundedBlockingDeque : public Uncopyable {
         return back;
     }
 
+    /**
+     * 队首元素满足pred的时候取出，队列为空的时候最多等到deadline
+     * @param pred: 判断队首元素是否可以取出
+     * @param deadline: 队列为空时等待的截止时间
+     * @param[out] out: 取出的元素
+     * @return 取出返回true，否则返回false
+     */
+    template<typename Pred>
+    bool TakeFrontIf(Pred pred,
+                     const std::chrono::steady_clock::time_point& deadline,
+                     T *out) {
+        std::unique_lock<std::mutex> guard(mutex_);
+        bool waited = false;
+        while (deque_.empty()) {
+            if (notEmpty_.wait_until(guard, deadline) ==
+                std::cv_status::timeout && deque_.empty()) {
+                return false;
+            }
+            waited = true;
+        }
+        if (!pred(deque_.front())) {
+            // the notification may be meant for another taker
+            if (waited) {
+                notEmpty_.notify_one();
+            }
+            return false;
+        }
+        *out = std::move(deque_.front());
+        deque_.pop_front();
+        notFull_.notify_one();
+        return true;
+    }
+
     bool Empty() const {
         std::lock_guard<std::mutex> guard(mutex_);
         return deque_.empty();
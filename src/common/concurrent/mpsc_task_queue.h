@@ -0,0 +1,253 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_COMMON_CONCURRENT_MPSC_TASK_QUEUE_H_
+#define SRC_COMMON_CONCURRENT_MPSC_TASK_QUEUE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <utility>
+
+#include "include/curve_compiler_specific.h"
+
+namespace curve {
+namespace common {
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __asm__ __volatile__("pause" ::: "memory");
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#endif
+}
+
+/**
+ * Bounded lock-free task queue for multiple producers and a single consumer.
+ *
+ * Tasks are kept in a ring of slots, each with a sequence number telling
+ * whether it's free for the producer of a position or filled for the
+ * consumer, so producers only contend on one CAS of the tail and the
+ * consumer never takes a lock while tasks keep coming. Both sides spin for
+ * a while when the queue is full or empty, and only then park on a
+ * condition variable, which is notified only if someone is parked.
+ *
+ * The interface is the same as GenericTaskQueue, Pop() and TryPop() must
+ * only be called from one thread. The capacity is rounded up to a power of
+ * two.
+ */
+template <typename MutexT, typename CondVarT>
+class GenericMpscTaskQueue {
+ public:
+    using Task = std::function<void()>;
+
+    static const uint32_t kDefaultSpinCount = 1024;
+
+    explicit GenericMpscTaskQueue(size_t capacity,
+                                  uint32_t spinCount = kDefaultSpinCount)
+        : mask_(RoundUpPowerOfTwo(capacity) - 1),
+          slots_(new Slot[mask_ + 1]),
+          // spinning only wastes the cpu of the other side on one core
+          spinCount_(std::thread::hardware_concurrency() > 1 ? spinCount : 0),
+          tail_(0),
+          head_(0),
+          consumerParked_(false),
+          parkedProducers_(0) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template <class F, class... Args>
+    void Push(F&& f, Args&&... args) {
+        Task task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+        uint32_t spins = 0;
+        while (!TryPush(&task)) {
+            if (spins < spinCount_) {
+                ++spins;
+                CpuRelax();
+                continue;
+            }
+            std::unique_lock<MutexT> lk(mtx_);
+            parkedProducers_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool pushed = TryPush(&task);
+            if (!pushed) {
+                notfullcv_.wait(lk);
+            }
+            parkedProducers_.fetch_sub(1, std::memory_order_relaxed);
+            if (pushed) {
+                break;
+            }
+        }
+
+        // pairs with the fence in Pop(), either the consumer sees the task
+        // before parking or we see it parked
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (consumerParked_.load(std::memory_order_relaxed)) {
+            std::lock_guard<MutexT> lk(mtx_);
+            notemptycv_.notify_one();
+        }
+    }
+
+    Task Pop() {
+        Task task;
+        uint32_t spins = 0;
+        while (!TryPopSlot(&task)) {
+            if (spins < spinCount_) {
+                ++spins;
+                CpuRelax();
+                continue;
+            }
+            std::unique_lock<MutexT> lk(mtx_);
+            consumerParked_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool popped = TryPopSlot(&task);
+            if (!popped) {
+                notemptycv_.wait(lk);
+            }
+            consumerParked_.store(false, std::memory_order_relaxed);
+            if (popped) {
+                break;
+            }
+            spins = 0;
+        }
+
+        NotifyProducer();
+        return task;
+    }
+
+    // pop a task without waiting, return false if the queue is empty
+    bool TryPop(Task* task) {
+        if (!TryPopSlot(task)) {
+            return false;
+        }
+        NotifyProducer();
+        return true;
+    }
+
+    size_t Size() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t Capacity() const {
+        return mask_ + 1;
+    }
+
+ private:
+    struct Slot {
+        std::atomic<size_t> seq;
+        Task task;
+    };
+
+    static size_t RoundUpPowerOfTwo(size_t n) {
+        size_t size = 2;
+        while (size < n) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    bool TryPush(Task* task) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots_[pos & mask_];
+            size_t seq = slot->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) -
+                            static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the consumer hasn't taken the task of last round
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->task = std::move(*task);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // pairs with the fence in Push(), either a parked producer sees the
+    // free slot or we see it parked
+    void NotifyProducer() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parkedProducers_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<MutexT> lk(mtx_);
+            notfullcv_.notify_one();
+        }
+    }
+
+    bool TryPopSlot(Task* task) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        Slot* slot = &slots_[pos & mask_];
+        size_t seq = slot->seq.load(std::memory_order_acquire);
+        if (seq != pos + 1) {
+            return false;
+        }
+        *task = std::move(slot->task);
+        slot->task = nullptr;
+        slot->seq.store(pos + mask_ + 1, std::memory_order_release);
+        head_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+ private:
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    const uint32_t spinCount_;
+    // padded instead of aligned, the queue is allocated by operator new
+    // which doesn't honor extended alignment before c++17
+    char pad0_[CURVE_CACHELINE_SIZE];
+    std::atomic<size_t> tail_;
+    char pad1_[CURVE_CACHELINE_SIZE];
+    std::atomic<size_t> head_;
+    char pad2_[CURVE_CACHELINE_SIZE];
+    std::atomic<bool> consumerParked_;
+    std::atomic<uint32_t> parkedProducers_;
+    MutexT mtx_;
+    CondVarT notemptycv_;
+    CondVarT notfullcv_;
+};
+
+template <typename MutexT, typename CondVarT>
+const uint32_t GenericMpscTaskQueue<MutexT, CondVarT>::kDefaultSpinCount;
+
+using MpscTaskQueue =
+    GenericMpscTaskQueue<std::mutex, std::condition_variable>;
+
+}   // namespace common
+}   // namespace curve
+
+#endif  // SRC_COMMON_CONCURRENT_MPSC_TASK_QUEUE_H_
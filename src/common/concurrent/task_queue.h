@@ -57,6 +57,18 @@ class GenericTaskQueue {
         return t;
     }
 
+    // pop a task without waiting, return false if the queue is empty
+    bool TryPop(Task* task) {
+        std::unique_lock<MutexT> lk(mtx_);
+        if (tasks_.empty()) {
+            return false;
+        }
+        *task = std::move(tasks_.front());
+        tasks_.pop();
+        notfullcv_.notify_one();
+        return true;
+    }
+
     size_t Size() {
         std::unique_lock<MutexT> lk(mtx_);
         return tasks_.size();
@@ -0,0 +1,259 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_COMMON_CONCURRENT_WORK_STEALING_TASK_QUEUE_H_
+#define SRC_COMMON_CONCURRENT_WORK_STEALING_TASK_QUEUE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+namespace curve {
+namespace common {
+
+/**
+ * Task queues of a group of workers, in which idle workers steal tasks from
+ * the others.
+ *
+ * Every worker has its own queues, a task is pushed to the queue of the
+ * worker chosen by the caller, and the worker takes tasks from its own
+ * queues first. A worker with nothing to do steals the oldest stealable task
+ * of the other workers before parking, so tasks hashed to a busy worker
+ * don't wait while the others are idle. Tasks pushed as not stealable are
+ * only run by their own worker, in the order they are pushed.
+ *
+ * Tasks are pushed by other threads rather than the workers, so each queue
+ * is protected by its own lock instead of being an owner-only deque. The
+ * capacity is the total number of tasks of all workers, Push() blocks when
+ * it's reached.
+ *
+ * The task counters are atomics, the locks of the queue are only taken to
+ * park or unpark a worker, or a pusher waiting for capacity. Both sides
+ * publish their state before checking the other's (the counters against the
+ * parked flags), all sequentially consistent, so at least one of them sees
+ * the other and no wakeup is lost.
+ */
+template <typename MutexT, typename CondVarT>
+class GenericWorkStealingTaskQueue {
+ public:
+    using Task = std::function<void()>;
+
+    GenericWorkStealingTaskQueue(size_t workerNum, size_t capacity)
+        : capacity_(capacity),
+          size_(0),
+          fullWaiters_(0),
+          stealableNum_(0),
+          parkedNum_(0),
+          stealNum_(0) {
+        for (size_t i = 0; i < workerNum; ++i) {
+            workers_.emplace_back(new Worker());
+        }
+    }
+
+    /**
+     * Push: push a task to the queue of a worker
+     * @param index: index of the worker
+     * @param stealable: whether the task can be run by other workers
+     */
+    template <class F, class... Args>
+    void Push(size_t index, bool stealable, F&& f, Args&&... args) {
+        Task task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+        if (!TryReserve()) {
+            std::unique_lock<MutexT> lk(mtx_);
+            ++fullWaiters_;
+            while (!TryReserve()) {
+                notfullcv_.wait(lk);
+            }
+            --fullWaiters_;
+        }
+
+        Worker* worker = workers_[index].get();
+        {
+            std::lock_guard<MutexT> lk(worker->mtx);
+            if (stealable) {
+                worker->stealable.push_back(std::move(task));
+            } else {
+                worker->pinned.push_back(std::move(task));
+            }
+        }
+
+        // the counters are updated after the task is visible, so a worker
+        // which doesn't see the task either sees it counted or is unparked
+        if (stealable) {
+            ++stealableNum_;
+        } else {
+            ++worker->pinnedNum;
+        }
+        if (worker->parked.load() && Unpark(worker)) {
+            return;
+        }
+        if (stealable && parkedNum_.load() > 0) {
+            for (auto& other : workers_) {
+                if (other->parked.load() && Unpark(other.get())) {
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * Pop: take a task for a worker, wait if there is none
+     * @param index: index of the worker
+     */
+    Task Pop(size_t index) {
+        Worker* worker = workers_[index].get();
+        Task task;
+        while (true) {
+            // stolen tasks are always stealable ones
+            bool stealable = true;
+            if (TakeOwn(worker, &task, &stealable) ||
+                Steal(index, &task)) {
+                if (stealable) {
+                    --stealableNum_;
+                } else {
+                    --worker->pinnedNum;
+                }
+                --size_;
+                if (fullWaiters_.load() > 0) {
+                    std::lock_guard<MutexT> lk(mtx_);
+                    notfullcv_.notify_one();
+                }
+                return task;
+            }
+
+            std::unique_lock<MutexT> lk(worker->mtx);
+            worker->parked.store(true);
+            ++parkedNum_;
+            // recheck after parked is visible, a task pushed before that
+            // is counted here, one pushed after that unparks the worker
+            if (stealableNum_.load() > 0 || worker->pinnedNum.load() > 0) {
+                worker->parked.store(false);
+                --parkedNum_;
+                continue;
+            }
+            while (worker->parked.load()) {
+                worker->cv.wait(lk);
+            }
+        }
+    }
+
+    size_t Size() {
+        return size_.load();
+    }
+
+    // number of tasks run by workers other than the one pushed to
+    uint64_t StealNum() const {
+        return stealNum_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    struct Worker {
+        // protects the queues and parking of the worker
+        MutexT mtx;
+        std::deque<Task> pinned;
+        std::deque<Task> stealable;
+        std::atomic<int64_t> pinnedNum{0};
+        std::atomic<bool> parked{false};
+        CondVarT cv;
+    };
+
+    // reserve room for a task, false if the queue is full
+    bool TryReserve() {
+        size_t size = size_.load();
+        while (size < capacity_) {
+            if (size_.compare_exchange_weak(size, size + 1)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // return false if the worker has been unparked by others
+    bool Unpark(Worker* worker) {
+        std::lock_guard<MutexT> lk(worker->mtx);
+        if (!worker->parked.load()) {
+            return false;
+        }
+        worker->parked.store(false);
+        --parkedNum_;
+        worker->cv.notify_one();
+        return true;
+    }
+
+    bool TakeOwn(Worker* worker, Task* task, bool* stealable) {
+        std::lock_guard<MutexT> lk(worker->mtx);
+        if (!worker->pinned.empty()) {
+            *task = std::move(worker->pinned.front());
+            worker->pinned.pop_front();
+            *stealable = false;
+            return true;
+        }
+        if (!worker->stealable.empty()) {
+            *task = std::move(worker->stealable.front());
+            worker->stealable.pop_front();
+            *stealable = true;
+            return true;
+        }
+        return false;
+    }
+
+    bool Steal(size_t index, Task* task) {
+        for (size_t i = 1; i < workers_.size(); ++i) {
+            Worker* victim = workers_[(index + i) % workers_.size()].get();
+            std::lock_guard<MutexT> lk(victim->mtx);
+            if (!victim->stealable.empty()) {
+                *task = std::move(victim->stealable.front());
+                victim->stealable.pop_front();
+                stealNum_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+ private:
+    std::vector<std::unique_ptr<Worker>> workers_;
+    const size_t capacity_;
+    std::atomic<size_t> size_;
+    // only for pushers waiting for capacity
+    MutexT mtx_;
+    CondVarT notfullcv_;
+    std::atomic<size_t> fullWaiters_;
+    std::atomic<int64_t> stealableNum_;
+    std::atomic<size_t> parkedNum_;
+    std::atomic<uint64_t> stealNum_;
+};
+
+using WorkStealingTaskQueue =
+    GenericWorkStealingTaskQueue<std::mutex, std::condition_variable>;
+
+}   // namespace common
+}   // namespace curve
+
+#endif  // SRC_COMMON_CONCURRENT_WORK_STEALING_TASK_QUEUE_H_
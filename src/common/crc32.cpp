@@ -0,0 +1,226 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+#endif
+
+#include "src/common/crc32.h"
+
+namespace curve {
+namespace common {
+
+namespace {
+
+// CRC32C(Castagnoli) polynomial in reversed bit order
+const uint32_t kCrc32cPoly = 0x82f63b78;
+
+// bytes handled by each of the three interleaved streams
+const size_t kLongStride = 1024;
+const size_t kShortStride = 128;
+
+/**
+ * Multiply a and b modulo the CRC polynomial, both in reversed bit order,
+ * where the most significant bit is the coefficient of x^0
+ */
+uint32_t MultModP(uint32_t a, uint32_t b) {
+    uint32_t m = 1u << 31;
+    uint32_t p = 0;
+    while (true) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) {
+                break;
+            }
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ kCrc32cPoly : b >> 1;
+    }
+    return p;
+}
+
+/**
+ * x^n modulo the CRC polynomial in reversed bit order
+ */
+uint32_t XPowNModP(uint64_t n) {
+    uint32_t p = 1u << 31;      // x^0
+    uint32_t square = 1u << 30;  // x^1, x^2, x^4 ...
+    while (n > 0) {
+        if (n & 1) {
+            p = MultModP(square, p);
+        }
+        n >>= 1;
+        square = MultModP(square, square);
+    }
+    return p;
+}
+
+/**
+ * Constants to move a crc register over n zero bytes. The software path
+ * multiplies by x^(8n), the PCLMUL path multiplies by x^(8n-33) since the
+ * carry-less multiply of reversed operands and the following crc32
+ * instruction contribute another x^33
+ */
+struct ShiftConstants {
+    uint32_t softLong;
+    uint32_t softShort;
+    uint64_t clmulLong;
+    uint64_t clmulShort;
+    ShiftConstants() {
+        softLong = XPowNModP(8 * kLongStride);
+        softShort = XPowNModP(8 * kShortStride);
+        clmulLong = XPowNModP(8 * kLongStride - 33);
+        clmulShort = XPowNModP(8 * kShortStride - 33);
+    }
+};
+
+const ShiftConstants& GetShiftConstants() {
+    static const ShiftConstants constants;
+    return constants;
+}
+
+#if defined(__x86_64__)
+
+inline uint64_t Load64(const char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+__attribute__((target("sse4.2")))
+uint32_t Crc32cSerial(uint32_t crc, const char* p, size_t len) {
+    while (len > 0 && (reinterpret_cast<uintptr_t>(p) & 7) != 0) {
+        crc = _mm_crc32_u8(crc, *p++);
+        --len;
+    }
+    uint64_t c = crc;
+    while (len >= 8) {
+        c = _mm_crc32_u64(c, Load64(p));
+        p += 8;
+        len -= 8;
+    }
+    crc = static_cast<uint32_t>(c);
+    while (len > 0) {
+        crc = _mm_crc32_u8(crc, *p++);
+        --len;
+    }
+    return crc;
+}
+
+__attribute__((target("sse4.2,pclmul")))
+uint32_t ShiftClmul(uint32_t crc, uint64_t k) {
+    __m128i product = _mm_clmulepi64_si128(
+        _mm_cvtsi32_si128(crc), _mm_cvtsi64_si128(k), 0);
+    return static_cast<uint32_t>(
+        _mm_crc32_u64(0, _mm_cvtsi128_si64(product)));
+}
+
+/**
+ * Run three independent crc32 instruction streams over consecutive strides
+ * to hide the 3-cycle latency of the instruction, then merge them by
+ * shifting the former streams over the bytes behind them.
+ */
+template <bool kUseClmul>
+__attribute__((target("sse4.2")))
+uint32_t Crc32c3Way(uint32_t crc, const char* p, size_t len) {
+    const ShiftConstants& k = GetShiftConstants();
+    const size_t strides[] = {kLongStride, kShortStride};
+    const uint32_t softShifts[] = {k.softLong, k.softShort};
+    const uint64_t clmulShifts[] = {k.clmulLong, k.clmulShort};
+
+    for (int level = 0; level < 2; ++level) {
+        const size_t stride = strides[level];
+        while (len >= 3 * stride) {
+            uint64_t c0 = crc;
+            uint64_t c1 = 0;
+            uint64_t c2 = 0;
+            for (size_t i = 0; i < stride; i += 8) {
+                c0 = _mm_crc32_u64(c0, Load64(p + i));
+                c1 = _mm_crc32_u64(c1, Load64(p + stride + i));
+                c2 = _mm_crc32_u64(c2, Load64(p + 2 * stride + i));
+            }
+            uint32_t r0 = static_cast<uint32_t>(c0);
+            uint32_t r1 = static_cast<uint32_t>(c1);
+            if (kUseClmul) {
+                // shift(c0, 2 * stride) == shift(shift(c0, stride), stride)
+                r0 = ShiftClmul(r0, clmulShifts[level]) ^ r1;
+                crc = ShiftClmul(r0, clmulShifts[level]) ^
+                      static_cast<uint32_t>(c2);
+            } else {
+                r0 = MultModP(softShifts[level], r0) ^ r1;
+                crc = MultModP(softShifts[level], r0) ^
+                      static_cast<uint32_t>(c2);
+            }
+            p += 3 * stride;
+            len -= 3 * stride;
+        }
+    }
+    return Crc32cSerial(crc, p, len);
+}
+
+#endif  // __x86_64__
+
+uint32_t Crc32cFallback(uint32_t crc, const char* p, size_t len) {
+    // butil works on the finalized crc, invert to match the raw register
+    return ~butil::crc32c::Extend(~crc, p, len);
+}
+
+typedef uint32_t (*Crc32cFunc)(uint32_t crc, const char* p, size_t len);
+
+struct Crc32cDispatcher {
+    Crc32cFunc func;
+    bool accelerated;
+    Crc32cDispatcher() : func(Crc32cFallback), accelerated(false) {
+#if defined(__x86_64__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.2")) {
+            if (__builtin_cpu_supports("pclmul")) {
+                func = Crc32c3Way<true>;
+                accelerated = true;
+            } else {
+                func = Crc32c3Way<false>;
+            }
+        }
+#endif
+    }
+};
+
+const Crc32cDispatcher& GetDispatcher() {
+    static const Crc32cDispatcher dispatcher;
+    return dispatcher;
+}
+
+}  // namespace
+
+uint32_t CRC32CExtend(uint32_t crc, const char *pData, size_t iLen) {
+    return ~GetDispatcher().func(~crc, pData, iLen);
+}
+
+bool IsCRC32CAccelerated() {
+    return GetDispatcher().accelerated;
+}
+
+}  // namespace common
+}  // namespace curve
@@ -32,17 +32,33 @@ namespace curve {
 namespace common {
 
 /**
- * 计算数据的CRC32校验码(CRC32C)，基于brpc的crc32库进行封装
+ * 计算数据的CRC32C校验码，支持继承式计算
+ * 支持SSE4.2时使用crc32指令三路交织计算，并通过PCLMUL合并各路结果，
+ * 否则退化为brpc的crc32c实现，计算结果与butil::crc32c::Extend完全一致
+ * @param crc 起始的crc校验码
+ * @param pData 待计算的数据
+ * @param iLen 待计算的数据长度
+ * @return 32位的数据CRC32校验码
+ */
+uint32_t CRC32CExtend(uint32_t crc, const char *pData, size_t iLen);
+
+/**
+ * 当前CPU是否支持crc32指令及PCLMUL加速
+ */
+bool IsCRC32CAccelerated();
+
+/**
+ * 计算数据的CRC32校验码(CRC32C)
  * @param pData 待计算的数据
  * @param iLen 待计算的数据长度
  * @return 32位的数据CRC32校验码
  */
 inline uint32_t CRC32(const char *pData, size_t iLen) {
-    return butil::crc32c::Value(pData, iLen);
+    return CRC32CExtend(0, pData, iLen);
 }
 
 /**
- * 计算数据的CRC32校验码(CRC32C)，基于brpc的crc32库进行封装. 此函数支持继承式
+ * 计算数据的CRC32校验码(CRC32C). 此函数支持继承式
  * 计算，以支持对SGL类型的数据计算单个CRC校验码。满足如下约束:
  * CRC32("hello world", 11) == CRC32(CRC32("hello ", 6), "world", 5)
  * @param crc 起始的crc校验码
@@ -51,7 +67,7 @@ inline uint32_t CRC32(const char *pData, size_t iLen) {
  * @return 32位的数据CRC32校验码
  */
 inline uint32_t CRC32(uint32_t crc, const char *pData, size_t iLen) {
-    return butil::crc32c::Extend(crc, pData, iLen);
+    return CRC32CExtend(crc, pData, iLen);
 }
 
 }  // namespace common
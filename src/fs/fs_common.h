@@ -31,6 +31,13 @@ enum class FileSystemType {
     EXT4,
 };
 
+enum class IOEngineType {
+    // blocking pread/pwrite
+    PSYNC,
+    // io_uring with registered buffers and fixed files
+    IO_URING,
+};
+
 struct FileSystemInfo {
     uint64_t total = 0;         // Total bytes
     uint64_t available = 0;     // Free bytes available for unprivileged users
@@ -0,0 +1,272 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "src/fs/io_uring.h"
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+namespace curve {
+namespace fs {
+
+namespace {
+
+int SysIoUringSetup(uint32_t entries, struct io_uring_params* p) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int SysIoUringEnter(int fd, uint32_t toSubmit, uint32_t minComplete,
+                    uint32_t flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit,
+                                      minComplete, flags, nullptr, 0));
+}
+
+int SysIoUringRegister(int fd, uint32_t opcode, const void* arg,
+                       uint32_t nrArgs) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode,
+                                      arg, nrArgs));
+}
+
+inline uint32_t LoadAcquire(const uint32_t* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+inline void StoreRelease(uint32_t* p, uint32_t v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+}  // namespace
+
+IoUring::IoUring()
+    : ringFd_(-1),
+      sqEntries_(0),
+      sqRing_(MAP_FAILED),
+      sqRingSize_(0),
+      sqHead_(nullptr),
+      sqTail_(nullptr),
+      sqRingMask_(nullptr),
+      sqArray_(nullptr),
+      sqes_(nullptr),
+      sqesSize_(0),
+      sqeTail_(0),
+      cqRing_(MAP_FAILED),
+      cqRingSize_(0),
+      cqHead_(nullptr),
+      cqTail_(nullptr),
+      cqRingMask_(nullptr),
+      cqes_(nullptr) {}
+
+IoUring::~IoUring() {
+    Exit();
+}
+
+int IoUring::Init(uint32_t entries) {
+    if (ringFd_ >= 0) {
+        return 0;
+    }
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = SysIoUringSetup(entries, &params);
+    if (fd < 0) {
+        return -errno;
+    }
+    ringFd_ = fd;
+    sqEntries_ = params.sq_entries;
+
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cqRingSize_ = params.cq_off.cqes +
+                  params.cq_entries * sizeof(struct io_uring_cqe);
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+        if (cqRingSize_ > sqRingSize_) {
+            sqRingSize_ = cqRingSize_;
+        }
+        cqRingSize_ = sqRingSize_;
+    }
+
+    sqRing_ = ::mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQ_RING);
+    if (sqRing_ == MAP_FAILED) {
+        int err = errno;
+        Exit();
+        return -err;
+    }
+
+    if (singleMmap) {
+        cqRing_ = sqRing_;
+    } else {
+        cqRing_ = ::mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ringFd_,
+                         IORING_OFF_CQ_RING);
+        if (cqRing_ == MAP_FAILED) {
+            int err = errno;
+            Exit();
+            return -err;
+        }
+    }
+
+    sqesSize_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = ::mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ringFd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        int err = errno;
+        Exit();
+        return -err;
+    }
+    sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+    char* sq = static_cast<char*>(sqRing_);
+    sqHead_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    sqTail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    sqRingMask_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    sqArray_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+
+    char* cq = static_cast<char*>(cqRing_);
+    cqHead_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    cqTail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    cqRingMask_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    // sqes are always consumed in order, so the index array is an identity
+    for (uint32_t i = 0; i < sqEntries_; ++i) {
+        sqArray_[i] = i;
+    }
+    sqeTail_ = *sqTail_;
+    return 0;
+}
+
+void IoUring::Exit() {
+    if (sqes_ != nullptr) {
+        ::munmap(sqes_, sqesSize_);
+        sqes_ = nullptr;
+    }
+    if (cqRing_ != MAP_FAILED && cqRing_ != sqRing_) {
+        ::munmap(cqRing_, cqRingSize_);
+    }
+    cqRing_ = MAP_FAILED;
+    if (sqRing_ != MAP_FAILED) {
+        ::munmap(sqRing_, sqRingSize_);
+        sqRing_ = MAP_FAILED;
+    }
+    if (ringFd_ >= 0) {
+        ::close(ringFd_);
+        ringFd_ = -1;
+    }
+    sqEntries_ = 0;
+}
+
+int IoUring::RegisterFiles(const int* fds, uint32_t num) {
+    int ret = SysIoUringRegister(ringFd_, IORING_REGISTER_FILES, fds, num);
+    return ret < 0 ? -errno : 0;
+}
+
+int IoUring::UpdateFiles(uint32_t offset, const int* fds, uint32_t num) {
+    struct io_uring_files_update update;
+    memset(&update, 0, sizeof(update));
+    update.offset = offset;
+    update.fds = reinterpret_cast<uint64_t>(fds);
+    int ret = SysIoUringRegister(ringFd_, IORING_REGISTER_FILES_UPDATE,
+                                 &update, num);
+    return ret < 0 ? -errno : 0;
+}
+
+struct io_uring_sqe* IoUring::GetSqe() {
+    uint32_t head = LoadAcquire(sqHead_);
+    if (sqeTail_ - head >= sqEntries_) {
+        return nullptr;
+    }
+    struct io_uring_sqe* sqe = &sqes_[sqeTail_ & *sqRingMask_];
+    ++sqeTail_;
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+int IoUring::Submit(uint32_t waitNr, uint32_t* submitted) {
+    *submitted = 0;
+    StoreRelease(sqTail_, sqeTail_);
+    uint32_t flags = waitNr > 0 ? IORING_ENTER_GETEVENTS : 0;
+    int err = 0;
+    // the kernel takes sqes from the head in order and doesn't wait for
+    // completions if it takes fewer sqes than asked
+    while (true) {
+        uint32_t toSubmit = sqeTail_ - LoadAcquire(sqHead_);
+        if (toSubmit == 0) {
+            break;
+        }
+        int ret = SysIoUringEnter(ringFd_, toSubmit, waitNr, flags);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            err = -errno;
+            break;
+        }
+        if (ret == 0) {
+            err = -EAGAIN;
+            break;
+        }
+        *submitted += ret;
+    }
+    if (err != 0) {
+        // without SQPOLL the kernel reads the tail only in io_uring_enter,
+        // so the sqes it hasn't taken can be withdrawn
+        sqeTail_ = LoadAcquire(sqHead_);
+        StoreRelease(sqTail_, sqeTail_);
+    }
+    return err;
+}
+
+int IoUring::WaitCqe(struct io_uring_cqe** cqe) {
+    while (true) {
+        uint32_t head = *cqHead_;
+        if (head != LoadAcquire(cqTail_)) {
+            *cqe = &cqes_[head & *cqRingMask_];
+            return 0;
+        }
+        int ret = SysIoUringEnter(ringFd_, 0, 1, IORING_ENTER_GETEVENTS);
+        if (ret < 0 && errno != EINTR && errno != EAGAIN &&
+            errno != EBUSY) {
+            return -errno;
+        }
+    }
+}
+
+void IoUring::CqeSeen() {
+    StoreRelease(cqHead_, *cqHead_ + 1);
+}
+
+}  // namespace fs
+}  // namespace curve
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_FS_IO_URING_H_
+#define SRC_FS_IO_URING_H_
+
+#include <linux/io_uring.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace curve {
+namespace fs {
+
+/**
+ * A minimal io_uring ring built directly on the kernel syscalls,
+ * so the chunkserver does not depend on liburing.
+ * The ring is NOT thread safe, callers must serialize access.
+ */
+class IoUring {
+ public:
+    IoUring();
+    ~IoUring();
+
+    /**
+     * Setup the ring and map the submission/completion queues
+     * @param entries: queue depth of the submission queue
+     * @return success return 0, otherwise return -errno
+     */
+    int Init(uint32_t entries);
+
+    /**
+     * Unmap the queues and close the ring fd
+     */
+    void Exit();
+
+    bool Inited() const {
+        return ringFd_ >= 0;
+    }
+
+    uint32_t SqEntries() const {
+        return sqEntries_;
+    }
+
+    /**
+     * Register the fixed file table, -1 means an empty slot
+     * @return success return 0, otherwise return -errno
+     */
+    int RegisterFiles(const int* fds, uint32_t num);
+
+    /**
+     * Replace fixed file table slots [offset, offset + num)
+     * @return success return 0, otherwise return -errno
+     */
+    int UpdateFiles(uint32_t offset, const int* fds, uint32_t num);
+
+    /**
+     * Get a zeroed submission queue entry
+     * @return nullptr if the submission queue is full
+     */
+    struct io_uring_sqe* GetSqe();
+
+    /**
+     * Submit all prepared sqes to the kernel, retrying until the kernel
+     * takes them all. On failure the sqes not taken yet are dropped, so
+     * they never reach the kernel
+     * @param waitNr: wait until at least waitNr completions are available,
+     *                must not exceed the completions still to be reaped
+     * @param submitted: number of sqes taken by the kernel, their
+     *                   completions must be reaped even on failure
+     * @return success return 0, otherwise return -errno
+     */
+    int Submit(uint32_t waitNr, uint32_t* submitted);
+
+    /**
+     * Wait for one completion, the cqe must be released by CqeSeen()
+     * @return success return 0, otherwise return -errno
+     */
+    int WaitCqe(struct io_uring_cqe** cqe);
+
+    /**
+     * Mark the head completion as consumed
+     */
+    void CqeSeen();
+
+ private:
+    int ringFd_;
+    uint32_t sqEntries_;
+
+    // submission queue
+    void* sqRing_;
+    size_t sqRingSize_;
+    uint32_t* sqHead_;
+    uint32_t* sqTail_;
+    uint32_t* sqRingMask_;
+    uint32_t* sqArray_;
+    struct io_uring_sqe* sqes_;
+    size_t sqesSize_;
+    // local tail, published to the kernel in Submit()
+    uint32_t sqeTail_;
+
+    // completion queue
+    void* cqRing_;
+    size_t cqRingSize_;
+    uint32_t* cqHead_;
+    uint32_t* cqTail_;
+    uint32_t* cqRingMask_;
+    struct io_uring_cqe* cqes_;
+};
+
+}  // namespace fs
+}  // namespace curve
+
+#endif  // SRC_FS_IO_URING_H_
@@ -0,0 +1,735 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <glog/logging.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "src/fs/io_uring_filesystem_impl.h"
+
+namespace curve {
+namespace fs {
+
+namespace {
+
+const int kMaxRetryTimes = 3;
+const uint32_t kNoThreadSeq = UINT32_MAX;
+
+std::atomic<uint32_t> gThreadSeq(0);
+thread_local uint32_t tlsThreadSeq = kNoThreadSeq;
+
+bool IsRetryable(int result) {
+    return result == -EINTR || result == -EAGAIN;
+}
+
+bool IsSync(const IORequest& request) {
+    return request.type == IORequestType::FDATASYNC ||
+           request.type == IORequestType::FSYNC;
+}
+
+// skip the first `skip' bytes of the given iovecs
+void AdvanceIovec(const struct iovec* iov, int iovcnt, size_t skip,
+                  std::vector<struct iovec>* out) {
+    out->clear();
+    for (int i = 0; i < iovcnt; ++i) {
+        if (skip >= iov[i].iov_len) {
+            skip -= iov[i].iov_len;
+            continue;
+        }
+        struct iovec v;
+        v.iov_base = static_cast<char*>(iov[i].iov_base) + skip;
+        v.iov_len = iov[i].iov_len - skip;
+        out->push_back(v);
+        skip = 0;
+    }
+}
+
+// split data into write requests of at most IOV_MAX iovecs,
+// the iovecs are appended to iovecs which must not be reallocated
+// before the requests are submitted
+void BuildWriteRequests(int fd, const butil::IOBuf& data, uint64_t offset,
+                        std::vector<struct iovec>* iovecs,
+                        std::vector<IORequest>* requests) {
+    size_t first = iovecs->size();
+    size_t blockNum = data.backing_block_num();
+    for (size_t i = 0; i < blockNum; ++i) {
+        butil::StringPiece block = data.backing_block(i);
+        struct iovec v;
+        v.iov_base = const_cast<char*>(block.data());
+        v.iov_len = block.size();
+        iovecs->push_back(v);
+    }
+
+    uint64_t off = offset;
+    for (size_t i = 0; i < blockNum; i += IOV_MAX) {
+        IORequest req;
+        req.type = IORequestType::WRITE;
+        req.fd = fd;
+        req.iov = iovecs->data() + first + i;
+        req.iovcnt = std::min<size_t>(IOV_MAX, blockNum - i);
+        req.offset = off;
+        req.length = 0;
+        for (int j = 0; j < req.iovcnt; ++j) {
+            req.length += req.iov[j].iov_len;
+        }
+        off += req.length;
+        requests->push_back(req);
+    }
+}
+
+}  // namespace
+
+IoUringFileSystemImpl::IoUringFileSystemImpl(
+    std::shared_ptr<LocalFileSystem> base)
+    : base_(base) {
+    CHECK(base_ != nullptr) << "Base local filesystem is null";
+}
+
+IoUringFileSystemImpl::~IoUringFileSystemImpl() {
+    DestroyRings();
+}
+
+int IoUringFileSystemImpl::Init(const LocalFileSystemOption& option) {
+    int ret = base_->Init(option);
+    if (ret != 0) {
+        return ret;
+    }
+    if (!rings_.empty()) {
+        return 0;
+    }
+
+    if (option.ioUringRingNum == 0 || option.ioUringQueueDepth == 0) {
+        LOG(ERROR) << "Invalid io_uring option, ring num: "
+                   << option.ioUringRingNum
+                   << ", queue depth: " << option.ioUringQueueDepth;
+        return -EINVAL;
+    }
+    option_ = option;
+
+    for (uint32_t i = 0; i < option_.ioUringRingNum; ++i) {
+        std::unique_ptr<Ring> ring(new Ring());
+        ret = InitRing(ring.get());
+        if (ret != 0) {
+            DestroyRings();
+            return ret;
+        }
+        rings_.push_back(std::move(ring));
+    }
+
+    LOG(INFO) << "Init io_uring local filesystem success, ring num: "
+              << option_.ioUringRingNum
+              << ", queue depth: " << option_.ioUringQueueDepth
+              << ", fixed file num: " << option_.ioUringFixedFileNum;
+    return 0;
+}
+
+int IoUringFileSystemImpl::InitRing(Ring* ring) {
+    int ret = ring->uring.Init(option_.ioUringQueueDepth);
+    if (ret != 0) {
+        LOG(ERROR) << "io_uring setup failed: " << strerror(-ret);
+        return ret;
+    }
+
+    if (option_.ioUringFixedFileNum > 0) {
+        ring->fixedFds.assign(option_.ioUringFixedFileNum, -1);
+        ret = ring->uring.RegisterFiles(ring->fixedFds.data(),
+                                        ring->fixedFds.size());
+        if (ret != 0) {
+            LOG(WARNING) << "io_uring register files failed: "
+                         << strerror(-ret);
+            ring->fixedFds.clear();
+        } else {
+            ring->fixedFileEnabled = true;
+            ring->referenced.assign(ring->fixedFds.size(), false);
+            ring->lastUsedBatch.assign(ring->fixedFds.size(), 0);
+        }
+    }
+    return 0;
+}
+
+void IoUringFileSystemImpl::DestroyRings() {
+    // only the batch of the destroying thread can be reached
+    Batch* batch = GetBatch();
+    if (batch != nullptr) {
+        LOG_IF(WARNING, !batch->writes.empty())
+            << "Drop " << batch->writes.size()
+            << " deferred io_uring writes";
+        *batch = Batch();
+    }
+    for (auto& ring : rings_) {
+        std::lock_guard<std::mutex> lock(ring->mtx);
+        ring->uring.Exit();
+    }
+    rings_.clear();
+}
+
+IoUringFileSystemImpl::Ring* IoUringFileSystemImpl::GetRing() {
+    if (tlsThreadSeq == kNoThreadSeq) {
+        tlsThreadSeq = gThreadSeq.fetch_add(1, std::memory_order_relaxed);
+    }
+    return rings_[tlsThreadSeq % rings_.size()].get();
+}
+
+IoUringFileSystemImpl::Batch* IoUringFileSystemImpl::ThreadBatch() {
+    static thread_local Batch batch;
+    return &batch;
+}
+
+IoUringFileSystemImpl::Batch* IoUringFileSystemImpl::GetBatch() {
+    Batch* batch = ThreadBatch();
+    return batch->owner == this ? batch : nullptr;
+}
+
+int IoUringFileSystemImpl::GetFixedSlot(Ring* ring, int fd) {
+    if (!ring->fixedFileEnabled || fd < 0 ||
+        ring->openedFds.count(fd) == 0) {
+        return -1;
+    }
+
+    auto iter = ring->fdToSlot.find(fd);
+    if (iter != ring->fdToSlot.end()) {
+        ring->referenced[iter->second] = true;
+        ring->lastUsedBatch[iter->second] = ring->batchSeq;
+        return iter->second;
+    }
+
+    // find a victim by clock, each slot gets at most one second chance
+    uint32_t slotNum = ring->fixedFds.size();
+    int victim = -1;
+    for (uint32_t i = 0; i < 2 * slotNum; ++i) {
+        uint32_t slot = ring->clockHand;
+        ring->clockHand = (ring->clockHand + 1) % slotNum;
+        if (ring->fixedFds[slot] == -1) {
+            victim = slot;
+            break;
+        }
+        if (ring->lastUsedBatch[slot] == ring->batchSeq) {
+            continue;
+        }
+        if (ring->referenced[slot]) {
+            ring->referenced[slot] = false;
+            continue;
+        }
+        victim = slot;
+        break;
+    }
+    if (victim < 0) {
+        return -1;
+    }
+
+    int ret = ring->uring.UpdateFiles(victim, &fd, 1);
+    if (ret != 0) {
+        LOG(WARNING) << "io_uring update fixed file failed, fd: " << fd
+                     << ", slot: " << victim << ", error: " << strerror(-ret);
+        return -1;
+    }
+    if (ring->fixedFds[victim] != -1) {
+        ring->fdToSlot.erase(ring->fixedFds[victim]);
+    }
+    ring->fixedFds[victim] = fd;
+    ring->referenced[victim] = false;
+    ring->lastUsedBatch[victim] = ring->batchSeq;
+    ring->fdToSlot[fd] = victim;
+    return victim;
+}
+
+void IoUringFileSystemImpl::RemoveFixedFile(Ring* ring, int fd) {
+    auto iter = ring->fdToSlot.find(fd);
+    if (iter == ring->fdToSlot.end()) {
+        return;
+    }
+    int empty = -1;
+    int ret = ring->uring.UpdateFiles(iter->second, &empty, 1);
+    LOG_IF(WARNING, ret != 0) << "io_uring remove fixed file failed, fd: "
+                              << fd << ", error: " << strerror(-ret);
+    ring->fixedFds[iter->second] = -1;
+    ring->referenced[iter->second] = false;
+    ring->fdToSlot.erase(iter);
+}
+
+void IoUringFileSystemImpl::PrepareSqe(Ring* ring, const IORequest& request,
+                                       struct io_uring_sqe* sqe) {
+    int slot = GetFixedSlot(ring, request.fd);
+    if (slot >= 0) {
+        sqe->fd = slot;
+        sqe->flags |= IOSQE_FIXED_FILE;
+    } else {
+        sqe->fd = request.fd;
+    }
+
+    bool isRead = request.type == IORequestType::READ;
+    switch (request.type) {
+        case IORequestType::READ:
+        case IORequestType::WRITE: {
+            sqe->off = request.offset;
+            if (request.iov != nullptr) {
+                sqe->opcode = isRead ? IORING_OP_READV : IORING_OP_WRITEV;
+                sqe->addr = reinterpret_cast<uint64_t>(request.iov);
+                sqe->len = request.iovcnt;
+            } else {
+                sqe->opcode = isRead ? IORING_OP_READ : IORING_OP_WRITE;
+                sqe->addr = reinterpret_cast<uint64_t>(request.buf);
+                sqe->len = request.length;
+            }
+            break;
+        }
+        case IORequestType::FDATASYNC:
+            sqe->opcode = IORING_OP_FSYNC;
+            sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+            break;
+        case IORequestType::FSYNC:
+            sqe->opcode = IORING_OP_FSYNC;
+            break;
+    }
+}
+
+int IoUringFileSystemImpl::DoSubmit(Ring* ring, IORequest* requests,
+                                    size_t count) {
+    // a sync must not start before the writes to the same fd ahead of it
+    // complete, so these writes are moved right before the sync and linked
+    // to it, other requests run concurrently
+    std::vector<int> syncOf(count, -1);
+    for (size_t i = 0; i < count; ++i) {
+        if (!IsSync(requests[i])) {
+            continue;
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (syncOf[j] < 0 && requests[j].type == IORequestType::WRITE &&
+                requests[j].fd == requests[i].fd) {
+                syncOf[j] = i;
+            }
+        }
+    }
+    std::vector<size_t> order;
+    // linkNext[k] means order[k + 1] must run after order[k]
+    std::vector<bool> linkNext;
+    order.reserve(count);
+    linkNext.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (syncOf[i] >= 0) {
+            continue;
+        }
+        if (IsSync(requests[i])) {
+            for (size_t j = 0; j < i; ++j) {
+                if (syncOf[j] == static_cast<int>(i)) {
+                    order.push_back(j);
+                    linkNext.push_back(true);
+                }
+            }
+        }
+        order.push_back(i);
+        linkNext.push_back(false);
+    }
+
+    size_t done = 0;
+    while (done < count) {
+        size_t batch = std::min<size_t>(count - done,
+                                        ring->uring.SqEntries());
+        ++ring->batchSeq;
+        for (size_t k = done; k < done + batch; ++k) {
+            struct io_uring_sqe* sqe = ring->uring.GetSqe();
+            CHECK(sqe != nullptr) << "io_uring submission queue is full";
+            PrepareSqe(ring, requests[order[k]], sqe);
+            // a chain split by the queue depth is still ordered,
+            // since the next part is submitted after this one completes
+            if (linkNext[k] && k + 1 < done + batch) {
+                sqe->flags |= IOSQE_IO_LINK;
+            }
+            sqe->user_data = order[k];
+        }
+
+        uint32_t submitted = 0;
+        int ret = ring->uring.Submit(batch, &submitted);
+        // the kernel may use the buffers of the requests it has taken
+        // until they complete, so they are always reaped
+        for (uint32_t k = 0; k < submitted; ++k) {
+            struct io_uring_cqe* cqe = nullptr;
+            int err = ring->uring.WaitCqe(&cqe);
+            CHECK(err == 0) << "io_uring wait completion failed with "
+                            << submitted - k << " requests in flight: "
+                            << strerror(-err);
+            requests[cqe->user_data].result = cqe->res;
+            ring->uring.CqeSeen();
+        }
+        if (ret < 0) {
+            LOG(ERROR) << "io_uring submit failed, submitted: " << submitted
+                       << ", total: " << batch << ", error: "
+                       << strerror(-ret);
+            for (size_t k = done + submitted; k < count; ++k) {
+                requests[order[k]].result = ret;
+            }
+            return ret;
+        }
+        done += batch;
+    }
+
+    // in the order of the requests, so the writes linked to a sync are
+    // completed before the sync is retried
+    int firstError = 0;
+    for (size_t i = 0; i < count; ++i) {
+        IORequest& req = requests[i];
+        bool isData = !IsSync(req);
+        bool shortIO = isData && req.result >= 0 && req.result < req.length &&
+                       !(req.type == IORequestType::READ && req.result == 0);
+        // requests after a failed or short one in a chain are canceled
+        if (IsRetryable(req.result) || req.result == -ECANCELED || shortIO) {
+            CompleteRemainder(ring, &req);
+        }
+        if (req.result < 0) {
+            LOG(ERROR) << "io_uring request failed, fd: " << req.fd
+                       << ", offset: " << req.offset
+                       << ", length: " << req.length
+                       << ", error: " << strerror(-req.result);
+            if (firstError == 0) {
+                firstError = req.result;
+            }
+        }
+    }
+    return firstError;
+}
+
+int IoUringFileSystemImpl::CompleteRemainder(Ring* ring, IORequest* request) {
+    int done = request->result > 0 ? request->result : 0;
+    int retryTimes = 0;
+    std::vector<struct iovec> iovecs;
+    bool isSync = IsSync(*request);
+
+    while (isSync || done < request->length) {
+        IORequest sub = *request;
+        if (!isSync) {
+            sub.offset = request->offset + done;
+            sub.length = request->length - done;
+            if (request->iov != nullptr) {
+                AdvanceIovec(request->iov, request->iovcnt, done, &iovecs);
+                sub.iov = iovecs.data();
+                sub.iovcnt = iovecs.size();
+            } else {
+                sub.buf = request->buf + done;
+            }
+        }
+
+        ++ring->batchSeq;
+        struct io_uring_sqe* sqe = ring->uring.GetSqe();
+        CHECK(sqe != nullptr) << "io_uring submission queue is full";
+        PrepareSqe(ring, sub, sqe);
+        // a single sqe is either taken by the kernel or dropped
+        uint32_t submitted = 0;
+        int ret = ring->uring.Submit(1, &submitted);
+        if (ret < 0) {
+            request->result = ret;
+            return ret;
+        }
+        struct io_uring_cqe* cqe = nullptr;
+        ret = ring->uring.WaitCqe(&cqe);
+        CHECK(ret == 0) << "io_uring wait completion failed with a request"
+                        << " in flight: " << strerror(-ret);
+        int res = cqe->res;
+        ring->uring.CqeSeen();
+
+        if (IsRetryable(res) && retryTimes < kMaxRetryTimes) {
+            ++retryTimes;
+            continue;
+        }
+        if (res < 0) {
+            request->result = res;
+            return res;
+        }
+        if (isSync) {
+            request->result = 0;
+            return 0;
+        }
+        // if offset is beyond the end of file, read returns zero
+        if (res == 0) {
+            if (request->type == IORequestType::WRITE) {
+                request->result = -EIO;
+                return -EIO;
+            }
+            LOG(WARNING) << "io_uring read returns zero, offset: "
+                         << sub.offset << ", length: " << sub.length;
+            break;
+        }
+        done += res;
+    }
+    request->result = done;
+    return done;
+}
+
+bool IoUringFileSystemImpl::HasDeferred(int fd) {
+    Batch* batch = GetBatch();
+    if (batch == nullptr) {
+        return false;
+    }
+    for (const auto& write : batch->writes) {
+        if (write.fd == fd) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int IoUringFileSystemImpl::SubmitDeferred(Ring* ring, IORequest* request) {
+    Batch* batch = GetBatch();
+    if (batch == nullptr || batch->writes.empty()) {
+        if (request == nullptr) {
+            return 0;
+        }
+        DoSubmit(ring, request, 1);
+        return request->result;
+    }
+
+    size_t blockNum = 0;
+    for (const auto& write : batch->writes) {
+        blockNum += write.data.backing_block_num();
+    }
+    std::vector<struct iovec> iovecs;
+    iovecs.reserve(blockNum);
+    std::vector<IORequest> requests;
+    for (const auto& write : batch->writes) {
+        BuildWriteRequests(write.fd, write.data, write.offset, &iovecs,
+                           &requests);
+    }
+    size_t deferredNum = requests.size();
+    if (request != nullptr) {
+        requests.push_back(*request);
+    }
+
+    VLOG(9) << "Submit " << batch->writes.size()
+            << " deferred io_uring writes";
+    DoSubmit(ring, requests.data(), requests.size());
+    for (size_t i = 0; i < deferredNum; ++i) {
+        if (requests[i].result < 0 && batch->error == 0) {
+            batch->error = requests[i].result;
+        }
+    }
+    batch->writes.clear();
+
+    if (request == nullptr) {
+        return 0;
+    }
+    request->result = requests.back().result;
+    return request->result;
+}
+
+int IoUringFileSystemImpl::SubmitOne(IORequest* request) {
+    Ring* ring = GetRing();
+    std::lock_guard<std::mutex> lock(ring->mtx);
+    // a sync is linked after the deferred writes in the same submission,
+    // other requests wait for the deferred writes to the same file
+    if (IsSync(*request)) {
+        return SubmitDeferred(ring, request);
+    }
+    if (HasDeferred(request->fd)) {
+        SubmitDeferred(ring, nullptr);
+    }
+    DoSubmit(ring, request, 1);
+    return request->result;
+}
+
+void IoUringFileSystemImpl::BeginBatch() {
+    Batch* batch = ThreadBatch();
+    if (batch->owner != nullptr && batch->owner != this) {
+        LOG(WARNING) << "Begin io_uring batch before the batch of another"
+                     << " filesystem is flushed";
+    }
+    batch->owner = this;
+}
+
+int IoUringFileSystemImpl::FlushBatch() {
+    Batch* batch = GetBatch();
+    if (batch == nullptr) {
+        return 0;
+    }
+    Ring* ring = GetRing();
+    std::lock_guard<std::mutex> lock(ring->mtx);
+    SubmitDeferred(ring, nullptr);
+    int ret = batch->error;
+    batch->error = 0;
+    batch->owner = nullptr;
+    return ret;
+}
+
+int IoUringFileSystemImpl::Statfs(const string& path,
+                                  struct FileSystemInfo* info) {
+    return base_->Statfs(path, info);
+}
+
+int IoUringFileSystemImpl::Open(const string& path, int flags) {
+    int fd = base_->Open(path, flags);
+    if (fd < 0) {
+        return fd;
+    }
+    // the fd number may be reused from a file closed elsewhere,
+    // drop the stale fixed files of it
+    for (auto& ring : rings_) {
+        std::lock_guard<std::mutex> lock(ring->mtx);
+        RemoveFixedFile(ring.get(), fd);
+        ring->openedFds.insert(fd);
+    }
+    return fd;
+}
+
+int IoUringFileSystemImpl::Close(int fd) {
+    // the deferred writes must be done and the fd must leave all fixed file
+    // tables before it can be reused
+    FlushDeferred(fd);
+    for (auto& ring : rings_) {
+        std::lock_guard<std::mutex> lock(ring->mtx);
+        RemoveFixedFile(ring.get(), fd);
+        ring->openedFds.erase(fd);
+    }
+    return base_->Close(fd);
+}
+
+int IoUringFileSystemImpl::Delete(const string& path) {
+    return base_->Delete(path);
+}
+
+int IoUringFileSystemImpl::Mkdir(const string& dirPath) {
+    return base_->Mkdir(dirPath);
+}
+
+bool IoUringFileSystemImpl::DirExists(const string& dirPath) {
+    return base_->DirExists(dirPath);
+}
+
+bool IoUringFileSystemImpl::FileExists(const string& filePath) {
+    return base_->FileExists(filePath);
+}
+
+int IoUringFileSystemImpl::Rename(const string& oldPath,
+                                  const string& newPath,
+                                  unsigned int flags) {
+    return base_->Rename(oldPath, newPath, flags);
+}
+
+int IoUringFileSystemImpl::List(const string& dirPath,
+                                vector<std::string>* names) {
+    return base_->List(dirPath, names);
+}
+
+int IoUringFileSystemImpl::Read(int fd, char* buf, uint64_t offset,
+                                int length) {
+    IORequest request;
+    request.type = IORequestType::READ;
+    request.fd = fd;
+    request.buf = buf;
+    request.offset = offset;
+    request.length = length;
+    return SubmitOne(&request);
+}
+
+int IoUringFileSystemImpl::Write(int fd, const char* buf, uint64_t offset,
+                                 int length) {
+    IORequest request;
+    request.type = IORequestType::WRITE;
+    request.fd = fd;
+    request.buf = const_cast<char*>(buf);
+    request.offset = offset;
+    request.length = length;
+    int ret = SubmitOne(&request);
+    return ret < 0 ? ret : length;
+}
+
+int IoUringFileSystemImpl::Write(int fd, butil::IOBuf buf, uint64_t offset,
+                                 int length) {
+    if (length != static_cast<int>(buf.size())) {
+        LOG(ERROR) << "io_uring write failed, fd: " << fd
+                   << ", data size doesn't equal to length, data size: "
+                   << buf.size() << ", length: " << length;
+        return -EINVAL;
+    }
+
+    Ring* ring = GetRing();
+    std::lock_guard<std::mutex> lock(ring->mtx);
+    Batch* batch = GetBatch();
+    if (batch != nullptr) {
+        // overlapping writes in one submission may land in any order
+        for (const auto& write : batch->writes) {
+            if (write.fd == fd && write.offset < offset + length &&
+                offset < write.offset + write.data.size()) {
+                SubmitDeferred(ring, nullptr);
+                break;
+            }
+        }
+        if (batch->writes.size() >= ring->uring.SqEntries()) {
+            SubmitDeferred(ring, nullptr);
+        }
+        DeferredWrite write;
+        write.fd = fd;
+        write.offset = offset;
+        write.data.swap(buf);
+        batch->writes.push_back(std::move(write));
+        return length;
+    }
+
+    std::vector<struct iovec> iovecs;
+    std::vector<IORequest> requests;
+    BuildWriteRequests(fd, buf, offset, &iovecs, &requests);
+    int ret = DoSubmit(ring, requests.data(), requests.size());
+    return ret < 0 ? ret : length;
+}
+
+int IoUringFileSystemImpl::Sync(int fd) {
+    IORequest request;
+    request.type = IORequestType::FDATASYNC;
+    request.fd = fd;
+    return SubmitOne(&request);
+}
+
+int IoUringFileSystemImpl::Append(int fd, const char* buf, int length) {
+    FlushDeferred(fd);
+    return base_->Append(fd, buf, length);
+}
+
+int IoUringFileSystemImpl::Fallocate(int fd, int op, uint64_t offset,
+                                     int length) {
+    FlushDeferred(fd);
+    return base_->Fallocate(fd, op, offset, length);
+}
+
+int IoUringFileSystemImpl::Fstat(int fd, struct stat* info) {
+    FlushDeferred(fd);
+    return base_->Fstat(fd, info);
+}
+
+int IoUringFileSystemImpl::Fsync(int fd) {
+    IORequest request;
+    request.type = IORequestType::FSYNC;
+    request.fd = fd;
+    return SubmitOne(&request);
+}
+
+void IoUringFileSystemImpl::FlushDeferred(int fd) {
+    if (!HasDeferred(fd)) {
+        return;
+    }
+    Ring* ring = GetRing();
+    std::lock_guard<std::mutex> lock(ring->mtx);
+    SubmitDeferred(ring, nullptr);
+}
+
+}  // namespace fs
+}  // namespace curve
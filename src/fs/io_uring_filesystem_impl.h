@@ -0,0 +1,199 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_FS_IO_URING_FILESYSTEM_IMPL_H_
+#define SRC_FS_IO_URING_FILESYSTEM_IMPL_H_
+
+#include <butil/iobuf.h>
+#include <sys/uio.h>
+
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "src/fs/io_uring.h"
+#include "src/fs/local_filesystem.h"
+
+namespace curve {
+namespace fs {
+
+enum class IORequestType {
+    READ,
+    WRITE,
+    FDATASYNC,
+    FSYNC,
+};
+
+struct IORequest {
+    IORequestType type;
+    int fd;
+    // either buf or iov is used for READ/WRITE
+    char* buf;
+    const struct iovec* iov;
+    int iovcnt;
+    uint64_t offset;
+    int length;
+    // bytes transferred for READ/WRITE, 0 for sync, -errno on failure
+    int result;
+
+    IORequest()
+        : type(IORequestType::READ), fd(-1), buf(nullptr), iov(nullptr),
+          iovcnt(0), offset(0), length(0), result(0) {}
+};
+
+/**
+ * LocalFileSystem whose data path (Read/Write/Sync/Fsync) goes through
+ * io_uring, all other operations are delegated to the wrapped filesystem.
+ *
+ * Calling threads are spread over ioUringRingNum rings by the order they
+ * first use the filesystem, a ring may be shared by several threads, each
+ * submission holds the ring until all its completions are reaped. Every
+ * ring owns a fixed file table which caches the most recently used chunk
+ * files by a clock algorithm, only fds opened and closed through this
+ * filesystem are put into it. Buffers are passed to the kernel as is,
+ * data is never copied.
+ *
+ * Between BeginBatch and FlushBatch the IOBuf writes of a thread are
+ * deferred in the batch of that thread and submitted together, along with
+ * the next sync of the thread, by one io_uring_enter. Only the owner
+ * thread submits its deferred writes, and only its FlushBatch reports
+ * their errors. A file with deferred writes must not be closed by other
+ * threads before the batch is flushed.
+ */
+class IoUringFileSystemImpl : public LocalFileSystem {
+ public:
+    explicit IoUringFileSystemImpl(std::shared_ptr<LocalFileSystem> base);
+    virtual ~IoUringFileSystemImpl();
+
+    int Init(const LocalFileSystemOption& option) override;
+    int Statfs(const string& path, struct FileSystemInfo* info) override;
+    int Open(const string& path, int flags) override;
+    int Close(int fd) override;
+    int Delete(const string& path) override;
+    int Mkdir(const string& dirPath) override;
+    bool DirExists(const string& dirPath) override;
+    bool FileExists(const string& filePath) override;
+    int Rename(const string& oldPath,
+               const string& newPath,
+               unsigned int flags = 0) override;
+    int List(const string& dirPath, vector<std::string>* names) override;
+    int Read(int fd, char* buf, uint64_t offset, int length) override;
+    int Write(int fd, const char* buf, uint64_t offset, int length) override;
+    int Write(int fd, butil::IOBuf buf, uint64_t offset, int length) override;
+    int Sync(int fd) override;
+    int Append(int fd, const char* buf, int length) override;
+    int Fallocate(int fd, int op, uint64_t offset, int length) override;
+    int Fstat(int fd, struct stat* info) override;
+    int Fsync(int fd) override;
+    void BeginBatch() override;
+    int FlushBatch() override;
+
+ private:
+    struct DeferredWrite {
+        int fd;
+        uint64_t offset;
+        butil::IOBuf data;
+    };
+
+    // writes deferred by a thread in batch mode, only used by the thread
+    struct Batch {
+        // the filesystem the thread is in batch mode with
+        const IoUringFileSystemImpl* owner;
+        std::vector<DeferredWrite> writes;
+        // first error of the deferred writes submitted, reported by
+        // FlushBatch
+        int error;
+        Batch() : owner(nullptr), error(0) {}
+    };
+
+    struct Ring {
+        std::mutex mtx;
+        IoUring uring;
+        // fixed file table, -1 means empty slot
+        bool fixedFileEnabled;
+        std::vector<int> fixedFds;
+        // second chance bits of the clock algorithm
+        std::vector<bool> referenced;
+        // the batch sequence that last used the slot, slots used by the
+        // batch being prepared can not be evicted
+        std::vector<uint64_t> lastUsedBatch;
+        std::unordered_map<int, uint32_t> fdToSlot;
+        // fds opened through this filesystem and not closed yet, an fd
+        // closed elsewhere may be reused by another file, so other fds
+        // never enter the fixed file table
+        std::unordered_set<int> openedFds;
+        uint32_t clockHand;
+        uint64_t batchSeq;
+        Ring() : fixedFileEnabled(false), clockHand(0), batchSeq(0) {}
+    };
+
+    int InitRing(Ring* ring);
+    void DestroyRings();
+    Ring* GetRing();
+    // the batch of the calling thread
+    static Batch* ThreadBatch();
+    // the batch of the calling thread if it is in batch mode with this
+    // filesystem, otherwise nullptr
+    Batch* GetBatch();
+
+    /**
+     * Prepare, submit and reap the given requests on ring, the completions
+     * of all requests taken by the kernel are reaped before it returns,
+     * the caller must hold ring->mtx
+     */
+    int DoSubmit(Ring* ring, IORequest* requests, size_t count);
+    void PrepareSqe(Ring* ring, const IORequest& request,
+                    struct io_uring_sqe* sqe);
+    // return the fixed file slot of fd, -1 if fd is not registered
+    int GetFixedSlot(Ring* ring, int fd);
+    // the caller must hold ring->mtx
+    void RemoveFixedFile(Ring* ring, int fd);
+    // whether the calling thread has deferred writes to fd
+    bool HasDeferred(int fd);
+    /**
+     * Submit the deferred writes of the calling thread together with
+     * request, their errors are kept in the batch, the caller must hold
+     * ring->mtx of the ring of the thread
+     * @param request: submitted after the deferred writes, may be nullptr
+     * @return the result of request, or 0 if request is nullptr
+     */
+    int SubmitDeferred(Ring* ring, IORequest* request);
+    // submit a single request of the calling thread
+    int SubmitOne(IORequest* request);
+    // submit the deferred writes of the calling thread to fd
+    void FlushDeferred(int fd);
+    // complete a short read/write or a request interrupted by EINTR/EAGAIN
+    int CompleteRemainder(Ring* ring, IORequest* request);
+
+ private:
+    std::shared_ptr<LocalFileSystem> base_;
+    LocalFileSystemOption option_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+};
+
+}  // namespace fs
+}  // namespace curve
+
+#endif  // SRC_FS_IO_URING_FILESYSTEM_IMPL_H_
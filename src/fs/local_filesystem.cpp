@@ -24,6 +24,7 @@
 
 #include "src/fs/local_filesystem.h"
 #include "src/fs/ext4_filesystem_impl.h"
+#include "src/fs/io_uring_filesystem_impl.h"
 #include "src/fs/wrap_posix.h"
 
 namespace curve {
@@ -31,11 +32,17 @@ namespace fs {
 
 std::shared_ptr<LocalFileSystem> LocalFsFactory::CreateFs(
     FileSystemType type,
-    const std::string& deviceID) {
+    const std::string& deviceID,
+    IOEngineType engine) {
     (void)deviceID;
     std::shared_ptr<LocalFileSystem> localFs;
     if (type == FileSystemType::EXT4) {
         localFs = Ext4FileSystemImpl::getInstance();
+        // io_uring only takes over the data path, other operations
+        // are still served by the ext4 implementation
+        if (engine == IOEngineType::IO_URING) {
+            localFs = std::make_shared<IoUringFileSystemImpl>(localFs);
+        }
     } else {
         LOG(ERROR) << "Unknown filesystem type.";
         return nullptr;
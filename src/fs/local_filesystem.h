@@ -45,7 +45,18 @@ namespace fs {
 
 struct LocalFileSystemOption {
     bool enableRenameat2;
-    LocalFileSystemOption() : enableRenameat2(false) {}
+    // options below only take effect with IOEngineType::IO_URING
+    // number of rings, threads are spread over the rings
+    uint32_t ioUringRingNum;
+    // submission queue depth of each ring
+    uint32_t ioUringQueueDepth;
+    // fixed file slots of each ring for hot chunks, 0 means disabled
+    uint32_t ioUringFixedFileNum;
+    LocalFileSystemOption()
+        : enableRenameat2(false),
+          ioUringRingNum(16),
+          ioUringQueueDepth(128),
+          ioUringFixedFileNum(256) {}
 };
 
 class LocalFileSystem {
@@ -215,6 +226,19 @@ class LocalFileSystem {
      */
     virtual int Fsync(int fd) = 0;
 
+    /**
+     * 开始批量写，之后本线程通过butil::IOBuf写入的数据可能延迟到FlushBatch
+     * 时一起提交，期间本线程对同一文件的其他操作会先提交已延迟的写
+     * 默认实现直接写入，不做延迟
+     */
+    virtual void BeginBatch() {}
+
+    /**
+     * 提交本线程延迟的写并结束批量写
+     * @return 延迟的写全部成功返回0，否则返回第一个错误的-errno
+     */
+    virtual int FlushBatch() { return 0; }
+
  private:
     virtual int DoRename(const string& /* oldPath */,
                          const string& /* newPath */,
@@ -230,10 +254,12 @@ class LocalFsFactory {
      * 由该接口创建的文件系统会自动进行初始化
      * @param type：文件系统类型
      * @param deviceID: 设备的编号
+     * @param engine: 数据读写使用的IO引擎，默认使用pread/pwrite
      * @return 返回本地文件系统对象指针
      */
     static std::shared_ptr<LocalFileSystem> CreateFs(FileSystemType type,
-                                                const std::string& deviceID);
+                                const std::string& deviceID,
+                                IOEngineType engine = IOEngineType::PSYNC);
 };
 
 }  // namespace fs
@@ -1178,5 +1178,102 @@ TEST_F(ChunkService2Test, CheckEpochTest) {
     }
 }
 
+class BatchChunkTestClosure : public ::google::protobuf::Closure {
+ public:
+    void Run() override {
+        ++runTimes;
+    }
+
+    int runTimes = 0;
+};
+
+TEST_F(ChunkService2Test, BatchChunkTest) {
+    // inflight throttle
+    uint64_t maxInflight = 10000;
+    std::shared_ptr<InflightThrottle> inflightThrottle
+        = std::make_shared<InflightThrottle>(maxInflight);
+    CHECK(nullptr != inflightThrottle) << "new inflight throttle failed";
+
+    // chunk service
+    CopysetNodeManager &nodeManager = CopysetNodeManager::GetInstance();
+    ChunkServiceOptions chunkServiceOptions;
+    chunkServiceOptions.copysetNodeManager = &nodeManager;
+    chunkServiceOptions.inflightThrottle = inflightThrottle;
+    auto epochMap = std::make_shared<EpochMap>();
+    ASSERT_TRUE(epochMap->UpdateEpoch(1, 2));
+    ChunkServiceImpl chunkService(chunkServiceOptions, epochMap);
+
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 10000;
+
+    auto addRequest = [&](BatchChunkRequest *request, CHUNK_OP_TYPE type,
+                          ChunkID chunkId, uint32_t size) {
+        ChunkRequest *subRequest = request->add_requests();
+        subRequest->set_optype(type);
+        subRequest->set_logicpoolid(logicPoolId);
+        subRequest->set_copysetid(copysetId);
+        subRequest->set_chunkid(chunkId);
+        subRequest->set_offset(0);
+        subRequest->set_size(size);
+        subRequest->set_fileid(1);
+        subRequest->set_epoch(1);
+    };
+
+    // only read/write are supported
+    {
+        brpc::Controller cntl;
+        BatchChunkRequest request;
+        BatchChunkResponse response;
+        BatchChunkTestClosure done;
+        addRequest(&request, CHUNK_OP_TYPE::CHUNK_OP_READ, 1, 0);
+        addRequest(&request, CHUNK_OP_TYPE::CHUNK_OP_DELETE, 2, 0);
+        chunkService.BatchChunk(&cntl, &request, &response, &done);
+        ASSERT_EQ(1, done.runTimes);
+        ASSERT_EQ(2, response.responses_size());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST,
+                  response.responses(0).status());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST,
+                  response.responses(1).status());
+    }
+
+    // write data doesn't match the attachment
+    {
+        brpc::Controller cntl;
+        BatchChunkRequest request;
+        BatchChunkResponse response;
+        BatchChunkTestClosure done;
+        addRequest(&request, CHUNK_OP_TYPE::CHUNK_OP_WRITE, 1, 4096);
+        cntl.request_attachment().resize(1024, 'a');
+        chunkService.BatchChunk(&cntl, &request, &response, &done);
+        ASSERT_EQ(1, done.runTimes);
+        ASSERT_EQ(1, response.responses_size());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST,
+                  response.responses(0).status());
+    }
+
+    // sub requests are handled separately
+    {
+        brpc::Controller cntl;
+        BatchChunkRequest request;
+        BatchChunkResponse response;
+        BatchChunkTestClosure done;
+        addRequest(&request, CHUNK_OP_TYPE::CHUNK_OP_WRITE, 1, 4096);
+        addRequest(&request, CHUNK_OP_TYPE::CHUNK_OP_READ, 2, 0);
+        addRequest(&request, CHUNK_OP_TYPE::CHUNK_OP_WRITE, 3, 4096);
+        request.mutable_requests(2)->set_epoch(2);
+        cntl.request_attachment().resize(8192, 'a');
+        chunkService.BatchChunk(&cntl, &request, &response, &done);
+        ASSERT_EQ(1, done.runTimes);
+        ASSERT_EQ(3, response.responses_size());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_EPOCH_TOO_OLD,
+                  response.responses(0).status());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_COPYSET_NOTEXIST,
+                  response.responses(1).status());
+        ASSERT_NE(CHUNK_OP_STATUS::CHUNK_OP_STATUS_EPOCH_TOO_OLD,
+                  response.responses(2).status());
+        ASSERT_EQ(0U, cntl.response_attachment().size());
+    }
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -0,0 +1,264 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <butil/iobuf.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/chunkserver/chunk_write_batch.h"
+#include "test/fs/mock_local_filesystem.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Invoke;
+using ::testing::InSequence;
+using ::testing::Return;
+using ::curve::fs::MockLocalFileSystem;
+
+class MockBatchDataStore : public CSDataStore {
+ public:
+    MOCK_METHOD7(WriteChunk, CSErrorCode(ChunkID,
+                                         SequenceNum,
+                                         const butil::IOBuf&,
+                                         off_t,
+                                         size_t,
+                                         uint32_t*,
+                                         const std::string&));
+    MOCK_METHOD2(GetChunkInfo, CSErrorCode(ChunkID, CSChunkInfo*));
+    MOCK_METHOD0(GetLocalFileSystem, std::shared_ptr<LocalFileSystem>());
+};
+
+class ChunkWriteBatchTest : public testing::Test {
+ protected:
+    void SetUp() override {
+        datastore_ = std::make_shared<MockBatchDataStore>();
+        ON_CALL(*datastore_, GetLocalFileSystem())
+            .WillByDefault(Return(nullptr));
+        // chunks at version 2 without clone source and snapshot
+        ON_CALL(*datastore_, GetChunkInfo(_, _))
+            .WillByDefault(Invoke([](ChunkID, CSChunkInfo* info) {
+                info->curSn = 2;
+                info->snapSn = 0;
+                info->isClone = false;
+                return CSErrorCode::Success;
+            }));
+    }
+
+    void TearDown() override {
+        ApplyBatch::FlushAll();
+    }
+
+    void Add(ChunkID id, SequenceNum sn, off_t offset, size_t length,
+             char c, const std::string& location = "") {
+        butil::IOBuf data;
+        data.resize(length, c);
+        batch_.Add(datastore_, id, sn, location, data, offset, length,
+                   [this](CSErrorCode ret) {
+                       results_.push_back(ret);
+                   });
+    }
+
+ protected:
+    std::shared_ptr<MockBatchDataStore> datastore_;
+    ChunkWriteBatch batch_;
+    std::vector<CSErrorCode> results_;
+};
+
+TEST_F(ChunkWriteBatchTest, MergeContiguousWrites) {
+    std::string written;
+    EXPECT_CALL(*datastore_, WriteChunk(1, 2, _, 0, 12288, _, ""))
+        .WillOnce(DoAll(Invoke([&written](ChunkID, SequenceNum,
+                                          const butil::IOBuf& buf, off_t,
+                                          size_t, uint32_t*,
+                                          const std::string&) {
+                                   written = buf.to_string();
+                               }),
+                        Return(CSErrorCode::Success)));
+
+    Add(1, 2, 0, 4096, 'a');
+    Add(1, 2, 4096, 4096, 'b');
+    Add(1, 2, 8192, 4096, 'c');
+    ASSERT_EQ(3, batch_.PendingNum());
+    ASSERT_TRUE(results_.empty());
+
+    ApplyBatch::FlushAll();
+    ASSERT_EQ(0, batch_.PendingNum());
+    ASSERT_EQ(3, results_.size());
+    for (auto ret : results_) {
+        ASSERT_EQ(CSErrorCode::Success, ret);
+    }
+    ASSERT_EQ(std::string(4096, 'a') + std::string(4096, 'b') +
+              std::string(4096, 'c'), written);
+}
+
+TEST_F(ChunkWriteBatchTest, NotMergeableWrites) {
+    EXPECT_CALL(*datastore_, WriteChunk(1, 2, _, 0, 4096, _, ""))
+        .WillOnce(Return(CSErrorCode::Success));
+    // not contiguous
+    EXPECT_CALL(*datastore_, WriteChunk(1, 2, _, 8192, 4096, _, ""))
+        .WillOnce(Return(CSErrorCode::Success));
+    // different version
+    EXPECT_CALL(*datastore_, WriteChunk(1, 3, _, 12288, 4096, _, ""))
+        .WillOnce(Return(CSErrorCode::Success));
+    // different chunk
+    EXPECT_CALL(*datastore_, WriteChunk(2, 3, _, 16384, 4096, _, ""))
+        .WillOnce(Return(CSErrorCode::Success));
+    // different clone source
+    EXPECT_CALL(*datastore_, WriteChunk(2, 3, _, 20480, 4096, _, "loc@cs"))
+        .WillOnce(Return(CSErrorCode::Success));
+
+    Add(1, 2, 0, 4096, 'a');
+    Add(1, 2, 8192, 4096, 'b');
+    Add(1, 3, 12288, 4096, 'c');
+    Add(2, 3, 16384, 4096, 'd');
+    Add(2, 3, 20480, 4096, 'e', "loc@cs");
+    // applied together at flush
+    ASSERT_EQ(5, batch_.PendingNum());
+    ASSERT_TRUE(results_.empty());
+    ApplyBatch::FlushAll();
+    ASSERT_EQ(5, results_.size());
+}
+
+TEST_F(ChunkWriteBatchTest, LimitMergedSize) {
+    const size_t length = ChunkWriteBatch::kMaxWriteBytes / 2;
+    EXPECT_CALL(*datastore_, WriteChunk(1, 2, _, 0, 2 * length, _, ""))
+        .WillOnce(Return(CSErrorCode::Success));
+    EXPECT_CALL(*datastore_, WriteChunk(1, 2, _, 2 * length, length, _, ""))
+        .WillOnce(Return(CSErrorCode::Success));
+
+    Add(1, 2, 0, length, 'a');
+    Add(1, 2, length, length, 'b');
+    Add(1, 2, 2 * length, length, 'c');
+    ASSERT_TRUE(results_.empty());
+    ApplyBatch::FlushAll();
+    ASSERT_EQ(3, results_.size());
+}
+
+TEST_F(ChunkWriteBatchTest, ShareErrorOfMergedWrite) {
+    EXPECT_CALL(*datastore_, WriteChunk(1, 2, _, 0, 8192, _, ""))
+        .WillOnce(Return(CSErrorCode::BackwardRequestError));
+
+    Add(1, 2, 0, 4096, 'a');
+    Add(1, 2, 4096, 4096, 'b');
+    ApplyBatch::FlushAll();
+    ASSERT_EQ(2, results_.size());
+    for (auto ret : results_) {
+        ASSERT_EQ(CSErrorCode::BackwardRequestError, ret);
+    }
+}
+
+TEST_F(ChunkWriteBatchTest, SubmitDataOfAllChunksTogether) {
+    auto lfs = std::make_shared<MockLocalFileSystem>();
+    EXPECT_CALL(*datastore_, GetLocalFileSystem())
+        .WillRepeatedly(Return(lfs));
+    {
+        InSequence s;
+        EXPECT_CALL(*lfs, BeginBatch()).Times(1);
+        EXPECT_CALL(*datastore_, WriteChunk(1, 2, _, 0, 4096, _, ""))
+            .WillOnce(Return(CSErrorCode::Success));
+        EXPECT_CALL(*datastore_, WriteChunk(2, 2, _, 0, 4096, _, ""))
+            .WillOnce(Return(CSErrorCode::BackwardRequestError));
+        EXPECT_CALL(*datastore_, WriteChunk(3, 2, _, 0, 4096, _, ""))
+            .WillOnce(Return(CSErrorCode::Success));
+        // the deferred data failed to write
+        EXPECT_CALL(*lfs, FlushBatch()).WillOnce(Return(-EIO));
+    }
+
+    Add(1, 2, 0, 4096, 'a');
+    Add(2, 2, 0, 4096, 'b');
+    Add(3, 2, 0, 4096, 'c');
+    ApplyBatch::FlushAll();
+    ASSERT_EQ(3, results_.size());
+    ASSERT_EQ(CSErrorCode::InternalError, results_[0]);
+    ASSERT_EQ(CSErrorCode::BackwardRequestError, results_[1]);
+    ASSERT_EQ(CSErrorCode::InternalError, results_[2]);
+}
+
+TEST_F(ChunkWriteBatchTest, ApplyCloneAndCowWritesOutOfBatch) {
+    auto lfs = std::make_shared<MockLocalFileSystem>();
+    EXPECT_CALL(*datastore_, GetLocalFileSystem())
+        .WillRepeatedly(Return(lfs));
+    // chunk 2 is a clone chunk, chunk 3 has a snapshot
+    EXPECT_CALL(*datastore_, GetChunkInfo(2, _))
+        .WillRepeatedly(Invoke([](ChunkID, CSChunkInfo* info) {
+            info->curSn = 2;
+            info->isClone = true;
+            return CSErrorCode::Success;
+        }));
+    EXPECT_CALL(*datastore_, GetChunkInfo(3, _))
+        .WillRepeatedly(Invoke([](ChunkID, CSChunkInfo* info) {
+            info->curSn = 2;
+            info->snapSn = 1;
+            return CSErrorCode::Success;
+        }));
+    // chunk 5 doesn't exist yet
+    EXPECT_CALL(*datastore_, GetChunkInfo(5, _))
+        .WillRepeatedly(Return(CSErrorCode::ChunkNotExistError));
+    {
+        InSequence s;
+        EXPECT_CALL(*lfs, BeginBatch()).Times(1);
+        EXPECT_CALL(*datastore_, WriteChunk(1, 2, _, 0, 4096, _, ""))
+            .WillOnce(Return(CSErrorCode::Success));
+        EXPECT_CALL(*lfs, FlushBatch()).WillOnce(Return(0));
+        EXPECT_CALL(*datastore_, WriteChunk(2, 2, _, 0, 4096, _, ""))
+            .WillOnce(Return(CSErrorCode::Success));
+        EXPECT_CALL(*datastore_, WriteChunk(3, 2, _, 0, 4096, _, ""))
+            .WillOnce(Return(CSErrorCode::Success));
+        // a newer version bumps the chunk sn
+        EXPECT_CALL(*datastore_, WriteChunk(4, 3, _, 0, 4096, _, ""))
+            .WillOnce(Return(CSErrorCode::Success));
+        EXPECT_CALL(*datastore_, WriteChunk(5, 2, _, 0, 4096, _, "loc@cs"))
+            .WillOnce(Return(CSErrorCode::Success));
+        EXPECT_CALL(*lfs, BeginBatch()).Times(1);
+        EXPECT_CALL(*datastore_, WriteChunk(6, 2, _, 0, 4096, _, ""))
+            .WillOnce(Return(CSErrorCode::Success));
+        EXPECT_CALL(*lfs, FlushBatch()).WillOnce(Return(-EIO));
+    }
+
+    Add(1, 2, 0, 4096, 'a');
+    Add(2, 2, 0, 4096, 'b');
+    Add(3, 2, 0, 4096, 'c');
+    Add(4, 3, 0, 4096, 'd');
+    Add(5, 2, 0, 4096, 'e', "loc@cs");
+    Add(6, 2, 0, 4096, 'f');
+    ApplyBatch::FlushAll();
+    ASSERT_EQ(6, results_.size());
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(CSErrorCode::Success, results_[i]);
+    }
+    // only the write in the failed batch fails
+    ASSERT_EQ(CSErrorCode::InternalError, results_[5]);
+}
+
+TEST_F(ChunkWriteBatchTest, OnlyEnabledInBatchThread) {
+    ASSERT_EQ(nullptr, ChunkWriteBatch::Current());
+}
+
+}  // namespace chunkserver
+}  // namespace curve
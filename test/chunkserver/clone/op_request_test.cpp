@@ -1012,6 +1012,133 @@ TEST_P(OpRequestTest, ReadChunkTest) {
     closure->Release();
 }
 
+TEST_P(OpRequestTest, FollowerReadChunkTest) {
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 10001;
+    uint64_t chunkId = 12345;
+    uint32_t offset = 0;
+    uint32_t length = 5 * blocksize_;
+    ChunkRequest* request = new ChunkRequest();
+    request->set_logicpoolid(logicPoolId);
+    request->set_copysetid(copysetId);
+    request->set_chunkid(chunkId);
+    request->set_optype(CHUNK_OP_READ);
+    request->set_offset(offset);
+    request->set_size(length);
+    request->set_followerread(true);
+    brpc::Controller *cntl = new brpc::Controller();
+    ChunkResponse *response = new ChunkResponse();
+    UnitTestClosure *closure = new UnitTestClosure();
+    closure->SetCntl(cntl);
+    closure->SetRequest(request);
+    closure->SetResponse(response);
+    std::shared_ptr<ReadChunkRequest> opReq =
+        std::make_shared<ReadChunkRequest>(node_,
+                                           cloneMgr_.get(),
+                                           cntl,
+                                           request,
+                                           response,
+                                           closure);
+
+    EXPECT_CALL(*node_, IsLeaderTerm())
+        .WillRepeatedly(Return(false));
+    EXPECT_CALL(*node_, Propose(_))
+        .Times(0);
+
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == false,
+     *       请求的 apply index 大于 node的 apply index
+     * 预期： 会要求转发请求，返回CHUNK_OP_STATUS_REDIRECTED
+     */
+    {
+        request->set_appliedindex(LAST_INDEX + 1);
+
+        opReq->Process();
+
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED,
+                  closure->response_->status());
+    }
+
+    CSChunkInfo info;
+    info.isClone = false;
+    info.metaPageSize = metapagesize_;
+    info.chunkSize = chunksize_;
+    info.blockSize = blocksize_;
+    info.bitmap = std::make_shared<Bitmap>(chunksize_ / blocksize_);
+
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == false,
+     *       请求的 apply index 小于等于 node的 apply index
+     * 预期： 由follower处理，请求提交给concurrentApplyModule_处理
+     */
+    {
+        closure->Reset();
+
+        request->set_appliedindex(LAST_INDEX);
+
+        EXPECT_CALL(*datastore_, GetChunkInfo(_, _))
+            .WillOnce(
+                DoAll(SetArgPointee<1>(info), Return(CSErrorCode::Success)));
+        char *chunkData = new char[length];
+        memset(chunkData, 'a', length);
+        EXPECT_CALL(*datastore_, ReadChunk(_, _, _, offset, length))
+            .WillOnce(DoAll(SetArrayArgument<2>(chunkData, chunkData + length),
+                            Return(CSErrorCode::Success)));
+        EXPECT_CALL(*node_, UpdateAppliedIndex(_)).Times(1);
+
+        opReq->Process();
+
+        int retry = 10;
+        while (retry-- > 0) {
+            if (closure->isDone_) {
+                break;
+            }
+
+            ::sleep(1);
+        }
+
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  response->status());
+        ASSERT_EQ(
+            memcmp(chunkData,
+                   cntl->response_attachment().to_string().c_str(),  // NOLINT
+                   length),
+            0);
+        delete[] chunkData;
+    }
+
+    /**
+     * 测试OnApply
+     * 用例：follower处理的请求，请求的chunk是 clone chunk，需要拷贝数据
+     * 预期：不会产生clone task，返回CHUNK_OP_STATUS_REDIRECTED
+     */
+    {
+        closure->Reset();
+
+        info.isClone = true;
+        info.bitmap->Clear(1);
+        EXPECT_CALL(*datastore_, GetChunkInfo(_, _))
+            .WillOnce(
+                DoAll(SetArgPointee<1>(info), Return(CSErrorCode::Success)));
+        EXPECT_CALL(*datastore_, ReadChunk(_, _, _, _, _))
+            .Times(0);
+        EXPECT_CALL(*cloneMgr_, GenerateCloneTask(_, _))
+            .Times(0);
+
+        opReq->OnApply(3, closure);
+
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED,
+                  response->status());
+    }
+    // 释放资源
+    closure->Release();
+}
+
 TEST_P(OpRequestTest, RecoverChunkTest) {
     // 创建CreateCloneChunkRequest
     LogicPoolID logicPoolId = 1;
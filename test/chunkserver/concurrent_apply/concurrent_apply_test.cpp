@@ -24,6 +24,7 @@
 
 #include <atomic>
 #include <functional>
+#include <vector>
 
 #include "proto/chunk.pb.h"
 #include "src/common/timeutility.h"
@@ -31,6 +32,8 @@
 
 using curve::chunkserver::concurrent::ConcurrentApplyModule;
 using curve::chunkserver::concurrent::ConcurrentApplyOption;
+using curve::chunkserver::concurrent::ApplyQueueType;
+using curve::chunkserver::concurrent::ApplyBatch;
 using curve::chunkserver::CHUNK_OP_TYPE;
 
 TEST(ConcurrentApplyModule, InitTest) {
@@ -166,3 +169,152 @@ TEST(ConcurrentApplyModule, ConcurrentTest) {
     concurrentapply.Stop();
 }
 
+TEST(ConcurrentApplyModule, LockFreeQueueTest) {
+    std::atomic<uint32_t> testnum(0);
+    ConcurrentApplyModule concurrentapply;
+    ConcurrentApplyOption opt{4, 16, 2, 16, ApplyQueueType::LOCKFREE};
+    ASSERT_TRUE(concurrentapply.Init(opt));
+
+    auto task = [&testnum]() {
+        testnum.fetch_add(1);
+    };
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 8; i++) {
+        producers.emplace_back([&concurrentapply, &task]() {
+            for (int j = 0; j < 10000; j++) {
+                concurrentapply.Push(j, CHUNK_OP_TYPE::CHUNK_OP_WRITE, task);
+                concurrentapply.Push(j, CHUNK_OP_TYPE::CHUNK_OP_READ, task);
+            }
+        });
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+
+    concurrentapply.Flush();
+    // reads are not flushed, wait for them
+    while (testnum.load() < 160000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(160000, testnum.load());
+    concurrentapply.Stop();
+}
+
+class CountApplyBatch : public ApplyBatch {
+ public:
+    CountApplyBatch() : pending(0), flushed(0), flushNum(0) {}
+
+    void Add() {
+        if (pending == 0) {
+            ApplyBatch::Register(this);
+        }
+        pending++;
+    }
+
+    void Flush() override {
+        flushed += pending;
+        pending = 0;
+        flushNum++;
+    }
+
+    int pending;
+    int flushed;
+    int flushNum;
+};
+
+TEST(ConcurrentApplyModule, BatchTest) {
+    ConcurrentApplyModule concurrentapply;
+    ConcurrentApplyOption opt{1, 128, 1, 1, ApplyQueueType::MUTEX, 16};
+    ASSERT_TRUE(concurrentapply.Init(opt));
+
+    // only one write thread uses the batch
+    CountApplyBatch batch;
+    std::atomic<bool> enabled(false);
+    std::atomic<int> flushedBeforeDelete(-1);
+    CountDownEvent blocked(1);
+    CountDownEvent resume(1);
+
+    // hold the write thread to get the following tasks queued
+    concurrentapply.Push(0, CHUNK_OP_TYPE::CHUNK_OP_WRITE,
+                         [&blocked, &resume]() {
+                             blocked.Signal();
+                             resume.Wait();
+                         });
+    blocked.Wait();
+    for (int i = 0; i < 100; i++) {
+        concurrentapply.Push(0, CHUNK_OP_TYPE::CHUNK_OP_WRITE,
+                             [&batch, &enabled]() {
+                                 enabled.store(ApplyBatch::Enabled());
+                                 batch.Add();
+                             });
+    }
+    // other ops see the writes before them applied
+    concurrentapply.Push(0, CHUNK_OP_TYPE::CHUNK_OP_DELETE,
+                         [&batch, &flushedBeforeDelete]() {
+                             flushedBeforeDelete.store(batch.flushed);
+                         });
+    concurrentapply.Push(0, CHUNK_OP_TYPE::CHUNK_OP_WRITE, [&batch]() {
+        batch.Add();
+    });
+    resume.Signal();
+
+    concurrentapply.Flush();
+    ASSERT_TRUE(enabled.load());
+    ASSERT_EQ(100, flushedBeforeDelete.load());
+    ASSERT_EQ(0, batch.pending);
+    ASSERT_EQ(101, batch.flushed);
+    // flushed at least once every 16 tasks
+    ASSERT_GE(batch.flushNum, 100 / 16 + 1);
+    concurrentapply.Stop();
+}
+
+TEST(ConcurrentApplyModule, BatchDisabledTest) {
+    ConcurrentApplyModule concurrentapply;
+    ConcurrentApplyOption opt{1, 1, 1, 1};
+    ASSERT_TRUE(concurrentapply.Init(opt));
+
+    std::atomic<bool> enabled(true);
+    concurrentapply.Push(0, CHUNK_OP_TYPE::CHUNK_OP_WRITE, [&enabled]() {
+        enabled.store(ApplyBatch::Enabled());
+    });
+    concurrentapply.Flush();
+    ASSERT_FALSE(enabled.load());
+    concurrentapply.Stop();
+}
+
+TEST(ConcurrentApplyModule, ReadWorkStealingTest) {
+    ConcurrentApplyModule concurrentapply;
+    ConcurrentApplyOption opt{1, 1, 4, 64, ApplyQueueType::MUTEX, 1, true};
+    ASSERT_TRUE(concurrentapply.Init(opt));
+
+    // reads of a hot chunk are spread over the idle read threads
+    std::atomic<int> readnum(0);
+    for (int i = 0; i < 200; i++) {
+        concurrentapply.Push(0, CHUNK_OP_TYPE::CHUNK_OP_READ, [&readnum]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            readnum.fetch_add(1);
+        });
+        concurrentapply.Push(0, CHUNK_OP_TYPE::CHUNK_OP_READ_SNAP,
+                             [&readnum]() {
+                                 readnum.fetch_add(1);
+                             });
+    }
+    // recovers are kept in order
+    std::vector<int> order;
+    for (int i = 0; i < 100; i++) {
+        concurrentapply.Push(0, CHUNK_OP_TYPE::CHUNK_OP_RECOVER,
+                             [&order, &readnum, i]() {
+                                 order.push_back(i);
+                                 readnum.fetch_add(1);
+                             });
+    }
+    while (readnum.load() < 500) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_GT(concurrentapply.ReadStealNum(), 0);
+    ASSERT_EQ(100, order.size());
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(i, order[i]);
+    }
+    concurrentapply.Stop();
+}
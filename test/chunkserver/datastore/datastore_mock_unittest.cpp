@@ -1455,6 +1455,148 @@ TEST_P(CSDataStore_test, WriteChunkTest13) {
     delete[] buf;
 }
 
+/**
+ * WriteChunkTest
+ * 开启 lazy clone metapage 后写clone chunk
+ * case1:写入区域之前未写过
+ * 预期结果1:写入数据，bitmap只在内存中更新，不写metapage
+ * case2:读取metapage
+ * 预期结果2:返回内存中的metapage，不读磁盘
+ * case3:SyncMetaPages
+ * 预期结果3:写回一次metapage，再次调用不再写
+ * case4:遍写整个chunk
+ * 预期结果4:写入数据，clone chunk转为普通chunk并立即写metapage
+ */
+TEST_P(CSDataStore_test, WriteChunkLazyMetaPageTest) {
+    DataStoreOptions options;
+    options.baseDir = baseDir;
+    options.chunkSize = chunksize_;
+    options.blockSize = blocksize_;
+    options.metaPageSize = metapagesize_;
+    options.locationLimit = kLocationLimit;
+    options.enableOdsyncWhenOpenChunkFile = true;
+    options.enableLazyCloneMetaPage = true;
+    dataStore = std::make_shared<CSDataStore>(lfs_, fpool_, options);
+    // initialize
+    FakeEnv();
+    EXPECT_TRUE(dataStore->Initialize());
+
+    ChunkID id = 3;
+    SequenceNum sn = 1;
+    SequenceNum correctedSn = 0;
+    CSChunkInfo info;
+    // 创建 clone chunk
+    {
+        char chunk3MetaPage[metapagesize_];  // NOLINT(runtime/arrays)
+        memset(chunk3MetaPage, 0, sizeof(chunk3MetaPage));
+        shared_ptr<Bitmap> bitmap =
+            make_shared<Bitmap>(chunksize_ / blocksize_);
+        FakeEncodeChunk(chunk3MetaPage, correctedSn, sn, bitmap, location);
+        string chunk3Path = string(baseDir) + "/" +
+                            FileNameOperator::GenerateChunkFileName(id);
+        EXPECT_CALL(*lfs_, FileExists(chunk3Path))
+            .WillOnce(Return(false));
+        EXPECT_CALL(*fpool_, GetFileImpl(chunk3Path, NotNull()))
+            .WillOnce(Return(0));
+        EXPECT_CALL(*lfs_, Open(chunk3Path, _))
+            .Times(1)
+            .WillOnce(Return(4));
+        EXPECT_CALL(*lfs_, Read(4, NotNull(), 0, metapagesize_))
+            .WillOnce(DoAll(SetArrayArgument<1>(chunk3MetaPage,
+                            chunk3MetaPage + metapagesize_),
+                            Return(metapagesize_)));
+        EXPECT_EQ(CSErrorCode::Success,
+                  dataStore->CreateCloneChunk(id,
+                                              sn,
+                                              correctedSn,
+                                              chunksize_,
+                                              location));
+    }
+
+    // case1:写入区域之前未写过，不写metapage
+    {
+        off_t offset = blocksize_;
+        size_t length = 2 * blocksize_;
+        std::unique_ptr<char[]> buf(new char[length]);
+        EXPECT_CALL(*lfs_, Write(4, Matcher<butil::IOBuf>(_),
+                                 metapagesize_ + offset, length))
+            .Times(1);
+        EXPECT_CALL(*lfs_,
+                    Write(4, Matcher<const char*>(NotNull()), 0, metapagesize_))
+            .Times(0);
+
+        ASSERT_EQ(CSErrorCode::Success,
+                  dataStore->WriteChunk(id,
+                                        sn,
+                                        buf.get(),
+                                        offset,
+                                        length,
+                                        nullptr));
+        ASSERT_EQ(CSErrorCode::Success, dataStore->GetChunkInfo(id, &info));
+        ASSERT_EQ(true, info.isClone);
+        ASSERT_EQ(1, info.bitmap->NextSetBit(0));
+        ASSERT_EQ(3, info.bitmap->NextClearBit(1));
+        ASSERT_EQ(Bitmap::NO_POS, info.bitmap->NextSetBit(3));
+    }
+
+    // case2:读取内存中的metapage
+    {
+        std::unique_ptr<char[]> buf(new char[metapagesize_]);
+        EXPECT_CALL(*lfs_, Read(4, NotNull(), 0, metapagesize_))
+            .Times(0);
+        ASSERT_EQ(CSErrorCode::Success,
+                  dataStore->ReadChunkMetaPage(id, sn, buf.get()));
+        ChunkFileMetaPage metaPage;
+        ASSERT_EQ(CSErrorCode::Success, metaPage.decode(buf.get()));
+        ASSERT_EQ(location, metaPage.location);
+        ASSERT_EQ(1, metaPage.bitmap->NextSetBit(0));
+        ASSERT_EQ(3, metaPage.bitmap->NextClearBit(1));
+    }
+
+    // case3:快照前写回metapage
+    {
+        EXPECT_CALL(*lfs_,
+                    Write(4, Matcher<const char*>(NotNull()), 0, metapagesize_))
+            .Times(1);
+        ASSERT_EQ(CSErrorCode::Success, dataStore->SyncMetaPages());
+        ASSERT_EQ(CSErrorCode::Success, dataStore->SyncMetaPages());
+    }
+
+    // case4:遍写整个chunk，转为普通chunk
+    {
+        off_t offset = 0;
+        size_t length = chunksize_;
+        std::unique_ptr<char[]> buf(new char[length]);
+        EXPECT_CALL(*lfs_, Write(4, Matcher<butil::IOBuf>(_),
+                                 offset + metapagesize_, length))
+            .Times(1);
+        EXPECT_CALL(*lfs_,
+                    Write(4, Matcher<const char*>(NotNull()), 0, metapagesize_))
+            .Times(1);
+
+        ASSERT_EQ(CSErrorCode::Success,
+                  dataStore->WriteChunk(id,
+                                        sn,
+                                        buf.get(),
+                                        offset,
+                                        length,
+                                        nullptr));
+        ASSERT_EQ(CSErrorCode::Success, dataStore->GetChunkInfo(id, &info));
+        ASSERT_EQ(false, info.isClone);
+        ASSERT_EQ(nullptr, info.bitmap);
+        ASSERT_EQ(CSErrorCode::Success, dataStore->SyncMetaPages());
+    }
+
+    EXPECT_CALL(*lfs_, Close(1))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(2))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(3))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(4))
+        .Times(1);
+}
+
 /**
  * WriteChunkTest
  * 写clone chunk，模拟恢复
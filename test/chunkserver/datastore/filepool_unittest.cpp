@@ -26,6 +26,7 @@
 #include <gtest/gtest.h>
 #include <json/json.h>
 
+#include <chrono>  // NOLINT
 #include <climits>
 #include <memory>
 #include <thread>
@@ -573,6 +574,107 @@ TEST_P(CSFilePool_test, CleanChunkTest) {
     }
 }
 
+TEST_P(CSFilePool_test, MultiThreadCleanChunkTest) {
+    std::string filePool = "./cspooltest/filePool.meta";
+
+    FilePoolOptions cfop;
+    cfop.fileSize = 4096;
+    cfop.metaPageSize = 4096;
+    cfop.blockSize = 4096;
+    memcpy(cfop.metaPath, filePool.c_str(), filePool.size());
+    cfop.needClean = true;
+    cfop.iops4clean = 0;  // no throttle
+    cfop.cleanThreadNum = 4;
+    cfop.cleanByZeroRange = GetParam();
+
+    ASSERT_TRUE(chunkFilePoolPtr_->Initialize(cfop));
+    ASSERT_TRUE(chunkFilePoolPtr_->StartCleaning());
+    for (int i = 0; i < 100; i++) {
+        if (chunkFilePoolPtr_->GetState().dirtyChunksLeft == 0) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    ASSERT_TRUE(chunkFilePoolPtr_->StopCleaning());
+
+    auto currentStat = chunkFilePoolPtr_->GetState();
+    ASSERT_EQ(0, currentStat.dirtyChunksLeft);
+    ASSERT_EQ(100, currentStat.cleanChunksLeft);
+    ASSERT_EQ(50, currentStat.cleanedChunks);
+    ASSERT_EQ(100, chunkFilePoolPtr_->Size());
+
+    // all chunks are zeroed
+    char metapage[4096], data[8192];
+    memset(metapage, '2', sizeof(metapage));
+    for (int i = 1; i <= 100; i++) {
+        std::string filename = "test" + std::to_string(i);
+        ASSERT_EQ(0, chunkFilePoolPtr_->GetFile(filename, metapage, true));
+
+        int fd = fsptr->Open(filename, O_RDWR);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(8192, fsptr->Read(fd, data, 0, 8192));
+        for (int j = 4096; j < 8192; j++) ASSERT_EQ(data[j], '\0');
+        ASSERT_EQ(0, fsptr->Close(fd));
+        ASSERT_EQ(0, fsptr->Delete(filename));
+    }
+}
+
+TEST_P(CSFilePool_test, FormatChunkTest) {
+    std::string filePool = "./cspooltest/filePool.meta";
+
+    FilePoolOptions cfop;
+    cfop.fileSize = 4096;
+    cfop.metaPageSize = 4096;
+    cfop.blockSize = 4096;
+    memcpy(cfop.metaPath, filePool.c_str(), filePool.size());
+    cfop.iops4clean = 0;  // no throttle
+    cfop.formatLowWatermark = 90;
+    cfop.formatHighWatermark = 120;
+
+    // CASE 1: the pool is above the low watermark, nothing happen
+    ASSERT_TRUE(chunkFilePoolPtr_->Initialize(cfop));
+    ASSERT_TRUE(chunkFilePoolPtr_->StartCleaning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    ASSERT_EQ(100, chunkFilePoolPtr_->Size());
+    ASSERT_EQ(0, chunkFilePoolPtr_->GetState().formattedChunks);
+
+    // CASE 2: drain the pool under the low watermark, it's refilled to
+    //         the high watermark
+    char metapage[4096];
+    memset(metapage, '2', sizeof(metapage));
+    for (int i = 1; i <= 20; i++) {
+        std::string filename = "./cspooltest/test" + std::to_string(i);
+        ASSERT_EQ(0, chunkFilePoolPtr_->GetFile(filename, metapage));
+    }
+    for (int i = 0; i < 100; i++) {
+        if (chunkFilePoolPtr_->Size() >= 120) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    ASSERT_TRUE(chunkFilePoolPtr_->StopCleaning());
+
+    auto currentStat = chunkFilePoolPtr_->GetState();
+    ASSERT_EQ(120, chunkFilePoolPtr_->Size());
+    ASSERT_EQ(40, currentStat.formattedChunks);
+    ASSERT_EQ(30, currentStat.dirtyChunksLeft);
+    ASSERT_EQ(90, currentStat.cleanChunksLeft);
+
+    std::vector<std::string> files;
+    ASSERT_EQ(0, fsptr->List(FILEPOOL_DIR, &files));
+    ASSERT_EQ(120, files.size());
+
+    // CASE 3: the formatted chunks are kept after restart
+    chunkFilePoolPtr_->UnInitialize();
+    ASSERT_TRUE(chunkFilePoolPtr_->Initialize(cfop));
+    ASSERT_EQ(120, chunkFilePoolPtr_->Size());
+    for (int i = 21; i <= 120; i++) {
+        std::string filename = "./cspooltest/test" + std::to_string(i);
+        ASSERT_EQ(0, chunkFilePoolPtr_->GetFile(filename, metapage, true));
+    }
+}
+
 INSTANTIATE_TEST_CASE_P(CSFilePoolTest,
                         CSFilePool_test,
                         ::testing::Values(false, true));
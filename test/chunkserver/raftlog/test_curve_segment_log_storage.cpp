@@ -29,6 +29,7 @@
 #include <gtest/gtest.h>
 #include <braft/log.h>
 #include <fcntl.h>
+#include <unistd.h>
 
 #include <cstdio>
 #include <memory>
@@ -551,6 +552,47 @@ TEST_F(CurveSegmentLogStorageTest, basic_test_without_direct) {
     ASSERT_EQ(countWalSegmentFile(), storage->GetStatus().walSegmentFileCount);
 }
 
+TEST_F(CurveSegmentLogStorageTest, prepared_segments) {
+    FLAGS_walPreparedSegmentNum = 2;
+    EXPECT_CALL(*file_pool, GetFileImpl(_, _))
+        .WillRepeatedly(Invoke([](const std::string& path, const char*) {
+            return prepare_segment(path);
+        }));
+    auto storage = std::make_shared<CurveSegmentLogStorage>(kRaftLogDataDir,
+            true, file_pool);
+    ASSERT_EQ(0, storage->init(new braft::ConfigurationManager()));
+    while (storage->prepared_segment_num() < 2) {
+        usleep(1000);
+    }
+
+    // rolling over segments consumes the prepared files and refills them
+    append_entries(storage, 1000, 5);
+    read_entries(storage, 0, 5000);
+    ASSERT_EQ(2, storage->segments().size());
+    ASSERT_EQ(countWalSegmentFile(), storage->GetStatus().walSegmentFileCount);
+    while (storage->prepared_segment_num() < 2) {
+        usleep(1000);
+    }
+
+    // prepared files are returned to the file pool on destruction
+    std::string countPrepared = std::string("ls ") + kRaftLogDataDir +
+                                " | grep -c " CURVE_SEGMENT_PREPARED_PREFIX;
+    ASSERT_EQ("2\n", execShell(countPrepared));
+    storage = nullptr;
+    ASSERT_EQ("0\n", execShell(countPrepared));
+
+    // and on reload after crash
+    FLAGS_walPreparedSegmentNum = 0;
+    std::string path = kRaftLogDataDir;
+    butil::string_appendf(&path, "/" CURVE_SEGMENT_PREPARED_PATTERN, 100UL);
+    ASSERT_EQ(0, prepare_segment(path));
+    storage = std::make_shared<CurveSegmentLogStorage>(kRaftLogDataDir,
+            true, file_pool);
+    ASSERT_EQ(0, storage->init(new braft::ConfigurationManager()));
+    ASSERT_EQ("0\n", execShell(countPrepared));
+    ASSERT_EQ(storage->last_log_index(), 5000);
+    read_entries(storage, 0, 5000);
+}
 
 }  // namespace chunkserver
 }  // namespace curve
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/chunkserver/raftlog/wal_group_commit.h"
+
+namespace curve {
+namespace chunkserver {
+
+const char kGroupCommitDir[] = "./wal_group_commit_test";
+
+class WalGroupCommitTest : public testing::Test {
+ protected:
+    void SetUp() {
+        std::string cmd = std::string("mkdir -p ") + kGroupCommitDir;
+        ASSERT_EQ(0, ::system(cmd.c_str()));
+        for (int i = 0; i < 4; ++i) {
+            std::string path = std::string(kGroupCommitDir) + "/segment" +
+                               std::to_string(i);
+            int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            ASSERT_GE(fd, 0);
+            fds_.push_back(fd);
+        }
+    }
+    void TearDown() {
+        for (auto fd : fds_) {
+            ::close(fd);
+        }
+        std::string cmd = std::string("rm -rf ") + kGroupCommitDir;
+        ::system(cmd.c_str());
+    }
+
+    std::vector<int> fds_;
+};
+
+TEST_F(WalGroupCommitTest, ConcurrentSyncTest) {
+    auto committer = WalGroupCommitter::GetInstance(fds_[0]);
+    ASSERT_NE(nullptr, committer);
+    // files on the same disk share one committer
+    ASSERT_EQ(committer.get(), WalGroupCommitter::GetInstance(fds_[1]).get());
+    ASSERT_EQ(nullptr, WalGroupCommitter::GetInstance(-1));
+
+    std::vector<std::thread> threads;
+    std::vector<int> results(16, -1);
+    for (int i = 0; i < 16; ++i) {
+        threads.emplace_back([&, i]() {
+            int fd = fds_[i % fds_.size()];
+            std::string data(4096, 'a' + i);
+            ASSERT_EQ(4096, ::pwrite(fd, data.data(), data.size(), i * 4096));
+            results[i] = committer->Sync(fd);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (auto result : results) {
+        ASSERT_EQ(0, result);
+    }
+}
+
+TEST_F(WalGroupCommitTest, SyncErrorTest) {
+    WalGroupCommitter committer("wal_group_commit_error_test");
+    ASSERT_EQ(0, committer.Start());
+    ASSERT_EQ(0, committer.Sync(fds_[0]));
+    ASSERT_EQ(-EBADF, committer.Sync(-1));
+    committer.Stop();
+    // syncs after stop fall back to fdatasync
+    ASSERT_EQ(0, committer.Sync(fds_[0]));
+}
+
+TEST_F(WalGroupCommitTest, SyncErrorOfOneFdInBatch) {
+    uint32_t maxDelayUs = FLAGS_walGroupCommitMaxDelayUs;
+    uint32_t maxBatch = FLAGS_walGroupCommitMaxBatch;
+    // the batch is committed once all syncs have joined it
+    FLAGS_walGroupCommitMaxDelayUs = 10 * 1000 * 1000;
+    FLAGS_walGroupCommitMaxBatch = fds_.size() + 1;
+    WalGroupCommitter committer("wal_group_commit_batch_error_test");
+    ASSERT_EQ(0, committer.Start());
+
+    std::vector<std::thread> threads;
+    std::vector<int> results(fds_.size() + 1, 1);
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            int fd = i < fds_.size() ? fds_[i] : -1;
+            results[i] = committer.Sync(fd);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (size_t i = 0; i < fds_.size(); ++i) {
+        ASSERT_EQ(0, results[i]);
+    }
+    ASSERT_EQ(-EBADF, results.back());
+    committer.Stop();
+    FLAGS_walGroupCommitMaxDelayUs = maxDelayUs;
+    FLAGS_walGroupCommitMaxBatch = maxBatch;
+}
+
+}  // namespace chunkserver
+}  // namespace curve
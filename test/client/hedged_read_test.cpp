@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>  // NOLINT
+#include <memory>
+#include <random>
+#include <thread>  // NOLINT
+
+#include "src/client/hedged_read.h"
+#include "src/client/request_sender.h"
+#include "src/common/concurrent/count_down_event.h"
+#include "test/client/mock/mock_request_context.h"
+
+namespace curve {
+namespace client {
+
+TEST(LatencyQuantileTest, EmptyTest) {
+    LatencyQuantile quantile;
+    ASSERT_EQ(0, quantile.Get());
+
+    quantile.Add(1000);
+    ASSERT_EQ(1000, quantile.Get());
+}
+
+TEST(LatencyQuantileTest, ConvergeTest) {
+    LatencyQuantile quantile;
+    std::mt19937 gen(1);
+    // p95 of a uniform distribution in [0, 10000] is 9500
+    std::uniform_int_distribution<int64_t> dist(0, 10000);
+
+    for (int i = 0; i < 100000; ++i) {
+        quantile.Add(dist(gen));
+    }
+    ASSERT_GT(quantile.Get(), 9000);
+    ASSERT_LT(quantile.Get(), 9900);
+
+    // follows the latency when it drops
+    for (int i = 0; i < 100000; ++i) {
+        quantile.Add(dist(gen) / 10);
+    }
+    ASSERT_GT(quantile.Get(), 850);
+    ASSERT_LT(quantile.Get(), 1000);
+}
+
+TEST(HedgedReadTest, FollowerWinTest) {
+    butil::EndPoint endpoint;
+    butil::str2endpoint("127.0.0.1:9110", &endpoint);
+    auto leader = std::make_shared<RequestSender>(1, endpoint);
+    auto follower = std::make_shared<RequestSender>(2, endpoint);
+
+    curve::common::CountDownEvent cond(1);
+    FakeRequestContext reqCtx;
+    FakeRequestClosure done(&cond, &reqCtx);
+    HedgedRead hedgedRead(nullptr, leader, ChunkIDInfo(1, 1, 1), 0, 4, 1,
+                          &done);
+
+    // a failed follower read waits for the leader
+    {
+        brpc::Controller cntl;
+        curve::chunkserver::ChunkResponse response;
+        response.set_status(
+            curve::chunkserver::CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN);  // NOLINT
+        hedgedRead.OnFollowerDone(follower, &cntl, response);
+        ASSERT_EQ(-1, done.GetErrorCode());
+        ASSERT_EQ(0U, reqCtx.trace_.rpcUs);
+    }
+
+    // the follower wins, the read is traced with the time it takes
+    {
+        brpc::Controller cntl;
+        cntl.response_attachment().append("read");
+        curve::chunkserver::ChunkResponse response;
+        response.set_status(
+            curve::chunkserver::CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        hedgedRead.OnFollowerDone(follower, &cntl, response);
+        cond.Wait();
+        ASSERT_EQ(0, done.GetErrorCode());
+        ASSERT_EQ("read", reqCtx.readData_.to_string());
+        ASSERT_GE(reqCtx.trace_.rpcUs, 1000U);
+    }
+}
+
+}  // namespace client
+}  // namespace curve
@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <iostream>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/client/inflight_controller.h"
+#include "src/common/timeutility.h"
+
+DEFINE_uint64(ioNum, 1000000, "total ios of each round");
+DEFINE_uint64(maxInflight, 128, "max inflight tokens");
+
+using curve::client::InflightControl;
+using curve::common::TimeUtility;
+
+namespace {
+
+// the mutex/condvar implementation replaced by the lock-free one
+class MutexInflightControl {
+ public:
+    void SetMaxInflightNum(uint64_t maxInflightNum) {
+        maxInflightNum_ = maxInflightNum;
+    }
+
+    void GetInflightToken() {
+        {
+            std::unique_lock<std::mutex> lk(inflightComeBackmtx_);
+            inflightComeBackcv_.wait(lk, [this]() {
+                return curInflightIONum_ < maxInflightNum_;
+            });
+        }
+        curInflightIONum_.fetch_add(1, std::memory_order_release);
+    }
+
+    void ReleaseInflightToken() {
+        std::unique_lock<std::mutex> lk(inflightComeBackmtx_);
+        std::unique_lock<std::mutex> lk2(inflightAllComeBackmtx_);
+        const auto cnt =
+            curInflightIONum_.fetch_sub(1, std::memory_order_acq_rel);
+        if (cnt == 1) {
+            inflightAllComeBackcv_.notify_all();
+        }
+        inflightComeBackcv_.notify_one();
+    }
+
+ private:
+    uint64_t maxInflightNum_ = 0;
+    std::atomic<uint64_t> curInflightIONum_{0};
+    std::mutex inflightComeBackmtx_;
+    std::condition_variable inflightComeBackcv_;
+    std::mutex inflightAllComeBackmtx_;
+    std::condition_variable inflightAllComeBackcv_;
+};
+
+// iops of submitters taking a token for each io and completers returning
+// them, like the io path does with the rpc tokens
+template <typename ControlT>
+double Measure(int submitterNum, int completerNum) {
+    ControlT control;
+    control.SetMaxInflightNum(FLAGS_maxInflight);
+    const uint64_t perSubmitter = FLAGS_ioNum / submitterNum;
+    const uint64_t total = perSubmitter * submitterNum;
+    std::atomic<uint64_t> issued(0);
+    std::atomic<uint64_t> completed(0);
+
+    const uint64_t start = TimeUtility::GetTimeofDayUs();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < submitterNum; ++i) {
+        threads.emplace_back([&]() {
+            for (uint64_t j = 0; j < perSubmitter; ++j) {
+                control.GetInflightToken();
+                issued.fetch_add(1, std::memory_order_release);
+            }
+        });
+    }
+    for (int i = 0; i < completerNum; ++i) {
+        threads.emplace_back([&]() {
+            uint64_t done = completed.load(std::memory_order_relaxed);
+            while (done < total) {
+                if (done < issued.load(std::memory_order_acquire) &&
+                    completed.compare_exchange_weak(done, done + 1)) {
+                    control.ReleaseInflightToken();
+                }
+                done = completed.load(std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    const uint64_t cost = TimeUtility::GetTimeofDayUs() - start;
+    return static_cast<double>(total) * 1000000 / cost;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+
+    for (int submitterNum : {1, 2, 4, 8, 16}) {
+        for (int completerNum : {1, 4}) {
+            double mutexIops =
+                Measure<MutexInflightControl>(submitterNum, completerNum);
+            double atomicIops =
+                Measure<InflightControl>(submitterNum, completerNum);
+            std::cout << "submitters: " << submitterNum
+                      << ", completers: " << completerNum
+                      << ", mutex: " << mutexIops << " iops"
+                      << ", lock-free: " << atomicIops << " iops"
+                      << std::endl;
+        }
+    }
+    return 0;
+}
@@ -20,15 +20,18 @@
  * Author: tongguangxun
  */
 
+#include <bthread/bthread.h>
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>              //NOLINT
 #include <condition_variable>  //NOLINT
 #include <mutex>               // NOLINT
 #include <string>
 #include <thread>  //NOLINT
+#include <vector>
 
 #include "src/client/client_common.h"
 #include "src/client/client_config.h"
@@ -226,6 +229,50 @@ TEST(InflightRPCTest, FileCloseTest) {
     t2.joinable() ? t2.join() : void();
 }
 
+TEST(InflightRPCTest, TokenLimitTest) {
+    const uint64_t maxInflight = 4;
+    InflightControl control;
+    control.SetMaxInflightNum(maxInflight);
+
+    std::atomic<uint64_t> holding(0);
+    std::atomic<bool> exceeded(false);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 16; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 10000; ++j) {
+                control.GetInflightToken();
+                if (holding.fetch_add(1) + 1 > maxInflight) {
+                    exceeded = true;
+                }
+                holding.fetch_sub(1);
+                control.ReleaseInflightToken();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // tokens never exceed the limit, and waiters are all woken up
+    ASSERT_FALSE(exceeded);
+    ASSERT_EQ(0, control.GetCurrentInflightNum());
+
+    // wait from a bthread
+    control.GetInflightToken();
+    bthread_t tid;
+    ASSERT_EQ(0, bthread_start_background(
+                     &tid, nullptr,
+                     [](void* arg) -> void* {
+                         static_cast<InflightControl*>(arg)
+                             ->WaitInflightAllComeBack();
+                         return nullptr;
+                     },
+                     &control));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    control.ReleaseInflightToken();
+    ASSERT_EQ(0, bthread_join(tid, nullptr));
+}
+
 }  // namespace client
 }  // namespace curve
 
@@ -699,6 +699,40 @@ TEST_F(IOTrackerSplitorTest, ManagerStartRead) {
     delete[] data;
 }
 
+// the sync read copies each response to the user buffer as it comes back
+TEST_F(IOTrackerSplitorTest, ManagerStartReadOutOfOrder) {
+    MockRequestScheduler* mockschuler = new MockRequestScheduler;
+    EXPECT_CALL(*mockschuler, ScheduleRequest(_))
+        .WillOnce(Invoke([](const MockRequestScheduler::REQ& reqlist) {
+            for (auto iter = reqlist.rbegin(); iter != reqlist.rend();
+                 ++iter) {
+                RequestContext* req = *iter;
+                char c = 'a' + (iter - reqlist.rbegin());
+                req->readData_.append(std::string(req->rawlength_, c));
+                req->done_->SetFailed(0);
+                req->done_->Run();
+            }
+            return 0;
+        }));
+
+    auto ioctxmana = fileinstance_->GetIOManager4File();
+    ioctxmana->SetRequestScheduler(mockschuler);
+
+    uint64_t offset = 4 * 1024 * 1024 - 64 * 1024;
+    uint64_t length = 192 * 1024;
+    std::unique_ptr<char[]> data(new char[length]);
+    ASSERT_EQ(length,
+              ioctxmana->Read(data.get(), offset, length, mdsclient_.get()));
+
+    // three sub-requests answered from the last one
+    ASSERT_EQ('c', data[0]);
+    ASSERT_EQ('c', data[64 * 1024 - 1]);
+    ASSERT_EQ('b', data[64 * 1024]);
+    ASSERT_EQ('b', data[128 * 1024 - 1]);
+    ASSERT_EQ('a', data[128 * 1024]);
+    ASSERT_EQ('a', data[length - 1]);
+}
+
 TEST_F(IOTrackerSplitorTest, ManagerStartWrite) {
     MockRequestScheduler* mockschuler = new MockRequestScheduler;
     mockschuler->DelegateToFake();
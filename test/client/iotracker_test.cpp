@@ -23,16 +23,23 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>  // NOLINT
 #include <string>
 #include <thread>  // NOLINT
+#include <vector>
 
+#include "src/client/read_cache.h"
+#include "src/client/request_context.h"
+#include "src/client/request_scheduler.h"
+#include "src/client/splitor.h"
 #include "test/client/mock/mock_mdsclient.h"
 #include "test/client/mock/mock_meta_cache.h"
 
 namespace curve {
 namespace client {
 
+using ::curve::chunkserver::CHUNK_OP_STATUS;
 using ::testing::AllOf;
 using ::testing::Ge;
 using ::testing::Le;
@@ -186,5 +193,263 @@ TEST_F(IOTrackerTest, TestDiscardMultiSegment) {
     ASSERT_EQ(Bitmap::NO_POS, bitmap3.NextSetBit(0));
 }
 
+class TraceLogSink : public google::LogSink {
+ public:
+    void send(google::LogSeverity severity, const char* fullFilename,
+              const char* baseFilename, int line, const struct ::tm* tmTime,
+              const char* message, size_t messageLen) override {
+        if (std::string(message, messageLen).find("IO trace") == 0) {
+            count++;
+        }
+    }
+
+    std::atomic<int> count{0};
+};
+
+TEST_F(IOTrackerTest, TestDumpTraceBySampleRate) {
+    TraceLogSink sink;
+    google::AddLogSink(&sink);
+
+    EXPECT_CALL(*mockMDSClient_, DeAllocateSegment(_, _)).Times(0);
+    auto discard = [this]() {
+        IOTracker iotracker(nullptr, mockMetaCache_.get(), nullptr);
+        iotracker.StartDiscard(50 * GiB, 4 * KiB, mockMDSClient_.get(),
+                               &fileInfo_, discardTaskManager_.get());
+        ASSERT_EQ(0, iotracker.Wait());
+    };
+
+    // disabled
+    IOTraceOption traceOpt;
+    IOTracker::InitIOTraceOption(traceOpt);
+    discard();
+    discard();
+    ASSERT_EQ(0, sink.count);
+
+    // every IO is sampled
+    traceOpt.sampleRate = 1;
+    IOTracker::InitIOTraceOption(traceOpt);
+    discard();
+    discard();
+    ASSERT_EQ(2, sink.count);
+
+    // one in every two IOs is sampled, the IO ids are consecutive
+    sink.count = 0;
+    traceOpt.sampleRate = 2;
+    IOTracker::InitIOTraceOption(traceOpt);
+    discard();
+    discard();
+    ASSERT_EQ(1, sink.count);
+
+    IOTracker::InitIOTraceOption(IOTraceOption());
+    google::RemoveLogSink(&sink);
+}
+
+// keeps the read requests, the tests answer them in any order
+class FakeReadScheduler : public RequestScheduler {
+ public:
+    int ScheduleRequest(const std::vector<RequestContext*>& reqs) override {
+        for (auto* req : reqs) {
+            // the same as RequestScheduler, fake requests of unallocated
+            // chunks are done at once
+            if (!req->idinfo_.chunkExist) {
+                req->done_->Run();
+                continue;
+            }
+            requests.push_back(req);
+        }
+        return 0;
+    }
+
+    std::vector<RequestContext*> requests;
+};
+
+class FakeIOManager : public IOManager {
+ public:
+    void HandleAsyncIOResponse(IOTracker* iotracker) override {
+        delete iotracker;
+    }
+};
+
+class FakeSnapCloneClosure : public SnapCloneClosure {
+ public:
+    void Run() override {
+        done = true;
+    }
+
+    bool done = false;
+};
+
+class IOTrackerReadTest : public IOTrackerTest {
+ public:
+    void SetUp() override {
+        IOTrackerTest::SetUp();
+        Splitor::Init(IOSplitOption());
+        fileMetric_.reset(new FileMetric("/IOTrackerReadTest"));
+
+        // the read of the tests covers the end of chunk 0 and chunk 1
+        mockMetaCache_->UpdateChunkInfoByIndex(0, ChunkIDInfo(1, 1, 1));
+        mockMetaCache_->UpdateChunkInfoByIndex(1, ChunkIDInfo(2, 1, 1));
+    }
+
+    // answers a sub-request, the data is filled with the given char
+    static void Reply(RequestContext* req, char c, int errcode = 0) {
+        if (errcode == 0) {
+            req->readData_.append(std::string(req->rawlength_, c));
+        }
+        req->done_->SetFailed(errcode);
+        req->done_->Run();
+    }
+
+ protected:
+    FakeReadScheduler scheduler_;
+    std::unique_ptr<FileMetric> fileMetric_;
+    const uint64_t offset_ = 16 * MiB - 64 * KiB;
+    const uint64_t length_ = 192 * KiB;
+};
+
+TEST_F(IOTrackerReadTest, TestReadRawBufferOutOfOrder) {
+    IOTracker iotracker(nullptr, mockMetaCache_.get(), &scheduler_,
+                        fileMetric_.get());
+    iotracker.SetUserDataType(UserDataType::RawBuffer);
+    std::vector<char> buf(length_, 0);
+
+    iotracker.StartRead(buf.data(), offset_, length_, mockMDSClient_.get(),
+                        &fileInfo_, nullptr);
+    ASSERT_EQ(3, scheduler_.requests.size());
+    ASSERT_EQ(1, scheduler_.requests[0]->idinfo_.cid_);
+    ASSERT_EQ(2, scheduler_.requests[1]->idinfo_.cid_);
+    ASSERT_EQ(2, scheduler_.requests[2]->idinfo_.cid_);
+
+    // each response is copied to the user buffer as it comes back in
+    // its rpc thread, the last one first
+    std::vector<RequestContext*> reqs = scheduler_.requests;
+    for (int i = reqs.size() - 1; i >= 0; --i) {
+        RequestContext* req = reqs[i];
+        std::thread rpc([req, i]() { Reply(req, 'a' + i); });
+        rpc.join();
+    }
+    ASSERT_EQ(length_, iotracker.Wait());
+
+    for (uint64_t i = 0; i < length_; ++i) {
+        ASSERT_EQ('a' + i / (64 * KiB), buf[i]) << "offset " << i;
+    }
+}
+
+TEST_F(IOTrackerReadTest, TestReadRawBufferSubRequestFailed) {
+    IOTracker iotracker(nullptr, mockMetaCache_.get(), &scheduler_,
+                        fileMetric_.get());
+    iotracker.SetUserDataType(UserDataType::RawBuffer);
+    std::vector<char> buf(length_, 0);
+
+    iotracker.StartRead(buf.data(), offset_, length_, mockMDSClient_.get(),
+                        &fileInfo_, nullptr);
+    ASSERT_EQ(3, scheduler_.requests.size());
+
+    std::vector<RequestContext*> reqs = scheduler_.requests;
+    Reply(reqs[2], 'c');
+    Reply(reqs[1], 'b', CHUNK_OP_STATUS::CHUNK_OP_STATUS_DISK_FAIL);
+    Reply(reqs[0], 'a');
+    ASSERT_EQ(-LIBCURVE_ERROR::DISK_FAIL, iotracker.Wait());
+
+    // the data of the failed sub-request isn't copied
+    ASSERT_EQ('a', buf[0]);
+    ASSERT_EQ(0, buf[64 * KiB]);
+    ASSERT_EQ('c', buf[length_ - 1]);
+}
+
+TEST_F(IOTrackerReadTest, TestReadRawBufferUnallocatedChunk) {
+    ChunkIDInfo unallocated(0, 0, 0);
+    unallocated.chunkExist = false;
+    mockMetaCache_->UpdateChunkInfoByIndex(1, unallocated);
+
+    IOTracker iotracker(nullptr, mockMetaCache_.get(), &scheduler_,
+                        fileMetric_.get());
+    iotracker.SetUserDataType(UserDataType::RawBuffer);
+    std::vector<char> buf(length_, 'x');
+
+    iotracker.StartRead(buf.data(), offset_, length_, mockMDSClient_.get(),
+                        &fileInfo_, nullptr);
+
+    // only chunk 0 goes to chunkservers
+    ASSERT_EQ(1, scheduler_.requests.size());
+    Reply(scheduler_.requests[0], 'a');
+    ASSERT_EQ(length_, iotracker.Wait());
+
+    for (uint64_t i = 0; i < 64 * KiB; ++i) {
+        ASSERT_EQ('a', buf[i]) << "offset " << i;
+    }
+    for (uint64_t i = 64 * KiB; i < length_; ++i) {
+        ASSERT_EQ(0, buf[i]) << "offset " << i;
+    }
+}
+
+TEST_F(IOTrackerReadTest, TestReadSnapRawBuffer) {
+    FakeIOManager iomanager;
+    FakeSnapCloneClosure scc;
+    std::vector<char> buf(length_, 0);
+
+    // deleted by the iomanager once it's done
+    IOTracker* iotracker =
+        new IOTracker(&iomanager, mockMetaCache_.get(), &scheduler_);
+    iotracker->SetUserDataType(UserDataType::RawBuffer);
+    iotracker->ReadSnapChunk(ChunkIDInfo(1, 1, 1), 1, 0, length_,
+                             buf.data(), &scc);
+    ASSERT_EQ(3, scheduler_.requests.size());
+
+    std::vector<RequestContext*> reqs = scheduler_.requests;
+    Reply(reqs[1], 'b');
+    Reply(reqs[2], 'c');
+    ASSERT_FALSE(scc.done);
+    Reply(reqs[0], 'a');
+
+    ASSERT_TRUE(scc.done);
+    ASSERT_EQ(length_, scc.GetRetCode());
+    for (uint64_t i = 0; i < length_; ++i) {
+        ASSERT_EQ('a' + i / (64 * KiB), buf[i]) << "offset " << i;
+    }
+}
+
+// IOManager4File::Read uses raw buffers, and the IOBufs of the whole IO
+// when the read cache is on
+TEST_F(IOTrackerReadTest, TestReadRawBufferWithReadCache) {
+    ReadCacheOption opt;
+    opt.enable = true;
+    ReadCache readCache;
+    ASSERT_TRUE(readCache.Init(opt, "/IOTrackerReadTest",
+                               &fileMetric_->readCacheMetric));
+
+    IOTracker iotracker(nullptr, mockMetaCache_.get(), &scheduler_,
+                        fileMetric_.get());
+    iotracker.SetUserDataType(UserDataType::RawBuffer);
+    iotracker.SetReadCache(&readCache);
+    std::vector<char> buf(length_, 0);
+
+    iotracker.StartRead(buf.data(), offset_, length_, mockMDSClient_.get(),
+                        &fileInfo_, nullptr);
+    ASSERT_EQ(3, scheduler_.requests.size());
+
+    std::vector<RequestContext*> reqs = scheduler_.requests;
+    Reply(reqs[2], 'c');
+    Reply(reqs[0], 'a');
+    Reply(reqs[1], 'b');
+    ASSERT_EQ(length_, iotracker.Wait());
+    for (uint64_t i = 0; i < length_; ++i) {
+        ASSERT_EQ('a' + i / (64 * KiB), buf[i]) << "offset " << i;
+    }
+
+    // the data is cached, the same read doesn't go to chunkservers
+    scheduler_.requests.clear();
+    std::vector<char> cached(length_, 0);
+    IOTracker hit(nullptr, mockMetaCache_.get(), &scheduler_,
+                  fileMetric_.get());
+    hit.SetUserDataType(UserDataType::RawBuffer);
+    hit.SetReadCache(&readCache);
+    hit.StartRead(cached.data(), offset_, length_, mockMDSClient_.get(),
+                  &fileInfo_, nullptr);
+    ASSERT_TRUE(scheduler_.requests.empty());
+    ASSERT_EQ(length_, hit.Wait());
+    ASSERT_EQ(buf, cached);
+}
+
 }  // namespace client
 }  // namespace curve
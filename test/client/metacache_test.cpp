@@ -109,5 +109,56 @@ TEST_F(MetaCacheTest, TestCleanChunksInSegment) {
     }
 }
 
+
+TEST_F(MetaCacheTest, TestLeaderInShardedCopysets) {
+    const LogicPoolID lpid = 1;
+    const CopysetID copysetNum = 200;
+
+    // three peers for each copyset, the first one is the leader
+    auto peerAddr = [](ChunkServerID id) {
+        butil::EndPoint ep;
+        butil::str2endpoint("127.0.0.1", 9000 + id, &ep);
+        return PeerAddr(ep);
+    };
+    for (CopysetID cpid = 1; cpid <= copysetNum; ++cpid) {
+        CopysetInfo<ChunkServerID> info;
+        info.lpid_ = lpid;
+        info.cpid_ = cpid;
+        for (ChunkServerID id = 1; id <= 3; ++id) {
+            info.AddCopysetPeerInfo(CopysetPeerInfo<ChunkServerID>(
+                id, peerAddr(id), peerAddr(id)));
+            metaCache_.AddCopysetIDInfo(id, CopysetIDInfo(lpid, cpid));
+        }
+        info.UpdateLeaderIndex(0);
+        metaCache_.UpdateCopysetInfo(lpid, cpid, info);
+    }
+
+    ChunkServerID leaderId = 0;
+    butil::EndPoint leaderAddr;
+    for (CopysetID cpid = 1; cpid <= copysetNum; ++cpid) {
+        ASSERT_EQ(0, metaCache_.GetLeader(lpid, cpid, &leaderId, &leaderAddr));
+        ASSERT_EQ(1, leaderId);
+        ASSERT_EQ(peerAddr(1).addr_, leaderAddr);
+        ASSERT_FALSE(metaCache_.IsLeaderMayChange(lpid, cpid));
+    }
+    ASSERT_EQ(-1, metaCache_.GetLeader(lpid, copysetNum + 1, &leaderId,
+                                       &leaderAddr));
+
+    // leader changes are seen by the following lookups
+    for (CopysetID cpid = 1; cpid <= copysetNum; cpid += 2) {
+        ASSERT_EQ(0, metaCache_.UpdateLeader(lpid, cpid, peerAddr(2).addr_));
+    }
+    for (CopysetID cpid = 1; cpid <= copysetNum; ++cpid) {
+        ASSERT_EQ(0, metaCache_.GetLeader(lpid, cpid, &leaderId, &leaderAddr));
+        ASSERT_EQ(cpid % 2 == 1 ? 2 : 1, leaderId);
+    }
+
+    // only copysets led by the unstable chunkserver are marked
+    metaCache_.SetChunkserverUnstable(2);
+    for (CopysetID cpid = 1; cpid <= copysetNum; ++cpid) {
+        ASSERT_EQ(cpid % 2 == 1, metaCache_.IsLeaderMayChange(lpid, cpid));
+    }
+}
+
 }  // namespace client
 }  // namespace curve
@@ -0,0 +1,191 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "src/client/read_cache.h"
+
+namespace curve {
+namespace client {
+
+namespace {
+
+const uint64_t kBlockSize = 64 * 1024;
+
+butil::IOBuf MakeData(uint64_t length, char c) {
+    butil::IOBuf data;
+    data.append(std::string(length, c));
+    return data;
+}
+
+}  // namespace
+
+class ReadCacheTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        opt_.enable = true;
+        opt_.capacityMB = 1;
+        opt_.blockSizeKB = kBlockSize / 1024;
+    }
+
+    ReadCacheOption opt_;
+    ReadCacheMetric metric_{"read_cache_test"};
+};
+
+TEST_F(ReadCacheTest, GetAfterPut) {
+    ReadCache cache;
+    ASSERT_TRUE(cache.Init(opt_, "/test", &metric_));
+
+    butil::IOBuf out;
+    ASSERT_FALSE(cache.Get(0, 4096, &out));
+    ASSERT_EQ(1, metric_.miss.get_value());
+
+    // only the full blocks [64KB, 192KB) are cached
+    uint64_t seq = cache.Sequence(4096, 3 * kBlockSize);
+    butil::IOBuf data = MakeData(kBlockSize - 4096, 'a');
+    data.append(MakeData(kBlockSize, 'b'));
+    data.append(MakeData(kBlockSize, 'c'));
+    data.append(MakeData(4096, 'd'));
+    cache.Put(4096, data, seq);
+
+    ASSERT_FALSE(cache.Get(4096, 4096, &out));
+    ASSERT_FALSE(cache.Get(3 * kBlockSize, 4096, &out));
+
+    ASSERT_TRUE(cache.Get(kBlockSize + 4096, kBlockSize, &out));
+    std::string expected = std::string(kBlockSize - 4096, 'b') +
+                           std::string(4096, 'c');
+    ASSERT_EQ(expected, out.to_string());
+    ASSERT_EQ(1, metric_.hit.get_value());
+    ASSERT_EQ(kBlockSize, metric_.hitBytes.get_value());
+    ASSERT_EQ(2 * kBlockSize, metric_.memoryBytes.get_value());
+}
+
+TEST_F(ReadCacheTest, InvalidateTest) {
+    ReadCache cache;
+    ASSERT_TRUE(cache.Init(opt_, "/test", &metric_));
+
+    uint64_t seq = cache.Sequence(0, 2 * kBlockSize);
+    cache.Put(0, MakeData(2 * kBlockSize, 'a'), seq);
+
+    butil::IOBuf out;
+    ASSERT_TRUE(cache.Get(0, 2 * kBlockSize, &out));
+
+    // a write to the second block
+    cache.Invalidate(kBlockSize + 512, 512);
+    out.clear();
+    ASSERT_TRUE(cache.Get(0, kBlockSize, &out));
+    ASSERT_FALSE(cache.Get(kBlockSize, 512, &out));
+
+    // data read before the write isn't cached
+    seq = cache.Sequence(kBlockSize, kBlockSize);
+    cache.Invalidate(kBlockSize, 4096);
+    cache.Put(kBlockSize, MakeData(kBlockSize, 'a'), seq);
+    ASSERT_FALSE(cache.Get(kBlockSize, 512, &out));
+
+    // writes to other blocks don't matter
+    seq = cache.Sequence(kBlockSize, kBlockSize);
+    cache.Invalidate(10 * kBlockSize, 4096);
+    cache.Put(kBlockSize, MakeData(kBlockSize, 'b'), seq);
+    out.clear();
+    ASSERT_TRUE(cache.Get(kBlockSize, 512, &out));
+    ASSERT_EQ(std::string(512, 'b'), out.to_string());
+
+    // epoch or lease changes
+    seq = cache.Sequence(0, kBlockSize);
+    cache.Clear();
+    cache.Put(0, MakeData(kBlockSize, 'c'), seq);
+    ASSERT_FALSE(cache.Get(0, 512, &out));
+    ASSERT_FALSE(cache.Get(kBlockSize, 512, &out));
+    ASSERT_EQ(0, metric_.memoryBytes.get_value());
+}
+
+TEST_F(ReadCacheTest, EvictTest) {
+    ReadCache cache;
+    ASSERT_TRUE(cache.Init(opt_, "/test", &metric_));
+
+    // 1MB holds 16 blocks
+    for (uint64_t i = 0; i < 20; ++i) {
+        uint64_t seq = cache.Sequence(i * kBlockSize, kBlockSize);
+        cache.Put(i * kBlockSize, MakeData(kBlockSize, 'a' + i), seq);
+    }
+
+    butil::IOBuf out;
+    for (uint64_t i = 0; i < 4; ++i) {
+        ASSERT_FALSE(cache.Get(i * kBlockSize, kBlockSize, &out));
+    }
+    for (uint64_t i = 4; i < 20; ++i) {
+        out.clear();
+        ASSERT_TRUE(cache.Get(i * kBlockSize, kBlockSize, &out));
+        ASSERT_EQ(std::string(kBlockSize, 'a' + i), out.to_string());
+    }
+    ASSERT_EQ(16 * kBlockSize, metric_.memoryBytes.get_value());
+}
+
+TEST_F(ReadCacheTest, CacheFileTest) {
+    opt_.fileDir = ".";
+    opt_.fileCapacityMB = 1;
+    ReadCache cache;
+    ASSERT_TRUE(cache.Init(opt_, "/test", &metric_));
+
+    // 16 blocks in memory and 16 in the file
+    for (uint64_t i = 0; i < 40; ++i) {
+        uint64_t seq = cache.Sequence(i * kBlockSize, kBlockSize);
+        cache.Put(i * kBlockSize, MakeData(kBlockSize, 'a' + i), seq);
+    }
+    ASSERT_EQ(16 * kBlockSize, metric_.fileBytes.get_value());
+
+    butil::IOBuf out;
+    ASSERT_FALSE(cache.Get(0, kBlockSize, &out));
+    ASSERT_FALSE(cache.Get(7 * kBlockSize, kBlockSize, &out));
+    ASSERT_TRUE(cache.Get(8 * kBlockSize, 2 * kBlockSize, &out));
+    ASSERT_EQ(std::string(kBlockSize, 'a' + 8) +
+              std::string(kBlockSize, 'a' + 9), out.to_string());
+    ASSERT_EQ(2, metric_.fileHit.get_value());
+
+    // blocks invalidated in the file aren't read again
+    cache.Invalidate(20 * kBlockSize, kBlockSize);
+    ASSERT_FALSE(cache.Get(20 * kBlockSize, kBlockSize, &out));
+    out.clear();
+    ASSERT_TRUE(cache.Get(21 * kBlockSize, 4096, &out));
+    ASSERT_EQ(std::string(4096, 'a' + 21), out.to_string());
+
+    cache.Clear();
+    ASSERT_FALSE(cache.Get(22 * kBlockSize, 4096, &out));
+    ASSERT_EQ(0, metric_.fileBytes.get_value());
+}
+
+TEST_F(ReadCacheTest, InvalidOptionTest) {
+    ReadCache cache;
+    opt_.blockSizeKB = 0;
+    ASSERT_FALSE(cache.Init(opt_, "/test", nullptr));
+
+    ReadCache cache2;
+    opt_.blockSizeKB = 64;
+    opt_.fileDir = "/not/exist/dir";
+    opt_.fileCapacityMB = 1;
+    ASSERT_FALSE(cache2.Init(opt_, "/test", nullptr));
+}
+
+}  // namespace client
+}  // namespace curve
@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "src/client/readahead.h"
+
+namespace curve {
+namespace client {
+
+namespace {
+
+const uint64_t kKB = 1024;
+const uint64_t kAlignment = 64 * kKB;
+
+}  // namespace
+
+class ReadaheadTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        opt_.enable = true;
+        opt_.initWindowKB = 1024;
+        opt_.maxWindowKB = 4096;
+    }
+
+    ReadaheadOption opt_;
+};
+
+TEST_F(ReadaheadTest, SequentialReadTest) {
+    Readahead readahead(opt_, kAlignment);
+    uint64_t raOffset = 0;
+    uint64_t raLength = 0;
+
+    // the first read isn't a stream yet
+    ASSERT_FALSE(readahead.OnRead(0, 4 * kKB, &raOffset, &raLength));
+
+    // the window is aligned to the cache blocks
+    ASSERT_TRUE(readahead.OnRead(4 * kKB, 4 * kKB, &raOffset, &raLength));
+    ASSERT_EQ(0, raOffset);
+    ASSERT_EQ(1024 * kKB + kAlignment, raLength);
+    ASSERT_EQ(1024 * kKB, readahead.Window());
+
+    // nothing to do until half of the window is read
+    uint64_t offset = 8 * kKB;
+    uint64_t raEnd = raOffset + raLength;
+    while (raEnd - (offset + 4 * kKB) >= 512 * kKB) {
+        ASSERT_FALSE(readahead.OnRead(offset, 4 * kKB, &raOffset, &raLength));
+        offset += 4 * kKB;
+    }
+
+    // the next window follows the last one, and grows
+    ASSERT_TRUE(readahead.OnRead(offset, 4 * kKB, &raOffset, &raLength));
+    ASSERT_EQ(raEnd, raOffset);
+    ASSERT_EQ(2048 * kKB, raLength);
+    ASSERT_EQ(2048 * kKB, readahead.Window());
+
+    // up to the max window
+    uint64_t next = raOffset + raLength;
+    ASSERT_TRUE(readahead.OnRead(next - 4 * kKB, 4 * kKB,
+                                 &raOffset, &raLength));
+    ASSERT_EQ(next, raOffset);
+    ASSERT_EQ(4096 * kKB, raLength);
+    next = raOffset + raLength;
+    ASSERT_TRUE(readahead.OnRead(next - 4 * kKB, 4 * kKB,
+                                 &raOffset, &raLength));
+    ASSERT_EQ(4096 * kKB, raLength);
+}
+
+TEST_F(ReadaheadTest, RandomReadTest) {
+    Readahead readahead(opt_, kAlignment);
+    uint64_t raOffset = 0;
+    uint64_t raLength = 0;
+
+    ASSERT_FALSE(readahead.OnRead(0, 64 * kKB, &raOffset, &raLength));
+    ASSERT_TRUE(readahead.OnRead(64 * kKB, 64 * kKB, &raOffset, &raLength));
+    ASSERT_EQ(1024 * kKB, readahead.Window());
+
+    // the window collapses on random reads
+    ASSERT_FALSE(readahead.OnRead(100 * 1024 * kKB, 4 * kKB,
+                                  &raOffset, &raLength));
+    ASSERT_EQ(0, readahead.Window());
+    ASSERT_FALSE(readahead.OnRead(10 * 1024 * kKB, 4 * kKB,
+                                  &raOffset, &raLength));
+    ASSERT_FALSE(readahead.OnRead(0, 4 * kKB, &raOffset, &raLength));
+
+    // and starts again on a new stream
+    ASSERT_TRUE(readahead.OnRead(4 * kKB, 4 * kKB, &raOffset, &raLength));
+    ASSERT_EQ(1024 * kKB, readahead.Window());
+}
+
+TEST_F(ReadaheadTest, OutOfOrderReadTest) {
+    Readahead readahead(opt_, kAlignment);
+    uint64_t raOffset = 0;
+    uint64_t raLength = 0;
+
+    ASSERT_FALSE(readahead.OnRead(0, 64 * kKB, &raOffset, &raLength));
+    ASSERT_TRUE(readahead.OnRead(64 * kKB, 64 * kKB, &raOffset, &raLength));
+
+    // async reads of the stream arrive out of order
+    ASSERT_FALSE(readahead.OnRead(256 * kKB, 64 * kKB, &raOffset, &raLength));
+    ASSERT_FALSE(readahead.OnRead(192 * kKB, 64 * kKB, &raOffset, &raLength));
+    ASSERT_FALSE(readahead.OnRead(128 * kKB, 64 * kKB, &raOffset, &raLength));
+    ASSERT_EQ(1024 * kKB, readahead.Window());
+
+    // and keep the stream going
+    ASSERT_TRUE(readahead.OnRead(832 * kKB, 64 * kKB, &raOffset, &raLength));
+    ASSERT_EQ(1024 * kKB + 2 * kAlignment, raOffset);
+    ASSERT_EQ(2048 * kKB, raLength);
+
+    // but not reads beyond the prefetched range
+    ASSERT_FALSE(readahead.OnRead(64 * 1024 * kKB, 64 * kKB,
+                                  &raOffset, &raLength));
+    ASSERT_EQ(0, readahead.Window());
+}
+
+TEST_F(ReadaheadTest, InflightTest) {
+    Readahead readahead(opt_, kAlignment);
+    std::vector<int> done;
+    std::vector<Readahead::Task> tasks;
+
+    // no readahead in flight, the reads go on directly
+    ASSERT_FALSE(readahead.WaitInflight(0, 4 * kKB, [&done]() {
+        done.push_back(0);
+    }));
+
+    uint64_t first = readahead.AddInflight(0, 1024 * kKB);
+    uint64_t second = readahead.AddInflight(1024 * kKB, 1024 * kKB);
+
+    // reads before the windows don't wait
+    ASSERT_FALSE(readahead.WaitInflight(2048 * kKB, 4 * kKB, [&done]() {
+        done.push_back(0);
+    }));
+
+    // reads overlapping the windows wait for them
+    ASSERT_TRUE(readahead.WaitInflight(512 * kKB, 4 * kKB, [&done]() {
+        done.push_back(1);
+    }));
+    ASSERT_TRUE(readahead.WaitInflight(1020 * kKB, 8 * kKB, [&done]() {
+        done.push_back(2);
+    }));
+    ASSERT_TRUE(readahead.WaitInflight(1536 * kKB, 4 * kKB, [&done]() {
+        done.push_back(3);
+    }));
+
+    // the read across both windows waits for the second one too
+    readahead.RemoveInflight(first, &tasks);
+    ASSERT_EQ(1, tasks.size());
+    for (auto& task : tasks) {
+        task();
+    }
+    ASSERT_EQ(std::vector<int>({1}), done);
+
+    tasks.clear();
+    readahead.RemoveInflight(second, &tasks);
+    ASSERT_EQ(2, tasks.size());
+    for (auto& task : tasks) {
+        task();
+    }
+    ASSERT_EQ(std::vector<int>({1, 3, 2}), done);
+
+    // nothing in flight any more
+    ASSERT_FALSE(readahead.WaitInflight(512 * kKB, 4 * kKB, [&done]() {
+        done.push_back(0);
+    }));
+}
+
+}  // namespace client
+}  // namespace curve
@@ -26,6 +26,11 @@
 #include <brpc/channel.h>
 #include <butil/iobuf.h>
 
+#include <algorithm>
+#include <mutex>  // NOLINT
+#include <tuple>
+#include <vector>
+
 #include "src/client/request_scheduler.h"
 #include "src/client/client_common.h"
 #include "test/client/mock/mock_meta_cache.h"
@@ -599,5 +604,218 @@ TEST(RequestSchedulerTest, CommonTest) {
     ASSERT_EQ(0, sche.Fini());
 }
 
+TEST(RequestSchedulerTest, WriteMergeTest) {
+    RequestScheduleOption opt;
+    opt.scheduleQueueCapacity = 4096;
+    opt.scheduleThreadpoolSize = 1;
+    opt.ioSenderOpt.failRequestOpt.chunkserverRPCTimeoutMS = 200;
+    opt.ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry = 5;
+    opt.ioSenderOpt.failRequestOpt.chunkserverOPRetryIntervalUS = 5000;
+    opt.ioSenderOpt.chunkserverEnableAppliedIndexRead = 1;
+    opt.writeMergeOpt.enable = true;
+    opt.writeMergeOpt.maxSizeKB = 2;
+
+    brpc::Server server;
+    std::string listenAddr = "127.0.0.1:9109";
+    MockChunkServiceImpl mockChunkService;
+    mockChunkService.DelegateToFake();
+    ASSERT_EQ(server.AddService(&mockChunkService,
+                                brpc::SERVER_DOESNT_OWN_SERVICE), 0);
+    brpc::ServerOptions option;
+    option.idle_timeout_sec = -1;
+    ASSERT_EQ(server.Start(listenAddr.c_str(), &option), 0);
+
+    // (chunk id, offset, size) of the write rpcs
+    using WriteRecord = std::tuple<ChunkID, uint64_t, uint64_t>;
+    std::mutex mtx;
+    std::vector<WriteRecord> writes;
+    FakeChunkServiceImpl fakeChunkService;
+    EXPECT_CALL(mockChunkService, WriteChunk(_, _, _, _))
+        .Times(3)
+        .WillRepeatedly(Invoke(
+            [&](::google::protobuf::RpcController* controller,
+                const ::curve::chunkserver::ChunkRequest* request,
+                ::curve::chunkserver::ChunkResponse* response,
+                google::protobuf::Closure* done) {
+                {
+                    std::lock_guard<std::mutex> lk(mtx);
+                    writes.emplace_back(request->chunkid(), request->offset(),
+                                        request->size());
+                }
+                fakeChunkService.WriteChunk(controller, request, response,
+                                            done);
+            }));
+
+    RequestScheduler requestScheduler;
+    MockMetaCache mockMetaCache;
+    mockMetaCache.DelegateToFake();
+    EXPECT_CALL(mockMetaCache, GetLeader(_, _, _, _, _, _)).Times(AnyNumber());
+    FileMetric fm("write_merge_test");
+    ASSERT_EQ(0, requestScheduler.Init(opt, &mockMetaCache, &fm));
+
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 100001;
+    IOTracker iot(nullptr, nullptr, nullptr, &fm);
+    char writebuff[1024];
+    memset(writebuff, 'a', sizeof(writebuff));
+
+    // {chunk id, offset, length} of the requests
+    const uint64_t requests[][3] = {
+        {1, 0, 1024}, {1, 1024, 1024},      // merged, up to maxSizeKB
+        {1, 2048, 1024}, {1, 3072, 512},    // merged
+        {2, 3584, 512},                     // another chunk
+    };
+    curve::common::CountDownEvent cond(5);
+    std::vector<RequestClosure*> dones;
+    for (const auto& r : requests) {
+        RequestContext *reqCtx = new FakeRequestContext();
+        reqCtx->optype_ = OpType::WRITE;
+        reqCtx->idinfo_ = ChunkIDInfo(r[0], logicPoolId, copysetId);
+        reqCtx->writeData_.append(writebuff, r[2]);
+        reqCtx->offset_ = r[1];
+        reqCtx->rawlength_ = r[2];
+
+        RequestClosure *reqDone = new FakeRequestClosure(&cond, reqCtx);
+        reqDone->SetFileMetric(&fm);
+        reqDone->SetIOTracker(&iot);
+        reqCtx->done_ = reqDone;
+        dones.push_back(reqDone);
+
+        // queue all the requests before the scheduler runs
+        requestScheduler.GetQueue()->PutBack(
+            BBQItem<RequestContext*>(reqCtx));
+    }
+
+    ASSERT_EQ(0, requestScheduler.Run());
+    cond.Wait();
+
+    for (auto done : dones) {
+        ASSERT_EQ(0, done->GetErrorCode());
+    }
+    std::vector<WriteRecord> expected = {
+        WriteRecord(1, 0, 2048),
+        WriteRecord(1, 2048, 1536),
+        WriteRecord(2, 3584, 512),
+    };
+    std::sort(writes.begin(), writes.end());
+    ASSERT_EQ(expected, writes);
+    ASSERT_EQ(2U, fm.writeMergeMetric.mergedRPC.get_value());
+    ASSERT_EQ(4U, fm.writeMergeMetric.mergedRequest.get_value());
+    ASSERT_EQ(3584U, fm.writeMergeMetric.mergedBytes.get_value());
+
+    requestScheduler.Fini();
+    ASSERT_EQ(0, server.Stop(0));
+    ASSERT_EQ(0, server.Join());
+}
+
+
+TEST(RequestSchedulerTest, MultiQueueTest) {
+    RequestScheduleOption opt;
+    opt.scheduleQueueCapacity = 4096;
+    opt.scheduleThreadpoolSize = 4;
+    opt.ioSenderOpt.failRequestOpt.chunkserverRPCTimeoutMS = 200;
+    opt.ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry = 5;
+    opt.ioSenderOpt.failRequestOpt.chunkserverOPRetryIntervalUS = 5000;
+    opt.ioSenderOpt.chunkserverEnableAppliedIndexRead = 1;
+    opt.multiQueueOpt.enable = true;
+    opt.multiQueueOpt.queueCapacity = 16;
+
+    MetaCache metaCache;
+    FileMetric fm("multi_queue_test");
+    {
+        RequestScheduler sche;
+        opt.multiQueueOpt.cpuList = "0,a";
+        ASSERT_EQ(-1, sche.Init(opt, &metaCache, &fm));
+    }
+
+    brpc::Server server;
+    std::string listenAddr = "127.0.0.1:9109";
+    MockChunkServiceImpl mockChunkService;
+    mockChunkService.DelegateToFake();
+    ASSERT_EQ(server.AddService(&mockChunkService,
+                                brpc::SERVER_DOESNT_OWN_SERVICE), 0);
+    brpc::ServerOptions option;
+    option.idle_timeout_sec = -1;
+    ASSERT_EQ(server.Start(listenAddr.c_str(), &option), 0);
+
+    const uint64_t chunkNum = 8;
+    const uint64_t writesPerChunk = 32;
+
+    // (chunk id, offset) of the write rpcs
+    using WriteRecord = std::tuple<ChunkID, uint64_t>;
+    std::mutex mtx;
+    std::vector<WriteRecord> writes;
+    FakeChunkServiceImpl fakeChunkService;
+    EXPECT_CALL(mockChunkService, WriteChunk(_, _, _, _))
+        .Times(chunkNum * writesPerChunk)
+        .WillRepeatedly(Invoke(
+            [&](::google::protobuf::RpcController* controller,
+                const ::curve::chunkserver::ChunkRequest* request,
+                ::curve::chunkserver::ChunkResponse* response,
+                google::protobuf::Closure* done) {
+                {
+                    std::lock_guard<std::mutex> lk(mtx);
+                    writes.emplace_back(request->chunkid(),
+                                        request->offset());
+                }
+                fakeChunkService.WriteChunk(controller, request, response,
+                                            done);
+            }));
+
+    RequestScheduler requestScheduler;
+    MockMetaCache mockMetaCache;
+    mockMetaCache.DelegateToFake();
+    EXPECT_CALL(mockMetaCache, GetLeader(_, _, _, _, _, _)).Times(AnyNumber());
+    opt.multiQueueOpt.cpuList = "0";
+    ASSERT_EQ(0, requestScheduler.Init(opt, &mockMetaCache, &fm));
+    ASSERT_EQ(0, requestScheduler.Run());
+
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 100001;
+    IOTracker iot(nullptr, nullptr, nullptr, &fm);
+    char writebuff[1024];
+    memset(writebuff, 'a', sizeof(writebuff));
+
+    // more requests than the capacity of the queues
+    curve::common::CountDownEvent cond(chunkNum * writesPerChunk);
+    std::vector<RequestClosure*> dones;
+    std::vector<RequestContext*> reqCtxs;
+    for (uint64_t i = 0; i < writesPerChunk; ++i) {
+        for (uint64_t cid = 1; cid <= chunkNum; ++cid) {
+            RequestContext *reqCtx = new FakeRequestContext();
+            reqCtx->optype_ = OpType::WRITE;
+            reqCtx->idinfo_ = ChunkIDInfo(cid, logicPoolId, copysetId);
+            reqCtx->writeData_.append(writebuff, sizeof(writebuff));
+            reqCtx->offset_ = i * sizeof(writebuff);
+            reqCtx->rawlength_ = sizeof(writebuff);
+
+            RequestClosure *reqDone = new FakeRequestClosure(&cond, reqCtx);
+            reqDone->SetFileMetric(&fm);
+            reqDone->SetIOTracker(&iot);
+            reqCtx->done_ = reqDone;
+            dones.push_back(reqDone);
+            reqCtxs.push_back(reqCtx);
+        }
+    }
+    ASSERT_EQ(0, requestScheduler.ScheduleRequest(reqCtxs));
+    cond.Wait();
+
+    for (auto done : dones) {
+        ASSERT_EQ(0, done->GetErrorCode());
+    }
+    std::vector<WriteRecord> expected;
+    for (uint64_t cid = 1; cid <= chunkNum; ++cid) {
+        for (uint64_t i = 0; i < writesPerChunk; ++i) {
+            expected.emplace_back(cid, i * sizeof(writebuff));
+        }
+    }
+    std::sort(writes.begin(), writes.end());
+    ASSERT_EQ(expected, writes);
+
+    ASSERT_EQ(0, requestScheduler.Fini());
+    ASSERT_EQ(0, server.Stop(0));
+    ASSERT_EQ(0, server.Join());
+}
+
 }   // namespace client
 }   // namespace curve
@@ -21,8 +21,15 @@
  */
 
 #include <brpc/server.h>
+#include <brpc/stream.h>
+#include <butil/sys_byteorder.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+
 #include "src/client/client_common.h"
 #include "src/client/request_sender.h"
 #include "src/common/concurrent/count_down_event.h"
@@ -259,5 +266,284 @@ TEST_F(RequestSenderTest, TestReadChunkSourceInfo) {
     }
 }
 
+class FakeBatchChunkClosure : public FakeChunkClosure {
+ public:
+    explicit FakeBatchChunkClosure(CountDownEvent* event)
+        : FakeChunkClosure(event) {}
+
+    void Run() override {
+        rpcFailed = cntl_->Failed();
+        respStatus = response_->status();
+        readData = cntl_->response_attachment();
+        FakeChunkClosure::Run();
+    }
+
+    bool rpcFailed = true;
+    int respStatus = -1;
+    butil::IOBuf readData;
+};
+
+void WriteBatchChunkSubResponse(brpc::StreamId streamId, uint32_t index,
+                                CHUNK_OP_STATUS status,
+                                const std::string& data) {
+    curve::chunkserver::BatchChunkSubResponse subResponse;
+    subResponse.set_index(index);
+    subResponse.mutable_response()->set_status(status);
+
+    butil::IOBuf msg;
+    const uint32_t metaSize = butil::HostToNet32(subResponse.ByteSize());
+    msg.append(&metaSize, sizeof(uint32_t));
+    butil::IOBufAsZeroCopyOutputStream wrapper(&msg);
+    ASSERT_TRUE(subResponse.SerializeToZeroCopyStream(&wrapper));
+    msg.append(data);
+    ASSERT_EQ(0, brpc::StreamWrite(streamId, msg));
+}
+
+TEST_F(RequestSenderTest, TestBatchChunk) {
+    butil::EndPoint serverEndpoint;
+    butil::str2endpoint(serverAddr_.c_str(), &serverEndpoint);
+
+    ioSenderOption_.batchOpt.enable = true;
+    ioSenderOption_.batchOpt.maxBatchSize = 3;
+    ioSenderOption_.batchOpt.tickUs = 1000;
+    auto requestSender = std::make_shared<RequestSender>(0, serverEndpoint);
+    ASSERT_EQ(0, requestSender->Init(ioSenderOption_));
+
+    // requests are sent in one rpc once the batch is full
+    {
+        curve::chunkserver::BatchChunkRequest batchRequest;
+        std::string writeData;
+        EXPECT_CALL(mockChunkService_, BatchChunk(_, _, _, _))
+            .Times(1)
+            .WillOnce(Invoke(
+                [&](::google::protobuf::RpcController* controller,
+                    const curve::chunkserver::BatchChunkRequest* request,
+                    curve::chunkserver::BatchChunkResponse* response,
+                    google::protobuf::Closure* done) {
+                    brpc::ClosureGuard doneGuard(done);
+                    brpc::Controller* cntl =
+                        static_cast<brpc::Controller*>(controller);
+                    batchRequest = *request;
+                    writeData = cntl->request_attachment().to_string();
+                    response->add_responses()->set_status(
+                        CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+                    response->add_responses()->set_status(
+                        CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+                    response->add_responses()->set_status(
+                        CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED);
+                    cntl->response_attachment().append("read");
+                }));
+
+        CountDownEvent event(3);
+        FakeBatchChunkClosure write1(&event);
+        FakeBatchChunkClosure read(&event);
+        FakeBatchChunkClosure write2(&event);
+
+        butil::IOBuf data1;
+        data1.append("aaaa");
+        butil::IOBuf data2;
+        data2.append("bbbb");
+        requestSender->WriteChunk(ChunkIDInfo(1, 1, 1), 1, 1, 0, data1, 0, 4,
+                                  {}, &write1);
+        requestSender->ReadChunk(ChunkIDInfo(2, 1, 2), 0, 0, 4, 0, {}, &read);
+        requestSender->WriteChunk(ChunkIDInfo(3, 1, 3), 1, 1, 0, data2, 8, 4,
+                                  {}, &write2);
+        event.Wait();
+
+        ASSERT_EQ(3, batchRequest.requests_size());
+        ASSERT_EQ(1U, batchRequest.requests(0).chunkid());
+        ASSERT_EQ(2U, batchRequest.requests(1).chunkid());
+        ASSERT_EQ(3U, batchRequest.requests(2).chunkid());
+        ASSERT_EQ("aaaabbbb", writeData);
+
+        ASSERT_FALSE(write1.rpcFailed);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS, write1.respStatus);
+        ASSERT_FALSE(read.rpcFailed);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS, read.respStatus);
+        ASSERT_EQ("read", read.readData.to_string());
+        ASSERT_FALSE(write2.rpcFailed);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED,
+                  write2.respStatus);
+    }
+
+    // the results are returned separately through the stream, so a slow
+    // request doesn't hold the others
+    {
+        std::atomic<brpc::StreamId> streamId(brpc::INVALID_STREAM_ID);
+        EXPECT_CALL(mockChunkService_, BatchChunk(_, _, _, _))
+            .Times(1)
+            .WillOnce(Invoke(
+                [&](::google::protobuf::RpcController* controller,
+                    const curve::chunkserver::BatchChunkRequest* request,
+                    curve::chunkserver::BatchChunkResponse* response,
+                    google::protobuf::Closure* done) {
+                    brpc::ClosureGuard doneGuard(done);
+                    brpc::Controller* cntl =
+                        static_cast<brpc::Controller*>(controller);
+                    ASSERT_TRUE(cntl->has_remote_stream());
+                    brpc::StreamOptions options;
+                    brpc::StreamId id;
+                    ASSERT_EQ(0, brpc::StreamAccept(&id, *cntl, &options));
+                    streamId.store(id);
+                }));
+
+        CountDownEvent event(2);
+        CountDownEvent slowEvent(1);
+        FakeBatchChunkClosure write1(&event);
+        FakeBatchChunkClosure read(&event);
+        FakeBatchChunkClosure write2(&slowEvent);
+
+        butil::IOBuf data1;
+        data1.append("aaaa");
+        butil::IOBuf data2;
+        data2.append("bbbb");
+        requestSender->WriteChunk(ChunkIDInfo(1, 1, 1), 1, 1, 0, data1, 0, 4,
+                                  {}, &write1);
+        requestSender->ReadChunk(ChunkIDInfo(2, 1, 2), 0, 0, 4, 0, {}, &read);
+        requestSender->WriteChunk(ChunkIDInfo(3, 1, 3), 1, 1, 0, data2, 8, 4,
+                                  {}, &write2);
+        while (streamId.load() == brpc::INVALID_STREAM_ID) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        WriteBatchChunkSubResponse(streamId.load(), 1,
+                                   CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                                   "read");
+        WriteBatchChunkSubResponse(streamId.load(), 0,
+                                   CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                                   "");
+        event.Wait();
+        ASSERT_FALSE(write1.rpcFailed);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS, write1.respStatus);
+        ASSERT_FALSE(read.rpcFailed);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS, read.respStatus);
+        ASSERT_EQ("read", read.readData.to_string());
+        ASSERT_EQ(-1, write2.respStatus);
+
+        // the request without result fails when the stream is closed
+        ASSERT_EQ(0, brpc::StreamClose(streamId.load()));
+        slowEvent.Wait();
+        ASSERT_TRUE(write2.rpcFailed);
+    }
+
+    // a single request is sent as it is after the tick
+    {
+        EXPECT_CALL(mockChunkService_, BatchChunk(_, _, _, _))
+            .Times(0);
+        EXPECT_CALL(mockChunkService_, WriteChunk(_, _, _, _))
+            .Times(1)
+            .WillOnce(Invoke(
+                [](::google::protobuf::RpcController*,
+                   const curve::chunkserver::ChunkRequest*,
+                   curve::chunkserver::ChunkResponse* response,
+                   google::protobuf::Closure* done) {
+                    brpc::ClosureGuard doneGuard(done);
+                    response->set_status(
+                        CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+                }));
+
+        CountDownEvent event(1);
+        FakeBatchChunkClosure write(&event);
+        butil::IOBuf data;
+        data.append("cccc");
+        requestSender->WriteChunk(ChunkIDInfo(1, 1, 1), 1, 1, 0, data, 0, 4,
+                                  {}, &write);
+        event.Wait();
+
+        ASSERT_FALSE(write.rpcFailed);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS, write.respStatus);
+    }
+}
+
+TEST_F(RequestSenderTest, TestBatchChunkUnsupported) {
+    butil::EndPoint serverEndpoint;
+    butil::str2endpoint(serverAddr_.c_str(), &serverEndpoint);
+
+    ioSenderOption_.batchOpt.enable = true;
+    ioSenderOption_.batchOpt.maxBatchSize = 2;
+    ioSenderOption_.batchOpt.tickUs = 1000;
+    auto requestSender = std::make_shared<RequestSender>(0, serverEndpoint);
+    ASSERT_EQ(0, requestSender->Init(ioSenderOption_));
+
+    // an old chunkserver without the batch rpc
+    EXPECT_CALL(mockChunkService_, BatchChunk(_, _, _, _))
+        .Times(1)
+        .WillOnce(Invoke(
+            [](::google::protobuf::RpcController* controller,
+               const curve::chunkserver::BatchChunkRequest*,
+               curve::chunkserver::BatchChunkResponse*,
+               google::protobuf::Closure* done) {
+                brpc::ClosureGuard doneGuard(done);
+                static_cast<brpc::Controller*>(controller)->SetFailed(
+                    brpc::ENOMETHOD, "no method BatchChunk");
+            }));
+    std::string writeData;
+    EXPECT_CALL(mockChunkService_, WriteChunk(_, _, _, _))
+        .Times(2)
+        .WillRepeatedly(Invoke(
+            [&writeData](::google::protobuf::RpcController* controller,
+                         const curve::chunkserver::ChunkRequest*,
+                         curve::chunkserver::ChunkResponse* response,
+                         google::protobuf::Closure* done) {
+                brpc::ClosureGuard doneGuard(done);
+                brpc::Controller* cntl =
+                    static_cast<brpc::Controller*>(controller);
+                writeData += cntl->request_attachment().to_string();
+                response->set_status(
+                    CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+            }));
+    EXPECT_CALL(mockChunkService_, ReadChunk(_, _, _, _))
+        .Times(2)
+        .WillRepeatedly(Invoke(
+            [](::google::protobuf::RpcController* controller,
+               const curve::chunkserver::ChunkRequest*,
+               curve::chunkserver::ChunkResponse* response,
+               google::protobuf::Closure* done) {
+                brpc::ClosureGuard doneGuard(done);
+                static_cast<brpc::Controller*>(controller)
+                    ->response_attachment().append("read");
+                response->set_status(
+                    CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+            }));
+
+    // the batched requests are resent one by one
+    {
+        CountDownEvent event(2);
+        FakeBatchChunkClosure write(&event);
+        FakeBatchChunkClosure read(&event);
+        butil::IOBuf data;
+        data.append("aaaa");
+        requestSender->WriteChunk(ChunkIDInfo(1, 1, 1), 1, 1, 0, data, 0, 4,
+                                  {}, &write);
+        requestSender->ReadChunk(ChunkIDInfo(2, 1, 2), 0, 0, 4, 0, {}, &read);
+        event.Wait();
+
+        ASSERT_FALSE(write.rpcFailed);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS, write.respStatus);
+        ASSERT_EQ("aaaa", writeData);
+        ASSERT_FALSE(read.rpcFailed);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS, read.respStatus);
+        ASSERT_EQ("read", read.readData.to_string());
+    }
+
+    // and later requests are not batched any more
+    {
+        CountDownEvent event(2);
+        FakeBatchChunkClosure write(&event);
+        FakeBatchChunkClosure read(&event);
+        butil::IOBuf data;
+        data.append("bbbb");
+        requestSender->WriteChunk(ChunkIDInfo(1, 1, 1), 1, 1, 0, data, 4, 4,
+                                  {}, &write);
+        requestSender->ReadChunk(ChunkIDInfo(2, 1, 2), 0, 0, 4, 0, {}, &read);
+        event.Wait();
+
+        ASSERT_FALSE(write.rpcFailed);
+        ASSERT_EQ("aaaabbbb", writeData);
+        ASSERT_FALSE(read.rpcFailed);
+        ASSERT_EQ("read", read.readData.to_string());
+    }
+}
+
 }  // namespace client
 }  // namespace curve
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "src/client/client_metric.h"
+#include "src/client/request_closure.h"
+#include "src/client/request_context.h"
+#include "src/common/concurrent/count_down_event.h"
+#include "test/client/mock/mock_request_context.h"
+
+namespace curve {
+namespace client {
+
+TEST(RequestTraceTest, AddTest) {
+    RequestTrace trace;
+    trace.enqueueUs = 100;
+    trace.scheduleQueueUs = 1;
+    trace.getLeaderUs = 2;
+    trace.rpcUs = 3;
+    trace.retryBackoffUs = 4;
+
+    RequestTrace other;
+    other.enqueueUs = 200;
+    other.scheduleQueueUs = 10;
+    other.getLeaderUs = 20;
+    other.rpcUs = 30;
+    other.retryBackoffUs = 40;
+
+    trace.Add(other);
+    trace.Add(other);
+    ASSERT_EQ(100U, trace.enqueueUs);
+    ASSERT_EQ(21U, trace.scheduleQueueUs);
+    ASSERT_EQ(42U, trace.getLeaderUs);
+    ASSERT_EQ(63U, trace.rpcUs);
+    ASSERT_EQ(84U, trace.retryBackoffUs);
+
+    std::ostringstream os;
+    os << trace;
+    ASSERT_EQ("schedule queue = 21 us, get leader = 42 us, rpc = 63 us, "
+              "retry backoff = 84 us", os.str());
+}
+
+TEST(RequestTraceTest, StageLatencyRecordTest) {
+    // no file metric
+    MetricHelper::StageLatencyRecord(nullptr, 1, 2, 3, 4);
+
+    FileMetric fm("stage_latency_record_test");
+    StageLatencyMetric& metric = fm.stageLatencyMetric;
+
+    // the backoff is only recorded for retried requests
+    MetricHelper::StageLatencyRecord(&fm, 10, 20, 30, 0);
+    ASSERT_EQ(1, metric.scheduleQueue.count());
+    ASSERT_EQ(1, metric.getLeader.count());
+    ASSERT_EQ(1, metric.rpc.count());
+    ASSERT_EQ(0, metric.retryBackoff.count());
+
+    MetricHelper::StageLatencyRecord(&fm, 10, 20, 30, 40);
+    ASSERT_EQ(2, metric.scheduleQueue.count());
+    ASSERT_EQ(2, metric.getLeader.count());
+    ASSERT_EQ(2, metric.rpc.count());
+    ASSERT_EQ(1, metric.retryBackoff.count());
+    ASSERT_EQ(40, metric.retryBackoff.max_latency());
+
+    MetricHelper::TaskQueueLatencyRecord(&fm, 50);
+    ASSERT_EQ(1, metric.taskQueue.count());
+    ASSERT_EQ(50, metric.taskQueue.max_latency());
+}
+
+TEST(RequestTraceTest, MergedRequestClosureTest) {
+    curve::common::CountDownEvent cond(2);
+    std::vector<RequestContext*> requests;
+    for (int i = 0; i < 2; ++i) {
+        RequestContext* reqCtx = new FakeRequestContext();
+        reqCtx->trace_.scheduleQueueUs = 1;
+        reqCtx->done_ = new FakeRequestClosure(&cond, reqCtx);
+        requests.push_back(reqCtx);
+    }
+
+    // the merged request has been retried once
+    RequestContext* merged = new RequestContext();
+    merged->done_ = new MergedRequestClosure(merged, requests);
+    merged->trace_.scheduleQueueUs = 10;
+    merged->trace_.getLeaderUs = 20;
+    merged->trace_.rpcUs = 30;
+    merged->trace_.retryBackoffUs = 40;
+    merged->done_->SetFailed(0);
+    merged->done_->Run();
+    cond.Wait();
+
+    for (RequestContext* reqCtx : requests) {
+        ASSERT_EQ(0, reqCtx->done_->GetErrorCode());
+        ASSERT_EQ(11U, reqCtx->trace_.scheduleQueueUs);
+        ASSERT_EQ(20U, reqCtx->trace_.getLeaderUs);
+        ASSERT_EQ(30U, reqCtx->trace_.rpcUs);
+        ASSERT_EQ(40U, reqCtx->trace_.retryBackoffUs);
+        delete reqCtx->done_;
+        delete reqCtx;
+    }
+}
+
+}  // namespace client
+}  // namespace curve
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gflags/gflags.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "src/common/bitmap.h"
+#include "src/common/timeutility.h"
+
+DEFINE_uint32(bits, 4096, "bits of the bitmap, 16MB chunk with 4KB blocks");
+DEFINE_uint64(loops, 200000, "scans of each pattern");
+
+using curve::common::Bitmap;
+using curve::common::BitRange;
+using curve::common::TimeUtility;
+
+namespace {
+
+// the bit by bit scan which Bitmap used before
+uint32_t BitByBitNextClearBit(const Bitmap& bitmap, uint32_t index) {
+    for (; index < bitmap.Size(); ++index) {
+        if (!bitmap.Test(index)) {
+            return index;
+        }
+    }
+    return Bitmap::NO_POS;
+}
+
+uint32_t BitByBitRuns(const Bitmap& bitmap) {
+    uint32_t runs = 1;
+    for (uint32_t i = 1; i < bitmap.Size(); ++i) {
+        if (bitmap.Test(i) != bitmap.Test(i - 1)) {
+            ++runs;
+        }
+    }
+    return runs;
+}
+
+template <typename Func>
+double MeasureNsPerScan(Func func) {
+    uint64_t sum = 0;
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    for (uint64_t i = 0; i < FLAGS_loops; ++i) {
+        sum += func();
+    }
+    uint64_t cost = TimeUtility::GetTimeofDayUs() - start;
+    // keep the result alive
+    if (sum == 0x5a5a5a5a) {
+        std::cout << "";
+    }
+    return cost * 1000.0 / FLAGS_loops;
+}
+
+void RunPattern(const std::string& name, const Bitmap& bitmap) {
+    double slowScan = MeasureNsPerScan([&]() {
+        return BitByBitNextClearBit(bitmap, 0);
+    });
+    double fastScan = MeasureNsPerScan([&]() {
+        return bitmap.NextClearBit(0);
+    });
+    double slowRuns = MeasureNsPerScan([&]() {
+        return BitByBitRuns(bitmap);
+    });
+    double fastDivide = MeasureNsPerScan([&]() {
+        std::vector<BitRange> clearRanges;
+        bitmap.Divide(0, bitmap.Size() - 1, &clearRanges, nullptr);
+        return clearRanges.size();
+    });
+    double fastRuns = MeasureNsPerScan([&]() {
+        uint32_t runs = 0;
+        bitmap.ForEachRun(0, bitmap.Size() - 1,
+                          [&](const BitRange&, bool) { ++runs; });
+        return runs;
+    });
+    double fastCount = MeasureNsPerScan([&]() {
+        return bitmap.Count();
+    });
+    std::cout << name
+              << ": NextClearBit bit-by-bit " << slowScan << " ns"
+              << ", word " << fastScan << " ns"
+              << "; runs bit-by-bit " << slowRuns << " ns"
+              << ", Divide " << fastDivide << " ns"
+              << ", ForEachRun " << fastRuns << " ns"
+              << "; Count " << fastCount << " ns" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+
+    std::cout << "avx2: " << curve::common::IsBitmapScanAccelerated()
+              << ", bits: " << FLAGS_bits << std::endl;
+
+    // fully copied clone chunk, the check of every read walks all bits
+    Bitmap full(FLAGS_bits);
+    full.Set();
+    RunPattern("all set", full);
+
+    // the last block isn't copied yet
+    Bitmap tail(FLAGS_bits);
+    tail.Set(0, FLAGS_bits - 2);
+    RunPattern("last clear", tail);
+
+    // 64KB clone slices copied on every other slice
+    Bitmap striped(FLAGS_bits);
+    for (uint32_t i = 0; i < FLAGS_bits; i += 32) {
+        striped.Set(i, i + 15);
+    }
+    RunPattern("striped", striped);
+    return 0;
+}
@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include "src/common/bitmap.h"
 
 namespace curve {
@@ -415,5 +417,118 @@ TEST(BitmapTEST, divide_test) {
     }
 }
 
+// 逐位计算的结果，用于校验按字扫描的实现
+uint32_t SlowNext(const Bitmap& bitmap, uint32_t start, uint32_t end,
+                  bool set) {
+    for (uint32_t i = start; i <= end && i < bitmap.Size(); ++i) {
+        if (bitmap.Test(i) == set) {
+            return i;
+        }
+    }
+    return Bitmap::NO_POS;
+}
+
+TEST(BitmapTEST, scan_compare_test) {
+    std::mt19937 rng(12345);
+    // 包含非8字节对齐的大小及clone chunk常用的4096位
+    const uint32_t sizes[] = {1, 7, 63, 64, 65, 100, 1000, 4096, 4100};
+    for (uint32_t bits : sizes) {
+        Bitmap bitmap(bits);
+        for (int round = 0; round < 20; ++round) {
+            // 随机设置若干长短不一的连续区域
+            bitmap.Clear();
+            int runs = rng() % 8;
+            for (int i = 0; i < runs; ++i) {
+                uint32_t begin = rng() % bits;
+                uint32_t end = begin + rng() % (bits / 4 + 1);
+                bitmap.Set(begin, end);
+            }
+            if (round % 2 == 1) {
+                // 多数位为1，用于测试查找0
+                Bitmap inverted(bits);
+                inverted.Set();
+                for (uint32_t i = 0; i < bits; ++i) {
+                    if (bitmap.Test(i)) {
+                        inverted.Clear(i);
+                    }
+                }
+                bitmap = inverted;
+            }
+
+            for (int i = 0; i < 50; ++i) {
+                uint32_t start = rng() % bits;
+                uint32_t end = start + rng() % (bits - start + 1);
+                ASSERT_EQ(SlowNext(bitmap, start, end, true),
+                          bitmap.NextSetBit(start, end));
+                ASSERT_EQ(SlowNext(bitmap, start, end, false),
+                          bitmap.NextClearBit(start, end));
+                ASSERT_EQ(SlowNext(bitmap, start, bits - 1, true),
+                          bitmap.NextSetBit(start));
+                ASSERT_EQ(SlowNext(bitmap, start, bits - 1, false),
+                          bitmap.NextClearBit(start));
+
+                uint32_t count = 0;
+                for (uint32_t j = start; j <= end && j < bits; ++j) {
+                    count += bitmap.Test(j);
+                }
+                ASSERT_EQ(count, bitmap.Count(start, end));
+
+                // 连续区域首尾相接，且区域内位状态一致
+                uint32_t next = start;
+                bitmap.ForEachRun(start, end,
+                    [&](const BitRange& range, bool isSet) {
+                        ASSERT_EQ(next, range.beginIndex);
+                        ASSERT_EQ(range.endIndex,
+                                  std::min(SlowNext(bitmap, next, end, !isSet),
+                                           std::min(end, bits - 1) + 1) - 1);
+                        next = range.endIndex + 1;
+                    });
+                ASSERT_EQ(std::min(end, bits - 1) + 1, next);
+            }
+        }
+    }
+}
+
+TEST(BitmapTEST, range_set_and_count_test) {
+    Bitmap bitmap(4100);
+    ASSERT_EQ(0, bitmap.Count());
+
+    bitmap.Set(3, 4098);
+    ASSERT_EQ(4096, bitmap.Count());
+    ASSERT_FALSE(bitmap.Test(2));
+    ASSERT_TRUE(bitmap.Test(3));
+    ASSERT_TRUE(bitmap.Test(4098));
+    ASSERT_FALSE(bitmap.Test(4099));
+
+    bitmap.Clear(10, 20);
+    ASSERT_EQ(4085, bitmap.Count());
+    ASSERT_EQ(10, bitmap.NextClearBit(3));
+    ASSERT_EQ(21, bitmap.NextSetBit(10));
+    ASSERT_EQ(7, bitmap.Count(0, 20));
+
+    // 超出范围的位被忽略
+    bitmap.Set(4090, 10000);
+    ASSERT_EQ(4086, bitmap.Count());
+    ASSERT_EQ(0, bitmap.Count(5000, 6000));
+    ASSERT_EQ(0, bitmap.Count(20, 10));
+
+    BitRange range;
+    ASSERT_TRUE(bitmap.NextRun(3, 4099, &range));
+    ASSERT_EQ(3, range.beginIndex);
+    ASSERT_EQ(9, range.endIndex);
+    ASSERT_FALSE(bitmap.NextRun(10, 4099, &range));
+    ASSERT_EQ(10, range.beginIndex);
+    ASSERT_EQ(20, range.endIndex);
+    ASSERT_TRUE(bitmap.NextRun(21, 4099, &range));
+    ASSERT_EQ(21, range.beginIndex);
+    ASSERT_EQ(4099, range.endIndex);
+    ASSERT_FALSE(bitmap.NextRun(4100, 5000, &range));
+
+    Bitmap empty(0);
+    ASSERT_EQ(Bitmap::NO_POS, empty.NextSetBit(0));
+    ASSERT_EQ(Bitmap::NO_POS, empty.NextClearBit(0));
+    ASSERT_EQ(0, empty.Count());
+}
+
 }  // namespace common
 }  // namespace curve
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <butil/crc32c.h>
+#include <gflags/gflags.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "src/common/crc32.h"
+#include "src/common/timeutility.h"
+
+DEFINE_uint64(totalBytes, 4ULL * 1024 * 1024 * 1024,
+              "bytes to checksum for each buffer size");
+
+using curve::common::TimeUtility;
+
+namespace {
+
+template <typename Func>
+double MeasureThroughput(const std::string& buf, Func func) {
+    uint64_t loops = FLAGS_totalBytes / buf.size();
+    uint32_t crc = 0;
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    for (uint64_t i = 0; i < loops; ++i) {
+        crc = func(crc, buf.data(), buf.size());
+    }
+    uint64_t cost = TimeUtility::GetTimeofDayUs() - start;
+    // keep the result alive
+    if (crc == 0x5a5a5a5a) {
+        std::cout << "";
+    }
+    return static_cast<double>(loops * buf.size()) / cost;  // MB/s
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+
+    std::cout << "accelerated: " << curve::common::IsCRC32CAccelerated()
+              << std::endl;
+    const std::vector<size_t> sizes = {64, 512, 4096, 16384, 65536, 1048576};
+    for (auto size : sizes) {
+        std::string buf(size, 0);
+        for (size_t i = 0; i < size; ++i) {
+            buf[i] = static_cast<char>(i * 31);
+        }
+        double butilMBps = MeasureThroughput(buf, butil::crc32c::Extend);
+        double curveMBps =
+            MeasureThroughput(buf, curve::common::CRC32CExtend);
+        std::cout << "size: " << size
+                  << ", butil: " << butilMBps << " MB/s"
+                  << ", curve: " << curveMBps << " MB/s" << std::endl;
+    }
+    return 0;
+}
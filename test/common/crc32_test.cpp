@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "src/common/crc32.h"
 
 namespace curve {
@@ -92,5 +94,55 @@ TEST(Crc32TEST, Extend) {
             CRC32(CRC32("hello ", 6), "world", 5));
 }
 
+namespace {
+
+uint32_t BitwiseCrc32c(uint32_t crc, const char *pData, size_t iLen) {
+    crc = ~crc;
+    for (size_t i = 0; i < iLen; ++i) {
+        crc ^= static_cast<uint8_t>(pData[i]);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0x82f63b78 : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+}  // namespace
+
+TEST(Crc32TEST, CompareWithReference) {
+    // cover the unaligned head, both interleaved strides and the tail
+    std::string data(3 * 1024 * 3 + 3 * 128 * 2 + 4096, 0);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 131 + (i >> 7));
+    }
+    const size_t sizes[] = {0, 1, 7, 8, 9, 383, 384, 385, 1000, 3071,
+                            3072, 3073, 4096, 3072 + 384 + 5, 9216, 10000};
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (auto size : sizes) {
+            ASSERT_LE(offset + size, data.size());
+            const char* p = data.data() + offset;
+            ASSERT_EQ(BitwiseCrc32c(0, p, size), CRC32(p, size))
+                << "offset: " << offset << ", size: " << size;
+            ASSERT_EQ(butil::crc32c::Value(p, size), CRC32(p, size));
+            ASSERT_EQ(BitwiseCrc32c(0x12345678, p, size),
+                      CRC32(0x12345678, p, size));
+        }
+    }
+}
+
+TEST(Crc32TEST, ExtendLargeBuffer) {
+    std::string data(64 * 1024 + 17, 0);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i ^ (i >> 9));
+    }
+    uint32_t whole = CRC32(data.data(), data.size());
+    ASSERT_EQ(BitwiseCrc32c(0, data.data(), data.size()), whole);
+    for (size_t split = 1; split < data.size(); split += 4093) {
+        uint32_t crc = CRC32(data.data(), split);
+        crc = CRC32(crc, data.data() + split, data.size() - split);
+        ASSERT_EQ(whole, crc);
+    }
+}
+
 }  // namespace common
 }  // namespace curve
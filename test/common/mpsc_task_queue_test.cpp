@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/common/concurrent/mpsc_task_queue.h"
+
+namespace curve {
+namespace common {
+
+TEST(MpscTaskQueueTest, BasicTest) {
+    MpscTaskQueue queue(3);
+    ASSERT_EQ(4, queue.Capacity());
+    ASSERT_EQ(0, queue.Size());
+
+    int sum = 0;
+    auto add = [&sum](int n) { sum += n; };
+    for (int i = 1; i <= 4; ++i) {
+        queue.Push(add, i);
+    }
+    ASSERT_EQ(4, queue.Size());
+    for (int i = 0; i < 4; ++i) {
+        queue.Pop()();
+    }
+    ASSERT_EQ(10, sum);
+    ASSERT_EQ(0, queue.Size());
+}
+
+TEST(MpscTaskQueueTest, TryPopTest) {
+    MpscTaskQueue queue(2, 0);
+    MpscTaskQueue::Task task;
+    ASSERT_FALSE(queue.TryPop(&task));
+
+    int sum = 0;
+    auto add = [&sum](int n) { sum += n; };
+    queue.Push(add, 1);
+    queue.Push(add, 2);
+    // the producer blocked on the full queue is woken up by TryPop
+    std::thread producer([&]() { queue.Push(add, 3); });
+    while (sum < 6) {
+        if (queue.TryPop(&task)) {
+            task();
+        }
+    }
+    producer.join();
+    ASSERT_FALSE(queue.TryPop(&task));
+    ASSERT_EQ(6, sum);
+}
+
+TEST(MpscTaskQueueTest, FifoTest) {
+    MpscTaskQueue queue(16, 0);
+    std::vector<int> order;
+    std::thread consumer([&]() {
+        for (int i = 0; i < 1000; ++i) {
+            queue.Pop()();
+        }
+    });
+    for (int i = 0; i < 1000; ++i) {
+        queue.Push([&order, i]() { order.push_back(i); });
+    }
+    consumer.join();
+    ASSERT_EQ(1000, order.size());
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(i, order[i]);
+    }
+}
+
+TEST(MpscTaskQueueTest, BlockWhenFullTest) {
+    MpscTaskQueue queue(2, 16);
+    std::atomic<int> pushed(0);
+    std::thread producer([&]() {
+        for (int i = 0; i < 3; ++i) {
+            queue.Push([]() {});
+            pushed.fetch_add(1);
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(2, pushed.load());
+    queue.Pop()();
+    producer.join();
+    ASSERT_EQ(3, pushed.load());
+    ASSERT_EQ(2, queue.Size());
+}
+
+TEST(MpscTaskQueueTest, MultiProducerTest) {
+    const int kProducerNum = 8;
+    const int kTaskPerProducer = 20000;
+    // no spin, make both sides park as often as possible
+    for (uint32_t spin : {0u, MpscTaskQueue::kDefaultSpinCount}) {
+        MpscTaskQueue queue(4, spin);
+        std::vector<uint64_t> sums(kProducerNum, 0);
+        std::vector<int> last(kProducerNum, -1);
+        bool ordered = true;
+        std::thread consumer([&]() {
+            for (int i = 0; i < kProducerNum * kTaskPerProducer; ++i) {
+                queue.Pop()();
+            }
+        });
+        std::vector<std::thread> producers;
+        for (int p = 0; p < kProducerNum; ++p) {
+            producers.emplace_back([&, p]() {
+                for (int i = 0; i < kTaskPerProducer; ++i) {
+                    queue.Push([&, p, i]() {
+                        // tasks from one producer keep their order
+                        ordered = ordered && last[p] + 1 == i;
+                        last[p] = i;
+                        sums[p] += i;
+                    });
+                }
+            });
+        }
+        for (auto& t : producers) {
+            t.join();
+        }
+        consumer.join();
+        ASSERT_TRUE(ordered);
+        for (auto sum : sums) {
+            ASSERT_EQ(static_cast<uint64_t>(kTaskPerProducer) *
+                          (kTaskPerProducer - 1) / 2, sum);
+        }
+    }
+}
+
+}  // namespace common
+}  // namespace curve
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <iostream>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/common/concurrent/mpsc_task_queue.h"
+#include "src/common/concurrent/task_queue.h"
+#include "src/common/timeutility.h"
+
+DEFINE_uint64(taskNum, 4000000, "total tasks pushed for each round");
+DEFINE_uint64(queueDepth, 1024, "capacity of the queue");
+
+using curve::common::MpscTaskQueue;
+using curve::common::TaskQueue;
+using curve::common::TimeUtility;
+
+namespace {
+
+// push/pop throughput of one consumer and producerNum producers, in ops/s
+template <typename QueueT>
+double MeasureThroughput(int producerNum) {
+    QueueT queue(FLAGS_queueDepth);
+    uint64_t perProducer = FLAGS_taskNum / producerNum;
+    uint64_t total = perProducer * producerNum;
+    std::atomic<uint64_t> counter(0);
+
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    std::thread consumer([&]() {
+        for (uint64_t i = 0; i < total; ++i) {
+            queue.Pop()();
+        }
+    });
+    std::vector<std::thread> producers;
+    for (int i = 0; i < producerNum; ++i) {
+        producers.emplace_back([&]() {
+            for (uint64_t j = 0; j < perProducer; ++j) {
+                queue.Push([&counter]() {
+                    counter.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+        });
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    consumer.join();
+    uint64_t cost = TimeUtility::GetTimeofDayUs() - start;
+    return static_cast<double>(counter.load()) * 1000000 / cost;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    google::ParseCommandLineFlags(&argc, &argv, false);
+
+    for (int producerNum : {1, 2, 4, 8, 16, 32, 64}) {
+        double mutexOps = MeasureThroughput<TaskQueue>(producerNum);
+        double mpscOps = MeasureThroughput<MpscTaskQueue>(producerNum);
+        std::cout << "producers: " << producerNum
+                  << ", mutex queue: " << mutexOps << " ops/s"
+                  << ", mpsc queue: " << mpscOps << " ops/s" << std::endl;
+    }
+    return 0;
+}
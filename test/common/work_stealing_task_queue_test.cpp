@@ -0,0 +1,153 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/common/concurrent/count_down_event.h"
+#include "src/common/concurrent/work_stealing_task_queue.h"
+
+namespace curve {
+namespace common {
+
+TEST(WorkStealingTaskQueueTest, BasicTest) {
+    WorkStealingTaskQueue queue(2, 8);
+    int sum = 0;
+    auto add = [&sum](int n) { sum += n; };
+    queue.Push(0, true, add, 1);
+    queue.Push(0, false, add, 2);
+    queue.Push(1, true, add, 3);
+    ASSERT_EQ(3, queue.Size());
+
+    // pinned tasks first, then its own stealable ones, then steal
+    queue.Pop(0)();
+    ASSERT_EQ(2, sum);
+    queue.Pop(0)();
+    ASSERT_EQ(3, sum);
+    queue.Pop(0)();
+    ASSERT_EQ(6, sum);
+    ASSERT_EQ(0, queue.Size());
+    ASSERT_EQ(1, queue.StealNum());
+}
+
+TEST(WorkStealingTaskQueueTest, StealFromBusyWorkerTest) {
+    const int kWorkerNum = 4;
+    const int kTaskNum = 200;
+    WorkStealingTaskQueue queue(kWorkerNum, 1024);
+    std::atomic<bool> stop(false);
+    std::atomic<int> done(0);
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < kWorkerNum; ++i) {
+        workers.emplace_back([&, i]() {
+            while (!stop.load()) {
+                queue.Pop(i)();
+            }
+        });
+    }
+
+    // all tasks hashed to worker 0
+    for (int i = 0; i < kTaskNum; ++i) {
+        queue.Push(0, true, [&done]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            done.fetch_add(1);
+        });
+    }
+    while (done.load() < kTaskNum) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_GT(queue.StealNum(), 0);
+
+    stop.store(true);
+    for (int i = 0; i < kWorkerNum; ++i) {
+        queue.Push(i, false, []() {});
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+}
+
+TEST(WorkStealingTaskQueueTest, PinnedTaskOrderTest) {
+    const int kWorkerNum = 3;
+    const int kTaskNum = 10000;
+    WorkStealingTaskQueue queue(kWorkerNum, 16);
+    std::atomic<bool> stop(false);
+    std::vector<int> order;
+    CountDownEvent finished(1);
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < kWorkerNum; ++i) {
+        workers.emplace_back([&, i]() {
+            while (!stop.load()) {
+                queue.Pop(i)();
+            }
+        });
+    }
+
+    // only worker 1 runs the pinned tasks, so they keep the order
+    std::atomic<int> others(0);
+    for (int i = 0; i < kTaskNum; ++i) {
+        queue.Push(1, false, [&order, i]() { order.push_back(i); });
+        queue.Push(1, true, [&others]() { others.fetch_add(1); });
+    }
+    queue.Push(1, false, [&finished]() { finished.Signal(); });
+    finished.Wait();
+    while (others.load() < kTaskNum) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(kTaskNum, order.size());
+    for (int i = 0; i < kTaskNum; ++i) {
+        ASSERT_EQ(i, order[i]);
+    }
+
+    stop.store(true);
+    for (int i = 0; i < kWorkerNum; ++i) {
+        queue.Push(i, false, []() {});
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+}
+
+TEST(WorkStealingTaskQueueTest, BlockWhenFullTest) {
+    WorkStealingTaskQueue queue(2, 2);
+    std::atomic<int> pushed(0);
+    std::thread producer([&]() {
+        for (int i = 0; i < 3; ++i) {
+            queue.Push(i % 2, true, []() {});
+            pushed.fetch_add(1);
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(2, pushed.load());
+    queue.Pop(1)();
+    producer.join();
+    ASSERT_EQ(3, pushed.load());
+    ASSERT_EQ(2, queue.Size());
+}
+
+}  // namespace common
+}  // namespace curve
@@ -0,0 +1,339 @@
+/*
+ *  Copyright (c) 2026 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <glog/logging.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/fs/io_uring_filesystem_impl.h"
+#include "src/fs/local_filesystem.h"
+
+namespace curve {
+namespace fs {
+
+const char kTestDir[] = "./io_uring_fs_test";
+
+class IoUringFileSystemTest : public testing::Test {
+ protected:
+    void SetUp() override {
+        lfs_ = LocalFsFactory::CreateFs(FileSystemType::EXT4, "",
+                                        IOEngineType::IO_URING);
+        ASSERT_NE(nullptr, lfs_);
+        LocalFileSystemOption option;
+        option.ioUringRingNum = 2;
+        option.ioUringQueueDepth = 8;
+        option.ioUringFixedFileNum = 2;
+        // io_uring may be unavailable on old kernels or in containers
+        supported_ = lfs_->Init(option) == 0;
+        if (supported_) {
+            ASSERT_EQ(0, lfs_->Mkdir(kTestDir));
+        }
+    }
+
+    void TearDown() override {
+        if (supported_) {
+            lfs_->Delete(kTestDir);
+        }
+    }
+
+    int OpenFile(const std::string& name) {
+        return lfs_->Open(std::string(kTestDir) + "/" + name,
+                          O_RDWR | O_CREAT);
+    }
+
+ protected:
+    std::shared_ptr<LocalFileSystem> lfs_;
+    bool supported_;
+};
+
+TEST_F(IoUringFileSystemTest, ReadWriteTest) {
+    if (!supported_) {
+        LOG(WARNING) << "io_uring is not supported, skip";
+        return;
+    }
+
+    int fd = OpenFile("file1");
+    ASSERT_GE(fd, 0);
+
+    std::string small(4096, 'a');
+    ASSERT_EQ(4096, lfs_->Write(fd, small.data(), 0, 4096));
+    std::string large(16384, 'b');
+    ASSERT_EQ(16384, lfs_->Write(fd, large.data(), 4096, 16384));
+    ASSERT_EQ(0, lfs_->Sync(fd));
+    ASSERT_EQ(0, lfs_->Fsync(fd));
+
+    char buf[20480];
+    ASSERT_EQ(20480, lfs_->Read(fd, buf, 0, 20480));
+    ASSERT_EQ(small, std::string(buf, 4096));
+    ASSERT_EQ(large, std::string(buf + 4096, 16384));
+
+    // read beyond the end of file returns the bytes actually read
+    ASSERT_EQ(4096, lfs_->Read(fd, buf, 16384, 8192));
+    ASSERT_EQ(0, lfs_->Read(fd, buf, 20480, 4096));
+
+    ASSERT_EQ(0, lfs_->Close(fd));
+}
+
+TEST_F(IoUringFileSystemTest, WriteIOBufTest) {
+    if (!supported_) {
+        LOG(WARNING) << "io_uring is not supported, skip";
+        return;
+    }
+
+    int fd = OpenFile("file2");
+    ASSERT_GE(fd, 0);
+
+    butil::IOBuf data;
+    std::string part1(1024, 'x');
+    std::string part2(3072, 'y');
+    data.append(part1);
+    data.append(part2);
+    ASSERT_EQ(-EINVAL, lfs_->Write(fd, data, 0, 1024));
+    ASSERT_EQ(4096, lfs_->Write(fd, data, 0, 4096));
+
+    char buf[4096];
+    ASSERT_EQ(4096, lfs_->Read(fd, buf, 0, 4096));
+    ASSERT_EQ(part1 + part2, std::string(buf, 4096));
+    ASSERT_EQ(0, lfs_->Close(fd));
+}
+
+TEST_F(IoUringFileSystemTest, FixedFileEvictTest) {
+    if (!supported_) {
+        LOG(WARNING) << "io_uring is not supported, skip";
+        return;
+    }
+
+    // more files than fixed file slots
+    std::vector<int> fds;
+    for (int i = 0; i < 5; ++i) {
+        int fd = OpenFile("evict" + std::to_string(i));
+        ASSERT_GE(fd, 0);
+        fds.push_back(fd);
+    }
+    for (int round = 0; round < 3; ++round) {
+        for (size_t i = 0; i < fds.size(); ++i) {
+            std::string data(512, 'a' + i);
+            ASSERT_EQ(512, lfs_->Write(fds[i], data.data(), round * 512, 512));
+        }
+    }
+    for (size_t i = 0; i < fds.size(); ++i) {
+        char buf[1536];
+        ASSERT_EQ(1536, lfs_->Read(fds[i], buf, 0, 1536));
+        ASSERT_EQ(std::string(1536, 'a' + i), std::string(buf, 1536));
+        ASSERT_EQ(0, lfs_->Close(fds[i]));
+    }
+
+    // fd numbers are reused after close, the stale fixed files must be gone
+    int fd = OpenFile("reuse");
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(4, lfs_->Write(fd, "abcd", 0, 4));
+    char buf[4];
+    ASSERT_EQ(4, lfs_->Read(fd, buf, 0, 4));
+    ASSERT_EQ("abcd", std::string(buf, 4));
+    ASSERT_EQ(0, lfs_->Close(fd));
+}
+
+TEST_F(IoUringFileSystemTest, SubmitMoreThanQueueDepth) {
+    if (!supported_) {
+        LOG(WARNING) << "io_uring is not supported, skip";
+        return;
+    }
+
+    int fd = OpenFile("batch");
+    ASSERT_GE(fd, 0);
+
+    // more deferred writes than the queue depth
+    const int count = 20;
+    lfs_->BeginBatch();
+    for (int i = 0; i < count; ++i) {
+        butil::IOBuf data;
+        data.append(std::string(4096, 'a' + i));
+        ASSERT_EQ(4096, lfs_->Write(fd, data, i * 4096, 4096));
+    }
+    ASSERT_EQ(0, lfs_->FlushBatch());
+
+    std::vector<char> buf(count * 4096);
+    ASSERT_EQ(count * 4096, lfs_->Read(fd, buf.data(), 0, count * 4096));
+    for (int i = 0; i < count; ++i) {
+        ASSERT_EQ(std::string(4096, 'a' + i),
+                  std::string(buf.data() + i * 4096, 4096));
+    }
+    ASSERT_EQ(0, lfs_->Close(fd));
+}
+
+TEST_F(IoUringFileSystemTest, LinkSyncAfterWrites) {
+    if (!supported_) {
+        LOG(WARNING) << "io_uring is not supported, skip";
+        return;
+    }
+
+    int fd1 = OpenFile("link1");
+    int fd2 = OpenFile("link2");
+    ASSERT_GE(fd1, 0);
+    ASSERT_GE(fd2, 0);
+
+    // the deferred writes of fd1 are chained before its sync, more
+    // requests than the queue depth split the chain
+    std::string data(4096, 'l');
+    lfs_->BeginBatch();
+    for (int i = 0; i < 10; ++i) {
+        butil::IOBuf buf;
+        buf.append(data);
+        ASSERT_EQ(4096, lfs_->Write(i % 2 == 0 ? fd1 : fd2, buf, i * 4096,
+                                    4096));
+    }
+    ASSERT_EQ(0, lfs_->Sync(fd1));
+    ASSERT_EQ(0, lfs_->FlushBatch());
+
+    // a failed write cancels the linked sync, which is then retried
+    lfs_->BeginBatch();
+    butil::IOBuf bad;
+    bad.append_user_data(reinterpret_cast<void*>(4096), 4096,
+                         [](void*) {});
+    ASSERT_EQ(4096, lfs_->Write(fd2, bad, 0, 4096));
+    ASSERT_EQ(0, lfs_->Sync(fd2));
+    ASSERT_EQ(-EFAULT, lfs_->FlushBatch());
+
+    ASSERT_EQ(0, lfs_->Close(fd1));
+    ASSERT_EQ(0, lfs_->Close(fd2));
+}
+
+TEST_F(IoUringFileSystemTest, DeferWritesInBatch) {
+    if (!supported_) {
+        LOG(WARNING) << "io_uring is not supported, skip";
+        return;
+    }
+
+    int fd = OpenFile("defer");
+    ASSERT_GE(fd, 0);
+    std::string path = std::string(kTestDir) + "/defer";
+
+    lfs_->BeginBatch();
+    butil::IOBuf data1;
+    data1.append(std::string(4096, 'a'));
+    butil::IOBuf data2;
+    data2.append(std::string(4096, 'b'));
+    ASSERT_EQ(4096, lfs_->Write(fd, data1, 0, 4096));
+    ASSERT_EQ(4096, lfs_->Write(fd, data2, 4096, 4096));
+    // not written yet
+    int rawFd = ::open(path.c_str(), O_RDONLY);
+    ASSERT_GE(rawFd, 0);
+    char buf[8192];
+    ASSERT_EQ(0, ::pread(rawFd, buf, sizeof(buf), 0));
+
+    // an overlapping write lands after the deferred ones
+    butil::IOBuf data3;
+    data3.append(std::string(4096, 'c'));
+    ASSERT_EQ(4096, lfs_->Write(fd, data3, 2048, 4096));
+    // a read of the same file sees the deferred writes
+    ASSERT_EQ(8192, lfs_->Read(fd, buf, 0, 8192));
+    ASSERT_EQ(std::string(2048, 'a') + std::string(4096, 'c') +
+              std::string(2048, 'b'), std::string(buf, 8192));
+
+    butil::IOBuf data4;
+    data4.append(std::string(4096, 'd'));
+    ASSERT_EQ(4096, lfs_->Write(fd, data4, 8192, 4096));
+    ASSERT_EQ(0, lfs_->FlushBatch());
+    ASSERT_EQ(4096, ::pread(rawFd, buf, 4096, 8192));
+    ASSERT_EQ(std::string(4096, 'd'), std::string(buf, 4096));
+
+    // writes out of a batch are not deferred
+    ASSERT_EQ(4096, lfs_->Write(fd, data1, 12288, 4096));
+    ASSERT_EQ(4096, ::pread(rawFd, buf, 4096, 12288));
+
+    // errors of deferred writes are reported by FlushBatch
+    lfs_->BeginBatch();
+    ASSERT_EQ(4096, lfs_->Write(rawFd, data1, 0, 4096));
+    ASSERT_EQ(-EBADF, lfs_->FlushBatch());
+    ::close(rawFd);
+    ASSERT_EQ(0, lfs_->Close(fd));
+}
+
+TEST_F(IoUringFileSystemTest, BatchErrorsPerThread) {
+    if (!supported_) {
+        LOG(WARNING) << "io_uring is not supported, skip";
+        return;
+    }
+
+    // all threads share the only ring
+    auto lfs = LocalFsFactory::CreateFs(FileSystemType::EXT4, "",
+                                        IOEngineType::IO_URING);
+    LocalFileSystemOption option;
+    option.ioUringRingNum = 1;
+    option.ioUringQueueDepth = 8;
+    ASSERT_EQ(0, lfs->Init(option));
+    int fd = lfs->Open(std::string(kTestDir) + "/shared", O_RDWR | O_CREAT);
+    ASSERT_GE(fd, 0);
+
+    butil::IOBuf data;
+    data.append(std::string(4096, 's'));
+    lfs->BeginBatch();
+    ASSERT_EQ(4096, lfs->Write(-1, data, 0, 4096));
+
+    // the sync and the batch of another thread neither submit the
+    // deferred write nor take its error
+    std::thread other([&lfs, fd, &data]() {
+        lfs->BeginBatch();
+        ASSERT_EQ(4096, lfs->Write(fd, data, 0, 4096));
+        ASSERT_EQ(0, lfs->Sync(fd));
+        ASSERT_EQ(0, lfs->FlushBatch());
+    });
+    other.join();
+
+    ASSERT_EQ(-EBADF, lfs->FlushBatch());
+    // the error is reported only once
+    ASSERT_EQ(0, lfs->FlushBatch());
+    ASSERT_EQ(0, lfs->Close(fd));
+}
+
+TEST_F(IoUringFileSystemTest, FdClosedOutside) {
+    if (!supported_) {
+        LOG(WARNING) << "io_uring is not supported, skip";
+        return;
+    }
+
+    int fd = OpenFile("outside1");
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(4, lfs_->Write(fd, "1111", 0, 4));
+    // closed without the filesystem, the fixed file is stale
+    ::close(fd);
+    int fd2 = OpenFile("outside2");
+    ASSERT_EQ(fd, fd2);
+    ASSERT_EQ(4, lfs_->Write(fd2, "2222", 0, 4));
+    ASSERT_EQ(0, lfs_->Close(fd2));
+
+    char buf[4];
+    int rawFd = ::open((std::string(kTestDir) + "/outside1").c_str(),
+                       O_RDONLY);
+    ASSERT_GE(rawFd, 0);
+    ASSERT_EQ(4, ::pread(rawFd, buf, 4, 0));
+    ASSERT_EQ("1111", std::string(buf, 4));
+    ::close(rawFd);
+}
+
+}  // namespace fs
+}  // namespace curve